@@ -4,15 +4,47 @@
 #include <algorithm>
 #include <limits>
 #include <cstdint>
+#include <cstdlib>
 
 namespace mavsdk {
 
+namespace {
+
+bool parse_unsigned_option(const std::string& name, const std::string& value, unsigned& result)
+{
+    if (value.empty()) {
+        LogWarn() << "Value of " << name << " missing";
+        return false;
+    }
+
+    for (const auto& digit : value) {
+        if (!std::isdigit(digit)) {
+            LogWarn() << "Non-numeric char found in " << name;
+            return false;
+        }
+    }
+
+    const auto parsed = std::strtoull(value.c_str(), nullptr, 10);
+    if (parsed > std::numeric_limits<unsigned>::max()) {
+        LogWarn() << "Value of " << name << " too big.";
+        return false;
+    }
+    result = static_cast<unsigned>(parsed);
+
+    return true;
+}
+
+} // namespace
+
 void CliArg::reset()
 {
     _protocol = Protocol::None;
     _path.clear();
     _baudrate = 0;
     _port = 0;
+    _speed = 1.0;
+    _max_bytes_per_s = 0;
+    _coalesce_us = 0;
 }
 
 bool CliArg::parse(const std::string& uri)
@@ -24,6 +56,15 @@ bool CliArg::parse(const std::string& uri)
         return false;
     }
 
+    if (_protocol == Protocol::Tlog) {
+        // The path is only known once the options are removed.
+        return find_speed(rest) && find_path(rest);
+    }
+
+    if (!find_options(rest)) {
+        return false;
+    }
+
     if (!find_path(rest)) {
         return false;
     }
@@ -47,6 +88,7 @@ bool CliArg::find_protocol(std::string& rest)
     const std::string tcp = "tcp";
     const std::string serial = "serial";
     const std::string serial_flowcontrol = "serial_flowcontrol";
+    const std::string tlog = "tlog";
     const std::string delimiter = "://";
 
     if (rest.find(udp + delimiter) == 0) {
@@ -67,6 +109,10 @@ bool CliArg::find_protocol(std::string& rest)
         _flow_control_enabled = true;
         rest.erase(0, serial_flowcontrol.length() + delimiter.length());
         return true;
+    } else if (rest.find(tlog + delimiter) == 0) {
+        _protocol = Protocol::Tlog;
+        rest.erase(0, tlog.length() + delimiter.length());
+        return true;
     } else {
         LogWarn() << "Unknown protocol";
         return false;
@@ -79,12 +125,22 @@ bool CliArg::find_path(std::string& rest)
         if (_protocol == Protocol::Udp || _protocol == Protocol::Tcp) {
             // We have to use the default path
             return true;
+        } else if (_protocol == Protocol::Tlog) {
+            LogWarn() << "Path for tlog file required.";
+            return false;
         } else {
             LogWarn() << "Path for serial device required.";
             return false;
         }
     }
 
+    if (_protocol == Protocol::Tlog) {
+        // A file path can contain anything, including ':'.
+        _path = rest;
+        rest = "";
+        return true;
+    }
+
     const std::string delimiter = ":";
     size_t pos = rest.find(delimiter);
     if (pos != std::string::npos) {
@@ -173,4 +229,80 @@ bool CliArg::find_baudrate(std::string& rest)
     return true;
 }
 
+bool CliArg::find_speed(std::string& rest)
+{
+    const std::string delimiter = "?speed=";
+    size_t pos = rest.rfind(delimiter);
+    if (pos == std::string::npos) {
+        _speed = 1.0;
+        return true;
+    }
+
+    const std::string speed_str = rest.substr(pos + delimiter.length());
+    rest.erase(pos);
+
+    if (speed_str.empty()) {
+        LogWarn() << "Speed missing";
+        return false;
+    }
+
+    for (const auto& c : speed_str) {
+        if (!std::isdigit(c) && c != '.') {
+            LogWarn() << "Non-numeric char found in speed";
+            return false;
+        }
+    }
+
+    char* end = nullptr;
+    _speed = std::strtod(speed_str.c_str(), &end);
+    if (end != speed_str.c_str() + speed_str.length()) {
+        LogWarn() << "Invalid speed";
+        _speed = 1.0;
+        return false;
+    }
+
+    return true;
+}
+
+bool CliArg::find_options(std::string& rest)
+{
+    // Options are separated by '&', e.g. ?max_bytes_per_s=4000&coalesce_us=1000
+    const size_t pos = rest.find('?');
+    if (pos == std::string::npos) {
+        return true;
+    }
+
+    const std::string options = rest.substr(pos + 1);
+    rest.erase(pos);
+
+    size_t start = 0;
+    while (start <= options.length()) {
+        size_t end = options.find('&', start);
+        if (end == std::string::npos) {
+            end = options.length();
+        }
+        const std::string option = options.substr(start, end - start);
+        start = end + 1;
+
+        const size_t equals = option.find('=');
+        const std::string name = option.substr(0, equals);
+        const std::string value = equals == std::string::npos ? "" : option.substr(equals + 1);
+
+        if (name == "max_bytes_per_s") {
+            if (!parse_unsigned_option(name, value, _max_bytes_per_s)) {
+                return false;
+            }
+        } else if (name == "coalesce_us") {
+            if (!parse_unsigned_option(name, value, _coalesce_us)) {
+                return false;
+            }
+        } else {
+            LogWarn() << "Unknown connection option: " << name;
+            return false;
+        }
+    }
+
+    return true;
+}
+
 } // namespace mavsdk
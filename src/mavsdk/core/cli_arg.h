@@ -6,7 +6,7 @@ namespace mavsdk {
 
 class CliArg {
 public:
-    enum class Protocol { None, Udp, Tcp, Serial };
+    enum class Protocol { None, Udp, Tcp, Serial, Tlog };
 
     bool parse(const std::string& uri);
 
@@ -20,18 +20,32 @@ public:
 
     [[nodiscard]] std::string get_path() const { return _path; }
 
+    [[nodiscard]] double get_speed() const { return _speed; }
+
+    // Limit for outgoing traffic in bytes per second, 0 if unlimited.
+    [[nodiscard]] unsigned get_max_bytes_per_s() const { return _max_bytes_per_s; }
+
+    // Latency budget for packing outgoing messages into fewer writes in
+    // microseconds, 0 if every message is written on its own.
+    [[nodiscard]] unsigned get_coalesce_us() const { return _coalesce_us; }
+
 private:
     void reset();
     bool find_protocol(std::string& rest);
     bool find_path(std::string& rest);
     bool find_port(std::string& rest);
     bool find_baudrate(std::string& rest);
+    bool find_speed(std::string& rest);
+    bool find_options(std::string& rest);
 
     Protocol _protocol{Protocol::None};
     std::string _path{};
     int _port{0};
     int _baudrate{0};
     bool _flow_control_enabled{false};
+    double _speed{1.0};
+    unsigned _max_bytes_per_s{0};
+    unsigned _coalesce_us{0};
 };
 
 } // namespace mavsdk
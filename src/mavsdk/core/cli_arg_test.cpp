@@ -167,3 +167,109 @@ TEST(CliArg, SerialConnections)
     EXPECT_FALSE(ca.parse("serial://SOM3:57600"));
     EXPECT_FALSE(ca.parse("serial://COM3:-1"));
 }
+
+TEST(CliArg, TlogConnections)
+{
+    CliArg ca;
+
+    EXPECT_TRUE(ca.parse("tlog:///tmp/flight.tlog"));
+    EXPECT_EQ(ca.get_protocol(), CliArg::Protocol::Tlog);
+    EXPECT_STREQ(ca.get_path().c_str(), "/tmp/flight.tlog");
+    EXPECT_DOUBLE_EQ(1.0, ca.get_speed());
+
+    EXPECT_TRUE(ca.parse("tlog://flight.tlog?speed=10"));
+    EXPECT_EQ(ca.get_protocol(), CliArg::Protocol::Tlog);
+    EXPECT_STREQ(ca.get_path().c_str(), "flight.tlog");
+    EXPECT_DOUBLE_EQ(10.0, ca.get_speed());
+
+    EXPECT_TRUE(ca.parse("tlog://C:\\logs\\flight.tlog?speed=0.5"));
+    EXPECT_STREQ(ca.get_path().c_str(), "C:\\logs\\flight.tlog");
+    EXPECT_DOUBLE_EQ(0.5, ca.get_speed());
+
+    // As fast as possible.
+    EXPECT_TRUE(ca.parse("tlog://flight.tlog?speed=0"));
+    EXPECT_DOUBLE_EQ(0.0, ca.get_speed());
+
+    // All the wrong combinations.
+    EXPECT_FALSE(ca.parse("tlog://"));
+    EXPECT_FALSE(ca.parse("tlog://?speed=2"));
+    EXPECT_FALSE(ca.parse("tlog://flight.tlog?speed="));
+    EXPECT_FALSE(ca.parse("tlog://flight.tlog?speed=-1"));
+    EXPECT_FALSE(ca.parse("tlog://flight.tlog?speed=fast"));
+    EXPECT_FALSE(ca.parse("tlog://flight.tlog?speed=."));
+}
+
+TEST(CliArg, MaxBytesPerS)
+{
+    CliArg ca;
+
+    EXPECT_TRUE(ca.parse("serial:///dev/ttyUSB0:57600"));
+    EXPECT_EQ(0u, ca.get_max_bytes_per_s());
+
+    EXPECT_TRUE(ca.parse("serial:///dev/ttyUSB0:57600?max_bytes_per_s=4000"));
+    EXPECT_STREQ(ca.get_path().c_str(), "/dev/ttyUSB0");
+    EXPECT_EQ(57600, ca.get_baudrate());
+    EXPECT_EQ(4000u, ca.get_max_bytes_per_s());
+
+    EXPECT_TRUE(ca.parse("udp://:14540?max_bytes_per_s=100000"));
+    EXPECT_EQ(ca.get_protocol(), CliArg::Protocol::Udp);
+    EXPECT_EQ(14540, ca.get_port());
+    EXPECT_EQ(100000u, ca.get_max_bytes_per_s());
+
+    EXPECT_TRUE(ca.parse("tcp://127.0.0.1:5760?max_bytes_per_s=2000"));
+    EXPECT_STREQ(ca.get_path().c_str(), "127.0.0.1");
+    EXPECT_EQ(5760, ca.get_port());
+    EXPECT_EQ(2000u, ca.get_max_bytes_per_s());
+
+    // It's reset for the next one.
+    EXPECT_TRUE(ca.parse("udp://:14540"));
+    EXPECT_EQ(0u, ca.get_max_bytes_per_s());
+
+    // All the wrong combinations.
+    EXPECT_FALSE(ca.parse("serial:///dev/ttyUSB0:57600?max_bytes_per_s="));
+    EXPECT_FALSE(ca.parse("serial:///dev/ttyUSB0:57600?max_bytes_per_s=-1"));
+    EXPECT_FALSE(ca.parse("serial:///dev/ttyUSB0:57600?max_bytes_per_s=4k"));
+    EXPECT_FALSE(ca.parse("udp://:14540?max_bytes_per_s=99999999999999999999"));
+}
+
+TEST(CliArg, CoalesceUs)
+{
+    CliArg ca;
+
+    EXPECT_TRUE(ca.parse("serial:///dev/ttyUSB0:57600"));
+    EXPECT_EQ(0u, ca.get_coalesce_us());
+
+    EXPECT_TRUE(ca.parse("serial:///dev/ttyUSB0:57600?coalesce_us=1000"));
+    EXPECT_STREQ(ca.get_path().c_str(), "/dev/ttyUSB0");
+    EXPECT_EQ(57600, ca.get_baudrate());
+    EXPECT_EQ(1000u, ca.get_coalesce_us());
+    EXPECT_EQ(0u, ca.get_max_bytes_per_s());
+
+    EXPECT_TRUE(ca.parse("tcp://127.0.0.1:5760?coalesce_us=500"));
+    EXPECT_STREQ(ca.get_path().c_str(), "127.0.0.1");
+    EXPECT_EQ(5760, ca.get_port());
+    EXPECT_EQ(500u, ca.get_coalesce_us());
+
+    // Together with the rate limit, in either order.
+    EXPECT_TRUE(ca.parse("serial:///dev/ttyUSB0:57600?max_bytes_per_s=4000&coalesce_us=2000"));
+    EXPECT_EQ(57600, ca.get_baudrate());
+    EXPECT_EQ(4000u, ca.get_max_bytes_per_s());
+    EXPECT_EQ(2000u, ca.get_coalesce_us());
+
+    EXPECT_TRUE(ca.parse("tcp://127.0.0.1:5760?coalesce_us=300&max_bytes_per_s=8000"));
+    EXPECT_EQ(5760, ca.get_port());
+    EXPECT_EQ(8000u, ca.get_max_bytes_per_s());
+    EXPECT_EQ(300u, ca.get_coalesce_us());
+
+    // It's reset for the next one.
+    EXPECT_TRUE(ca.parse("tcp://127.0.0.1:5760"));
+    EXPECT_EQ(0u, ca.get_coalesce_us());
+
+    // All the wrong combinations.
+    EXPECT_FALSE(ca.parse("serial:///dev/ttyUSB0:57600?coalesce_us="));
+    EXPECT_FALSE(ca.parse("serial:///dev/ttyUSB0:57600?coalesce_us=-1"));
+    EXPECT_FALSE(ca.parse("serial:///dev/ttyUSB0:57600?coalesce_us=1ms"));
+    EXPECT_FALSE(ca.parse("tcp://127.0.0.1:5760?coalesce_us=99999999999999999999"));
+    EXPECT_FALSE(ca.parse("tcp://127.0.0.1:5760?coalesce_us=1000&"));
+    EXPECT_FALSE(ca.parse("tcp://127.0.0.1:5760?coalesce=1000"));
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mavsdk {
+
+// Set of component IDs, one bit for each possible ID.
+//
+// Checking and adding IDs doesn't take a lock, so this can be done for every
+// incoming message. Once all components are known, that is a single atomic
+// load.
+class ComponentSet {
+public:
+    [[nodiscard]] bool contains(uint8_t component_id) const
+    {
+        return (word(component_id).load(std::memory_order_acquire) & bit(component_id)) != 0;
+    }
+
+    // Returns true if the ID was not in the set before. If several threads
+    // insert the same ID, this is true for exactly one of them.
+    bool insert(uint8_t component_id)
+    {
+        if (contains(component_id)) {
+            return false;
+        }
+        const auto before =
+            word(component_id).fetch_or(bit(component_id), std::memory_order_acq_rel);
+        return (before & bit(component_id)) == 0;
+    }
+
+    // Returns true if the ID was in the set.
+    bool erase(uint8_t component_id)
+    {
+        const auto before =
+            word(component_id).fetch_and(~bit(component_id), std::memory_order_acq_rel);
+        return (before & bit(component_id)) != 0;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        for (const auto& bits : _words) {
+            if (bits.load(std::memory_order_acquire) != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] std::size_t size() const { return ids().size(); }
+
+    // Returns the IDs in ascending order.
+    [[nodiscard]] std::vector<uint8_t> ids() const
+    {
+        std::vector<uint8_t> result;
+        for_each([&result](uint8_t component_id) { result.push_back(component_id); });
+        return result;
+    }
+
+    // Calls func for each ID in ascending order, without allocating.
+    template<typename F> void for_each(F&& func) const
+    {
+        for (std::size_t i = 0; i < _words.size(); ++i) {
+            auto bits = _words[i].load(std::memory_order_acquire);
+            for (unsigned j = 0; bits != 0; ++j, bits >>= 1) {
+                if ((bits & 1) != 0) {
+                    func(static_cast<uint8_t>(i * 64 + j));
+                }
+            }
+        }
+    }
+
+private:
+    std::atomic<uint64_t>& word(uint8_t component_id) { return _words[component_id / 64]; }
+    const std::atomic<uint64_t>& word(uint8_t component_id) const
+    {
+        return _words[component_id / 64];
+    }
+    static uint64_t bit(uint8_t component_id) { return uint64_t(1) << (component_id % 64); }
+
+    std::array<std::atomic<uint64_t>, 4> _words{};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,67 @@
+#include "component_set.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace mavsdk;
+
+TEST(ComponentSet, InsertAndContains)
+{
+    ComponentSet components;
+    EXPECT_TRUE(components.empty());
+    EXPECT_FALSE(components.contains(1));
+
+    EXPECT_TRUE(components.insert(1));
+    EXPECT_FALSE(components.insert(1));
+    EXPECT_TRUE(components.insert(255));
+    EXPECT_TRUE(components.insert(64));
+    EXPECT_TRUE(components.insert(0));
+
+    EXPECT_FALSE(components.empty());
+    EXPECT_TRUE(components.contains(1));
+    EXPECT_TRUE(components.contains(255));
+    EXPECT_FALSE(components.contains(2));
+    EXPECT_FALSE(components.contains(63));
+    EXPECT_EQ(components.size(), 4u);
+    EXPECT_EQ(components.ids(), (std::vector<uint8_t>{0, 1, 64, 255}));
+}
+
+TEST(ComponentSet, InsertIsNewForExactlyOneThread)
+{
+    ComponentSet components;
+    std::atomic<unsigned> new_count{0};
+
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < 4; ++i) {
+        threads.emplace_back([&]() {
+            for (unsigned id = 0; id < 256; ++id) {
+                if (components.insert(static_cast<uint8_t>(id))) {
+                    ++new_count;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(new_count, 256u);
+    EXPECT_EQ(components.size(), 256u);
+}
+
+TEST(ComponentSet, Erase)
+{
+    ComponentSet components;
+    components.insert(1);
+    components.insert(200);
+
+    EXPECT_TRUE(components.erase(1));
+    EXPECT_FALSE(components.erase(1));
+    EXPECT_FALSE(components.erase(2));
+    EXPECT_FALSE(components.contains(1));
+    EXPECT_EQ(components.ids(), (std::vector<uint8_t>{200}));
+
+    EXPECT_TRUE(components.erase(200));
+    EXPECT_TRUE(components.empty());
+}
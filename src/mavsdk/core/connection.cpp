@@ -1,7 +1,10 @@
 #include "connection.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <memory>
 #include <utility>
+#include "log.h"
 #include "mavsdk_impl.h"
 #include "mavlink_channels.h"
 
@@ -12,8 +15,13 @@ std::atomic<unsigned> Connection::_forwarding_connections_count = 0;
 Connection::Connection(ReceiverCallback receiver_callback, ForwardingOption forwarding_option) :
     _receiver_callback(std::move(receiver_callback)),
     _mavlink_receiver(),
+    _signing(std::make_unique<MavlinkSigning>()),
+    _send_queue(std::make_unique<SendQueue>(
+        [this](const mavlink_message_t& message) { return write_message(message); })),
     _forwarding_option(forwarding_option)
 {
+    _send_queue->set_signing(_signing.get());
+
     // Insert system ID 0 in all connections for broadcast.
     _system_ids.insert(0);
 
@@ -50,8 +58,88 @@ void Connection::stop_mavlink_receiver()
     }
 }
 
+void Connection::start_send_queue()
+{
+    _send_queue->start();
+    _send_queue_running = true;
+}
+
+void Connection::stop_send_queue()
+{
+    _send_queue_running = false;
+    _send_queue->stop();
+}
+
+void Connection::enable_write_coalescing(SendQueue::WriteBytesFunction write_bytes_function)
+{
+    auto latency = _coalescing_latency;
+    if (latency.count() == 0) {
+        if (const char* env_p = std::getenv("MAVSDK_WRITE_COALESCING_US")) {
+            // Latency budget for packing messages together, e.g. 1000.
+            latency = std::chrono::microseconds(std::max(0, std::atoi(env_p)));
+        }
+    }
+
+    if (latency.count() > 0) {
+        LogDebug() << "Coalescing writes within " << latency.count() << " us.";
+        _send_queue->set_coalescing(latency, std::move(write_bytes_function));
+    }
+}
+
+bool Connection::send_message(const mavlink_message_t& message)
+{
+    if (_send_queue_running) {
+        // Signed by the writer thread, in the order the messages are written.
+        return _send_queue->push(message);
+    }
+
+    if (_signing->is_enabled()) {
+        // The same message can go out on other links with other keys.
+        mavlink_message_t signed_message = message;
+        if (!_signing->sign(signed_message)) {
+            return false;
+        }
+        return write_message(signed_message);
+    }
+    return write_message(message);
+}
+
+SendQueue::Stats Connection::send_queue_stats() const
+{
+    return _send_queue->stats();
+}
+
+void Connection::set_max_bytes_per_s(unsigned max_bytes_per_s)
+{
+    _send_queue->set_max_bytes_per_s(max_bytes_per_s);
+}
+
+bool Connection::has_bulk_capacity() const
+{
+    return !_send_queue_running || _send_queue->has_room(SendQueue::Priority::Bulk);
+}
+
+void Connection::set_signing(const Mavsdk::SigningOptions& options)
+{
+    _signing->enable(options.secret_key, options.link_id, options.accept_unsigned);
+}
+
+void Connection::clear_signing()
+{
+    _signing->disable();
+}
+
+MavlinkSigning::Stats Connection::signing_stats() const
+{
+    return _signing->stats();
+}
+
 void Connection::receive_message(mavlink_message_t& message, Connection* connection)
 {
+    if (_signing->is_enabled() && !_signing->verify(message)) {
+        return;
+    }
+
     // Register system ID when receiving a message from a new system.
     if (_system_ids.find(message.sysid) == _system_ids.end()) {
         _system_ids.insert(message.sysid);
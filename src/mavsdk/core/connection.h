@@ -2,11 +2,17 @@
 
 #include "mavsdk.h"
 #include "mavlink_receiver.h"
+#include "mavlink_signing.h"
+#include "send_queue.h"
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <unordered_set>
 
 namespace mavsdk {
 
+class IoReactor;
+
 class Connection {
 public:
     using ReceiverCallback =
@@ -20,7 +26,51 @@ public:
     virtual ConnectionResult start() = 0;
     virtual ConnectionResult stop() = 0;
 
-    virtual bool send_message(const mavlink_message_t& message) = 0;
+    // Queues the message for the writer thread if the connection has one
+    // running, otherwise writes it right away.
+    bool send_message(const mavlink_message_t& message);
+
+    // Same as send_message() but packs the message straight into the send
+    // queue, see SendQueue::emplace(). Without a writer thread it's packed on
+    // the stack and written right away.
+    template<typename Pack> bool send_message_in_place(uint32_t message_id, const Pack& pack)
+    {
+        if (_send_queue_running) {
+            return _send_queue->emplace(message_id, pack);
+        }
+
+        mavlink_message_t message;
+        if (!pack(message)) {
+            return false;
+        }
+        return send_message(message);
+    }
+
+    [[nodiscard]] SendQueue::Stats send_queue_stats() const;
+
+    // Limits outgoing traffic to this many bytes per second, 0 for unlimited.
+    void set_max_bytes_per_s(unsigned max_bytes_per_s);
+
+    // Packs outgoing messages written within this latency into one write, 0
+    // to write each on its own. Needs to be set before start().
+    void set_coalescing_latency(std::chrono::microseconds latency)
+    {
+        _coalescing_latency = latency;
+    }
+
+    // Returns false while bulk messages are piling up in the send queue.
+    [[nodiscard]] bool has_bulk_capacity() const;
+
+    // Signs outgoing messages and drops incoming ones which are not signed
+    // with the same key.
+    void set_signing(const Mavsdk::SigningOptions& options);
+    void clear_signing();
+
+    [[nodiscard]] MavlinkSigning::Stats signing_stats() const;
+
+    // Receives on the thread of the reactor instead of an own thread, if
+    // the connection supports it. Needs to be set before start().
+    void set_io_reactor(IoReactor* io_reactor) { _io_reactor = io_reactor; }
 
     bool has_system_id(uint8_t system_id);
     bool should_forward_messages() const;
@@ -33,10 +83,27 @@ public:
 protected:
     bool start_mavlink_receiver();
     void stop_mavlink_receiver();
+    // The send queue needs to be stopped in stop() of the specific connection
+    // because the writer thread calls write_message.
+    void start_send_queue();
+    void stop_send_queue();
+    // Packs queued messages into fewer writes if a coalescing latency is set
+    // for the connection, or else MAVSDK_WRITE_COALESCING_US is set for all
+    // of them. Needs to be called before start_send_queue().
+    void enable_write_coalescing(SendQueue::WriteBytesFunction write_bytes_function);
+
+    // Writes a message to the underlying port or socket, which can block.
+    virtual bool write_message(const mavlink_message_t& message) = 0;
     void receive_message(mavlink_message_t& message, Connection* connection);
 
     ReceiverCallback _receiver_callback{};
     std::unique_ptr<MavlinkReceiver> _mavlink_receiver;
+    // Before the send queue, so its writer thread can still sign.
+    std::unique_ptr<MavlinkSigning> _signing;
+    std::unique_ptr<SendQueue> _send_queue;
+    std::atomic<bool> _send_queue_running{false};
+    IoReactor* _io_reactor{nullptr};
+    std::chrono::microseconds _coalescing_latency{0};
     ForwardingOption _forwarding_option;
     std::unordered_set<uint8_t> _system_ids;
 
@@ -6,64 +6,108 @@ namespace mavsdk::geometry {
 
 CoordinateTransformation::CoordinateTransformation(GlobalCoordinate reference) :
     _ref_lat_rad(to_rad_from_deg(reference.latitude_deg)),
-    _ref_lon_rad(to_rad_from_deg(reference.longitude_deg))
+    _ref_lon_rad(to_rad_from_deg(reference.longitude_deg)),
+    _ref_sin_lat(sin(_ref_lat_rad)),
+    _ref_cos_lat(cos(_ref_lat_rad))
 {}
 
 CoordinateTransformation::LocalCoordinate
 CoordinateTransformation::local_from_global(GlobalCoordinate global_coordinate) const
 {
-    const double lat_rad = to_rad_from_deg(global_coordinate.latitude_deg);
-    const double lon_rad = to_rad_from_deg(global_coordinate.longitude_deg);
-
-    const double sin_lat = sin(lat_rad);
-    const double cos_lat = cos(lat_rad);
-
-    const double cos_d_lon = cos(lon_rad - _ref_lon_rad);
-
-    const double ref_sin_lat = sin(_ref_lat_rad);
-    const double ref_cos_lat = cos(_ref_lat_rad);
-
-    const double arg =
-        constrain(ref_sin_lat * sin_lat + ref_cos_lat * cos_lat * cos_d_lon, -1.0, 1.0);
-    const double c = acos(arg);
-
-    const double k = (fabs(c) > 0) ? (c / sin(c)) : 1.0;
-
-    return LocalCoordinate{
-        k * (ref_cos_lat * sin_lat - ref_sin_lat * cos_lat * cos_d_lon) * world_radius_m,
-        k * cos_lat * sin(lon_rad - _ref_lon_rad) * world_radius_m};
+    LocalCoordinate local{};
+    local_from_global(
+        &global_coordinate.latitude_deg,
+        &global_coordinate.longitude_deg,
+        1,
+        &local.north_m,
+        &local.east_m);
+    return local;
 }
 
 CoordinateTransformation::GlobalCoordinate
 CoordinateTransformation::global_from_local(LocalCoordinate local_coordinate) const
 {
-    const double x_rad = local_coordinate.north_m / world_radius_m;
-    const double y_rad = local_coordinate.east_m / world_radius_m;
-    const double c = sqrt(x_rad * x_rad + y_rad * y_rad);
-
     GlobalCoordinate global{};
+    global_from_local(
+        &local_coordinate.north_m,
+        &local_coordinate.east_m,
+        1,
+        &global.latitude_deg,
+        &global.longitude_deg);
+    return global;
+}
 
-    if (fabs(c) > 0) {
-        const double sin_c = sin(c);
-        const double cos_c = cos(c);
-
-        const double ref_sin_lat = sin(_ref_lat_rad);
-        const double ref_cos_lat = cos(_ref_lat_rad);
-
-        const double lat_rad = asin(cos_c * ref_sin_lat + (x_rad * sin_c * ref_cos_lat) / c);
-        const double lon_rad =
-            (_ref_lon_rad +
-             atan2(y_rad * sin_c, c * ref_cos_lat * cos_c - x_rad * ref_sin_lat * sin_c));
-
-        global.latitude_deg = to_deg_from_rad(lat_rad);
-        global.longitude_deg = to_deg_from_rad(lon_rad);
-
-    } else {
-        global.latitude_deg = to_deg_from_rad(_ref_lat_rad);
-        global.longitude_deg = to_deg_from_rad(_ref_lon_rad);
+void CoordinateTransformation::local_from_global(
+    const double* latitude_deg,
+    const double* longitude_deg,
+    std::size_t count,
+    double* north_m,
+    double* east_m) const
+{
+    // Copies, so the compiler knows they don't change when writing the results.
+    const double ref_sin_lat = _ref_sin_lat;
+    const double ref_cos_lat = _ref_cos_lat;
+    const double ref_lon_rad = _ref_lon_rad;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const double lat_rad = to_rad_from_deg(latitude_deg[i]);
+        const double d_lon_rad = to_rad_from_deg(longitude_deg[i]) - ref_lon_rad;
+
+        const double sin_lat = sin(lat_rad);
+        const double cos_lat = cos(lat_rad);
+        const double sin_d_lon = sin(d_lon_rad);
+        const double cos_d_lon = cos(d_lon_rad);
+
+        const double arg =
+            constrain(ref_sin_lat * sin_lat + ref_cos_lat * cos_lat * cos_d_lon, -1.0, 1.0);
+        const double c = acos(arg);
+
+        // This is sin(c) without another call to sin. Factored like this
+        // it stays accurate for short distances where arg is close to 1.
+        const double sin_c = sqrt((1.0 - arg) * (1.0 + arg));
+        const double k = (sin_c > 0) ? (c / sin_c) : 1.0;
+
+        north_m[i] =
+            k * (ref_cos_lat * sin_lat - ref_sin_lat * cos_lat * cos_d_lon) * world_radius_m;
+        east_m[i] = k * cos_lat * sin_d_lon * world_radius_m;
     }
+}
 
-    return global;
+void CoordinateTransformation::global_from_local(
+    const double* north_m,
+    const double* east_m,
+    std::size_t count,
+    double* latitude_deg,
+    double* longitude_deg) const
+{
+    const double ref_sin_lat = _ref_sin_lat;
+    const double ref_cos_lat = _ref_cos_lat;
+    const double ref_lat_deg = to_deg_from_rad(_ref_lat_rad);
+    const double ref_lon_deg = to_deg_from_rad(_ref_lon_rad);
+    const double ref_lon_rad = _ref_lon_rad;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const double x_rad = north_m[i] / world_radius_m;
+        const double y_rad = east_m[i] / world_radius_m;
+        const double c = sqrt(x_rad * x_rad + y_rad * y_rad);
+
+        if (fabs(c) > 0) {
+            const double sin_c = sin(c);
+            const double cos_c = cos(c);
+
+            const double lat_rad = asin(cos_c * ref_sin_lat + (x_rad * sin_c * ref_cos_lat) / c);
+            const double lon_rad =
+                (ref_lon_rad +
+                 atan2(y_rad * sin_c, c * ref_cos_lat * cos_c - x_rad * ref_sin_lat * sin_c));
+
+            latitude_deg[i] = to_deg_from_rad(lat_rad);
+            longitude_deg[i] = to_deg_from_rad(lon_rad);
+
+        } else {
+            latitude_deg[i] = ref_lat_deg;
+            longitude_deg[i] = ref_lon_deg;
+        }
+    }
 }
 
 } // namespace mavsdk::geometry
@@ -1,5 +1,9 @@
 #include "geometry.h"
+#include <algorithm>
+#include <cmath>
 #include <gtest/gtest.h>
+#include <utility>
+#include <vector>
 
 using namespace mavsdk::geometry;
 
@@ -48,3 +52,98 @@ TEST(Geoemtry, LocalToGlobalAndBack)
     EXPECT_NEAR(location.north_m, location_again.north_m, 1e-8);
     EXPECT_NEAR(location.east_m, location_again.east_m, 1e-8);
 }
+
+// The projection as it is written in the reference, in long double, to
+// check that the arrangement for speed doesn't cost accuracy.
+static CoordinateTransformation::LocalCoordinate reference_local_from_global(
+    CoordinateTransformation::GlobalCoordinate reference,
+    CoordinateTransformation::GlobalCoordinate global)
+{
+    const long double deg = 3.14159265358979323846264338327950288L / 180.0L;
+    const long double ref_lat = reference.latitude_deg * deg;
+    const long double ref_lon = reference.longitude_deg * deg;
+    const long double lat = global.latitude_deg * deg;
+    const long double lon = global.longitude_deg * deg;
+
+    const long double c = std::acos(std::min(
+        1.0L,
+        std::sin(ref_lat) * std::sin(lat) +
+            std::cos(ref_lat) * std::cos(lat) * std::cos(lon - ref_lon)));
+    const long double k = c > 0 ? c / std::sin(c) : 1.0L;
+
+    return {
+        static_cast<double>(
+            k *
+            (std::cos(ref_lat) * std::sin(lat) -
+             std::sin(ref_lat) * std::cos(lat) * std::cos(lon - ref_lon)) *
+            6371000.0L),
+        static_cast<double>(k * std::cos(lat) * std::sin(lon - ref_lon) * 6371000.0L)};
+}
+
+TEST(Geometry, GlobalToLocalBatchIsAccurate)
+{
+    const CoordinateTransformation::GlobalCoordinate reference{47.397742, 8.545594};
+    CoordinateTransformation ct(reference);
+
+    // From the reference itself, over a few mm up to 200 km away.
+    std::vector<double> latitudes;
+    std::vector<double> longitudes;
+    for (double offset_deg = 1e-8; offset_deg < 2.0; offset_deg *= 3.0) {
+        for (const auto& [lat_sign, lon_sign] : {std::pair{1, 0}, {-1, 1}, {0, -1}, {1, 1}}) {
+            latitudes.push_back(reference.latitude_deg + lat_sign * offset_deg);
+            longitudes.push_back(reference.longitude_deg + lon_sign * offset_deg);
+        }
+    }
+    latitudes.push_back(reference.latitude_deg);
+    longitudes.push_back(reference.longitude_deg);
+
+    std::vector<double> north(latitudes.size());
+    std::vector<double> east(latitudes.size());
+    ct.local_from_global(
+        latitudes.data(), longitudes.data(), latitudes.size(), north.data(), east.data());
+
+    for (std::size_t i = 0; i < latitudes.size(); ++i) {
+        const auto expected = reference_local_from_global(reference, {latitudes[i], longitudes[i]});
+        EXPECT_NEAR(north[i], expected.north_m, 1e-6) << i;
+        EXPECT_NEAR(east[i], expected.east_m, 1e-6) << i;
+
+        const auto single = ct.local_from_global({latitudes[i], longitudes[i]});
+        EXPECT_EQ(north[i], single.north_m);
+        EXPECT_EQ(east[i], single.east_m);
+    }
+}
+
+TEST(Geometry, LocalToGlobalBatchAndBack)
+{
+    CoordinateTransformation ct({-35.363261, 149.165230});
+
+    std::vector<double> north;
+    std::vector<double> east;
+    for (double north_m = -50000.0; north_m <= 50000.0; north_m += 1234.5) {
+        for (double east_m = -50000.0; east_m <= 50000.0; east_m += 2345.6) {
+            north.push_back(north_m);
+            east.push_back(east_m);
+        }
+    }
+    north.push_back(0.0);
+    east.push_back(0.0);
+
+    std::vector<double> latitudes(north.size());
+    std::vector<double> longitudes(north.size());
+    ct.global_from_local(
+        north.data(), east.data(), north.size(), latitudes.data(), longitudes.data());
+
+    std::vector<double> north_again(north.size());
+    std::vector<double> east_again(north.size());
+    ct.local_from_global(
+        latitudes.data(), longitudes.data(), north.size(), north_again.data(), east_again.data());
+
+    for (std::size_t i = 0; i < north.size(); ++i) {
+        const auto single = ct.global_from_local({north[i], east[i]});
+        EXPECT_EQ(latitudes[i], single.latitude_deg);
+        EXPECT_EQ(longitudes[i], single.longitude_deg);
+
+        EXPECT_NEAR(north_again[i], north[i], 1e-6) << i;
+        EXPECT_NEAR(east_again[i], east[i], 1e-6) << i;
+    }
+}
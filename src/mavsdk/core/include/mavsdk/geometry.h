@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 namespace mavsdk::geometry {
 
 /**
@@ -55,6 +57,45 @@ public:
      */
     [[nodiscard]] GlobalCoordinate global_from_local(LocalCoordinate local_coordinate) const;
 
+    /**
+     * @brief Calculate local coordinates from global coordinates for many points.
+     *
+     * This is faster than transforming the points one by one, e.g. for
+     * mission plans, geofences or positions of many vehicles. The points
+     * are passed as separate arrays per axis of `count` elements each.
+     *
+     * @param latitude_deg Latitudes to project from.
+     * @param longitude_deg Longitudes to project from.
+     * @param count Number of points.
+     * @param north_m Resulting positions in North direction.
+     * @param east_m Resulting positions in East direction.
+     */
+    void local_from_global(
+        const double* latitude_deg,
+        const double* longitude_deg,
+        std::size_t count,
+        double* north_m,
+        double* east_m) const;
+
+    /**
+     * @brief Calculate global coordinates from local coordinates for many points.
+     *
+     * This is faster than transforming the points one by one. The points
+     * are passed as separate arrays per axis of `count` elements each.
+     *
+     * @param north_m Positions in North direction to project from.
+     * @param east_m Positions in East direction to project from.
+     * @param count Number of points.
+     * @param latitude_deg Resulting latitudes.
+     * @param longitude_deg Resulting longitudes.
+     */
+    void global_from_local(
+        const double* north_m,
+        const double* east_m,
+        std::size_t count,
+        double* latitude_deg,
+        double* longitude_deg) const;
+
     /**
      * @brief Destructor.
      */
@@ -63,6 +104,8 @@ public:
 private:
     double _ref_lat_rad;
     double _ref_lon_rad;
+    double _ref_sin_lat;
+    double _ref_cos_lat;
     static constexpr double world_radius_m{6371000.0};
 };
 
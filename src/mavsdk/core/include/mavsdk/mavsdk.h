@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <optional>
@@ -75,17 +77,30 @@ public:
     /**
      * @brief Adds Connection via URL
      *
-     * Supports connection: Serial, TCP or UDP.
+     * Supports connection: Serial, TCP, UDP or a telemetry log to replay.
      * Connection URL format should be:
-     * - UDP:    udp://[host][:bind_port]
-     * - TCP:    tcp://[host][:remote_port]
-     * - Serial: serial://dev_node[:baudrate]
+     * - UDP:    udp://[host][:bind_port][?max_bytes_per_s=N]
+     * - TCP:    tcp://[host][:remote_port][?max_bytes_per_s=N][&coalesce_us=N]
+     * - Serial: serial://dev_node[:baudrate][?max_bytes_per_s=N][&coalesce_us=N]
+     * - Tlog:   tlog://file_path[?speed=N]
      *
      * For UDP, the host can be set to either:
      *   - zero IP: 0.0.0.0 -> behave like a server and listen for heartbeats.
      *   - some IP: 192.168.1.12 -> behave like a client, initiate connection
      *     and start sending heartbeats.
      *
+     * For a tlog, the messages are replayed at the recorded pace by default,
+     * N times faster with speed=N, or as fast as possible with speed=0.
+     *
+     * With max_bytes_per_s=N, outgoing messages are limited to N bytes per
+     * second, e.g. to leave room on a slow radio link. Bulk transfers such as
+     * parameters wait while the link is busy. See connection_stats() for how
+     * much of the limit is used.
+     *
+     * With coalesce_us=N on TCP and serial links, outgoing messages sent
+     * within N microseconds are packed into one write, trading a little
+     * latency for fewer writes. Several options are separated by '&'.
+     *
      * @param connection_url connection URL string.
      * @param forwarding_option message forwarding option (when multiple interfaces are used).
      * @return The result of adding the connection.
@@ -103,17 +118,30 @@ public:
      * @brief Adds Connection via URL Additionally returns a handle to remove
      *        the connection later.
      *
-     * Supports connection: Serial, TCP or UDP.
+     * Supports connection: Serial, TCP, UDP or a telemetry log to replay.
      * Connection URL format should be:
-     * - UDP:    udp://[host][:bind_port]
-     * - TCP:    tcp://[host][:remote_port]
-     * - Serial: serial://dev_node[:baudrate]
+     * - UDP:    udp://[host][:bind_port][?max_bytes_per_s=N]
+     * - TCP:    tcp://[host][:remote_port][?max_bytes_per_s=N][&coalesce_us=N]
+     * - Serial: serial://dev_node[:baudrate][?max_bytes_per_s=N][&coalesce_us=N]
+     * - Tlog:   tlog://file_path[?speed=N]
      *
      * For UDP, the host can be set to either:
      *   - zero IP: 0.0.0.0 -> behave like a server and listen for heartbeats.
      *   - some IP: 192.168.1.12 -> behave like a client, initiate connection
      *     and start sending heartbeats.
      *
+     * For a tlog, the messages are replayed at the recorded pace by default,
+     * N times faster with speed=N, or as fast as possible with speed=0.
+     *
+     * With max_bytes_per_s=N, outgoing messages are limited to N bytes per
+     * second, e.g. to leave room on a slow radio link. Bulk transfers such as
+     * parameters wait while the link is busy. See connection_stats() for how
+     * much of the limit is used.
+     *
+     * With coalesce_us=N on TCP and serial links, outgoing messages sent
+     * within N microseconds are packed into one write, trading a little
+     * latency for fewer writes. Several options are separated by '&'.
+     *
      * @param connection_url connection URL string.
      * @param forwarding_option message forwarding option (when multiple interfaces are used).
      * @return A pair containing the result of adding the connection as well
@@ -202,6 +230,62 @@ public:
      */
     void remove_connection(ConnectionHandle handle);
 
+    /**
+     * @brief Options for MAVLink 2 message signing on a connection.
+     */
+    struct SigningOptions {
+        std::array<uint8_t, 32> secret_key{}; /**< @brief Key shared with the other end. */
+        uint8_t link_id{0}; /**< @brief ID of this link, part of every signature. */
+        bool accept_unsigned{false}; /**< @brief Whether to accept unsigned messages. */
+    };
+
+    /**
+     * @brief Sign messages sent on a connection, and drop received ones which
+     *        are not signed with the same key.
+     *
+     * Each connection can have its own key. Received messages are also
+     * dropped if they are replayed or their timestamp is more than a minute
+     * old. Unsigned RADIO_STATUS messages are always accepted, since radios
+     * inject them without knowing the key.
+     *
+     * @param handle Handle returned when connection was added.
+     * @param options Key and link ID to use.
+     * @return ConnectionError if the connection was not found.
+     */
+    ConnectionResult set_signing(ConnectionHandle handle, const SigningOptions& options);
+
+    /**
+     * @brief Stop signing and checking signatures on a connection.
+     *
+     * @param handle Handle returned when connection was added.
+     * @return ConnectionError if the connection was not found.
+     */
+    ConnectionResult clear_signing(ConnectionHandle handle);
+
+    /**
+     * @brief Statistics of the messages sent on a connection.
+     */
+    struct ConnectionStats {
+        uint64_t messages_sent{0}; /**< @brief Messages written to the link. */
+        uint64_t messages_dropped{0}; /**< @brief Messages dropped as the queue was full. */
+        uint64_t bytes_sent{0}; /**< @brief Bytes written to the link. */
+        double bytes_per_s{0.0}; /**< @brief Bytes sent per second, over about the last second. */
+        uint32_t max_bytes_per_s{0}; /**< @brief Limit set with max_bytes_per_s, 0 if none. */
+        double utilization{0.0}; /**< @brief Fraction of the limit used, 0 if there is none. */
+    };
+
+    /**
+     * @brief Get statistics of the messages sent on a connection.
+     *
+     * This is useful to see how much of the bandwidth of a limited link,
+     * set with max_bytes_per_s in the connection URL, is used.
+     *
+     * @param handle Handle returned when connection was added.
+     * @return ConnectionError if the connection was not found, and the
+     *         statistics otherwise.
+     */
+    std::pair<ConnectionResult, ConnectionStats> connection_stats(ConnectionHandle handle) const;
+
     /**
      * @brief Get a vector of systems which have been discovered or set-up.
      *
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "mavlink_include.h"
+#include <type_traits>
+
+namespace mavsdk {
+
+/**
+ * @brief Refers to a callable which packs a MAVLink message.
+ *
+ * This is usually a lambda calling one of the `mavlink_msg_*_pack` functions.
+ * It can be handed down to where the message ends up without the allocation
+ * a std::function might need.
+ *
+ * It doesn't own the callable, so it's only valid as long as that is, which
+ * is the call it's passed to.
+ */
+class MessagePacker {
+public:
+    /**
+     * @brief Refers to a callable taking a `mavlink_message_t&` to fill.
+     */
+    template<
+        typename Pack,
+        typename = std::enable_if_t<!std::is_same_v<std::decay_t<Pack>, MessagePacker>>>
+    MessagePacker(const Pack& pack) :
+        _pack(&pack),
+        _call([](const void* pack_ptr, mavlink_message_t& message) {
+            (*static_cast<const Pack*>(pack_ptr))(message);
+        })
+    {}
+
+    /**
+     * @brief Calls the callable with the message to fill.
+     */
+    void operator()(mavlink_message_t& message) const { _call(_pack, message); }
+
+private:
+    const void* _pack;
+    void (*_call)(const void* pack_ptr, mavlink_message_t& message);
+};
+
+} // namespace mavsdk
@@ -26,6 +26,27 @@ public:
      */
     ~ServerComponent() = default;
 
+    /**
+     * @brief Limit how many parameter messages are sent per second.
+     *
+     * This mostly paces the answer to a request for the whole parameter list,
+     * which is also held back while the link is backed up. The default is
+     * 1000 messages per second.
+     *
+     * @param max_messages_per_s Maximum messages per second, 0 for unlimited.
+     */
+    void set_parameter_max_messages_per_s(double max_messages_per_s);
+
+    /**
+     * @brief Limit how many bytes of parameter messages are sent per second.
+     *
+     * This is useful on slow links, e.g. a telemetry radio. There is no limit
+     * by default.
+     *
+     * @param max_bytes_per_s Maximum bytes per second, 0 for unlimited.
+     */
+    void set_parameter_max_bytes_per_s(double max_bytes_per_s);
+
 private:
     std::shared_ptr<ServerComponentImpl> _impl;
 
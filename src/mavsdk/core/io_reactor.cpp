@@ -0,0 +1,244 @@
+#if defined(LINUX)
+
+#include "io_reactor.h"
+#include "log.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+namespace mavsdk {
+
+IoReactor::IoReactor()
+{
+    _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (_epoll_fd == -1) {
+        LogErr() << "epoll_create1 failed: " << strerror(errno);
+        return;
+    }
+
+    _wakeup_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (_wakeup_fd == -1) {
+        LogErr() << "eventfd failed: " << strerror(errno);
+        return;
+    }
+
+    // ID 0 is not used by any handler.
+    struct epoll_event event {};
+    event.events = EPOLLIN;
+    event.data.u64 = 0;
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _wakeup_fd, &event) == -1) {
+        LogErr() << "epoll_ctl failed: " << strerror(errno);
+        return;
+    }
+
+    // The thread only starts once _thread is set, so is_io_thread() works.
+    std::lock_guard<std::mutex> lock(_mutex);
+    _thread = std::make_unique<std::thread>(&IoReactor::io_thread, this);
+}
+
+IoReactor::~IoReactor()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _should_exit = true;
+    }
+
+    if (_thread) {
+        wake_up();
+        _thread->join();
+        _thread.reset();
+    }
+
+    if (_wakeup_fd != -1) {
+        close(_wakeup_fd);
+    }
+    if (_epoll_fd != -1) {
+        close(_epoll_fd);
+    }
+}
+
+bool IoReactor::add(int fd, Events events, Callback callback)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_thread) {
+        return false;
+    }
+
+    if (_handler_ids.find(fd) != _handler_ids.end()) {
+        LogErr() << "fd " << fd << " is already added";
+        return false;
+    }
+
+    const auto id = _next_handler_id++;
+
+    struct epoll_event event {};
+    event.events = (events == Events::Readable) ? EPOLLIN : EPOLLOUT;
+    event.data.u64 = id;
+    if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event) == -1) {
+        LogErr() << "epoll_ctl failed: " << strerror(errno);
+        return false;
+    }
+
+    _handlers[id] = Handler{fd, std::make_shared<Callback>(std::move(callback))};
+    _handler_ids[fd] = id;
+    return true;
+}
+
+void IoReactor::remove(int fd)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    const auto it = _handler_ids.find(fd);
+    if (it == _handler_ids.end()) {
+        return;
+    }
+
+    epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+
+    const auto callback = _handlers[it->second].callback;
+    _handlers.erase(it->second);
+    _handler_ids.erase(it);
+
+    if (!is_io_thread()) {
+        _cv.wait(lock, [&]() { return _calling != callback; });
+    }
+}
+
+IoReactor::TimerId IoReactor::call_after(std::chrono::milliseconds delay, Callback callback)
+{
+    TimerId timer_id;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        timer_id = _next_timer_id++;
+        _timers[timer_id] = Timer{
+            std::chrono::steady_clock::now() + delay,
+            std::make_shared<Callback>(std::move(callback))};
+    }
+
+    // So the new deadline is taken into account.
+    wake_up();
+    return timer_id;
+}
+
+void IoReactor::cancel(TimerId timer_id)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    _timers.erase(timer_id);
+
+    if (!is_io_thread()) {
+        _cv.wait(lock, [&]() { return _calling_timer != timer_id; });
+    }
+}
+
+bool IoReactor::is_io_thread() const
+{
+    return _thread && _thread->get_id() == std::this_thread::get_id();
+}
+
+void IoReactor::wake_up()
+{
+    const uint64_t one = 1;
+    if (write(_wakeup_fd, &one, sizeof(one)) == -1 && errno != EAGAIN) {
+        LogErr() << "eventfd write failed: " << strerror(errno);
+    }
+}
+
+int IoReactor::timeout_ms() const
+{
+    if (_timers.empty()) {
+        return -1;
+    }
+
+    const auto earliest = std::min_element(
+        _timers.begin(), _timers.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.second.deadline < rhs.second.deadline;
+        });
+
+    const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        earliest->second.deadline - std::chrono::steady_clock::now());
+
+    // Round up, otherwise we wake up just before it's due.
+    return std::max(0, static_cast<int>(remaining.count()) + 1);
+}
+
+void IoReactor::io_thread()
+{
+    constexpr int max_events = 16;
+    struct epoll_event events[max_events];
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_should_exit) {
+        const int timeout = timeout_ms();
+
+        lock.unlock();
+        const int num_events = epoll_wait(_epoll_fd, events, max_events, timeout);
+        lock.lock();
+
+        if (num_events == -1 && errno != EINTR) {
+            LogErr() << "epoll_wait failed: " << strerror(errno);
+        }
+
+        for (int i = 0; i < num_events; ++i) {
+            const uint64_t id = events[i].data.u64;
+            if (id == 0) {
+                uint64_t count;
+                if (read(_wakeup_fd, &count, sizeof(count)) == -1 && errno != EAGAIN) {
+                    LogErr() << "eventfd read failed: " << strerror(errno);
+                }
+                continue;
+            }
+
+            const auto it = _handlers.find(id);
+            if (it == _handlers.end()) {
+                // Removed in the meantime.
+                continue;
+            }
+
+            _calling = it->second.callback;
+            lock.unlock();
+            (*_calling)();
+            lock.lock();
+            _calling.reset();
+            _cv.notify_all();
+        }
+
+        call_timers(lock);
+    }
+}
+
+void IoReactor::call_timers(std::unique_lock<std::mutex>& lock)
+{
+    const auto now = std::chrono::steady_clock::now();
+
+    // One by one, as a callback can add or cancel timers.
+    while (true) {
+        const auto due = std::find_if(_timers.begin(), _timers.end(), [&](const auto& timer) {
+            return timer.second.deadline <= now;
+        });
+        if (due == _timers.end()) {
+            break;
+        }
+
+        _calling = due->second.callback;
+        _calling_timer = due->first;
+        _timers.erase(due);
+        lock.unlock();
+        (*_calling)();
+        lock.lock();
+        _calling.reset();
+        _calling_timer = 0;
+        _cv.notify_all();
+    }
+}
+
+} // namespace mavsdk
+
+#endif
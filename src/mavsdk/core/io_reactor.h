@@ -0,0 +1,100 @@
+#pragma once
+
+#if defined(LINUX)
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace mavsdk {
+
+// Waits for several connections on one thread, instead of one blocking
+// receive thread for each of them.
+//
+// Callbacks are called on the I/O thread whenever a file descriptor is ready.
+// The descriptors are level-triggered, so a callback should do at most one
+// read and it will be called again if there is more to read. This way,
+// blocking descriptors can be used as well.
+//
+// This uses epoll, so it's only available on Linux.
+class IoReactor {
+public:
+    using Callback = std::function<void()>;
+    using TimerId = uint64_t;
+
+    enum class Events {
+        Readable,
+        Writable,
+    };
+
+    IoReactor();
+    ~IoReactor();
+
+    // Returns false if the file descriptor could not be added.
+    bool add(int fd, Events events, Callback callback);
+
+    // Once this returns, the callback for fd is not called anymore, unless
+    // it's called from a callback of this reactor.
+    void remove(int fd);
+
+    // Calls the callback once on the I/O thread after the delay.
+    TimerId call_after(std::chrono::milliseconds delay, Callback callback);
+
+    // Like remove but for a timer.
+    void cancel(TimerId timer_id);
+
+    [[nodiscard]] bool is_io_thread() const;
+
+    // Non-copyable
+    IoReactor(const IoReactor&) = delete;
+    const IoReactor& operator=(const IoReactor&) = delete;
+
+private:
+    void io_thread();
+    void wake_up();
+    // Assumes to have the lock for _mutex.
+    int timeout_ms() const;
+    void call_timers(std::unique_lock<std::mutex>& lock);
+
+    struct Handler {
+        int fd;
+        std::shared_ptr<Callback> callback;
+    };
+
+    struct Timer {
+        std::chrono::steady_clock::time_point deadline;
+        std::shared_ptr<Callback> callback;
+    };
+
+    int _epoll_fd{-1};
+    int _wakeup_fd{-1};
+
+    mutable std::mutex _mutex{};
+    std::condition_variable _cv{};
+
+    // Indexed by an ID instead of the file descriptor, so an event for a
+    // descriptor which has been removed and reused in the meantime is ignored.
+    std::unordered_map<uint64_t, Handler> _handlers{};
+    std::unordered_map<int, uint64_t> _handler_ids{};
+    uint64_t _next_handler_id{1};
+
+    std::map<TimerId, Timer> _timers{};
+    TimerId _next_timer_id{1};
+
+    // The callback being called right now, so remove and cancel can wait for it.
+    std::shared_ptr<Callback> _calling{};
+    TimerId _calling_timer{0};
+
+    bool _should_exit{false};
+    std::unique_ptr<std::thread> _thread{};
+};
+
+} // namespace mavsdk
+
+#endif
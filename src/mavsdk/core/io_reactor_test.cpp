@@ -0,0 +1,105 @@
+#if defined(LINUX)
+
+#include "io_reactor.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace mavsdk;
+
+class IoReactorTest : public ::testing::Test {
+protected:
+    void SetUp() override { ASSERT_EQ(pipe(fds), 0); }
+
+    void TearDown() override
+    {
+        close(fds[0]);
+        close(fds[1]);
+    }
+
+    void write_byte() { ASSERT_EQ(write(fds[1], "x", 1), 1); }
+
+    int fds[2]{-1, -1};
+    IoReactor reactor;
+};
+
+TEST_F(IoReactorTest, CallsBackWhenReadable)
+{
+    std::promise<std::thread::id> prom;
+    auto fut = prom.get_future();
+
+    ASSERT_TRUE(reactor.add(fds[0], IoReactor::Events::Readable, [&]() {
+        char byte;
+        EXPECT_EQ(read(fds[0], &byte, 1), 1);
+        prom.set_value(std::this_thread::get_id());
+    }));
+
+    write_byte();
+    ASSERT_EQ(fut.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_NE(fut.get(), std::this_thread::get_id());
+
+    reactor.remove(fds[0]);
+}
+
+TEST_F(IoReactorTest, DoesNotCallBackOnceRemoved)
+{
+    std::atomic<unsigned> calls{0};
+
+    ASSERT_TRUE(reactor.add(fds[0], IoReactor::Events::Readable, [&]() {
+        char byte;
+        EXPECT_EQ(read(fds[0], &byte, 1), 1);
+        ++calls;
+    }));
+    EXPECT_FALSE(reactor.add(fds[0], IoReactor::Events::Readable, []() {}));
+
+    reactor.remove(fds[0]);
+    write_byte();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(calls, 0u);
+
+    // It can be added again.
+    ASSERT_TRUE(reactor.add(fds[0], IoReactor::Events::Readable, [&]() {
+        char byte;
+        EXPECT_EQ(read(fds[0], &byte, 1), 1);
+        ++calls;
+    }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(calls, 1u);
+
+    reactor.remove(fds[0]);
+}
+
+TEST_F(IoReactorTest, CallsTimersAfterDelay)
+{
+    std::promise<void> prom;
+    auto fut = prom.get_future();
+    std::atomic<bool> cancelled_called{false};
+
+    const auto start = std::chrono::steady_clock::now();
+    reactor.call_after(std::chrono::milliseconds(20), [&]() { prom.set_value(); });
+    const auto timer_id =
+        reactor.call_after(std::chrono::milliseconds(10), [&]() { cancelled_called = true; });
+    reactor.cancel(timer_id);
+
+    ASSERT_EQ(fut.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+    EXPECT_FALSE(cancelled_called);
+}
+
+TEST_F(IoReactorTest, CallsBackOnIoThread)
+{
+    std::promise<bool> prom;
+    auto fut = prom.get_future();
+
+    reactor.call_after(
+        std::chrono::milliseconds(0), [&]() { prom.set_value(reactor.is_io_thread()); });
+
+    ASSERT_EQ(fut.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_TRUE(fut.get());
+    EXPECT_FALSE(reactor.is_io_thread());
+}
+
+#endif
@@ -2,30 +2,74 @@
 
 #include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <utility>
 
 #include <mavsdk.h>
 
+#include "system_selection.h"
+
 namespace mavsdk::mavsdk_server {
 
-template<typename Plugin> class LazyPlugin {
+// Creates one plugin instance per system, on first use.
+//
+// Which system's plugin is returned depends on the system selected for the
+// current call, see SystemSelection. Plugins are kept for the lifetime of the
+// server, so pointers handed out stay valid, e.g. to unsubscribe later.
+template<typename Plugin, typename Mavsdk = ::mavsdk::Mavsdk> class LazyPlugin {
 public:
     explicit LazyPlugin(Mavsdk& mavsdk) : _mavsdk(mavsdk) {}
 
     Plugin* maybe_plugin()
     {
+        const auto system_id = SystemSelection::current();
+
         std::lock_guard<std::mutex> lock(_mutex);
-        if (_plugin == nullptr) {
-            if (_mavsdk.systems().empty()) {
-                return nullptr;
-            }
-            _plugin = std::make_unique<Plugin>(_mavsdk.systems()[0]);
+        if (!system_id && _default_plugin != nullptr) {
+            return _default_plugin;
+        }
+
+        const auto system = find_system(system_id);
+        if (system == nullptr) {
+            return nullptr;
         }
-        return _plugin.get();
+
+        auto& plugin = _plugins[system->get_system_id()];
+        if (plugin == nullptr) {
+            plugin = std::make_unique<Plugin>(system);
+        }
+
+        if (!system_id) {
+            _default_plugin = plugin.get();
+        }
+        return plugin.get();
     }
 
 private:
+    using SystemPtr = typename decltype(std::declval<const Mavsdk&>().systems())::value_type;
+
+    SystemPtr find_system(std::optional<uint8_t> system_id)
+    {
+        const auto systems = _mavsdk.systems();
+        if (systems.empty()) {
+            return nullptr;
+        }
+
+        if (!system_id) {
+            return systems[0];
+        }
+
+        for (const auto& system : systems) {
+            if (system->get_system_id() == system_id.value()) {
+                return system;
+            }
+        }
+        return nullptr;
+    }
+
     Mavsdk& _mavsdk;
-    std::unique_ptr<Plugin> _plugin{};
+    std::unordered_map<uint8_t, std::unique_ptr<Plugin>> _plugins{};
+    Plugin* _default_plugin{nullptr};
     std::mutex _mutex{};
 };
 
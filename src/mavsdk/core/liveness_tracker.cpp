@@ -0,0 +1,81 @@
+#include "liveness_tracker.h"
+
+namespace mavsdk {
+
+LivenessTracker::LivenessTracker(Time& time, double timeout_s) :
+    _timeout_ns(static_cast<int64_t>(timeout_s * 1e9)),
+    _time(time)
+{}
+
+bool LivenessTracker::heartbeat(uint8_t system_id, uint8_t component_id)
+{
+    _last_heartbeat_ns[index(system_id, component_id)].store(
+        now_ns(), std::memory_order_relaxed);
+
+    // Pairs with the fences in check(). Either check() sees the new time
+    // after erasing the component, or we see it erased and add it again.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_alive_components[system_id].insert(component_id)) {
+        // The same for the system.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    // This doesn't depend on whether the component was alive, so that a
+    // heartbeat which comes in just while a check times the system out
+    // brings it back.
+    return _alive_systems.insert(system_id);
+}
+
+void LivenessTracker::check(std::vector<uint8_t>& timed_out_system_ids)
+{
+    const int64_t deadline_ns = now_ns() - _timeout_ns;
+
+    const auto is_stale = [&](uint8_t system_id, uint8_t component_id) {
+        return _last_heartbeat_ns[index(system_id, component_id)].load(
+                   std::memory_order_relaxed) < deadline_ns;
+    };
+
+    _alive_systems.for_each([&](uint8_t system_id) {
+        auto& components = _alive_components[system_id];
+        components.for_each([&](uint8_t component_id) {
+            if (is_stale(system_id, component_id)) {
+                components.erase(component_id);
+
+                // A heartbeat which came in since we looked might have seen
+                // the component as still alive and not added it again.
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!is_stale(system_id, component_id)) {
+                    components.insert(component_id);
+                }
+            }
+        });
+
+        if (components.empty() && _alive_systems.erase(system_id)) {
+            // Same for a heartbeat of any component. If it already added the
+            // system again, it reported it as new, so we report it as gone.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (components.empty() || !_alive_systems.insert(system_id)) {
+                timed_out_system_ids.push_back(system_id);
+            }
+        }
+    });
+}
+
+bool LivenessTracker::is_alive(uint8_t system_id) const
+{
+    return _alive_systems.contains(system_id);
+}
+
+bool LivenessTracker::is_alive(uint8_t system_id, uint8_t component_id) const
+{
+    return _alive_components[system_id].contains(component_id);
+}
+
+int64_t LivenessTracker::now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               _time.steady_time().time_since_epoch())
+        .count();
+}
+
+} // namespace mavsdk
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "component_set.h"
+#include "mavsdk_time.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace mavsdk {
+
+// Keeps track of which systems are alive, based on their heartbeats.
+//
+// The time of the last heartbeat is kept in a flat array indexed by system
+// and component ID, so a heartbeat is only an atomic store and, unless the
+// component is already known to be alive, setting a bit. There is no timer
+// per system to refresh. Instead, one periodic check goes through the alive
+// systems and returns all of the ones which timed out together.
+//
+// A system is alive as long as any of its components sends heartbeats.
+//
+// Heartbeats can come in on any thread, but check() needs to be called from
+// one thread only.
+class LivenessTracker {
+public:
+    explicit LivenessTracker(Time& time, double timeout_s = HEARTBEAT_TIMEOUT_S);
+    ~LivenessTracker() = default;
+
+    // delete copy and move constructors and assign operators
+    LivenessTracker(LivenessTracker const&) = delete; // Copy construct
+    LivenessTracker(LivenessTracker&&) = delete; // Move construct
+    LivenessTracker& operator=(LivenessTracker const&) = delete; // Copy assign
+    LivenessTracker& operator=(LivenessTracker&&) = delete; // Move assign
+
+    // Returns true if the system was not alive before.
+    bool heartbeat(uint8_t system_id, uint8_t component_id);
+
+    // Appends the systems which timed out since the last check. They are no
+    // longer alive until their next heartbeat.
+    void check(std::vector<uint8_t>& timed_out_system_ids);
+
+    [[nodiscard]] bool is_alive(uint8_t system_id) const;
+    [[nodiscard]] bool is_alive(uint8_t system_id, uint8_t component_id) const;
+
+    static constexpr double HEARTBEAT_TIMEOUT_S = 3.0;
+
+private:
+    int64_t now_ns();
+
+    static std::size_t index(uint8_t system_id, uint8_t component_id)
+    {
+        return static_cast<std::size_t>(system_id) * 256 + component_id;
+    }
+
+    std::array<std::atomic<int64_t>, 256 * 256> _last_heartbeat_ns{};
+    std::array<ComponentSet, 256> _alive_components{};
+    // Same as the components, one bit for each system ID.
+    ComponentSet _alive_systems{};
+
+    const int64_t _timeout_ns;
+
+    Time& _time;
+};
+
+} // namespace mavsdk
@@ -0,0 +1,137 @@
+#include "liveness_tracker.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#ifdef FAKE_TIME
+#define Time FakeTime
+#endif
+
+using namespace mavsdk;
+
+TEST(LivenessTracker, AliveUntilTimedOut)
+{
+    Time time;
+    // Too big for the stack of some platforms.
+    auto tracker = std::make_unique<LivenessTracker>(time, 3.0);
+
+    EXPECT_FALSE(tracker->is_alive(1));
+    EXPECT_TRUE(tracker->heartbeat(1, 1));
+    EXPECT_FALSE(tracker->heartbeat(1, 1));
+    EXPECT_TRUE(tracker->is_alive(1));
+    EXPECT_TRUE(tracker->is_alive(1, 1));
+    EXPECT_FALSE(tracker->is_alive(1, 2));
+
+    std::vector<uint8_t> timed_out;
+    time.sleep_for(std::chrono::seconds(2));
+    tracker->check(timed_out);
+    EXPECT_TRUE(timed_out.empty());
+
+    // Another component keeps the system alive.
+    EXPECT_FALSE(tracker->heartbeat(1, 100));
+    time.sleep_for(std::chrono::seconds(2));
+    tracker->check(timed_out);
+    EXPECT_TRUE(timed_out.empty());
+    EXPECT_TRUE(tracker->is_alive(1));
+    EXPECT_FALSE(tracker->is_alive(1, 1));
+    EXPECT_TRUE(tracker->is_alive(1, 100));
+
+    time.sleep_for(std::chrono::seconds(2));
+    tracker->check(timed_out);
+    EXPECT_EQ(timed_out, (std::vector<uint8_t>{1}));
+    EXPECT_FALSE(tracker->is_alive(1));
+
+    // Only reported once.
+    timed_out.clear();
+    tracker->check(timed_out);
+    EXPECT_TRUE(timed_out.empty());
+
+    // And back.
+    EXPECT_TRUE(tracker->heartbeat(1, 1));
+    EXPECT_TRUE(tracker->is_alive(1));
+}
+
+TEST(LivenessTracker, TimesOutFleetInOneCheck)
+{
+    Time time;
+    auto tracker = std::make_unique<LivenessTracker>(time, 3.0);
+
+    for (unsigned system_id = 1; system_id <= 100; ++system_id) {
+        for (uint8_t component_id : {1, 100, 154}) {
+            tracker->heartbeat(static_cast<uint8_t>(system_id), component_id);
+        }
+    }
+
+    // Half of them keep sending.
+    time.sleep_for(std::chrono::seconds(2));
+    for (unsigned system_id = 2; system_id <= 100; system_id += 2) {
+        tracker->heartbeat(static_cast<uint8_t>(system_id), 1);
+    }
+    time.sleep_for(std::chrono::seconds(2));
+
+    std::vector<uint8_t> timed_out;
+    tracker->check(timed_out);
+    ASSERT_EQ(timed_out.size(), 50u);
+    for (std::size_t i = 0; i < timed_out.size(); ++i) {
+        EXPECT_EQ(timed_out[i], 2 * i + 1);
+        EXPECT_FALSE(tracker->is_alive(timed_out[i]));
+        EXPECT_TRUE(tracker->is_alive(static_cast<uint8_t>(timed_out[i] + 1)));
+    }
+}
+
+TEST(LivenessTracker, HeartbeatDuringCheckIsNotLost)
+{
+    Time time;
+    auto tracker = std::make_unique<LivenessTracker>(time, 3.0);
+
+    // Both threads go through the components in the same order, so the
+    // heartbeats keep landing right between a check looking at a component
+    // and timing it out.
+    const auto for_all = [](const auto& func) {
+        for (unsigned system_id = 1; system_id <= 255; ++system_id) {
+            for (unsigned component_id = 0; component_id <= 255; ++component_id) {
+                func(static_cast<uint8_t>(system_id), static_cast<uint8_t>(component_id));
+            }
+        }
+    };
+    for_all([&](uint8_t system_id, uint8_t component_id) {
+        tracker->heartbeat(system_id, component_id);
+    });
+
+    for (unsigned round = 0; round < 20; ++round) {
+        // All of them timed out, and come back while checking.
+        time.sleep_for(std::chrono::seconds(4));
+
+        std::atomic<bool> go{false};
+        std::vector<bool> was_new(256, false);
+        std::thread heartbeat_thread([&]() {
+            while (!go) {}
+            for_all([&](uint8_t system_id, uint8_t component_id) {
+                if (tracker->heartbeat(system_id, component_id)) {
+                    was_new[system_id] = true;
+                }
+            });
+        });
+
+        std::vector<uint8_t> timed_out;
+        go = true;
+        tracker->check(timed_out);
+        heartbeat_thread.join();
+
+        // Nothing is lost, and what is reported as timed out is exactly what
+        // the heartbeats report as new again.
+        std::vector<bool> was_timed_out(256, false);
+        for (const auto system_id : timed_out) {
+            was_timed_out[system_id] = true;
+        }
+        for_all([&](uint8_t system_id, uint8_t component_id) {
+            ASSERT_TRUE(tracker->is_alive(system_id, component_id))
+                << round << ": " << int(system_id) << "/" << int(component_id);
+        });
+        for (unsigned system_id = 1; system_id <= 255; ++system_id) {
+            ASSERT_TRUE(tracker->is_alive(static_cast<uint8_t>(system_id)));
+            ASSERT_EQ(was_new[system_id], was_timed_out[system_id]) << round << ": " << system_id;
+        }
+    }
+}
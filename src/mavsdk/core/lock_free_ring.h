@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace mavsdk {
+
+// Bounded queue which can be pushed to from multiple threads without
+// taking a lock, e.g. from the receive threads of all connections.
+//
+// Each cell carries a sequence number which tells pushing and popping
+// threads whether it is free or filled for the current lap, based on:
+// http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+//
+// If the queue is full, try_push fails and it's up to the caller to drop
+// or retry.
+template<typename T, std::size_t N> class LockFreeRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N needs to be a power of 2");
+
+public:
+    LockFreeRing() : _cells(std::make_unique<Cell[]>(N))
+    {
+        for (std::size_t i = 0; i < N; ++i) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    ~LockFreeRing() = default;
+
+    bool try_push(const T& value)
+    {
+        Cell* cell;
+        std::size_t pos = _push_pos.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &_cells[pos & (N - 1)];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff =
+                static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (_push_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // Full.
+                return false;
+            } else {
+                // Another thread was faster, try again.
+                pos = _push_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& value)
+    {
+        Cell* cell;
+        std::size_t pos = _pop_pos.load(std::memory_order_relaxed);
+        while (true) {
+            cell = &_cells[pos & (N - 1)];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto diff =
+                static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0) {
+                if (_pop_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // Empty.
+                return false;
+            } else {
+                pos = _pop_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        value = cell->value;
+        // Mark the cell as free for the next lap.
+        cell->sequence.store(pos + N, std::memory_order_release);
+        return true;
+    }
+
+    static constexpr std::size_t capacity() { return N; }
+
+    // Non-copyable
+    LockFreeRing(const LockFreeRing&) = delete;
+    const LockFreeRing& operator=(const LockFreeRing&) = delete;
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        T value{};
+    };
+
+    std::unique_ptr<Cell[]> _cells;
+
+    // Keep the positions on separate cache lines, so that pushing and
+    // popping threads don't slow each other down.
+    alignas(64) std::atomic<std::size_t> _push_pos{0};
+    alignas(64) std::atomic<std::size_t> _pop_pos{0};
+};
+
+} // namespace mavsdk
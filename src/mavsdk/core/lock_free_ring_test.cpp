@@ -0,0 +1,82 @@
+#include "lock_free_ring.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace mavsdk;
+
+TEST(LockFreeRing, PushAndPop)
+{
+    LockFreeRing<int, 4> ring;
+
+    int value = 0;
+    EXPECT_FALSE(ring.try_pop(value));
+
+    EXPECT_TRUE(ring.try_push(1));
+    EXPECT_TRUE(ring.try_push(2));
+    EXPECT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_FALSE(ring.try_pop(value));
+}
+
+TEST(LockFreeRing, Full)
+{
+    LockFreeRing<int, 4> ring;
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(ring.try_push(i));
+    }
+    EXPECT_FALSE(ring.try_push(4));
+
+    // Wrap around a few times.
+    int value = 0;
+    for (int i = 4; i < 20; ++i) {
+        EXPECT_TRUE(ring.try_pop(value));
+        EXPECT_EQ(value, i - 4);
+        EXPECT_TRUE(ring.try_push(i));
+    }
+}
+
+TEST(LockFreeRing, MultipleProducers)
+{
+    constexpr int num_producers = 4;
+    constexpr int num_per_producer = 10000;
+
+    LockFreeRing<int, 256> ring;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; ++p) {
+        producers.emplace_back([&ring, p]() {
+            for (int i = 0; i < num_per_producer; ++i) {
+                // Encode producer and sequence to check the order per producer.
+                while (!ring.try_push(p * num_per_producer + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<int> last_received(num_producers, -1);
+    int received = 0;
+    while (received < num_producers * num_per_producer) {
+        int value;
+        if (!ring.try_pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        const int producer = value / num_per_producer;
+        const int sequence = value % num_per_producer;
+        EXPECT_EQ(sequence, last_received[producer] + 1);
+        last_received[producer] = sequence;
+        ++received;
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    int value;
+    EXPECT_FALSE(ring.try_pop(value));
+}
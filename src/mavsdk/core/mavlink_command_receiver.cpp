@@ -1,13 +1,17 @@
 #include "mavlink_command_receiver.h"
 #include "mavsdk_impl.h"
 #include "log.h"
+#include <algorithm>
 #include <cmath>
 #include <future>
+#include <iterator>
 #include <memory>
 
 namespace mavsdk {
 
-MavlinkCommandReceiver::MavlinkCommandReceiver(MavsdkImpl& mavsdk_impl) : _mavsdk_impl(mavsdk_impl)
+MavlinkCommandReceiver::MavlinkCommandReceiver(MavsdkImpl& mavsdk_impl) :
+    _mavsdk_impl(mavsdk_impl),
+    _mavlink_command_handler_table(std::make_shared<HandlerTable>())
 {
     _mavsdk_impl.mavlink_message_handler.register_one(
         MAVLINK_MSG_ID_COMMAND_LONG,
@@ -31,10 +35,12 @@ void MavlinkCommandReceiver::receive_command_int(const mavlink_message_t& messag
 {
     MavlinkCommandReceiver::CommandInt cmd(message);
 
-    std::lock_guard<std::mutex> lock(_mavlink_command_handler_table_mutex);
-
-    for (auto& handler : _mavlink_command_int_handler_table) {
-        if (handler.cmd_id == cmd.command) {
+    // No lock is held while handlers run, they are free to take their time or to
+    // (un)register handlers themselves.
+    const auto table = begin_call();
+    const auto it = table->command_int.find(cmd.command);
+    if (it != table->command_int.end()) {
+        for (const auto& handler : it->second) {
             // The client side can pack a COMMAND_ACK as a response to receiving the command.
             auto maybe_message = handler.callback(cmd);
             if (maybe_message) {
@@ -42,16 +48,20 @@ void MavlinkCommandReceiver::receive_command_int(const mavlink_message_t& messag
             }
         }
     }
+
+    end_call(*table);
 }
 
 void MavlinkCommandReceiver::receive_command_long(const mavlink_message_t& message)
 {
     MavlinkCommandReceiver::CommandLong cmd(message);
 
-    std::lock_guard<std::mutex> lock(_mavlink_command_handler_table_mutex);
-
-    for (auto& handler : _mavlink_command_long_handler_table) {
-        if (handler.cmd_id == cmd.command) {
+    // No lock is held while handlers run, they are free to take their time or to
+    // (un)register handlers themselves.
+    const auto table = begin_call();
+    const auto it = table->command_long.find(cmd.command);
+    if (it != table->command_long.end()) {
+        for (const auto& handler : it->second) {
             // The client side can pack a COMMAND_ACK as a response to receiving the command.
             auto maybe_message = handler.callback(cmd);
             if (maybe_message) {
@@ -59,6 +69,8 @@ void MavlinkCommandReceiver::receive_command_long(const mavlink_message_t& messa
             }
         }
     }
+
+    end_call(*table);
 }
 
 void MavlinkCommandReceiver::register_mavlink_command_handler(
@@ -66,8 +78,9 @@ void MavlinkCommandReceiver::register_mavlink_command_handler(
 {
     std::lock_guard<std::mutex> lock(_mavlink_command_handler_table_mutex);
 
-    MAVLinkCommandIntHandlerTableEntry entry = {cmd_id, callback, cookie};
-    _mavlink_command_int_handler_table.push_back(entry);
+    auto table = copy_table();
+    table->command_int[cmd_id].push_back(MAVLinkCommandIntHandlerTableEntry{callback, cookie});
+    publish_table(std::move(table));
 }
 
 void MavlinkCommandReceiver::register_mavlink_command_handler(
@@ -75,62 +88,173 @@ void MavlinkCommandReceiver::register_mavlink_command_handler(
 {
     std::lock_guard<std::mutex> lock(_mavlink_command_handler_table_mutex);
 
-    MAVLinkCommandLongHandlerTableEntry entry = {cmd_id, callback, cookie};
-    _mavlink_command_long_handler_table.push_back(entry);
+    auto table = copy_table();
+    table->command_long[cmd_id].push_back(MAVLinkCommandLongHandlerTableEntry{callback, cookie});
+    publish_table(std::move(table));
 }
 
 void MavlinkCommandReceiver::unregister_mavlink_command_handler(uint16_t cmd_id, const void* cookie)
 {
-    std::lock_guard<std::mutex> lock(_mavlink_command_handler_table_mutex);
+    {
+        std::lock_guard<std::mutex> lock(_mavlink_command_handler_table_mutex);
 
-    // COMMAND_INT
-    for (auto it = _mavlink_command_int_handler_table.begin();
-         it != _mavlink_command_int_handler_table.end();
-         /* no ++it */) {
-        if (it->cmd_id == cmd_id && it->cookie == cookie) {
-            it = _mavlink_command_int_handler_table.erase(it);
-        } else {
-            ++it;
+        auto table = copy_table();
+
+        const auto has_cookie = [cookie](const auto& entry) { return entry.cookie == cookie; };
+
+        // COMMAND_INT
+        if (auto it = table->command_int.find(cmd_id); it != table->command_int.end()) {
+            auto& entries = it->second;
+            entries.erase(
+                std::remove_if(entries.begin(), entries.end(), has_cookie), entries.end());
+            if (entries.empty()) {
+                table->command_int.erase(it);
+            }
         }
-    }
 
-    // COMMAND_LONG
-    for (auto it = _mavlink_command_long_handler_table.begin();
-         it != _mavlink_command_long_handler_table.end();
-         /* no ++it */) {
-        if (it->cmd_id == cmd_id && it->cookie == cookie) {
-            it = _mavlink_command_long_handler_table.erase(it);
-        } else {
-            ++it;
+        // COMMAND_LONG
+        if (auto it = table->command_long.find(cmd_id); it != table->command_long.end()) {
+            auto& entries = it->second;
+            entries.erase(
+                std::remove_if(entries.begin(), entries.end(), has_cookie), entries.end());
+            if (entries.empty()) {
+                table->command_long.erase(it);
+            }
         }
+
+        publish_table(std::move(table));
     }
+
+    // Without holding the lock, so the handlers we wait for can still (un)register.
+    wait_for_calls_of_old_tables();
 }
 
 void MavlinkCommandReceiver::unregister_all_mavlink_command_handlers(const void* cookie)
 {
-    std::lock_guard<std::mutex> lock(_mavlink_command_handler_table_mutex);
+    std::unique_lock<std::mutex> lock(_mavlink_command_handler_table_mutex);
+
+    auto table = copy_table();
+
+    const auto has_cookie = [cookie](const auto& entry) { return entry.cookie == cookie; };
 
     // COMMAND_INT
-    for (auto it = _mavlink_command_int_handler_table.begin();
-         it != _mavlink_command_int_handler_table.end();
+    for (auto it = table->command_int.begin(); it != table->command_int.end();
          /* no ++it */) {
-        if (it->cookie == cookie) {
-            it = _mavlink_command_int_handler_table.erase(it);
+        auto& entries = it->second;
+        entries.erase(std::remove_if(entries.begin(), entries.end(), has_cookie), entries.end());
+        if (entries.empty()) {
+            it = table->command_int.erase(it);
         } else {
             ++it;
         }
     }
 
     // COMMAND_LONG
-    for (auto it = _mavlink_command_long_handler_table.begin();
-         it != _mavlink_command_long_handler_table.end();
+    for (auto it = table->command_long.begin(); it != table->command_long.end();
          /* no ++it */) {
-        if (it->cookie == cookie) {
-            it = _mavlink_command_long_handler_table.erase(it);
+        auto& entries = it->second;
+        entries.erase(std::remove_if(entries.begin(), entries.end(), has_cookie), entries.end());
+        if (entries.empty()) {
+            it = table->command_long.erase(it);
         } else {
             ++it;
         }
     }
+
+    publish_table(std::move(table));
+
+    // Without holding the lock, so the handlers we wait for can still (un)register.
+    lock.unlock();
+    wait_for_calls_of_old_tables();
+}
+
+std::unique_ptr<MavlinkCommandReceiver::HandlerTable> MavlinkCommandReceiver::copy_table()
+{
+    // Assumes to have the lock for _mavlink_command_handler_table_mutex.
+
+    const auto current = std::atomic_load(&_mavlink_command_handler_table);
+    auto table = std::make_unique<HandlerTable>();
+    table->command_int = current->command_int;
+    table->command_long = current->command_long;
+    return table;
+}
+
+void MavlinkCommandReceiver::publish_table(std::unique_ptr<HandlerTable> table)
+{
+    // Assumes to have the lock for _mavlink_command_handler_table_mutex.
+
+    auto old_table = std::atomic_load(&_mavlink_command_handler_table);
+    std::atomic_store(
+        &_mavlink_command_handler_table, std::shared_ptr<const HandlerTable>(std::move(table)));
+    old_table->retired = true;
+
+    // The old table is deleted once the last call using it is done and we no longer wait.
+    std::lock_guard<std::mutex> lock(_calls_mutex);
+    forget_unused_tables();
+    _retired_tables.push_back(std::move(old_table));
+}
+
+void MavlinkCommandReceiver::wait_for_calls_of_old_tables()
+{
+    // Called from within a handler, we can't wait for others, as they might just as well be
+    // waiting for us.
+    if (std::find(_in_call_on_thread.begin(), _in_call_on_thread.end(), this) !=
+        _in_call_on_thread.end()) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(_calls_mutex);
+    _calls_cv.wait(lock, [this]() {
+        forget_unused_tables();
+        return _retired_tables.empty();
+    });
+}
+
+void MavlinkCommandReceiver::forget_unused_tables()
+{
+    // Assumes to have the lock for _calls_mutex.
+
+    _retired_tables.erase(
+        std::remove_if(
+            _retired_tables.begin(),
+            _retired_tables.end(),
+            [](const auto& table) { return table->calls == 0; }),
+        _retired_tables.end());
+}
+
+std::shared_ptr<const MavlinkCommandReceiver::HandlerTable> MavlinkCommandReceiver::begin_call()
+{
+    while (true) {
+        auto table = std::atomic_load(&_mavlink_command_handler_table);
+        ++table->calls;
+
+        // If the table was replaced before we counted ourselves in, an unregister might
+        // already have stopped waiting for it, so start over with the new one.
+        if (std::atomic_load(&_mavlink_command_handler_table) == table) {
+            _in_call_on_thread.push_back(this);
+            return table;
+        }
+        leave_table(*table);
+    }
+}
+
+void MavlinkCommandReceiver::end_call(const HandlerTable& table)
+{
+    const auto it = std::find(_in_call_on_thread.rbegin(), _in_call_on_thread.rend(), this);
+    if (it != _in_call_on_thread.rend()) {
+        _in_call_on_thread.erase(std::next(it).base());
+    }
+
+    leave_table(table);
+}
+
+void MavlinkCommandReceiver::leave_table(const HandlerTable& table)
+{
+    // Only the last call of a replaced table can have someone waiting for it.
+    if (--table.calls == 0 && table.retired) {
+        std::lock_guard<std::mutex> lock(_calls_mutex);
+        _calls_cv.notify_all();
+    }
 }
 
 } // namespace mavsdk
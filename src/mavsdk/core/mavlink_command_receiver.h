@@ -2,14 +2,19 @@
 
 #include "mavlink_include.h"
 #include "locked_queue.h"
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
 #include <cstdint>
 #include <string>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <thread>
 #include <unordered_map>
 #include <variant>
+#include <vector>
 
 namespace mavsdk {
 
@@ -113,6 +118,8 @@ public:
     void register_mavlink_command_handler(
         uint16_t cmd_id, const MavlinkCommandLongHandler& callback, const void* cookie);
 
+    // Once this returns, the handler is not called anymore. Called from within a handler,
+    // calls that are already underway on other threads can still be finishing.
     void unregister_mavlink_command_handler(uint16_t cmd_id, const void* cookie);
     void unregister_all_mavlink_command_handlers(const void* cookie);
 
@@ -123,20 +130,55 @@ private:
     void receive_command_long(const mavlink_message_t& message);
 
     struct MAVLinkCommandIntHandlerTableEntry {
-        uint16_t cmd_id;
         MavlinkCommandIntHandler callback;
         const void* cookie; // This is the identification to unregister.
     };
 
     struct MAVLinkCommandLongHandlerTableEntry {
-        uint16_t cmd_id;
         MavlinkCommandLongHandler callback;
         const void* cookie; // This is the identification to unregister.
     };
 
+    // Handlers indexed by command id. A table is never changed once published, registering
+    // or unregistering publishes a modified copy instead. Each incoming command keeps the
+    // table it started with alive, so the handlers can be called without holding any lock.
+    struct HandlerTable {
+        std::unordered_map<uint16_t, std::vector<MAVLinkCommandIntHandlerTableEntry>>
+            command_int{};
+        std::unordered_map<uint16_t, std::vector<MAVLinkCommandLongHandlerTableEntry>>
+            command_long{};
+
+        // Calls using this table right now.
+        mutable std::atomic<unsigned> calls{0};
+        // Set once a newer table has been published.
+        mutable std::atomic<bool> retired{false};
+    };
+
+    std::unique_ptr<HandlerTable> copy_table();
+    void publish_table(std::unique_ptr<HandlerTable> table);
+    void wait_for_calls_of_old_tables();
+    void forget_unused_tables();
+
+    std::shared_ptr<const HandlerTable> begin_call();
+    void end_call(const HandlerTable& table);
+    void leave_table(const HandlerTable& table);
+
+    // Taken to change the table, so changes are not lost when done concurrently.
     std::mutex _mavlink_command_handler_table_mutex{};
-    std::vector<MAVLinkCommandIntHandlerTableEntry> _mavlink_command_int_handler_table{};
-    std::vector<MAVLinkCommandLongHandlerTableEntry> _mavlink_command_long_handler_table{};
+
+    // Only accessed with std::atomic_load and std::atomic_store, so incoming commands get
+    // the table without taking a lock.
+    std::shared_ptr<const HandlerTable> _mavlink_command_handler_table{};
+
+    // Tables which have been replaced, until no call uses them anymore. After unregistering,
+    // we wait for that, unless we are in a call ourselves. A call only takes the lock if it
+    // is the last one to leave a replaced table, to wake up who waits.
+    std::mutex _calls_mutex{};
+    std::condition_variable _calls_cv{};
+    std::vector<std::shared_ptr<const HandlerTable>> _retired_tables{};
+
+    // The receivers whose handlers the current thread is in.
+    static inline thread_local std::vector<const MavlinkCommandReceiver*> _in_call_on_thread{};
 };
 
 } // namespace mavsdk
@@ -0,0 +1,156 @@
+#include "mavlink_command_receiver.h"
+#include "mavsdk_impl.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace mavsdk;
+
+using CommandLong = MavlinkCommandReceiver::CommandLong;
+using MavlinkCommandLongHandler = MavlinkCommandReceiver::MavlinkCommandLongHandler;
+
+static mavlink_message_t make_command_long(uint16_t command)
+{
+    mavlink_message_t message;
+    mavlink_msg_command_long_pack(
+        245, MAV_COMP_ID_MISSIONPLANNER, &message, 1, 1, command, 0, 0, 0, 0, 0, 0, 0, 0);
+    return message;
+}
+
+TEST(MavlinkCommandReceiver, CallsHandlersOfCommandOnly)
+{
+    MavsdkImpl mavsdk_impl;
+    MavlinkCommandReceiver receiver(mavsdk_impl);
+
+    unsigned calls_a = 0;
+    unsigned calls_b = 0;
+    int cookie_a;
+    int cookie_b;
+
+    receiver.register_mavlink_command_handler(
+        MAV_CMD_COMPONENT_ARM_DISARM,
+        MavlinkCommandLongHandler([&](const CommandLong&) -> std::optional<mavlink_message_t> {
+            ++calls_a;
+            return {};
+        }),
+        &cookie_a);
+    receiver.register_mavlink_command_handler(
+        MAV_CMD_NAV_TAKEOFF,
+        MavlinkCommandLongHandler([&](const CommandLong&) -> std::optional<mavlink_message_t> {
+            ++calls_b;
+            return {};
+        }),
+        &cookie_b);
+
+    mavsdk_impl.mavlink_message_handler.process_message(
+        make_command_long(MAV_CMD_COMPONENT_ARM_DISARM));
+    mavsdk_impl.mavlink_message_handler.process_message(
+        make_command_long(MAV_CMD_COMPONENT_ARM_DISARM));
+    mavsdk_impl.mavlink_message_handler.process_message(make_command_long(MAV_CMD_NAV_LAND));
+
+    EXPECT_EQ(calls_a, 2u);
+    EXPECT_EQ(calls_b, 0u);
+
+    receiver.unregister_all_mavlink_command_handlers(&cookie_a);
+    mavsdk_impl.mavlink_message_handler.process_message(
+        make_command_long(MAV_CMD_COMPONENT_ARM_DISARM));
+    mavsdk_impl.mavlink_message_handler.process_message(make_command_long(MAV_CMD_NAV_TAKEOFF));
+
+    EXPECT_EQ(calls_a, 2u);
+    EXPECT_EQ(calls_b, 1u);
+}
+
+TEST(MavlinkCommandReceiver, HandlerCanUnregisterItself)
+{
+    MavsdkImpl mavsdk_impl;
+    MavlinkCommandReceiver receiver(mavsdk_impl);
+
+    unsigned calls = 0;
+    int cookie;
+
+    receiver.register_mavlink_command_handler(
+        MAV_CMD_NAV_TAKEOFF,
+        MavlinkCommandLongHandler([&](const CommandLong&) -> std::optional<mavlink_message_t> {
+            ++calls;
+            receiver.unregister_mavlink_command_handler(MAV_CMD_NAV_TAKEOFF, &cookie);
+            return {};
+        }),
+        &cookie);
+
+    mavsdk_impl.mavlink_message_handler.process_message(make_command_long(MAV_CMD_NAV_TAKEOFF));
+    mavsdk_impl.mavlink_message_handler.process_message(make_command_long(MAV_CMD_NAV_TAKEOFF));
+
+    EXPECT_EQ(calls, 1u);
+}
+
+TEST(MavlinkCommandReceiver, UnregisterWaitsForRunningHandler)
+{
+    MavsdkImpl mavsdk_impl;
+    MavlinkCommandReceiver receiver(mavsdk_impl);
+
+    std::promise<void> handler_started;
+    std::atomic<bool> handler_done{false};
+    int cookie;
+
+    receiver.register_mavlink_command_handler(
+        MAV_CMD_NAV_TAKEOFF,
+        MavlinkCommandLongHandler([&](const CommandLong&) -> std::optional<mavlink_message_t> {
+            handler_started.set_value();
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            handler_done = true;
+            return {};
+        }),
+        &cookie);
+
+    auto receive = std::async(std::launch::async, [&]() {
+        mavsdk_impl.mavlink_message_handler.process_message(
+            make_command_long(MAV_CMD_NAV_TAKEOFF));
+    });
+
+    handler_started.get_future().wait();
+    receiver.unregister_all_mavlink_command_handlers(&cookie);
+    EXPECT_TRUE(handler_done);
+
+    receive.wait();
+}
+
+TEST(MavlinkCommandReceiver, RunningHandlerCanRegisterWhileUnregisterWaits)
+{
+    MavsdkImpl mavsdk_impl;
+    MavlinkCommandReceiver receiver(mavsdk_impl);
+
+    std::promise<void> handler_started;
+    std::atomic<bool> handler_done{false};
+    int cookie;
+    int other_cookie;
+
+    receiver.register_mavlink_command_handler(
+        MAV_CMD_NAV_TAKEOFF,
+        MavlinkCommandLongHandler([&](const CommandLong&) -> std::optional<mavlink_message_t> {
+            handler_started.set_value();
+            // By now, unregistering is waiting for us to finish.
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            receiver.register_mavlink_command_handler(
+                MAV_CMD_NAV_LAND,
+                MavlinkCommandLongHandler(
+                    [](const CommandLong&) -> std::optional<mavlink_message_t> { return {}; }),
+                &other_cookie);
+            handler_done = true;
+            return {};
+        }),
+        &cookie);
+
+    auto receive = std::async(std::launch::async, [&]() {
+        mavsdk_impl.mavlink_message_handler.process_message(
+            make_command_long(MAV_CMD_NAV_TAKEOFF));
+    });
+
+    handler_started.get_future().wait();
+    receiver.unregister_all_mavlink_command_handlers(&cookie);
+    EXPECT_TRUE(handler_done);
+
+    receive.wait();
+    receiver.unregister_all_mavlink_command_handlers(&other_cookie);
+}
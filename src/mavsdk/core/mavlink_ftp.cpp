@@ -214,7 +214,12 @@ void MavlinkFtp::process_mavlink_ftp_message(const mavlink_message_t& msg)
     }
 }
 
-MavlinkFtp::~MavlinkFtp() {}
+MavlinkFtp::~MavlinkFtp()
+{
+    if (_download_data_check_cookie != nullptr) {
+        _system_impl.remove_call_every(_download_data_check_cookie);
+    }
+}
 
 void MavlinkFtp::_process_ack(PayloadHeader* payload)
 {
@@ -247,11 +252,16 @@ void MavlinkFtp::_process_ack(PayloadHeader* payload)
             break;
 
         case CMD_READ_FILE:
-            _ofstream.stream.write(reinterpret_cast<const char*>(payload->data), payload->size);
-            if (!_ofstream.stream) {
-                _session_result = ServerResult::ERR_FILE_IO_ERROR;
-                _end_read_session();
-                return;
+            if (_download_data_callback) {
+                _download_data_batch.insert(
+                    _download_data_batch.end(), payload->data, payload->data + payload->size);
+            } else {
+                _ofstream.stream.write(reinterpret_cast<const char*>(payload->data), payload->size);
+                if (!_ofstream.stream) {
+                    _session_result = ServerResult::ERR_FILE_IO_ERROR;
+                    _end_read_session();
+                    return;
+                }
             }
             _bytes_transferred += payload->size;
             _call_op_progress_callback(_bytes_transferred, _file_size);
@@ -365,6 +375,7 @@ void MavlinkFtp::_process_nak(ServerResult result)
             if (_session_valid) {
                 _end_write_session();
             } else {
+                _stop_upload_data();
                 _stop_timer();
                 _call_op_result_callback(_session_result);
             }
@@ -508,6 +519,7 @@ void MavlinkFtp::download_async(
 
     _curr_op_progress_callback = callback;
     _last_progress_percentage = -1;
+    _download_data_callback = nullptr;
 
     const auto result_callback = [callback](ClientResult result) {
         ProgressData empty{};
@@ -517,9 +529,36 @@ void MavlinkFtp::download_async(
     _generic_command_async(CMD_OPEN_FILE_RO, 0, remote_path, result_callback);
 }
 
+void MavlinkFtp::download_data_async(const std::string& remote_path, DownloadDataCallback callback)
+{
+    std::lock_guard<std::mutex> lock(_curr_op_mutex);
+    if (_curr_op != CMD_NONE) {
+        ProgressData empty{};
+        callback(ClientResult::Busy, {}, empty);
+        return;
+    }
+
+    _curr_op_progress_callback = nullptr;
+    _download_data_callback = callback;
+    _download_data_batch.clear();
+    _download_data_queued_bytes = std::make_shared<std::atomic<std::size_t>>(0);
+    _download_data_paused = false;
+
+    const auto result_callback = [callback](ClientResult result) {
+        ProgressData empty{};
+        callback(result, {}, empty);
+    };
+
+    _generic_command_async(CMD_OPEN_FILE_RO, 0, remote_path, result_callback);
+}
+
 void MavlinkFtp::_end_read_session(bool delete_file)
 {
     _curr_op = CMD_NONE;
+    if (_download_data_callback) {
+        // What we have must reach the user before the result does.
+        _flush_download_data();
+    }
     if (_ofstream.stream.is_open()) {
         _ofstream.stream.close();
 
@@ -538,6 +577,26 @@ void MavlinkFtp::_read()
         return;
     }
 
+    if (_download_data_callback) {
+        if (_download_data_batch.size() >= DOWNLOAD_DATA_BATCH_BYTES) {
+            _flush_download_data();
+        }
+
+        if (*_download_data_queued_bytes >= MAX_DOWNLOAD_DATA_QUEUED_BYTES) {
+            // The user is not keeping up, so we stop reading until enough of
+            // what was handed over has been consumed. Without that, the
+            // callback queue would grow with the size of the file.
+            _curr_op = CMD_READ_FILE;
+            _download_data_paused = true;
+            _stop_timer();
+            _system_impl.add_call_every(
+                [this]() { _check_download_data(); },
+                DOWNLOAD_DATA_CHECK_INTERVAL_S,
+                &_download_data_check_cookie);
+            return;
+        }
+    }
+
     auto payload = PayloadHeader{};
     payload.seq_number = _seq_number++;
     payload.session = _session;
@@ -587,17 +646,140 @@ void MavlinkFtp::upload_async(
     _generic_command_async(CMD_OPEN_FILE_WO, 0, remote_file_path, result_callback);
 }
 
+void MavlinkFtp::_flush_download_data()
+{
+    if (_download_data_batch.empty()) {
+        return;
+    }
+
+    *_download_data_queued_bytes += _download_data_batch.size();
+
+    ProgressData progress;
+    progress.bytes_transferred = _bytes_transferred;
+    progress.total_bytes = _file_size;
+
+    const auto temp_callback = _download_data_callback;
+    const auto queued_bytes = _download_data_queued_bytes;
+    auto batch = std::make_shared<std::vector<uint8_t>>(std::move(_download_data_batch));
+    _download_data_batch.clear();
+
+    _system_impl.call_user_callback([temp_callback, queued_bytes, batch, progress]() {
+        temp_callback(ClientResult::Next, *batch, progress);
+        // Only once the user is done with it, we count it as consumed.
+        *queued_bytes -= batch->size();
+    });
+}
+
+void MavlinkFtp::_check_download_data()
+{
+    std::lock_guard<std::mutex> lock(_curr_op_mutex);
+
+    if (!_download_data_paused || *_download_data_queued_bytes >= MAX_DOWNLOAD_DATA_QUEUED_BYTES) {
+        return;
+    }
+
+    _download_data_paused = false;
+    _system_impl.remove_call_every(_download_data_check_cookie);
+    _download_data_check_cookie = nullptr;
+    _read();
+}
+
+void MavlinkFtp::upload_data_async(const std::string& remote_file_path, ResultCallback callback)
+{
+    std::lock_guard<std::mutex> lock(_curr_op_mutex);
+    if (_curr_op != CMD_NONE) {
+        callback(ClientResult::Busy);
+        return;
+    }
+    if (remote_file_path.length() >= max_data_length) {
+        callback(ClientResult::InvalidParameter);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> data_lock(_upload_data_mutex);
+        _upload_data.clear();
+        _upload_data_active = true;
+        _upload_data_finished = false;
+    }
+    _upload_from_data = true;
+    _upload_data_waiting = false;
+    _curr_op_progress_callback = nullptr;
+
+    _generic_command_async(CMD_OPEN_FILE_WO, 0, remote_file_path, callback);
+}
+
+bool MavlinkFtp::write_upload_data(const std::vector<uint8_t>& data)
+{
+    {
+        std::unique_lock<std::mutex> lock(_upload_data_mutex);
+        _upload_data_cv.wait(lock, [this, &data]() {
+            return !_upload_data_active || _upload_data.empty() ||
+                   _upload_data.size() + data.size() <= MAX_UPLOAD_DATA_QUEUED_BYTES;
+        });
+        if (!_upload_data_active || _upload_data_finished) {
+            return false;
+        }
+        _upload_data.insert(_upload_data.end(), data.begin(), data.end());
+    }
+
+    _resume_upload_data();
+    return true;
+}
+
+void MavlinkFtp::finish_upload_data()
+{
+    {
+        std::lock_guard<std::mutex> lock(_upload_data_mutex);
+        _upload_data_finished = true;
+    }
+
+    _resume_upload_data();
+}
+
+void MavlinkFtp::_resume_upload_data()
+{
+    std::lock_guard<std::mutex> lock(_curr_op_mutex);
+    if (_upload_data_waiting) {
+        _upload_data_waiting = false;
+        _write_upload_data();
+    }
+}
+
+void MavlinkFtp::_stop_upload_data()
+{
+    if (!_upload_from_data) {
+        return;
+    }
+    _upload_from_data = false;
+    _upload_data_waiting = false;
+
+    {
+        std::lock_guard<std::mutex> lock(_upload_data_mutex);
+        _upload_data_active = false;
+        _upload_data.clear();
+    }
+    // Writers blocked on a full queue need to find out.
+    _upload_data_cv.notify_all();
+}
+
 void MavlinkFtp::_end_write_session()
 {
     _curr_op = CMD_NONE;
     if (_ifstream) {
         _ifstream.close();
     }
+    _stop_upload_data();
     _terminate_session();
 }
 
 void MavlinkFtp::_write()
 {
+    if (_upload_from_data) {
+        _write_upload_data();
+        return;
+    }
+
     if (_bytes_transferred >= _file_size) {
         _session_result = ServerResult::SUCCESS;
         _end_write_session();
@@ -620,6 +802,44 @@ void MavlinkFtp::_write()
     _send_mavlink_ftp_message(payload);
 }
 
+void MavlinkFtp::_write_upload_data()
+{
+    auto payload = PayloadHeader{};
+    bool finished = false;
+    {
+        std::lock_guard<std::mutex> lock(_upload_data_mutex);
+        const auto size = std::min(_upload_data.size(), std::size_t(max_data_length));
+        std::copy_n(_upload_data.begin(), size, payload.data);
+        _upload_data.erase(_upload_data.begin(), _upload_data.begin() + size);
+        payload.size = static_cast<uint8_t>(size);
+        finished = _upload_data_finished;
+    }
+
+    if (payload.size == 0) {
+        if (finished) {
+            _session_result = ServerResult::SUCCESS;
+            _end_write_session();
+        } else {
+            // Nothing to write until more data is passed to us. Other
+            // operations are kept out meanwhile.
+            _curr_op = CMD_WRITE_FILE;
+            _upload_data_waiting = true;
+            _stop_timer();
+        }
+        return;
+    }
+
+    // There is room for more now.
+    _upload_data_cv.notify_all();
+
+    payload.seq_number = _seq_number++;
+    payload.session = _session;
+    payload.opcode = _curr_op = CMD_WRITE_FILE;
+    payload.offset = _bytes_transferred;
+    _bytes_transferred += payload.size;
+    _send_mavlink_ftp_message(payload);
+}
+
 void MavlinkFtp::_terminate_session()
 {
     if (!_session_valid) {
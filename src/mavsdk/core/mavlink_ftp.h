@@ -1,8 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <cinttypes>
+#include <condition_variable>
+#include <deque>
 #include <functional>
 #include <fstream>
+#include <memory>
 #include <unordered_map>
 #include <mutex>
 #include <optional>
@@ -58,6 +62,8 @@ public:
     using ResultCallback = std::function<void(ClientResult)>;
     using UploadCallback = std::function<void(ClientResult, ProgressData)>;
     using DownloadCallback = std::function<void(ClientResult, ProgressData)>;
+    using DownloadDataCallback =
+        std::function<void(ClientResult, const std::vector<uint8_t>&, ProgressData)>;
     using ListDirectoryCallback = std::function<void(ClientResult, std::vector<std::string>)>;
     using AreFilesIdenticalCallback = std::function<void(ClientResult, bool)>;
 
@@ -80,6 +86,20 @@ public:
         const std::string& local_file_path,
         const std::string& remote_folder,
         UploadCallback callback);
+
+    // Same as download_async but hands the content to the callback in order
+    // as it arrives, instead of writing it to a local file. The callback is
+    // called with Next and the data, and finally with the result and no data.
+    void download_data_async(const std::string& remote_file_path, DownloadDataCallback callback);
+
+    // Same as upload_async but uploads what is passed to write_upload_data
+    // instead of a local file, until finish_upload_data is called.
+    void upload_data_async(const std::string& remote_file_path, ResultCallback callback);
+    // Blocks while too much is queued and not written to the vehicle yet.
+    // Returns false if the upload has already ended, the callback of
+    // upload_data_async then has the result.
+    bool write_upload_data(const std::vector<uint8_t>& data);
+    void finish_upload_data();
     void list_directory_async(
         const std::string& path, ListDirectoryCallback callback, uint32_t offset = 0);
     void create_directory_async(const std::string& path, ResultCallback callback);
@@ -214,6 +234,35 @@ private:
     uint32_t _file_size = 0;
     std::vector<std::string> _curr_directory_list{};
 
+    // Data is handed over in batches of this size, rather than per message.
+    static constexpr std::size_t DOWNLOAD_DATA_BATCH_BYTES = 16 * 1024;
+    // No more is read while this much is handed over but not consumed yet.
+    static constexpr std::size_t MAX_DOWNLOAD_DATA_QUEUED_BYTES = 1024 * 1024;
+    static constexpr float DOWNLOAD_DATA_CHECK_INTERVAL_S = 0.05f;
+
+    DownloadDataCallback _download_data_callback{};
+    std::vector<uint8_t> _download_data_batch{};
+    // Bytes handed to the user but not consumed yet. This is shared with
+    // the queued callbacks rather than having them call back into us. Each
+    // download gets its own, so a batch consumed late doesn't count against
+    // the next download.
+    std::shared_ptr<std::atomic<std::size_t>> _download_data_queued_bytes{};
+    bool _download_data_paused{false};
+    void* _download_data_check_cookie{nullptr};
+
+    // Writing blocks while this much is queued for the upload.
+    static constexpr std::size_t MAX_UPLOAD_DATA_QUEUED_BYTES = 64 * 1024;
+
+    // Set while the upload takes its data from write_upload_data.
+    bool _upload_from_data{false};
+    // The upload ran out of data and waits for more to be written.
+    bool _upload_data_waiting{false};
+    std::mutex _upload_data_mutex{};
+    std::condition_variable _upload_data_cv{};
+    std::deque<uint8_t> _upload_data{};
+    bool _upload_data_active{false};
+    bool _upload_data_finished{false};
+
     ResultCallback _curr_op_result_callback{};
     // _curr_op_progress_callback is used for download_callback_t as well as upload_callback_t
     static_assert(
@@ -240,6 +289,11 @@ private:
         Opcode opcode, uint32_t offset, const std::string& path, ResultCallback callback);
     void _read();
     void _write();
+    void _write_upload_data();
+    void _flush_download_data();
+    void _check_download_data();
+    void _resume_upload_data();
+    void _stop_upload_data();
     void _end_read_session(bool delete_file = false);
     void _end_write_session();
     void _terminate_session();
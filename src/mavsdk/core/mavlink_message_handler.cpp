@@ -10,6 +10,16 @@ void MavlinkMessageHandler::register_one(
 
     Entry entry = {msg_id, {}, callback, cookie};
     _table.push_back(entry);
+    set_has_handler(msg_id);
+}
+
+void MavlinkMessageHandler::register_all(const Callback& callback, const void* cookie)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    Entry entry = {ALL_MESSAGES, {}, callback, cookie};
+    _table.push_back(entry);
+    set_has_handler(ALL_MESSAGES);
 }
 
 void MavlinkMessageHandler::register_one(
@@ -22,6 +32,7 @@ void MavlinkMessageHandler::register_one(
 
     Entry entry = {msg_id, component_id, callback, cookie};
     _table.push_back(entry);
+    set_has_handler(msg_id);
 }
 
 void MavlinkMessageHandler::unregister_one(uint16_t msg_id, const void* cookie)
@@ -36,6 +47,7 @@ void MavlinkMessageHandler::unregister_one(uint16_t msg_id, const void* cookie)
             ++it;
         }
     }
+    update_has_handler();
 }
 
 void MavlinkMessageHandler::unregister_all(const void* cookie)
@@ -50,17 +62,25 @@ void MavlinkMessageHandler::unregister_all(const void* cookie)
             ++it;
         }
     }
+    update_has_handler();
 }
 
 void MavlinkMessageHandler::process_message(const mavlink_message_t& message)
 {
+    if (!has_handler(message.msgid)) {
+#if MESSAGE_DEBUGGING == 1
+        LogDebug() << "Ignoring msg " << int(message.msgid);
+#endif
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(_mutex);
 
 #if MESSAGE_DEBUGGING == 1
     bool forwarded = false;
 #endif
     for (auto& entry : _table) {
-        if (entry.msg_id == message.msgid &&
+        if ((entry.msg_id == message.msgid || entry.msg_id == ALL_MESSAGES) &&
             (!entry.cmp_id.has_value() || entry.cmp_id == message.compid)) {
 #if MESSAGE_DEBUGGING == 1
             LogDebug() << "Forwarding msg " << int(message.msgid) << " to "
@@ -90,4 +110,52 @@ void MavlinkMessageHandler::update_component_id(
     }
 }
 
+bool MavlinkMessageHandler::has_handler(uint32_t msg_id) const
+{
+    // Relaxed is enough, the table itself is only read with the lock. A
+    // message which races with registering its handler is simply as if it
+    // came in just before.
+    if (_has_handler_for_all.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    if (msg_id >= NUM_HANDLED_IDS) {
+        return false;
+    }
+    return (_has_handler[msg_id / 64].load(std::memory_order_relaxed) &
+            (uint64_t{1} << (msg_id % 64))) != 0;
+}
+
+void MavlinkMessageHandler::set_has_handler(uint32_t msg_id)
+{
+    if (msg_id == ALL_MESSAGES) {
+        _has_handler_for_all.store(true, std::memory_order_relaxed);
+    } else {
+        _has_handler[msg_id / 64].fetch_or(
+            uint64_t{1} << (msg_id % 64), std::memory_order_relaxed);
+    }
+}
+
+void MavlinkMessageHandler::update_has_handler()
+{
+    std::array<uint64_t, NUM_HANDLED_IDS / 64> has_handler{};
+    bool has_handler_for_all = false;
+
+    for (const auto& entry : _table) {
+        if (entry.msg_id == ALL_MESSAGES) {
+            has_handler_for_all = true;
+        } else {
+            has_handler[entry.msg_id / 64] |= uint64_t{1} << (entry.msg_id % 64);
+        }
+    }
+
+    // Each word goes straight from the old to the new bits, so the ones of
+    // messages which are still handled never get cleared in between.
+    for (std::size_t i = 0; i < has_handler.size(); ++i) {
+        if (_has_handler[i].load(std::memory_order_relaxed) != has_handler[i]) {
+            _has_handler[i].store(has_handler[i], std::memory_order_relaxed);
+        }
+    }
+    _has_handler_for_all.store(has_handler_for_all, std::memory_order_relaxed);
+}
+
 } // namespace mavsdk
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <mutex>
@@ -21,6 +23,8 @@ public:
     };
 
     void register_one(uint16_t msg_id, const Callback& callback, const void* cookie);
+    // Called for every message, regardless of the message ID.
+    void register_all(const Callback& callback, const void* cookie);
     void register_one(
         uint16_t msg_id,
         std::optional<uint8_t> cmp_id,
@@ -32,8 +36,27 @@ public:
     void update_component_id(uint16_t msg_id, uint8_t cmp_id, const void* cookie);
 
 private:
+    // Not a valid message ID, MAVLink 2 only uses 24 bits.
+    static constexpr uint32_t ALL_MESSAGES = UINT32_MAX;
+
+    [[nodiscard]] bool has_handler(uint32_t msg_id) const;
+    // Assumes to have the lock for _mutex.
+    void set_has_handler(uint32_t msg_id);
+    // Assumes to have the lock for _mutex.
+    void update_has_handler();
+
+    // Held while the callbacks run, so the handlers of one table are never
+    // called from several threads at once, e.g. from two connections or two
+    // receive shards.
     std::mutex _mutex{};
     std::vector<Entry> _table{};
+
+    // One bit for each message ID with a handler, so messages no one handles
+    // are skipped without touching the lock. Registered IDs are 16 bits, so
+    // larger ones are only handled by register_all.
+    static constexpr std::size_t NUM_HANDLED_IDS = 1 << 16;
+    std::array<std::atomic<uint64_t>, NUM_HANDLED_IDS / 64> _has_handler{};
+    std::atomic<bool> _has_handler_for_all{false};
 };
 
 } // namespace mavsdk
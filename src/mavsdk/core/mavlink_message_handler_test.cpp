@@ -0,0 +1,94 @@
+#include "mavlink_message_handler.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace mavsdk;
+
+static mavlink_message_t make_message(uint32_t msg_id, uint8_t component_id = 1)
+{
+    mavlink_message_t message{};
+    message.msgid = msg_id;
+    message.compid = component_id;
+    return message;
+}
+
+TEST(MavlinkMessageHandler, CallsMatchingHandlers)
+{
+    MavlinkMessageHandler handler;
+    std::vector<int> calls;
+    int first_cookie = 0;
+    int second_cookie = 0;
+
+    // 30 and 31 share one word of the bitmap.
+    handler.register_one(
+        30, [&](const mavlink_message_t&) { calls.push_back(30); }, &first_cookie);
+    handler.register_one(
+        31, 100, [&](const mavlink_message_t&) { calls.push_back(31); }, &second_cookie);
+
+    handler.process_message(make_message(30));
+    handler.process_message(make_message(31));
+    handler.process_message(make_message(31, 100));
+    handler.process_message(make_message(32));
+    EXPECT_EQ(calls, (std::vector<int>{30, 31}));
+
+    calls.clear();
+    handler.unregister_one(30, &first_cookie);
+    handler.process_message(make_message(30));
+    handler.process_message(make_message(31, 100));
+    EXPECT_EQ(calls, (std::vector<int>{31}));
+
+    // Also gets the IDs which no one else handles, even beyond 16 bits.
+    calls.clear();
+    handler.register_all([&](const mavlink_message_t&) { calls.push_back(0); }, &first_cookie);
+    handler.process_message(make_message(32));
+    handler.process_message(make_message(70000));
+    EXPECT_EQ(calls, (std::vector<int>{0, 0}));
+
+    calls.clear();
+    handler.unregister_all(&first_cookie);
+    handler.unregister_all(&second_cookie);
+    handler.process_message(make_message(31, 100));
+    handler.process_message(make_message(70000));
+    EXPECT_TRUE(calls.empty());
+}
+
+TEST(MavlinkMessageHandler, CallsOneCallbackAtATime)
+{
+    MavlinkMessageHandler handler;
+    std::atomic<unsigned> inside{0};
+    std::atomic<bool> overlapped{false};
+    unsigned calls = 0;
+    int cookie = 0;
+
+    handler.register_one(
+        30,
+        [&](const mavlink_message_t&) {
+            if (++inside > 1) {
+                overlapped = true;
+            }
+            // Gives the other thread time to get in, if it could.
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            ++calls;
+            --inside;
+        },
+        &cookie);
+
+    constexpr unsigned num_messages = 200;
+    std::thread other([&handler]() {
+        for (unsigned i = 0; i < num_messages; ++i) {
+            handler.process_message(make_message(30));
+        }
+    });
+    for (unsigned i = 0; i < num_messages; ++i) {
+        handler.process_message(make_message(30));
+    }
+    other.join();
+
+    EXPECT_FALSE(overlapped);
+    EXPECT_EQ(calls, 2 * num_messages);
+
+    handler.unregister_all(&cookie);
+}
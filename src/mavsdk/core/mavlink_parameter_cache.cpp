@@ -83,9 +83,10 @@ MavlinkParameterCache::all_parameters_map(bool including_extended) const
 std::optional<MavlinkParameterCache::Param>
 MavlinkParameterCache::param_by_id(const std::string& param_id, bool including_extended) const
 {
-    const auto& params = all_parameters(including_extended);
-
-    for (const auto& param : params) {
+    for (const auto& param : _all_params) {
+        if (!including_extended && param.value.needs_extended()) {
+            continue;
+        }
         if (param.id == param_id) {
             return param;
         }
@@ -97,25 +98,46 @@ MavlinkParameterCache::param_by_id(const std::string& param_id, bool including_e
 std::optional<MavlinkParameterCache::Param>
 MavlinkParameterCache::param_by_index(uint16_t param_index, bool including_extended) const
 {
-    const auto& params = all_parameters(including_extended);
-    if (param_index >= params.size()) {
-        LogErr() << "param at " << (int)param_index << " out of bounds (" << params.size() << ")";
-        return {};
+    std::size_t position = 0;
+    const Param* param = nullptr;
+    for (unsigned i = 0; i <= param_index; ++i) {
+        param = next_param(position, including_extended);
+        if (param == nullptr) {
+            LogErr() << "param at " << static_cast<int>(param_index) << " out of bounds (" << i
+                     << ")";
+            return {};
+        }
     }
 
-    const auto& param = params[param_index];
     // Check that the redundant index matches the actual vector index.
-    assert(param.index == param_index);
-    return {param};
+    assert(param->index == param_index);
+    return {*param};
 }
 
 uint16_t MavlinkParameterCache::count(bool including_extended) const
 {
-    const auto num = all_parameters(including_extended).size();
+    const auto num = including_extended ?
+                         _all_params.size() :
+                         static_cast<std::size_t>(std::count_if(
+                             _all_params.begin(), _all_params.end(), [](const auto& param) {
+                                 return !param.value.needs_extended();
+                             }));
     assert(num < std::numeric_limits<uint16_t>::max());
     return static_cast<uint16_t>(num);
 }
 
+const MavlinkParameterCache::Param*
+MavlinkParameterCache::next_param(std::size_t& position, bool including_extended) const
+{
+    while (position < _all_params.size()) {
+        const auto& param = _all_params[position++];
+        if (including_extended || !param.value.needs_extended()) {
+            return &param;
+        }
+    }
+    return nullptr;
+}
+
 void MavlinkParameterCache::clear()
 {
     _all_params.clear();
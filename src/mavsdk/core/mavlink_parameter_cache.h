@@ -44,6 +44,13 @@ public:
 
     [[nodiscard]] uint16_t count(bool including_extended) const;
 
+    // Returns the next param at or after position, skipping extended ones unless
+    // requested, and moves position past it. Returns nullptr at the end.
+    //
+    // This allows to go through all params without copying them, as long as
+    // the cache is not changed in between.
+    [[nodiscard]] const Param* next_param(std::size_t& position, bool including_extended) const;
+
     [[nodiscard]] std::optional<uint16_t> next_missing_index(uint16_t count);
 
     void clear();
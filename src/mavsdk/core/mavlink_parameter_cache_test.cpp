@@ -104,3 +104,34 @@ TEST(MavlinkParameterCache, MissingIndicesNotSorted)
     // It should still work when not sorted.
     EXPECT_EQ(cache.next_missing_index(3), 2);
 }
+
+TEST(MavlinkParameterCache, NextParamSkipsExtended)
+{
+    MavlinkParameterCache cache;
+    ParamValue int_value;
+    int_value.set_int(42);
+    ParamValue custom_value;
+    custom_value.set_custom("hello");
+
+    cache.add_new_param("PARAM0", int_value);
+    cache.add_new_param("CUSTOM", custom_value);
+    cache.add_new_param("PARAM2", int_value);
+
+    std::size_t position = 0;
+    auto param = cache.next_param(position, false);
+    ASSERT_NE(param, nullptr);
+    EXPECT_EQ(param->id, "PARAM0");
+    param = cache.next_param(position, false);
+    ASSERT_NE(param, nullptr);
+    EXPECT_EQ(param->id, "PARAM2");
+    EXPECT_EQ(cache.next_param(position, false), nullptr);
+    EXPECT_EQ(cache.count(false), 2);
+
+    position = 0;
+    unsigned num_extended = 0;
+    while (cache.next_param(position, true) != nullptr) {
+        ++num_extended;
+    }
+    EXPECT_EQ(num_extended, 3);
+    EXPECT_EQ(cache.count(true), 3);
+}
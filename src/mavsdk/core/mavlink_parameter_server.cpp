@@ -1,6 +1,7 @@
 #include "mavlink_parameter_server.h"
 #include "mavlink_parameter_helper.h"
 #include "plugin_base.h"
+#include <algorithm>
 #include <cassert>
 
 namespace mavsdk {
@@ -8,9 +9,11 @@ namespace mavsdk {
 MavlinkParameterServer::MavlinkParameterServer(
     Sender& sender,
     MavlinkMessageHandler& message_handler,
+    Time& time,
     std::optional<std::map<std::string, ParamValue>> optional_param_values) :
     _sender(sender),
-    _message_handler(message_handler)
+    _message_handler(message_handler),
+    _time(time)
 {
     if (const char* env_p = std::getenv("MAVSDK_PARAMETER_DEBUGGING")) {
         if (std::string(env_p) == "1") {
@@ -19,6 +22,8 @@ MavlinkParameterServer::MavlinkParameterServer(
         }
     }
 
+    _last_credit_time = _time.steady_time();
+
     // Populate the parameter set before the first communication, if provided by the user.
     if (optional_param_values.has_value()) {
         const auto& param_values = optional_param_values.value();
@@ -427,90 +432,182 @@ void MavlinkParameterServer::process_param_ext_request_list(const mavlink_messag
 void MavlinkParameterServer::broadcast_all_parameters(const bool extended)
 {
     std::lock_guard<std::mutex> lock(_all_params_mutex);
-    const auto all_params = _param_cache.all_parameters(extended);
+
+    // A new request restarts the list, there is no point in sending
+    // everything twice.
+    _broadcast.active = true;
+    _broadcast.extended = extended;
+    _broadcast.position = 0;
+    _broadcast.sent = 0;
+    _broadcast.count = _param_cache.count(extended);
+
     if (_parameter_debugging) {
         LogDebug() << "broadcast_all_parameters " << (extended ? "extended" : "") << ": "
-                   << all_params.size();
+                   << _broadcast.count;
     }
-    for (const auto& parameter : all_params) {
-        if (_parameter_debugging) {
-            LogDebug() << "sending param:" << parameter.id;
+}
+
+void MavlinkParameterServer::set_max_messages_per_s(double max_messages_per_s)
+{
+    _max_messages_per_s = max_messages_per_s;
+}
+
+void MavlinkParameterServer::set_max_bytes_per_s(double max_bytes_per_s)
+{
+    _max_bytes_per_s = max_bytes_per_s;
+}
+
+void MavlinkParameterServer::do_work()
+{
+    const auto now = _time.steady_time();
+    _send_credit_s =
+        std::min(_send_credit_s + _time.elapsed_since_s(_last_credit_time), MAX_BURST_S);
+    _last_credit_time = now;
+
+    while (_send_credit_s > 0.0) {
+        mavlink_message_t message;
+
+        // Answers to single requests go first, so they are not stuck behind
+        // a long list. The list waits while the link is backed up.
+        if (!pack_next_work_item(message) &&
+            (!_sender.has_bulk_capacity() || !pack_next_broadcast_param(message))) {
+            break;
         }
-        auto new_work = std::make_shared<WorkItem>(
-            parameter.id,
-            parameter.value,
-            WorkItemValue{parameter.index, static_cast<uint16_t>(all_params.size()), extended});
-        _work_queue.push_back(new_work);
+
+        if (!_sender.send_message(message)) {
+            LogErr() << "Error: Send message failed";
+        }
+
+        // We might go into debt with the last message, which is paid back
+        // before the next one is sent.
+        _send_credit_s -= send_cost_s(message);
     }
 }
 
-void MavlinkParameterServer::do_work()
+double MavlinkParameterServer::send_cost_s(const mavlink_message_t& message) const
+{
+    const double max_messages_per_s = _max_messages_per_s.load();
+    const double max_bytes_per_s = _max_bytes_per_s.load();
+
+    double cost_s = 0.0;
+    if (max_messages_per_s > 0.0) {
+        cost_s = 1.0 / max_messages_per_s;
+    }
+    if (max_bytes_per_s > 0.0) {
+        const double num_bytes = MAVLINK_NUM_NON_PAYLOAD_BYTES + message.len;
+        cost_s = std::max(cost_s, num_bytes / max_bytes_per_s);
+    }
+    return cost_s;
+}
+
+bool MavlinkParameterServer::pack_next_work_item(mavlink_message_t& message)
 {
     LockedQueue<WorkItem>::Guard work_queue_guard(_work_queue);
     auto work = work_queue_guard.get_front();
     if (!work) {
-        return;
+        return false;
     }
-    const auto param_id_message_buffer = param_id_to_message_buffer(work->param_id);
-
-    mavlink_message_t mavlink_message;
 
     std::visit(
         overloaded{
             [&](const WorkItemValue& specific) {
-                if (specific.extended) {
-                    const auto buf = work->param_value.get_128_bytes();
-                    mavlink_msg_param_ext_value_pack(
-                        _sender.get_own_system_id(),
-                        _sender.get_own_component_id(),
-                        &mavlink_message,
-                        param_id_message_buffer.data(),
-                        buf.data(),
-                        work->param_value.get_mav_param_ext_type(),
-                        specific.param_count,
-                        specific.param_index);
-                } else {
-                    float param_value;
-                    if (_sender.autopilot() == Sender::Autopilot::ArduPilot) {
-                        param_value = work->param_value.get_4_float_bytes_cast();
-                    } else {
-                        param_value = work->param_value.get_4_float_bytes_bytewise();
-                    }
-                    mavlink_msg_param_value_pack(
-                        _sender.get_own_system_id(),
-                        _sender.get_own_component_id(),
-                        &mavlink_message,
-                        param_id_message_buffer.data(),
-                        param_value,
-                        work->param_value.get_mav_param_type(),
-                        specific.param_count,
-                        specific.param_index);
-                }
-                if (!_sender.send_message(mavlink_message)) {
-                    LogErr() << "Error: Send message failed";
-                    work_queue_guard.pop_front();
-                    return;
-                }
-                work_queue_guard.pop_front();
+                pack_param_value(
+                    message,
+                    work->param_id,
+                    work->param_value,
+                    specific.param_index,
+                    specific.param_count,
+                    specific.extended);
             },
             [&](const WorkItemAck& specific) {
-                auto buf = work->param_value.get_128_bytes();
-                mavlink_msg_param_ext_ack_pack(
-                    _sender.get_own_system_id(),
-                    _sender.get_own_component_id(),
-                    &mavlink_message,
-                    param_id_message_buffer.data(),
-                    buf.data(),
-                    work->param_value.get_mav_param_ext_type(),
-                    specific.param_ack);
-                if (!_sender.send_message(mavlink_message)) {
-                    LogErr() << "Error: Send message failed";
-                    work_queue_guard.pop_front();
-                    return;
-                }
-                work_queue_guard.pop_front();
+                pack_param_ack(message, work->param_id, work->param_value, specific.param_ack);
             }},
         work->work_item_variant);
+
+    work_queue_guard.pop_front();
+    return true;
+}
+
+bool MavlinkParameterServer::pack_next_broadcast_param(mavlink_message_t& message)
+{
+    std::lock_guard<std::mutex> lock(_all_params_mutex);
+
+    if (!_broadcast.active) {
+        return false;
+    }
+
+    const auto* param = _param_cache.next_param(_broadcast.position, _broadcast.extended);
+    if (param == nullptr || _broadcast.sent >= _broadcast.count) {
+        _broadcast.active = false;
+        return false;
+    }
+
+    if (_parameter_debugging) {
+        LogDebug() << "sending param:" << param->id;
+    }
+
+    pack_param_value(
+        message, param->id, param->value, param->index, _broadcast.count, _broadcast.extended);
+    ++_broadcast.sent;
+    return true;
+}
+
+void MavlinkParameterServer::pack_param_value(
+    mavlink_message_t& message,
+    const std::string& param_id,
+    const ParamValue& param_value,
+    uint16_t param_index,
+    uint16_t param_count,
+    bool extended)
+{
+    const auto param_id_message_buffer = param_id_to_message_buffer(param_id);
+
+    if (extended) {
+        const auto buf = param_value.get_128_bytes();
+        mavlink_msg_param_ext_value_pack(
+            _sender.get_own_system_id(),
+            _sender.get_own_component_id(),
+            &message,
+            param_id_message_buffer.data(),
+            buf.data(),
+            param_value.get_mav_param_ext_type(),
+            param_count,
+            param_index);
+    } else {
+        float value;
+        if (_sender.autopilot() == Sender::Autopilot::ArduPilot) {
+            value = param_value.get_4_float_bytes_cast();
+        } else {
+            value = param_value.get_4_float_bytes_bytewise();
+        }
+        mavlink_msg_param_value_pack(
+            _sender.get_own_system_id(),
+            _sender.get_own_component_id(),
+            &message,
+            param_id_message_buffer.data(),
+            value,
+            param_value.get_mav_param_type(),
+            param_count,
+            param_index);
+    }
+}
+
+void MavlinkParameterServer::pack_param_ack(
+    mavlink_message_t& message,
+    const std::string& param_id,
+    const ParamValue& param_value,
+    PARAM_ACK param_ack)
+{
+    const auto param_id_message_buffer = param_id_to_message_buffer(param_id);
+    const auto buf = param_value.get_128_bytes();
+    mavlink_msg_param_ext_ack_pack(
+        _sender.get_own_system_id(),
+        _sender.get_own_component_id(),
+        &message,
+        param_id_message_buffer.data(),
+        buf.data(),
+        param_value.get_mav_param_ext_type(),
+        param_ack);
 }
 
 std::ostream& operator<<(std::ostream& str, const MavlinkParameterServer::Result& result)
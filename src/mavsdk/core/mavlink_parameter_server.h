@@ -6,9 +6,11 @@
 #include "timeout_s_callback.h"
 #include "param_value.h"
 #include "locked_queue.h"
+#include "mavsdk_time.h"
 #include "mavlink_parameter_subscription.h"
 #include "mavlink_parameter_cache.h"
 
+#include <atomic>
 #include <map>
 #include <string>
 #include <list>
@@ -24,6 +26,7 @@ public:
     explicit MavlinkParameterServer(
         Sender& parent,
         MavlinkMessageHandler& message_handler,
+        Time& time,
         // By providing all the parameters on construction you can populate the
         // parameter set before the server starts reacting to clients.
         //
@@ -55,6 +58,15 @@ public:
     std::pair<Result, int32_t> retrieve_server_param_int(const std::string& name);
     std::pair<Result, std::string> retrieve_server_param_custom(const std::string& name);
 
+    // Limits at which messages are sent, mostly to pace the answer to a
+    // PARAM_REQUEST_LIST, 0 means unlimited.
+    //
+    // The list is also held back while the link is backed up, so the
+    // default rate only needs to keep it from taking over a fast link.
+    static constexpr double DEFAULT_MAX_MESSAGES_PER_S = 1000.0;
+    void set_max_messages_per_s(double max_messages_per_s);
+    void set_max_bytes_per_s(double max_bytes_per_s);
+
     void do_work();
 
     friend std::ostream& operator<<(std::ostream&, const Result&);
@@ -78,6 +90,21 @@ private:
     void process_param_request_list(const mavlink_message_t& message);
     void process_param_ext_request_list(const mavlink_message_t& message);
     void broadcast_all_parameters(bool extended);
+    bool pack_next_broadcast_param(mavlink_message_t& message);
+    void pack_param_value(
+        mavlink_message_t& message,
+        const std::string& param_id,
+        const ParamValue& param_value,
+        uint16_t param_index,
+        uint16_t param_count,
+        bool extended);
+    void pack_param_ack(
+        mavlink_message_t& message,
+        const std::string& param_id,
+        const ParamValue& param_value,
+        PARAM_ACK param_ack);
+    bool pack_next_work_item(mavlink_message_t& message);
+    double send_cost_s(const mavlink_message_t& message) const;
 
     bool target_matches(uint16_t target_sys_id, uint16_t target_comp_id, bool is_request);
     void log_target_mismatch(uint16_t target_sys_id, uint16_t target_comp_id);
@@ -111,12 +138,31 @@ private:
 
     Sender& _sender;
     MavlinkMessageHandler& _message_handler;
+    Time& _time;
 
     std::mutex _all_params_mutex{};
     MavlinkParameterCache _param_cache{};
 
+    // Progress of answering a PARAM_REQUEST_LIST, params are sent straight
+    // from the cache. Protected by _all_params_mutex.
+    struct {
+        bool active{false};
+        bool extended{false};
+        std::size_t position{0};
+        uint16_t sent{0};
+        uint16_t count{0};
+    } _broadcast{};
+
     LockedQueue<WorkItem> _work_queue{};
 
+    // Token bucket, in seconds worth of sending.
+    static constexpr double MAX_BURST_S = 0.05;
+    // Can be set from any thread while the work thread sends.
+    std::atomic<double> _max_messages_per_s{DEFAULT_MAX_MESSAGES_PER_S};
+    std::atomic<double> _max_bytes_per_s{0.0};
+    double _send_credit_s{0.0};
+    SteadyTimePoint _last_credit_time{};
+
     bool _parameter_debugging = false;
 };
 
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include "mavlink_parameter_server.h"
+#include "mocks/sender_mock.h"
+
+using namespace mavsdk;
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+using ::testing::Return;
+using MockSender = NiceMock<mavsdk::testing::MockSender>;
+
+static MAVLinkAddress own_address{1, MAV_COMP_ID_AUTOPILOT1};
+static MAVLinkAddress target_address{245, MAV_COMP_ID_MISSIONPLANNER};
+
+static constexpr unsigned num_params = 1500;
+
+class MavlinkParameterServerTest : public ::testing::Test {
+protected:
+    MavlinkParameterServerTest() : ::testing::Test(), mps(mock_sender, message_handler, time) {}
+
+    void SetUp() override
+    {
+        ON_CALL(mock_sender, get_own_system_id()).WillByDefault(Return(own_address.system_id));
+        ON_CALL(mock_sender, get_own_component_id())
+            .WillByDefault(Return(own_address.component_id));
+        ON_CALL(mock_sender, get_system_id()).WillByDefault(Return(target_address.system_id));
+        ON_CALL(mock_sender, autopilot()).WillByDefault(Return(Sender::Autopilot::Px4));
+        ON_CALL(mock_sender, send_message(_))
+            .WillByDefault(Invoke([this](mavlink_message_t& message) {
+                if (message.msgid == MAVLINK_MSG_ID_PARAM_VALUE) {
+                    ++num_param_values_received;
+                    num_bytes_received += MAVLINK_NUM_NON_PAYLOAD_BYTES + message.len;
+                }
+                return true;
+            }));
+
+        for (unsigned i = 0; i < num_params; ++i) {
+            mps.provide_server_param_int("PARAM" + std::to_string(i), int32_t(i));
+        }
+    }
+
+    void request_list()
+    {
+        mavlink_message_t message;
+        mavlink_msg_param_request_list_pack(
+            target_address.system_id,
+            target_address.component_id,
+            &message,
+            own_address.system_id,
+            own_address.component_id);
+        message_handler.process_message(message);
+    }
+
+    // Runs the server like the work thread does and returns how long it took
+    // until all params were sent.
+    double time_until_all_received()
+    {
+        const auto start_time = time.steady_time();
+        while (num_param_values_received < num_params && time.elapsed_since_s(start_time) < 60.0) {
+            time.sleep_for(std::chrono::milliseconds(10));
+            mps.do_work();
+        }
+        return time.elapsed_since_s(start_time);
+    }
+
+    MockSender mock_sender;
+    MavlinkMessageHandler message_handler;
+    FakeTime time;
+    MavlinkParameterServer mps;
+
+    unsigned num_param_values_received{0};
+    unsigned num_bytes_received{0};
+};
+
+TEST_F(MavlinkParameterServerTest, ListIsPacedByDefaultRate)
+{
+    request_list();
+    const double elapsed_s = time_until_all_received();
+
+    const double expected_s = num_params / MavlinkParameterServer::DEFAULT_MAX_MESSAGES_PER_S;
+    EXPECT_EQ(num_param_values_received, num_params);
+    EXPECT_NEAR(elapsed_s, expected_s, expected_s * 0.1 + 0.05);
+}
+
+TEST_F(MavlinkParameterServerTest, ListIsPacedByMessageRate)
+{
+    for (const double rate : {100.0, 500.0, 2000.0}) {
+        num_param_values_received = 0;
+        mps.set_max_messages_per_s(rate);
+
+        request_list();
+        const double elapsed_s = time_until_all_received();
+
+        EXPECT_EQ(num_param_values_received, num_params);
+        EXPECT_NEAR(elapsed_s, num_params / rate, num_params / rate * 0.1 + 0.05) << rate;
+    }
+}
+
+TEST_F(MavlinkParameterServerTest, ListIsPacedByBandwidth)
+{
+    mps.set_max_messages_per_s(0.0);
+
+    for (const double bytes_per_s : {5760.0, 50000.0}) {
+        num_param_values_received = 0;
+        num_bytes_received = 0;
+        mps.set_max_bytes_per_s(bytes_per_s);
+
+        request_list();
+        const double elapsed_s = time_until_all_received();
+
+        EXPECT_EQ(num_param_values_received, num_params);
+        const double expected_s = num_bytes_received / bytes_per_s;
+        EXPECT_NEAR(elapsed_s, expected_s, expected_s * 0.1 + 0.05) << bytes_per_s;
+    }
+}
+
+TEST_F(MavlinkParameterServerTest, ListUnlimitedIsSentAtOnce)
+{
+    mps.set_max_messages_per_s(0.0);
+    mps.set_max_bytes_per_s(0.0);
+
+    request_list();
+    time.sleep_for(std::chrono::milliseconds(10));
+    mps.do_work();
+
+    EXPECT_EQ(num_param_values_received, num_params);
+}
+
+TEST_F(MavlinkParameterServerTest, SecondRequestRestartsList)
+{
+    mps.set_max_messages_per_s(1000.0);
+
+    request_list();
+    time.sleep_for(std::chrono::milliseconds(10));
+    mps.do_work();
+    const auto received_before_restart = num_param_values_received;
+    EXPECT_GT(received_before_restart, 0u);
+    EXPECT_LT(received_before_restart, num_params);
+
+    request_list();
+    num_param_values_received = 0;
+    time_until_all_received();
+
+    // Nothing more is sent once the list is done.
+    for (unsigned i = 0; i < 10; ++i) {
+        time.sleep_for(std::chrono::milliseconds(10));
+        mps.do_work();
+    }
+    EXPECT_EQ(num_param_values_received, num_params);
+}
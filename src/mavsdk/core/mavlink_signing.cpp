@@ -0,0 +1,205 @@
+#include "mavlink_signing.h"
+#include "sha256.h"
+
+#include <algorithm>
+
+namespace mavsdk {
+
+namespace {
+// Signing timestamps count from 1.1.2015 00:00 UTC.
+constexpr std::chrono::seconds signing_epoch{1420070400};
+
+constexpr std::size_t header_len = MAVLINK_CORE_HEADER_LEN + 1;
+
+std::array<uint8_t, header_len> header_of(const mavlink_message_t& message)
+{
+    return {
+        message.magic,
+        message.len,
+        message.incompat_flags,
+        message.compat_flags,
+        message.seq,
+        message.sysid,
+        message.compid,
+        static_cast<uint8_t>(message.msgid & 0xFF),
+        static_cast<uint8_t>((message.msgid >> 8) & 0xFF),
+        static_cast<uint8_t>((message.msgid >> 16) & 0xFF)};
+}
+
+const uint8_t* payload_of(const mavlink_message_t& message)
+{
+    return reinterpret_cast<const uint8_t*>(message.payload64);
+}
+} // namespace
+
+void MavlinkSigning::enable(
+    const std::array<uint8_t, KEY_LEN>& secret_key, uint8_t link_id, bool accept_unsigned)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _secret_key = secret_key;
+    _link_id = link_id;
+    _accept_unsigned = accept_unsigned;
+    _enabled = true;
+}
+
+void MavlinkSigning::disable()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _enabled = false;
+    _secret_key.fill(0);
+}
+
+bool MavlinkSigning::sign(mavlink_message_t& message)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    // Every message gets a new timestamp, even if the clock hasn't moved on.
+    return sign_with_lock(message, std::max(_timestamp + 1, timestamp_now()));
+}
+
+bool MavlinkSigning::sign(mavlink_message_t& message, uint64_t timestamp)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return sign_with_lock(message, timestamp);
+}
+
+bool MavlinkSigning::sign_with_lock(mavlink_message_t& message, uint64_t timestamp)
+{
+    if (message.magic != MAVLINK_STX) {
+        return false;
+    }
+
+    const mavlink_msg_entry_t* entry = mavlink_get_msg_entry(message.msgid);
+    if (entry == nullptr) {
+        return false;
+    }
+
+    message.incompat_flags |= MAVLINK_IFLAG_SIGNED;
+
+    // The checksum covers the flags, so it needs to be calculated again.
+    const auto header = header_of(message);
+    uint16_t checksum = crc_calculate(&header[1], MAVLINK_CORE_HEADER_LEN);
+    crc_accumulate_buffer(
+        &checksum, reinterpret_cast<const char*>(payload_of(message)), message.len);
+    crc_accumulate(entry->crc_extra, &checksum);
+    message.checksum = checksum;
+
+    // Like mavlink_finalize_message, also keep the checksum after the payload.
+    auto* checksum_bytes = reinterpret_cast<uint8_t*>(message.payload64) + message.len;
+    checksum_bytes[0] = static_cast<uint8_t>(checksum & 0xFF);
+    checksum_bytes[1] = static_cast<uint8_t>(checksum >> 8);
+
+    message.signature[0] = _link_id;
+    for (unsigned i = 0; i < 6; ++i) {
+        message.signature[1 + i] = static_cast<uint8_t>(timestamp >> (8 * i));
+    }
+    const auto sig = signature(message);
+    std::copy(sig.begin(), sig.end(), &message.signature[7]);
+
+    _timestamp = std::max(_timestamp, timestamp);
+    ++_stats.signed_messages;
+    return true;
+}
+
+bool MavlinkSigning::verify(const mavlink_message_t& message)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (message.magic != MAVLINK_STX || (message.incompat_flags & MAVLINK_IFLAG_SIGNED) == 0) {
+        if (_accept_unsigned || message.msgid == MAVLINK_MSG_ID_RADIO_STATUS) {
+            ++_stats.accepted;
+            return true;
+        }
+        ++_stats.unsigned_messages;
+        return false;
+    }
+
+    const auto expected = signature(message);
+    uint8_t difference = 0;
+    for (unsigned i = 0; i < SIGNATURE_LEN; ++i) {
+        difference |= static_cast<uint8_t>(expected[i] ^ message.signature[7 + i]);
+    }
+    if (difference != 0) {
+        ++_stats.bad_signature;
+        return false;
+    }
+
+    const uint8_t link_id = message.signature[0];
+    uint64_t timestamp = 0;
+    for (unsigned i = 0; i < 6; ++i) {
+        timestamp |= static_cast<uint64_t>(message.signature[1 + i]) << (8 * i);
+    }
+
+    auto stream = std::find_if(_streams.begin(), _streams.end(), [&](const Stream& s) {
+        return s.link_id == link_id && s.system_id == message.sysid &&
+               s.component_id == message.compid;
+    });
+
+    if (stream == _streams.end()) {
+        const uint64_t now = std::max(_timestamp, timestamp_now());
+        if (timestamp + MAX_TIMESTAMP_LAG < now) {
+            ++_stats.bad_timestamp;
+            return false;
+        }
+        const Stream new_stream{
+            link_id, message.sysid, message.compid, timestamp, ++_streams_seen};
+        if (_streams.size() < MAX_STREAMS) {
+            _streams.push_back(new_stream);
+        } else {
+            // Make room by forgetting the least recently seen stream.
+            auto oldest = std::min_element(
+                _streams.begin(), _streams.end(), [](const Stream& a, const Stream& b) {
+                    return a.last_seen < b.last_seen;
+                });
+            *oldest = new_stream;
+        }
+
+    } else {
+        if (timestamp <= stream->timestamp) {
+            ++_stats.bad_timestamp;
+            return false;
+        }
+        stream->timestamp = timestamp;
+        stream->last_seen = ++_streams_seen;
+    }
+
+    _timestamp = std::max(_timestamp, timestamp);
+    ++_stats.accepted;
+    return true;
+}
+
+MavlinkSigning::Stats MavlinkSigning::stats() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+uint64_t MavlinkSigning::timestamp_now()
+{
+    const auto since_epoch = _time.system_time().time_since_epoch() - signing_epoch;
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(since_epoch).count() / 10);
+}
+
+std::array<uint8_t, MavlinkSigning::SIGNATURE_LEN>
+MavlinkSigning::signature(const mavlink_message_t& message) const
+{
+    const auto header = header_of(message);
+    const uint8_t checksum[2] = {
+        static_cast<uint8_t>(message.checksum & 0xFF), static_cast<uint8_t>(message.checksum >> 8)};
+
+    // SHA-256 of key, header, payload, checksum, link ID and timestamp, of
+    // which the first 6 bytes are used.
+    Sha256 sha256;
+    sha256.update(_secret_key.data(), _secret_key.size());
+    sha256.update(header.data(), header.size());
+    sha256.update(payload_of(message), message.len);
+    sha256.update(checksum, sizeof(checksum));
+    sha256.update(message.signature, 7);
+    const auto digest = sha256.finalize();
+
+    std::array<uint8_t, SIGNATURE_LEN> result;
+    std::copy(digest.begin(), digest.begin() + SIGNATURE_LEN, result.begin());
+    return result;
+}
+
+} // namespace mavsdk
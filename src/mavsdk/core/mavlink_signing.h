@@ -0,0 +1,114 @@
+#pragma once
+
+#include "mavlink_include.h"
+#include "mavsdk_time.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace mavsdk {
+
+// MAVLink 2 message signing for one connection.
+//
+// Outgoing messages are signed with the secret key, the link ID of this
+// connection and a timestamp which increases with every message. Incoming
+// messages are only accepted if their signature matches and their timestamp
+// is newer than the last one of the same link, system and component, so
+// recorded messages can't be replayed. The timestamp of a new stream must
+// not be more than a minute behind ours.
+//
+// Up to MAX_STREAMS streams are remembered. When a new one comes in beyond
+// that, the one not seen for the longest time is forgotten, and is treated
+// like a new stream once it shows up again.
+//
+// Signing happens per connection when a message is written, so each link can
+// have its own key, and a message sent on several links is signed for each of
+// them.
+//
+// This class is thread-safe.
+class MavlinkSigning {
+public:
+    static constexpr std::size_t KEY_LEN = 32;
+
+    struct Stats {
+        uint64_t signed_messages{0};
+        uint64_t accepted{0};
+        uint64_t bad_signature{0};
+        // Replayed or too old.
+        uint64_t bad_timestamp{0};
+        uint64_t unsigned_messages{0};
+    };
+
+    MavlinkSigning() = default;
+    ~MavlinkSigning() = default;
+
+    // delete copy and move constructors and assign operators
+    MavlinkSigning(MavlinkSigning const&) = delete; // Copy construct
+    MavlinkSigning(MavlinkSigning&&) = delete; // Move construct
+    MavlinkSigning& operator=(MavlinkSigning const&) = delete; // Copy assign
+    MavlinkSigning& operator=(MavlinkSigning&&) = delete; // Move assign
+
+    // Unsigned incoming messages are dropped unless accept_unsigned is set,
+    // apart from RADIO_STATUS which radios inject without a key.
+    void enable(
+        const std::array<uint8_t, KEY_LEN>& secret_key, uint8_t link_id, bool accept_unsigned);
+    void disable();
+
+    [[nodiscard]] bool is_enabled() const { return _enabled; }
+
+    // Sets the signed flag, updates the checksum and appends the signature.
+    // Returns false for MAVLink 1 and unknown messages, which can't be signed.
+    bool sign(mavlink_message_t& message);
+
+    // Same as above but with a given timestamp in 10 us since 1.1.2015.
+    bool sign(mavlink_message_t& message, uint64_t timestamp);
+
+    // Returns false if the message is to be dropped.
+    bool verify(const mavlink_message_t& message);
+
+    [[nodiscard]] Stats stats() const;
+
+    // The current time in the unit of signing timestamps.
+    uint64_t timestamp_now();
+
+    // How far the timestamp of a new stream may be behind ours, one minute.
+    static constexpr uint64_t MAX_TIMESTAMP_LAG = 6000000;
+    // Streams of link, system and component which are remembered.
+    static constexpr std::size_t MAX_STREAMS = 64;
+
+private:
+    static constexpr std::size_t SIGNATURE_LEN = 6;
+
+    // Assumes to have the lock for _mutex.
+    bool sign_with_lock(mavlink_message_t& message, uint64_t timestamp);
+    // Assumes to have the lock for _mutex.
+    std::array<uint8_t, SIGNATURE_LEN> signature(const mavlink_message_t& message) const;
+
+    std::atomic<bool> _enabled{false};
+
+    mutable std::mutex _mutex{};
+    std::array<uint8_t, KEY_LEN> _secret_key{};
+    uint8_t _link_id{0};
+    bool _accept_unsigned{false};
+    // The last timestamp we have sent or seen.
+    uint64_t _timestamp{0};
+
+    struct Stream {
+        uint8_t link_id;
+        uint8_t system_id;
+        uint8_t component_id;
+        uint64_t timestamp;
+        // Value of _streams_seen when the stream was last seen.
+        uint64_t last_seen;
+    };
+    std::vector<Stream> _streams{};
+    uint64_t _streams_seen{0};
+
+    Stats _stats{};
+
+    Time _time{};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,165 @@
+#include "mavlink_signing.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+using namespace mavsdk;
+
+namespace {
+const std::array<uint8_t, MavlinkSigning::KEY_LEN> key{
+    1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 16,
+    17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32};
+
+mavlink_message_t make_heartbeat(uint8_t system_id = 1)
+{
+    mavlink_message_t message;
+    mavlink_msg_heartbeat_pack(
+        system_id,
+        MAV_COMP_ID_AUTOPILOT1,
+        &message,
+        MAV_TYPE_QUADROTOR,
+        MAV_AUTOPILOT_PX4,
+        MAV_MODE_FLAG_CUSTOM_MODE_ENABLED,
+        0,
+        MAV_STATE_ACTIVE);
+    return message;
+}
+
+// Parses the bytes as they would go over the wire, and checks the signature
+// with the implementation of the MAVLink library.
+uint8_t parse_with_mavlink_signing(const mavlink_message_t& message, mavlink_message_t& parsed)
+{
+    std::vector<uint8_t> buffer(MAVLINK_MAX_PACKET_LEN);
+    buffer.resize(mavlink_msg_to_send_buffer(buffer.data(), &message));
+
+    mavlink_signing_t signing{};
+    std::memcpy(signing.secret_key, key.data(), key.size());
+    mavlink_signing_streams_t signing_streams{};
+
+    mavlink_status_t status{};
+    status.signing = &signing;
+    status.signing_streams = &signing_streams;
+    mavlink_message_t rxmsg{};
+    mavlink_status_t r_status{};
+
+    uint8_t result = MAVLINK_FRAMING_INCOMPLETE;
+    for (const auto byte : buffer) {
+        result = mavlink_frame_char_buffer(&rxmsg, &status, byte, &parsed, &r_status);
+    }
+    return result;
+}
+} // namespace
+
+TEST(MavlinkSigning, SignsLikeMavlink)
+{
+    MavlinkSigning signing;
+    signing.enable(key, 3, false);
+
+    auto message = make_heartbeat();
+    ASSERT_TRUE(signing.sign(message));
+    EXPECT_TRUE(message.incompat_flags & MAVLINK_IFLAG_SIGNED);
+    EXPECT_EQ(message.signature[0], 3);
+
+    mavlink_message_t parsed{};
+    EXPECT_EQ(parse_with_mavlink_signing(message, parsed), MAVLINK_FRAMING_OK);
+
+    MavlinkSigning other_end;
+    other_end.enable(key, 0, false);
+    EXPECT_TRUE(other_end.verify(parsed));
+    EXPECT_EQ(other_end.stats().accepted, 1u);
+}
+
+TEST(MavlinkSigning, RejectsWrongKeyAndTampering)
+{
+    MavlinkSigning signing;
+    signing.enable(key, 0, false);
+
+    auto other_key = key;
+    other_key[0] = 0xFF;
+    MavlinkSigning other_end;
+    other_end.enable(other_key, 0, false);
+
+    auto message = make_heartbeat();
+    ASSERT_TRUE(signing.sign(message));
+    EXPECT_FALSE(other_end.verify(message));
+
+    other_end.enable(key, 0, false);
+    auto tampered = message;
+    reinterpret_cast<uint8_t*>(tampered.payload64)[0] ^= 0x01;
+    EXPECT_FALSE(other_end.verify(tampered));
+    EXPECT_EQ(other_end.stats().bad_signature, 2u);
+
+    EXPECT_TRUE(other_end.verify(message));
+}
+
+TEST(MavlinkSigning, RejectsReplayedAndOldMessages)
+{
+    MavlinkSigning signing;
+    signing.enable(key, 0, false);
+    MavlinkSigning other_end;
+    other_end.enable(key, 0, false);
+
+    auto first = make_heartbeat();
+    auto second = make_heartbeat();
+    ASSERT_TRUE(signing.sign(first));
+    ASSERT_TRUE(signing.sign(second));
+
+    EXPECT_TRUE(other_end.verify(first));
+    EXPECT_TRUE(other_end.verify(second));
+    EXPECT_FALSE(other_end.verify(first));
+    EXPECT_FALSE(other_end.verify(second));
+
+    // A new stream, but from too long ago.
+    auto old = make_heartbeat(2);
+    ASSERT_TRUE(signing.sign(old, signing.timestamp_now() - 2 * MavlinkSigning::MAX_TIMESTAMP_LAG));
+    EXPECT_FALSE(other_end.verify(old));
+
+    EXPECT_EQ(other_end.stats().bad_timestamp, 3u);
+}
+
+TEST(MavlinkSigning, ForgetsLeastRecentlySeenStreams)
+{
+    MavlinkSigning signing;
+    signing.enable(key, 0, false);
+    MavlinkSigning other_end;
+    other_end.enable(key, 0, false);
+
+    // More senders than streams which are remembered, all of them are let in.
+    constexpr unsigned num_senders = MavlinkSigning::MAX_STREAMS + 10;
+    std::vector<mavlink_message_t> first_messages;
+    for (unsigned i = 1; i <= num_senders; ++i) {
+        auto message = make_heartbeat(static_cast<uint8_t>(i));
+        ASSERT_TRUE(signing.sign(message));
+        EXPECT_TRUE(other_end.verify(message));
+        first_messages.push_back(message);
+    }
+
+    // The most recent streams are still known, so their replays are caught.
+    EXPECT_FALSE(other_end.verify(first_messages.back()));
+
+    // The first ones were forgotten, and come back as new streams.
+    auto next = make_heartbeat(1);
+    ASSERT_TRUE(signing.sign(next));
+    EXPECT_TRUE(other_end.verify(next));
+    EXPECT_FALSE(other_end.verify(next));
+
+    EXPECT_EQ(other_end.stats().accepted, num_senders + 1);
+    EXPECT_EQ(other_end.stats().bad_timestamp, 2u);
+}
+
+TEST(MavlinkSigning, UnsignedOnlyIfAccepted)
+{
+    MavlinkSigning signing;
+    signing.enable(key, 0, false);
+
+    EXPECT_FALSE(signing.verify(make_heartbeat()));
+
+    mavlink_message_t radio_status;
+    mavlink_msg_radio_status_pack(3, 68, &radio_status, 0, 0, 0, 0, 0, 0, 0);
+    EXPECT_TRUE(signing.verify(radio_status));
+
+    signing.enable(key, 0, true);
+    EXPECT_TRUE(signing.verify(make_heartbeat()));
+
+    EXPECT_EQ(signing.stats().unsigned_messages, 1u);
+}
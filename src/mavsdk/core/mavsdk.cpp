@@ -65,6 +65,22 @@ void Mavsdk::remove_connection(ConnectionHandle handle)
     _impl->remove_connection(handle);
 }
 
+ConnectionResult Mavsdk::set_signing(ConnectionHandle handle, const SigningOptions& options)
+{
+    return _impl->set_signing(handle, options);
+}
+
+ConnectionResult Mavsdk::clear_signing(ConnectionHandle handle)
+{
+    return _impl->clear_signing(handle);
+}
+
+std::pair<ConnectionResult, Mavsdk::ConnectionStats>
+Mavsdk::connection_stats(ConnectionHandle handle) const
+{
+    return _impl->connection_stats(handle);
+}
+
 std::vector<std::shared_ptr<System>> Mavsdk::systems() const
 {
     return _impl->systems();
@@ -1,6 +1,7 @@
 #include "mavsdk_impl.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <mutex>
 
 #include "connection.h"
@@ -9,6 +10,7 @@
 #include "system.h"
 #include "system_impl.h"
 #include "serial_connection.h"
+#include "tlog_connection.h"
 #include "cli_arg.h"
 #include "version.h"
 #include "server_component_impl.h"
@@ -18,7 +20,10 @@ namespace mavsdk {
 
 template class CallbackList<>;
 
-MavsdkImpl::MavsdkImpl() : timeout_handler(_time), call_every_handler(_time)
+MavsdkImpl::MavsdkImpl() :
+    timeout_handler(_time),
+    call_every_handler(_time),
+    liveness_tracker(_time)
 {
     LogInfo() << "MAVSDK version: " << mavsdk_version;
 
@@ -36,6 +41,42 @@ MavsdkImpl::MavsdkImpl() : timeout_handler(_time), call_every_handler(_time)
         }
     }
 
+    if (const char* env_p = std::getenv("MAVSDK_TLOG_RECORDING")) {
+        // Record everything going in and out to the given file.
+        _tlog_recorder = std::make_unique<TlogRecorder>(env_p);
+        if (!_tlog_recorder->start()) {
+            _tlog_recorder.reset();
+        }
+    }
+
+    if (const char* env_p = std::getenv("MAVSDK_RECEIVE_THREADS")) {
+        // Process the messages of different systems in parallel.
+        const int num_threads = std::atoi(env_p);
+        if (num_threads > 1) {
+            LogDebug() << "Processing received messages on " << num_threads << " threads.";
+            _receive_shards = std::make_unique<ReceiveShards>(
+                static_cast<unsigned>(num_threads),
+                [this](const mavlink_message_t& message) { route_message(message); });
+        }
+    }
+
+#if defined(LINUX)
+    if (const char* env_p = std::getenv("MAVSDK_IO_THREADS")) {
+        // Receive on all connections with these threads instead of one
+        // thread for each connection.
+        const int num_threads = std::atoi(env_p);
+        if (num_threads > 0) {
+            LogDebug() << "Receiving on " << num_threads << " I/O threads.";
+            for (int i = 0; i < num_threads; ++i) {
+                _io_reactors.push_back(std::make_unique<IoReactor>());
+            }
+        }
+    }
+#endif
+
+    call_every_handler.add(
+        [this]() { check_liveness(); }, LIVENESS_CHECK_INTERVAL_S, &_liveness_check_cookie);
+
     _work_thread = new std::thread(&MavsdkImpl::work_thread, this);
 
     _process_user_callbacks_thread =
@@ -45,6 +86,7 @@ MavsdkImpl::MavsdkImpl() : timeout_handler(_time), call_every_handler(_time)
 MavsdkImpl::~MavsdkImpl()
 {
     call_every_handler.remove(_heartbeat_send_cookie);
+    call_every_handler.remove(_liveness_check_cookie);
 
     _should_exit = true;
 
@@ -61,8 +103,14 @@ MavsdkImpl::~MavsdkImpl()
         _work_thread = nullptr;
     }
 
+    // Nothing must be routed to the systems anymore once they are gone.
+    if (_receive_shards) {
+        _receive_shards->stop();
+    }
+
     {
         std::lock_guard<std::recursive_mutex> lock(_systems_mutex);
+        _systems_by_id.fill(nullptr);
         _systems.clear();
     }
 
@@ -70,6 +118,11 @@ MavsdkImpl::~MavsdkImpl()
         std::lock_guard<std::mutex> lock(_connections_mutex);
         _connections.clear();
     }
+
+    // Only stop recording once no connection can receive anymore.
+    if (_tlog_recorder) {
+        _tlog_recorder->stop();
+    }
 }
 
 std::string MavsdkImpl::version()
@@ -291,6 +344,10 @@ void MavsdkImpl::receive_message(mavlink_message_t& message, Connection* connect
                    << static_cast<int>(message.sysid) << "/" << static_cast<int>(message.compid);
     }
 
+    if (_tlog_recorder) {
+        _tlog_recorder->record(message);
+    }
+
     // This is a low level interface where incoming messages can be tampered
     // with or even dropped.
     {
@@ -349,7 +406,16 @@ void MavsdkImpl::receive_message(mavlink_message_t& message, Connection* connect
         return;
     }
 
-    std::lock_guard<std::recursive_mutex> lock(_systems_mutex);
+    if (_receive_shards) {
+        _receive_shards->push(message);
+    } else {
+        route_message(message);
+    }
+}
+
+void MavsdkImpl::route_message(const mavlink_message_t& message)
+{
+    std::unique_lock<std::recursive_mutex> lock(_systems_mutex);
 
     // The only situation where we create a system with sysid 0 is when we initialize the connection
     // to the remote.
@@ -358,45 +424,51 @@ void MavsdkImpl::receive_message(mavlink_message_t& message, Connection* connect
                    << " Comp ID: " << static_cast<int>(message.compid);
         _systems[0].first = message.sysid;
         _systems[0].second->system_impl()->set_system_id(message.sysid);
+        _systems_by_id[0].reset();
+        _systems_by_id[message.sysid] = _systems[0].second;
 
         // Even though the fake system was already discovered, we can now
         // send a notification, now that it seems to really actually exist.
         notify_on_discover();
     }
 
-    bool found_system = false;
-    for (auto& system : _systems) {
-        if (system.first == message.sysid) {
-            system.second->system_impl()->add_new_component(message.compid);
-            found_system = true;
-            break;
-        }
-    }
+    auto system = _systems_by_id[message.sysid];
 
-    if (!found_system && message.compid == MAV_COMP_ID_TELEMETRY_RADIO) {
+    if (system != nullptr) {
+        system->system_impl()->add_new_component(message.compid);
+
+    } else if (message.compid == MAV_COMP_ID_TELEMETRY_RADIO) {
         if (_message_logging_on) {
             LogDebug() << "Don't create new system just for telemetry radio";
         }
         return;
-    }
 
-    if (!found_system) {
+    } else {
         make_system_with_component(message.sysid, message.compid);
+        system = _systems_by_id[message.sysid];
     }
 
-    if (_should_exit) {
-        // Don't try to call at() if systems have already been destroyed
+    if (_should_exit || system == nullptr) {
+        // Don't try to use the system if systems have already been destroyed
         // in destructor.
         return;
     }
 
-    for (auto& system : _systems) {
-        if (system.first == message.sysid) {
-            // system.second->system_impl()->process_mavlink_message(message);
-            mavlink_message_handler.process_message(message);
-            break;
-        }
+    // With receive shards, all messages of a system come from the same shard,
+    // so the handlers of different systems can run in parallel without the
+    // lock. We keep a reference in case the system is removed meanwhile.
+    // Otherwise, the lock is held, as the messages of one system can come
+    // from several connections at once.
+    //
+    // Either way, each handler table only runs one callback at a time.
+    // Handlers of server components see the messages of all systems, the
+    // ones of a system only its own.
+    if (_receive_shards) {
+        lock.unlock();
     }
+
+    mavlink_message_handler.process_message(message);
+    system->system_impl()->process_mavlink_message(message);
 }
 
 bool MavsdkImpl::send_message(mavlink_message_t& message)
@@ -419,6 +491,10 @@ bool MavsdkImpl::send_message(mavlink_message_t& message)
         }
     }
 
+    if (_tlog_recorder) {
+        _tlog_recorder->record(message);
+    }
+
     std::lock_guard<std::mutex> lock(_connections_mutex);
 
     if (_connections.empty()) {
@@ -427,10 +503,11 @@ bool MavsdkImpl::send_message(mavlink_message_t& message)
         return true;
     }
 
+    // Looked up once, not for every connection.
+    const uint8_t target_system_id = get_target_system_id(message);
+
     uint8_t successful_emissions = 0;
     for (auto& _connection : _connections) {
-        const uint8_t target_system_id = get_target_system_id(message);
-
         if (target_system_id != 0 && !(*_connection.connection).has_system_id(target_system_id)) {
             continue;
         }
@@ -448,6 +525,52 @@ bool MavsdkImpl::send_message(mavlink_message_t& message)
     return true;
 }
 
+bool MavsdkImpl::send_message_in_place(uint32_t message_id, const MessagePacker& pack)
+{
+    {
+        std::lock_guard<std::mutex> lock(_connections_mutex);
+
+        // Logging and intercepting need the message before it's queued.
+        if (_connections.size() == 1 && !_message_logging_on &&
+            _intercept_outgoing_messages_callback == nullptr) {
+            auto& connection = *_connections.front().connection;
+
+            const bool queued =
+                connection.send_message_in_place(message_id, [&](mavlink_message_t& message) {
+                    pack(message);
+
+                    const uint8_t target_system_id = get_target_system_id(message);
+                    if (target_system_id != 0 && !connection.has_system_id(target_system_id)) {
+                        return false;
+                    }
+
+                    if (_tlog_recorder) {
+                        _tlog_recorder->record(message);
+                    }
+                    return true;
+                });
+
+            if (!queued) {
+                LogErr() << "Sending message failed";
+            }
+            return queued;
+        }
+    }
+
+    mavlink_message_t message;
+    pack(message);
+    return send_message(message);
+}
+
+bool MavsdkImpl::has_bulk_capacity()
+{
+    std::lock_guard<std::mutex> lock(_connections_mutex);
+
+    return std::all_of(_connections.begin(), _connections.end(), [](const auto& entry) {
+        return entry.connection->has_bulk_capacity();
+    });
+}
+
 std::pair<ConnectionResult, Mavsdk::ConnectionHandle> MavsdkImpl::add_any_connection(
     const std::string& connection_url, ForwardingOption forwarding_option)
 {
@@ -458,14 +581,21 @@ std::pair<ConnectionResult, Mavsdk::ConnectionHandle> MavsdkImpl::add_any_connec
 
     switch (cli_arg.get_protocol()) {
         case CliArg::Protocol::Udp: {
+            if (cli_arg.get_coalesce_us() > 0) {
+                // Each message is its own datagram.
+                LogWarn() << "coalesce_us has no effect on UDP connections";
+            }
+
             int port = cli_arg.get_port() ? cli_arg.get_port() : Mavsdk::DEFAULT_UDP_PORT;
 
             if (cli_arg.get_path().empty() || cli_arg.get_path() == Mavsdk::DEFAULT_UDP_BIND_IP) {
                 std::string path = Mavsdk::DEFAULT_UDP_BIND_IP;
-                return add_udp_connection(path, port, forwarding_option);
+                return add_udp_connection(
+                    path, port, forwarding_option, cli_arg.get_max_bytes_per_s());
             } else {
                 std::string path = cli_arg.get_path();
-                return setup_udp_remote(path, port, forwarding_option);
+                return setup_udp_remote(
+                    path, port, forwarding_option, cli_arg.get_max_bytes_per_s());
             }
         }
 
@@ -478,7 +608,12 @@ std::pair<ConnectionResult, Mavsdk::ConnectionHandle> MavsdkImpl::add_any_connec
             if (cli_arg.get_port()) {
                 port = cli_arg.get_port();
             }
-            return add_tcp_connection(path, port, forwarding_option);
+            return add_tcp_connection(
+                path,
+                port,
+                forwarding_option,
+                cli_arg.get_max_bytes_per_s(),
+                cli_arg.get_coalesce_us());
         }
 
         case CliArg::Protocol::Serial: {
@@ -488,16 +623,27 @@ std::pair<ConnectionResult, Mavsdk::ConnectionHandle> MavsdkImpl::add_any_connec
             }
             bool flow_control = cli_arg.get_flow_control();
             return add_serial_connection(
-                cli_arg.get_path(), baudrate, flow_control, forwarding_option);
+                cli_arg.get_path(),
+                baudrate,
+                flow_control,
+                forwarding_option,
+                cli_arg.get_max_bytes_per_s(),
+                cli_arg.get_coalesce_us());
         }
 
+        case CliArg::Protocol::Tlog:
+            return add_tlog_connection(cli_arg.get_path(), cli_arg.get_speed(), forwarding_option);
+
         default:
             return {ConnectionResult::ConnectionError, Mavsdk::ConnectionHandle{}};
     }
 }
 
 std::pair<ConnectionResult, Mavsdk::ConnectionHandle> MavsdkImpl::add_udp_connection(
-    const std::string& local_ip, const int local_port, ForwardingOption forwarding_option)
+    const std::string& local_ip,
+    const int local_port,
+    ForwardingOption forwarding_option,
+    unsigned max_bytes_per_s)
 {
     auto new_conn = std::make_shared<UdpConnection>(
         [this](mavlink_message_t& message, Connection* connection) {
@@ -509,6 +655,8 @@ std::pair<ConnectionResult, Mavsdk::ConnectionHandle> MavsdkImpl::add_udp_connec
     if (!new_conn) {
         return {ConnectionResult::ConnectionError, Mavsdk::ConnectionHandle{}};
     }
+    new_conn->set_max_bytes_per_s(max_bytes_per_s);
+    new_conn->set_io_reactor(next_io_reactor());
     ConnectionResult ret = new_conn->start();
     if (ret == ConnectionResult::Success) {
         return {ret, add_connection(new_conn)};
@@ -518,7 +666,10 @@ std::pair<ConnectionResult, Mavsdk::ConnectionHandle> MavsdkImpl::add_udp_connec
 }
 
 std::pair<ConnectionResult, Mavsdk::ConnectionHandle> MavsdkImpl::setup_udp_remote(
-    const std::string& remote_ip, int remote_port, ForwardingOption forwarding_option)
+    const std::string& remote_ip,
+    int remote_port,
+    ForwardingOption forwarding_option,
+    unsigned max_bytes_per_s)
 {
     auto new_conn = std::make_shared<UdpConnection>(
         [this](mavlink_message_t& message, Connection* connection) {
@@ -530,6 +681,8 @@ std::pair<ConnectionResult, Mavsdk::ConnectionHandle> MavsdkImpl::setup_udp_remo
     if (!new_conn) {
         return {ConnectionResult::ConnectionError, Mavsdk::ConnectionHandle{}};
     }
+    new_conn->set_max_bytes_per_s(max_bytes_per_s);
+    new_conn->set_io_reactor(next_io_reactor());
     ConnectionResult ret = new_conn->start();
     if (ret == ConnectionResult::Success) {
         new_conn->add_remote(remote_ip, remote_port);
@@ -552,7 +705,11 @@ std::pair<ConnectionResult, Mavsdk::ConnectionHandle> MavsdkImpl::setup_udp_remo
 }
 
 std::pair<ConnectionResult, Mavsdk::ConnectionHandle> MavsdkImpl::add_tcp_connection(
-    const std::string& remote_ip, int remote_port, ForwardingOption forwarding_option)
+    const std::string& remote_ip,
+    int remote_port,
+    ForwardingOption forwarding_option,
+    unsigned max_bytes_per_s,
+    unsigned coalesce_us)
 {
     auto new_conn = std::make_shared<TcpConnection>(
         [this](mavlink_message_t& message, Connection* connection) {
@@ -564,6 +721,9 @@ std::pair<ConnectionResult, Mavsdk::ConnectionHandle> MavsdkImpl::add_tcp_connec
     if (!new_conn) {
         return {ConnectionResult::ConnectionError, Mavsdk::ConnectionHandle{}};
     }
+    new_conn->set_max_bytes_per_s(max_bytes_per_s);
+    new_conn->set_coalescing_latency(std::chrono::microseconds(coalesce_us));
+    new_conn->set_io_reactor(next_io_reactor());
     ConnectionResult ret = new_conn->start();
     if (ret == ConnectionResult::Success) {
         return {ret, add_connection(new_conn)};
@@ -576,7 +736,9 @@ std::pair<ConnectionResult, Mavsdk::ConnectionHandle> MavsdkImpl::add_serial_con
     const std::string& dev_path,
     int baudrate,
     bool flow_control,
-    ForwardingOption forwarding_option)
+    ForwardingOption forwarding_option,
+    unsigned max_bytes_per_s,
+    unsigned coalesce_us)
 {
     auto new_conn = std::make_shared<SerialConnection>(
         [this](mavlink_message_t& message, Connection* connection) {
@@ -589,6 +751,9 @@ std::pair<ConnectionResult, Mavsdk::ConnectionHandle> MavsdkImpl::add_serial_con
     if (!new_conn) {
         return {ConnectionResult::ConnectionError, Mavsdk::ConnectionHandle{}};
     }
+    new_conn->set_max_bytes_per_s(max_bytes_per_s);
+    new_conn->set_coalescing_latency(std::chrono::microseconds(coalesce_us));
+    new_conn->set_io_reactor(next_io_reactor());
     ConnectionResult ret = new_conn->start();
     if (ret == ConnectionResult::Success) {
         auto handle = add_connection(new_conn);
@@ -608,6 +773,38 @@ std::pair<ConnectionResult, Mavsdk::ConnectionHandle> MavsdkImpl::add_serial_con
     }
 }
 
+std::pair<ConnectionResult, Mavsdk::ConnectionHandle> MavsdkImpl::add_tlog_connection(
+    const std::string& path, double speed, ForwardingOption forwarding_option)
+{
+    auto new_conn = std::make_shared<TlogConnection>(
+        [this](mavlink_message_t& message, Connection* connection) {
+            receive_message(message, connection);
+        },
+        path,
+        speed,
+        forwarding_option);
+    if (!new_conn) {
+        return {ConnectionResult::ConnectionError, Mavsdk::ConnectionHandle{}};
+    }
+    ConnectionResult ret = new_conn->start();
+    if (ret == ConnectionResult::Success) {
+        return {ret, add_connection(new_conn)};
+    } else {
+        return {ret, Mavsdk::ConnectionHandle{}};
+    }
+}
+
+IoReactor* MavsdkImpl::next_io_reactor()
+{
+#if defined(LINUX)
+    if (!_io_reactors.empty()) {
+        // Spread the connections evenly.
+        return _io_reactors[_next_io_reactor++ % _io_reactors.size()].get();
+    }
+#endif
+    return nullptr;
+}
+
 Mavsdk::ConnectionHandle
 MavsdkImpl::add_connection(const std::shared_ptr<Connection>& new_connection)
 {
@@ -627,6 +824,57 @@ void MavsdkImpl::remove_connection(Mavsdk::ConnectionHandle handle)
     }));
 }
 
+ConnectionResult
+MavsdkImpl::set_signing(Mavsdk::ConnectionHandle handle, const Mavsdk::SigningOptions& options)
+{
+    std::lock_guard<std::mutex> lock(_connections_mutex);
+
+    for (auto& entry : _connections) {
+        if (entry.handle == handle) {
+            entry.connection->set_signing(options);
+            return ConnectionResult::Success;
+        }
+    }
+    return ConnectionResult::ConnectionError;
+}
+
+ConnectionResult MavsdkImpl::clear_signing(Mavsdk::ConnectionHandle handle)
+{
+    std::lock_guard<std::mutex> lock(_connections_mutex);
+
+    for (auto& entry : _connections) {
+        if (entry.handle == handle) {
+            entry.connection->clear_signing();
+            return ConnectionResult::Success;
+        }
+    }
+    return ConnectionResult::ConnectionError;
+}
+
+std::pair<ConnectionResult, Mavsdk::ConnectionStats>
+MavsdkImpl::connection_stats(Mavsdk::ConnectionHandle handle)
+{
+    std::lock_guard<std::mutex> lock(_connections_mutex);
+
+    for (auto& entry : _connections) {
+        if (entry.handle == handle) {
+            const auto send_queue_stats = entry.connection->send_queue_stats();
+
+            Mavsdk::ConnectionStats stats;
+            stats.messages_sent = send_queue_stats.written;
+            for (const auto dropped : send_queue_stats.dropped) {
+                stats.messages_dropped += dropped;
+            }
+            stats.bytes_sent = send_queue_stats.bytes_written;
+            stats.bytes_per_s = send_queue_stats.bytes_per_s;
+            stats.max_bytes_per_s = send_queue_stats.max_bytes_per_s;
+            stats.utilization = send_queue_stats.utilization;
+            return {ConnectionResult::Success, stats};
+        }
+    }
+    return {ConnectionResult::ConnectionError, {}};
+}
+
 Mavsdk::Configuration MavsdkImpl::get_configuration() const
 {
     return _configuration;
@@ -707,6 +955,7 @@ void MavsdkImpl::make_system_with_component(uint8_t system_id, uint8_t comp_id)
     new_system->init(system_id, comp_id);
 
     _systems.emplace_back(system_id, new_system);
+    _systems_by_id[system_id] = new_system;
 }
 
 void MavsdkImpl::notify_on_discover()
@@ -748,6 +997,23 @@ bool MavsdkImpl::is_any_system_connected() const
     });
 }
 
+void MavsdkImpl::check_liveness()
+{
+    _timed_out_system_ids.clear();
+    liveness_tracker.check(_timed_out_system_ids);
+
+    for (const auto system_id : _timed_out_system_ids) {
+        std::shared_ptr<System> system;
+        {
+            std::lock_guard<std::recursive_mutex> lock(_systems_mutex);
+            system = _systems_by_id[system_id];
+        }
+        if (system != nullptr) {
+            system->system_impl()->heartbeats_timed_out();
+        }
+    }
+}
+
 void MavsdkImpl::work_thread()
 {
     while (!_should_exit) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <mutex>
 #include <utility>
@@ -10,15 +11,20 @@
 #include "call_every_handler.h"
 #include "connection.h"
 #include "handle.h"
+#include "io_reactor.h"
+#include "liveness_tracker.h"
 #include "mavsdk.h"
 #include "mavlink_include.h"
 #include "mavlink_address.h"
 #include "mavlink_message_handler.h"
 #include "mavlink_command_receiver.h"
+#include "message_packer.h"
+#include "receive_shards.h"
 #include "safe_queue.h"
 #include "server_component.h"
 #include "system.h"
 #include "timeout_handler.h"
+#include "tlog_recorder.h"
 #include "callback_list.h"
 
 namespace mavsdk {
@@ -52,23 +58,54 @@ public:
     void forward_message(mavlink_message_t& message, Connection* connection);
     void receive_message(mavlink_message_t& message, Connection* connection);
     bool send_message(mavlink_message_t& message);
+    // Same as above but packs the message straight into the send queue when
+    // there is just one connection, which is the usual case for streaming
+    // setpoints. Otherwise it's packed on the stack and sent as above.
+    bool send_message_in_place(uint32_t message_id, const MessagePacker& pack);
+
+    // Returns false while bulk messages are piling up on any connection, so
+    // bulk senders such as param or FTP transfers can hold off.
+    [[nodiscard]] bool has_bulk_capacity();
 
     std::pair<ConnectionResult, Mavsdk::ConnectionHandle>
     add_any_connection(const std::string& connection_url, ForwardingOption forwarding_option);
+    // max_bytes_per_s limits outgoing traffic on the connection, 0 for unlimited.
+    // coalesce_us packs outgoing messages into fewer writes on TCP and serial
+    // links, 0 to write each on its own.
     std::pair<ConnectionResult, Mavsdk::ConnectionHandle> add_udp_connection(
-        const std::string& local_ip, int local_port_number, ForwardingOption forwarding_option);
+        const std::string& local_ip,
+        int local_port_number,
+        ForwardingOption forwarding_option,
+        unsigned max_bytes_per_s = 0);
     std::pair<ConnectionResult, Mavsdk::ConnectionHandle> add_tcp_connection(
-        const std::string& remote_ip, int remote_port, ForwardingOption forwarding_option);
+        const std::string& remote_ip,
+        int remote_port,
+        ForwardingOption forwarding_option,
+        unsigned max_bytes_per_s = 0,
+        unsigned coalesce_us = 0);
     std::pair<ConnectionResult, Mavsdk::ConnectionHandle> add_serial_connection(
         const std::string& dev_path,
         int baudrate,
         bool flow_control,
-        ForwardingOption forwarding_option);
+        ForwardingOption forwarding_option,
+        unsigned max_bytes_per_s = 0,
+        unsigned coalesce_us = 0);
     std::pair<ConnectionResult, Mavsdk::ConnectionHandle> setup_udp_remote(
-        const std::string& remote_ip, int remote_port, ForwardingOption forwarding_option);
+        const std::string& remote_ip,
+        int remote_port,
+        ForwardingOption forwarding_option,
+        unsigned max_bytes_per_s = 0);
+    std::pair<ConnectionResult, Mavsdk::ConnectionHandle> add_tlog_connection(
+        const std::string& path, double speed, ForwardingOption forwarding_option);
 
     void remove_connection(Mavsdk::ConnectionHandle handle);
 
+    ConnectionResult
+    set_signing(Mavsdk::ConnectionHandle handle, const Mavsdk::SigningOptions& options);
+    ConnectionResult clear_signing(Mavsdk::ConnectionHandle handle);
+    std::pair<ConnectionResult, Mavsdk::ConnectionStats>
+    connection_stats(Mavsdk::ConnectionHandle handle);
+
     std::vector<std::shared_ptr<System>> systems() const;
 
     std::optional<std::shared_ptr<System>> first_autopilot(double timeout_s);
@@ -98,6 +135,7 @@ public:
 
     TimeoutHandler timeout_handler;
     CallEveryHandler call_every_handler;
+    LivenessTracker liveness_tracker;
 
     void call_user_callback_located(
         const std::string& filename, int linenumber, const std::function<void()>& func);
@@ -111,17 +149,27 @@ public:
 
 private:
     Mavsdk::ConnectionHandle add_connection(const std::shared_ptr<Connection>&);
+    // Returns nullptr if connections should receive on their own threads.
+    IoReactor* next_io_reactor();
     void make_system_with_component(uint8_t system_id, uint8_t component_id);
+    void route_message(const mavlink_message_t& message);
 
     void work_thread();
     void process_user_callbacks_thread();
 
     void send_heartbeat();
     bool is_any_system_connected() const;
+    void check_liveness();
 
     static uint8_t get_target_system_id(const mavlink_message_t& message);
     static uint8_t get_target_component_id(const mavlink_message_t& message);
 
+#if defined(LINUX)
+    // Declared before the connections, so they outlive them.
+    std::vector<std::unique_ptr<IoReactor>> _io_reactors{};
+    std::atomic<unsigned> _next_io_reactor{0};
+#endif
+
     std::mutex _connections_mutex{};
     uint64_t _connections_handle_id{1};
     struct ConnectionEntry {
@@ -132,6 +180,9 @@ private:
 
     mutable std::recursive_mutex _systems_mutex{};
     std::vector<std::pair<uint8_t, std::shared_ptr<System>>> _systems{};
+    // The same systems as above, indexed by sysid so that incoming messages
+    // can be routed directly.
+    std::array<std::shared_ptr<System>, 256> _systems_by_id{};
 
     mutable std::mutex _server_components_mutex{};
     std::vector<std::pair<uint8_t, std::shared_ptr<ServerComponent>>> _server_components{};
@@ -162,6 +213,9 @@ private:
     SafeQueue<UserCallback> _user_callback_queue{};
 
     bool _message_logging_on{false};
+
+    std::unique_ptr<TlogRecorder> _tlog_recorder{};
+    std::unique_ptr<ReceiveShards> _receive_shards{};
     bool _callback_debugging{false};
 
     mutable std::mutex _intercept_callback_mutex{};
@@ -173,6 +227,12 @@ private:
     static constexpr double HEARTBEAT_SEND_INTERVAL_S = 1.0;
     void* _heartbeat_send_cookie{nullptr};
 
+    // How late a timed out system can be noticed, on top of the timeout.
+    static constexpr double LIVENESS_CHECK_INTERVAL_S = 0.5;
+    void* _liveness_check_cookie{nullptr};
+    // Only used by check_liveness(), kept to not allocate every time.
+    std::vector<uint8_t> _timed_out_system_ids{};
+
     std::atomic<bool> _should_exit = {false};
 };
 
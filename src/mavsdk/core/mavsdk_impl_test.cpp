@@ -0,0 +1,139 @@
+#include "mavsdk_impl.h"
+#include "plugin_impl_base.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace mavsdk;
+
+namespace {
+
+// Registers a handler with its system the same way a plugin would.
+class AttitudeCounterImpl : public PluginImplBase {
+public:
+    explicit AttitudeCounterImpl(std::shared_ptr<System> system) :
+        PluginImplBase(std::move(system))
+    {}
+
+    void init() override
+    {
+        _system_impl->register_mavlink_message_handler(
+            MAVLINK_MSG_ID_ATTITUDE, [this](const mavlink_message_t&) { ++count; }, this);
+    }
+
+    void deinit() override { _system_impl->unregister_all_mavlink_message_handlers(this); }
+    void enable() override {}
+    void disable() override {}
+
+    unsigned count{0};
+};
+
+// Notes if its handler is ever entered while it is still running.
+class OverlapCheckImpl : public PluginImplBase {
+public:
+    explicit OverlapCheckImpl(std::shared_ptr<System> system) : PluginImplBase(std::move(system)) {}
+
+    void init() override
+    {
+        _system_impl->register_mavlink_message_handler(
+            MAVLINK_MSG_ID_ATTITUDE,
+            [this](const mavlink_message_t&) {
+                if (++_inside > 1) {
+                    overlapped = true;
+                }
+                // Gives another thread time to get in, if it could.
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                ++count;
+                --_inside;
+            },
+            this);
+    }
+
+    void deinit() override { _system_impl->unregister_all_mavlink_message_handlers(this); }
+    void enable() override {}
+    void disable() override {}
+
+    unsigned count{0};
+    std::atomic<bool> overlapped{false};
+
+private:
+    std::atomic<unsigned> _inside{0};
+};
+
+mavlink_message_t make_attitude(uint8_t system_id)
+{
+    mavlink_message_t message;
+    mavlink_msg_attitude_pack(system_id, MAV_COMP_ID_AUTOPILOT1, &message, 0, 0, 0, 0, 0, 0, 0);
+    return message;
+}
+
+} // namespace
+
+TEST(MavsdkImpl, MessagesOnlyReachHandlersOfTheirSystem)
+{
+    MavsdkImpl mavsdk_impl;
+
+    auto message_1 = make_attitude(1);
+    auto message_2 = make_attitude(2);
+    mavsdk_impl.receive_message(message_1, nullptr);
+    mavsdk_impl.receive_message(message_2, nullptr);
+
+    auto systems = mavsdk_impl.systems();
+    ASSERT_EQ(systems.size(), 2u);
+
+    AttitudeCounterImpl counter_1(systems[0]);
+    AttitudeCounterImpl counter_2(systems[1]);
+    counter_1.init();
+    counter_2.init();
+
+    unsigned count_any = 0;
+    int cookie;
+    mavsdk_impl.mavlink_message_handler.register_one(
+        MAVLINK_MSG_ID_ATTITUDE, [&](const mavlink_message_t&) { ++count_any; }, &cookie);
+
+    mavsdk_impl.receive_message(message_1, nullptr);
+    mavsdk_impl.receive_message(message_1, nullptr);
+    mavsdk_impl.receive_message(message_2, nullptr);
+
+    EXPECT_EQ(counter_1.count, 2u);
+    EXPECT_EQ(counter_2.count, 1u);
+    // Handlers not belonging to a system still see everything.
+    EXPECT_EQ(count_any, 3u);
+
+    mavsdk_impl.mavlink_message_handler.unregister_all(&cookie);
+    counter_1.deinit();
+    counter_2.deinit();
+}
+
+TEST(MavsdkImpl, HandlersOfOneSystemAreNotCalledConcurrently)
+{
+    MavsdkImpl mavsdk_impl;
+
+    auto message = make_attitude(1);
+    mavsdk_impl.receive_message(message, nullptr);
+
+    auto systems = mavsdk_impl.systems();
+    ASSERT_EQ(systems.size(), 1u);
+
+    OverlapCheckImpl check(systems[0]);
+    check.init();
+
+    // Like two connections to the same vehicle, each on its receive thread.
+    constexpr unsigned num_messages = 200;
+    auto feed = [&mavsdk_impl]() {
+        auto attitude = make_attitude(1);
+        for (unsigned i = 0; i < num_messages; ++i) {
+            mavsdk_impl.receive_message(attitude, nullptr);
+        }
+    };
+    std::thread first(feed);
+    std::thread second(feed);
+    first.join();
+    second.join();
+
+    EXPECT_FALSE(check.overlapped);
+    EXPECT_EQ(check.count, 2 * num_messages);
+
+    check.deinit();
+}
@@ -8,3 +8,20 @@ TEST(Mavsdk, version)
     Mavsdk mavsdk;
     ASSERT_GT(mavsdk.version().size(), 5);
 }
+
+TEST(Mavsdk, ConnectionStats)
+{
+    Mavsdk mavsdk;
+    auto [result, handle] =
+        mavsdk.add_any_connection_with_handle("udp://:24540?max_bytes_per_s=4000");
+    ASSERT_EQ(result, ConnectionResult::Success);
+
+    auto [stats_result, stats] = mavsdk.connection_stats(handle);
+    EXPECT_EQ(stats_result, ConnectionResult::Success);
+    EXPECT_EQ(stats.max_bytes_per_s, 4000u);
+    EXPECT_EQ(stats.messages_dropped, 0u);
+    EXPECT_GE(stats.utilization, 0.0);
+
+    mavsdk.remove_connection(handle);
+    EXPECT_EQ(mavsdk.connection_stats(handle).first, ConnectionResult::ConnectionError);
+}
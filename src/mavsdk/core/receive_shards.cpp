@@ -0,0 +1,138 @@
+#include "receive_shards.h"
+
+#include <chrono>
+#include <utility>
+
+namespace mavsdk {
+
+ReceiveShards::ReceiveShards(unsigned num_shards, Callback callback) :
+    _callback(std::move(callback))
+{
+    for (unsigned i = 0; i < num_shards; ++i) {
+        _shards.push_back(std::make_unique<Shard>());
+    }
+
+    // Only start once all shards exist, so the vector doesn't change anymore.
+    for (auto& shard : _shards) {
+        shard->thread = std::make_unique<std::thread>(&ReceiveShards::work, this, std::ref(*shard));
+    }
+}
+
+ReceiveShards::~ReceiveShards()
+{
+    // If no one explicitly called stop before, we should at least do it.
+    stop();
+}
+
+void ReceiveShards::push(const mavlink_message_t& message)
+{
+    auto& shard = *_shards[message.sysid % _shards.size()];
+
+    if (shard.queue.try_push(message)) {
+        wake(shard);
+        return;
+    }
+
+    // Full, so wait for the thread to catch up.
+    std::unique_lock<std::mutex> lock(shard.mutex);
+    ++shard.blocked_pushers;
+    while (!shard.queue.try_push(message)) {
+        if (_should_exit) {
+            --shard.blocked_pushers;
+            return;
+        }
+        const unsigned popped = shard.popped;
+        // The timeout is just a safety net, the thread can pop the last
+        // message before it sees us blocked, but it has a full queue to go.
+        shard.space_cv.wait_for(lock, std::chrono::milliseconds(10), [&shard, popped, this]() {
+            return shard.popped != popped || _should_exit;
+        });
+    }
+    --shard.blocked_pushers;
+    lock.unlock();
+
+    wake(shard);
+}
+
+void ReceiveShards::stop()
+{
+    _should_exit = true;
+
+    for (auto& shard : _shards) {
+        {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            shard->waiting = false;
+        }
+        shard->cv.notify_one();
+        shard->space_cv.notify_all();
+    }
+
+    for (auto& shard : _shards) {
+        if (shard->thread) {
+            shard->thread->join();
+            shard->thread.reset();
+        }
+    }
+}
+
+void ReceiveShards::wake(Shard& shard)
+{
+    // Only take the lock if the thread is actually waiting, which it only
+    // does once its queue was empty.
+    if (shard.waiting.exchange(false)) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.cv.notify_one();
+    }
+}
+
+void ReceiveShards::made_space(Shard& shard)
+{
+    // Pushers only block when the queue is full, so this is usually just a
+    // load.
+    if (shard.blocked_pushers > 0) {
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            ++shard.popped;
+        }
+        shard.space_cv.notify_all();
+    }
+}
+
+void ReceiveShards::work(Shard& shard)
+{
+    mavlink_message_t message;
+
+    while (!_should_exit) {
+        while (shard.queue.try_pop(message)) {
+            made_space(shard);
+            _callback(message);
+        }
+
+        std::unique_lock<std::mutex> lock(shard.mutex);
+        shard.waiting = true;
+
+        // Something might have been pushed before we were marked as waiting,
+        // in which case no one is going to wake us.
+        if (shard.queue.try_pop(message)) {
+            shard.waiting = false;
+            lock.unlock();
+            made_space(shard);
+            _callback(message);
+            continue;
+        }
+
+        // The timeout is just a safety net, we should always be woken up.
+        shard.cv.wait_for(lock, std::chrono::milliseconds(100), [&shard, this]() {
+            return !shard.waiting || _should_exit;
+        });
+        shard.waiting = false;
+    }
+
+    // Process whatever is left.
+    while (shard.queue.try_pop(message)) {
+        made_space(shard);
+        _callback(message);
+    }
+}
+
+} // namespace mavsdk
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "lock_free_ring.h"
+#include "mavlink_include.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mavsdk {
+
+// Processes received messages on several threads.
+//
+// Messages are assigned to a thread by their sysid, so the messages of one
+// system are always processed in order by the same thread, while the ones
+// of different systems can be processed in parallel.
+//
+// If a thread can't keep up and its queue is full, pushing blocks until
+// there is space again, so no messages are lost.
+class ReceiveShards {
+public:
+    using Callback = std::function<void(const mavlink_message_t&)>;
+
+    ReceiveShards(unsigned num_shards, Callback callback);
+    ~ReceiveShards();
+
+    void push(const mavlink_message_t& message);
+
+    // Processes what is queued already and stops the threads. Messages
+    // pushed afterwards are dropped.
+    void stop();
+
+    [[nodiscard]] unsigned num_shards() const { return static_cast<unsigned>(_shards.size()); }
+
+    // Non-copyable
+    ReceiveShards(const ReceiveShards&) = delete;
+    const ReceiveShards& operator=(const ReceiveShards&) = delete;
+
+private:
+    static constexpr std::size_t QUEUE_SIZE = 1024;
+
+    struct Shard {
+        LockFreeRing<mavlink_message_t, QUEUE_SIZE> queue{};
+        std::mutex mutex{};
+        std::condition_variable cv{};
+        std::atomic<bool> waiting{false};
+        // Pushers waiting for space, woken whenever a message is taken out.
+        std::condition_variable space_cv{};
+        std::atomic<unsigned> blocked_pushers{0};
+        unsigned popped{0};
+        std::unique_ptr<std::thread> thread{};
+    };
+
+    void work(Shard& shard);
+    static void wake(Shard& shard);
+    static void made_space(Shard& shard);
+
+    const Callback _callback;
+    std::vector<std::unique_ptr<Shard>> _shards{};
+    std::atomic<bool> _should_exit{false};
+};
+
+} // namespace mavsdk
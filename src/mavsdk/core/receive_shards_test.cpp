@@ -0,0 +1,116 @@
+#include "receive_shards.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace mavsdk;
+
+static mavlink_message_t make_message(uint8_t system_id, uint8_t seq)
+{
+    mavlink_message_t message{};
+    message.sysid = system_id;
+    message.seq = seq;
+    return message;
+}
+
+TEST(ReceiveShards, KeepsOrderPerSystem)
+{
+    std::mutex mutex;
+    std::map<uint8_t, std::vector<uint8_t>> received;
+
+    {
+        ReceiveShards shards(4, [&](const mavlink_message_t& message) {
+            std::lock_guard<std::mutex> lock(mutex);
+            received[message.sysid].push_back(message.seq);
+        });
+
+        // More than fits into the queues, so pushing needs to wait at times.
+        for (unsigned i = 0; i < 10000; ++i) {
+            shards.push(make_message(static_cast<uint8_t>(1 + i % 10), static_cast<uint8_t>(i)));
+        }
+        shards.stop();
+    }
+
+    ASSERT_EQ(received.size(), 10u);
+    for (const auto& [system_id, seqs] : received) {
+        ASSERT_EQ(seqs.size(), 1000u);
+        for (unsigned i = 0; i < seqs.size(); ++i) {
+            EXPECT_EQ(seqs[i], static_cast<uint8_t>(system_id - 1 + i * 10)) << int(system_id);
+        }
+    }
+}
+
+TEST(ReceiveShards, ProcessesSystemsOnSeparateThreads)
+{
+    std::mutex mutex;
+    std::map<uint8_t, std::thread::id> thread_ids;
+
+    ReceiveShards shards(2, [&](const mavlink_message_t& message) {
+        std::lock_guard<std::mutex> lock(mutex);
+        thread_ids[message.sysid] = std::this_thread::get_id();
+    });
+
+    shards.push(make_message(1, 0));
+    shards.push(make_message(2, 0));
+    shards.push(make_message(3, 0));
+    shards.stop();
+
+    ASSERT_EQ(thread_ids.size(), 3u);
+    EXPECT_NE(thread_ids[1], thread_ids[2]);
+    EXPECT_EQ(thread_ids[1], thread_ids[3]);
+    EXPECT_NE(thread_ids[1], std::this_thread::get_id());
+}
+
+TEST(ReceiveShards, DropsAfterStop)
+{
+    unsigned count = 0;
+
+    ReceiveShards shards(1, [&](const mavlink_message_t&) { ++count; });
+    shards.stop();
+
+    // Must not block even if more is pushed than fits.
+    for (unsigned i = 0; i < 2000; ++i) {
+        shards.push(make_message(1, 0));
+    }
+
+    EXPECT_EQ(count, 0u);
+}
+
+TEST(ReceiveShards, BlocksPushersOfFullShard)
+{
+    std::atomic<unsigned> count{0};
+    std::atomic<bool> blocked{true};
+
+    ReceiveShards shards(1, [&](const mavlink_message_t&) {
+        while (blocked) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        ++count;
+    });
+
+    // Several connections push to the same shard at once, while its thread
+    // is held up.
+    std::vector<std::thread> pushers;
+    for (uint8_t seq = 0; seq < 4; ++seq) {
+        pushers.emplace_back([&shards, seq]() {
+            for (unsigned i = 0; i < 1000; ++i) {
+                shards.push(make_message(1, seq));
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(count, 0u);
+    blocked = false;
+
+    for (auto& pusher : pushers) {
+        pusher.join();
+    }
+    shards.stop();
+
+    EXPECT_EQ(count, 4000u);
+}
@@ -0,0 +1,354 @@
+#include "send_queue.h"
+#include "log.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace mavsdk {
+
+namespace {
+
+// Enough for a couple of full messages, and the bucket doesn't take longer
+// than 100 ms to fill, so a link that has been idle only gets a short burst.
+double bucket_size(unsigned max_bytes_per_s)
+{
+    return std::max(2.0 * MAVLINK_MAX_PACKET_LEN, max_bytes_per_s / 10.0);
+}
+
+} // namespace
+
+SendQueue::SendQueue(WriteFunction write_function) : _write_function(std::move(write_function))
+{
+    for (std::size_t i = 0; i < NUM_PRIORITIES; ++i) {
+        _queues[i].slots.resize(QUEUE_SIZES[i] + 1);
+    }
+}
+
+SendQueue::~SendQueue()
+{
+    // If no one explicitly called stop before, we should at least do it.
+    stop();
+}
+
+void SendQueue::start()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _should_exit = false;
+    }
+    _write_thread = std::make_unique<std::thread>(&SendQueue::write_thread, this);
+}
+
+void SendQueue::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _should_exit = true;
+    }
+    _cv.notify_all();
+
+    if (_write_thread) {
+        _write_thread->join();
+        _write_thread.reset();
+
+        const auto dropped = stats().dropped;
+        if (const auto total = dropped[0] + dropped[1] + dropped[2]; total > 0) {
+            LogWarn() << "Dropped " << total << " outgoing messages because the queue was full";
+        }
+    }
+}
+
+bool SendQueue::push(const mavlink_message_t& message)
+{
+    return emplace(message.msgid, [&message](mavlink_message_t& slot) {
+        slot = message;
+        return true;
+    });
+}
+
+void SendQueue::set_max_bytes_per_s(unsigned max_bytes_per_s)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stats.max_bytes_per_s = max_bytes_per_s;
+        _tokens = bucket_size(max_bytes_per_s);
+        _last_refill = std::chrono::steady_clock::now();
+    }
+    _cv.notify_all();
+}
+
+void SendQueue::set_coalescing(
+    std::chrono::microseconds latency, WriteBytesFunction write_bytes_function)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _coalescing_latency = latency;
+    _write_bytes_function = std::move(write_bytes_function);
+    _batch.reserve(COALESCING_BUFFER_SIZE);
+}
+
+void SendQueue::set_signing(MavlinkSigning* signing)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _signing = signing;
+}
+
+bool SendQueue::has_room(Priority priority) const
+{
+    const auto index = static_cast<unsigned>(priority);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _queues[index].queued() < QUEUE_SIZES[index] / 2;
+}
+
+SendQueue::Stats SendQueue::stats() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto stats = _stats;
+
+    // Otherwise the rate would be stuck at the last one measured while nothing
+    // is written.
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - _rate_window_start;
+    if (elapsed.count() >= 1.0) {
+        stats.bytes_per_s = static_cast<double>(_rate_window_bytes) / elapsed.count();
+    }
+
+    if (stats.max_bytes_per_s > 0) {
+        stats.utilization = stats.bytes_per_s / stats.max_bytes_per_s;
+    }
+    return stats;
+}
+
+mavlink_message_t* SendQueue::free_slot(unsigned priority)
+{
+    if (_should_exit) {
+        return nullptr;
+    }
+
+    auto& queue = _queues[priority];
+    if (queue.queued() >= QUEUE_SIZES[priority]) {
+        ++_stats.dropped[priority];
+        return nullptr;
+    }
+    return &queue.slots[(queue.first + queue.size) % queue.slots.size()];
+}
+
+void SendQueue::commit_slot(unsigned priority)
+{
+    auto& queue = _queues[priority];
+    ++queue.size;
+    _stats.max_queued[priority] = std::max(_stats.max_queued[priority], queue.queued());
+}
+
+mavlink_message_t* SendQueue::front(unsigned& priority)
+{
+    for (priority = 0; priority < NUM_PRIORITIES; ++priority) {
+        auto& queue = _queues[priority];
+        if (queue.size > 0) {
+            return &queue.slots[queue.first];
+        }
+    }
+    return nullptr;
+}
+
+void SendQueue::pop(unsigned priority)
+{
+    auto& queue = _queues[priority];
+    queue.first = (queue.first + 1) % queue.slots.size();
+    --queue.size;
+}
+
+void SendQueue::refill_tokens(std::chrono::steady_clock::time_point now)
+{
+    const std::chrono::duration<double> elapsed = now - _last_refill;
+    _last_refill = now;
+    _tokens = std::min(
+        bucket_size(_stats.max_bytes_per_s),
+        _tokens + elapsed.count() * _stats.max_bytes_per_s);
+}
+
+void SendQueue::update_rate(std::chrono::steady_clock::time_point now, unsigned bytes)
+{
+    const std::chrono::duration<double> elapsed = now - _rate_window_start;
+    if (elapsed.count() >= 1.0) {
+        _stats.bytes_per_s = static_cast<double>(_rate_window_bytes) / elapsed.count();
+        _rate_window_start = now;
+        _rate_window_bytes = 0;
+    }
+    _rate_window_bytes += bytes;
+}
+
+void SendQueue::write_thread()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _rate_window_start = std::chrono::steady_clock::now();
+
+    while (true) {
+        unsigned priority = 0;
+        auto* next = front(priority);
+        const auto now = std::chrono::steady_clock::now();
+
+        if (next == nullptr) {
+            if (_batch_messages > 0) {
+                if (_should_exit || now >= _batch_deadline) {
+                    write_batch(lock, now);
+                } else {
+                    _cv.wait_until(lock, _batch_deadline);
+                }
+                continue;
+            }
+            if (_should_exit) {
+                // Only once everything that was queued is written.
+                break;
+            }
+            _cv.wait(lock);
+            continue;
+        }
+
+        // Signing appends the signature, which the rate limit already needs
+        // to account for.
+        const bool sign = _signing != nullptr && _signing->is_enabled();
+        const unsigned bytes =
+            mavlink_msg_get_send_buffer_length(next) + (sign ? MAVLINK_SIGNATURE_BLOCK_LEN : 0);
+
+        if (_batch_messages > 0 && _batch.size() + bytes > COALESCING_BUFFER_SIZE) {
+            write_batch(lock, now);
+            continue;
+        }
+
+        // When stopping, what is left is written without waiting.
+        if (_stats.max_bytes_per_s > 0 && !_should_exit) {
+            refill_tokens(now);
+            if (_tokens < bytes) {
+                if (_batch_messages > 0) {
+                    // No point in holding on to it while we wait.
+                    write_batch(lock, now);
+                    continue;
+                }
+                // Check again afterwards: something more urgent might be
+                // queued by then.
+                _cv.wait_for(
+                    lock,
+                    std::chrono::duration<double>((bytes - _tokens) / _stats.max_bytes_per_s));
+                continue;
+            }
+            _tokens -= bytes;
+        }
+
+        if (!_write_bytes_function) {
+            // Don't hold up anyone queueing while we sign and write. The
+            // message stays in its slot until popped, so it can be written
+            // from there.
+            _queues[priority].writing = true;
+            lock.unlock();
+            const bool success = (!sign || _signing->sign(*next)) && _write_function(*next);
+            lock.lock();
+            _queues[priority].writing = false;
+
+            pop(priority);
+            count_write(success, 1, bytes, now);
+            continue;
+        }
+
+        if (_batch_messages == 0) {
+            _batch_deadline = now + _coalescing_latency;
+        }
+
+        bool signed_ok = true;
+        if (sign) {
+            // Same as above, only the writer thread touches the batch.
+            _queues[priority].writing = true;
+            lock.unlock();
+            signed_ok = _signing->sign(*next);
+            if (signed_ok) {
+                append_to_batch(*next);
+            }
+            lock.lock();
+            _queues[priority].writing = false;
+        } else {
+            append_to_batch(*next);
+        }
+        pop(priority);
+
+        if (!signed_ok) {
+            ++_stats.write_failed;
+            continue;
+        }
+        ++_batch_messages;
+
+        if (priority == static_cast<unsigned>(Priority::Control) || now >= _batch_deadline) {
+            write_batch(lock, now);
+        }
+    }
+}
+
+void SendQueue::append_to_batch(const mavlink_message_t& message)
+{
+    const auto offset = _batch.size();
+    _batch.resize(offset + mavlink_msg_get_send_buffer_length(&message));
+    _batch.resize(offset + mavlink_msg_to_send_buffer(&_batch[offset], &message));
+}
+
+void SendQueue::write_batch(
+    std::unique_lock<std::mutex>& lock, std::chrono::steady_clock::time_point now)
+{
+    // Don't hold up anyone queueing while we write.
+    lock.unlock();
+    const bool success = _write_bytes_function(_batch.data(), _batch.size());
+    lock.lock();
+
+    count_write(success, _batch_messages, static_cast<unsigned>(_batch.size()), now);
+    _batch.clear();
+    _batch_messages = 0;
+}
+
+void SendQueue::count_write(
+    bool success, uint64_t messages, unsigned bytes, std::chrono::steady_clock::time_point now)
+{
+    ++_stats.write_calls;
+    if (success) {
+        _stats.written += messages;
+        _stats.bytes_written += bytes;
+        update_rate(now, bytes);
+    } else {
+        _stats.write_failed += messages;
+    }
+}
+
+SendQueue::Priority SendQueue::priority_for(uint32_t message_id)
+{
+    switch (message_id) {
+        // A late setpoint or heartbeat is as bad as a lost one.
+        case MAVLINK_MSG_ID_HEARTBEAT:
+        case MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED:
+        case MAVLINK_MSG_ID_SET_POSITION_TARGET_GLOBAL_INT:
+        case MAVLINK_MSG_ID_SET_ATTITUDE_TARGET:
+        case MAVLINK_MSG_ID_SET_ACTUATOR_CONTROL_TARGET:
+        case MAVLINK_MSG_ID_MANUAL_CONTROL:
+        case MAVLINK_MSG_ID_RC_CHANNELS_OVERRIDE:
+            return Priority::Control;
+
+        // Transfers of many messages which are retried anyway.
+        case MAVLINK_MSG_ID_PARAM_VALUE:
+        case MAVLINK_MSG_ID_PARAM_SET:
+        case MAVLINK_MSG_ID_PARAM_REQUEST_READ:
+        case MAVLINK_MSG_ID_PARAM_REQUEST_LIST:
+        case MAVLINK_MSG_ID_PARAM_EXT_VALUE:
+        case MAVLINK_MSG_ID_PARAM_EXT_SET:
+        case MAVLINK_MSG_ID_PARAM_EXT_REQUEST_READ:
+        case MAVLINK_MSG_ID_PARAM_EXT_REQUEST_LIST:
+        case MAVLINK_MSG_ID_MISSION_ITEM:
+        case MAVLINK_MSG_ID_MISSION_ITEM_INT:
+        case MAVLINK_MSG_ID_MISSION_REQUEST:
+        case MAVLINK_MSG_ID_MISSION_REQUEST_INT:
+        case MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL:
+        case MAVLINK_MSG_ID_LOG_REQUEST_DATA:
+        case MAVLINK_MSG_ID_LOG_DATA:
+            return Priority::Bulk;
+
+        default:
+            return Priority::Normal;
+    }
+}
+
+} // namespace mavsdk
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "mavlink_include.h"
+#include "mavlink_signing.h"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mavsdk {
+
+// Outbound queue of a connection, drained by its own writer thread.
+//
+// Senders only have to queue a message, so a slow or blocking write, e.g.
+// to a serial port at 57600 baud, doesn't hold up anyone else. Messages are
+// written by priority: control setpoints and heartbeats first and bulk
+// transfers such as params, missions, FTP and logs last. Within one priority
+// the order is kept.
+//
+// Order across priorities is not kept: a message can be overtaken by any
+// message of a higher priority which is queued after it. For instance, a
+// PARAM_SET (bulk) can be written after a COMMAND_LONG (normal) that was sent
+// later. Senders which depend on the order of two messages need to wait for
+// the first one to be acknowledged before sending the second.
+//
+// Each priority has a bounded queue, allocated upfront so queueing doesn't
+// allocate. If it's full, the message is dropped and counted. Messages can be
+// packed straight into their slot with emplace(), and they are serialized
+// straight from there, without copying them out first.
+//
+// Optionally, writing is limited to a number of bytes per second using a
+// token bucket, so a slow radio link isn't saturated by what it can't carry.
+//
+// Also optionally, consecutive messages are packed into one write within a
+// latency budget, to save syscalls when streaming at high rates. Control
+// messages are written right away, together with whatever is packed before
+// them.
+//
+// If the connection signs its messages, they are signed by the writer thread
+// just before they are written. Signing them when they are queued would give
+// a message which overtakes others a newer timestamp than theirs, and the
+// receiver would drop them as replays.
+class SendQueue {
+public:
+    using WriteFunction = std::function<bool(const mavlink_message_t&)>;
+    using WriteBytesFunction = std::function<bool(const uint8_t* data, std::size_t length)>;
+
+    enum class Priority : unsigned {
+        Control = 0,
+        Normal = 1,
+        Bulk = 2,
+    };
+    static constexpr std::size_t NUM_PRIORITIES = 3;
+
+    struct Stats {
+        uint64_t written{0};
+        uint64_t write_failed{0};
+        // Calls of the write function, so written / write_calls is the
+        // number of messages per syscall.
+        uint64_t write_calls{0};
+        std::array<uint64_t, NUM_PRIORITIES> dropped{};
+        std::array<std::size_t, NUM_PRIORITIES> max_queued{};
+        uint64_t bytes_written{0};
+        // Measured over roughly the last second.
+        double bytes_per_s{0.0};
+        // Fraction of max_bytes_per_s used, 0 if unlimited.
+        double utilization{0.0};
+        unsigned max_bytes_per_s{0};
+    };
+
+    explicit SendQueue(WriteFunction write_function);
+    ~SendQueue();
+
+    void start();
+
+    // Writes whatever is queued and stops the writer thread.
+    void stop();
+
+    // Returns false if the message had to be dropped or the queue is stopped.
+    bool push(const mavlink_message_t& message);
+
+    // Same as push() but calls pack with the slot the message goes into, to
+    // pack it there instead of copying it in. If pack returns false, the
+    // message is not queued after all. pack is called with the lock held, so
+    // it needs to be quick, e.g. one of the mavlink_msg_*_pack functions.
+    template<typename Pack> bool emplace(uint32_t message_id, const Pack& pack)
+    {
+        const auto index = static_cast<unsigned>(priority_for(message_id));
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto* slot = free_slot(index);
+            if (slot == nullptr || !pack(*slot)) {
+                return false;
+            }
+            commit_slot(index);
+        }
+
+        _cv.notify_one();
+        return true;
+    }
+
+    // Limits writing to this many bytes per second, 0 for unlimited.
+    void set_max_bytes_per_s(unsigned max_bytes_per_s);
+
+    // Packs messages into one write of at most COALESCING_BUFFER_SIZE bytes,
+    // and waits up to latency for more to arrive. Needs to be set before
+    // start().
+    void set_coalescing(std::chrono::microseconds latency, WriteBytesFunction write_bytes_function);
+
+    // Signs messages as they are written, while signing is enabled. Needs to
+    // be set before start() and to outlive the queue.
+    void set_signing(MavlinkSigning* signing);
+
+    // Returns false once the queue for this priority is half full, so bulk
+    // senders can hold off before messages get dropped.
+    [[nodiscard]] bool has_room(Priority priority) const;
+
+    [[nodiscard]] Stats stats() const;
+
+    static Priority priority_for(uint32_t message_id);
+
+    static constexpr std::array<std::size_t, NUM_PRIORITIES> QUEUE_SIZES{64, 256, 256};
+    static constexpr std::size_t COALESCING_BUFFER_SIZE = 2048;
+
+    // Non-copyable
+    SendQueue(const SendQueue&) = delete;
+    const SendQueue& operator=(const SendQueue&) = delete;
+
+private:
+    void write_thread();
+    void write_batch(std::unique_lock<std::mutex>& lock, std::chrono::steady_clock::time_point now);
+    // Only called by the writer thread.
+    void append_to_batch(const mavlink_message_t& message);
+
+    // Returns nullptr and counts the drop if the queue is full.
+    // Assumes to have the lock for _mutex.
+    mavlink_message_t* free_slot(unsigned priority);
+    // Assumes to have the lock for _mutex.
+    void commit_slot(unsigned priority);
+    // Assumes to have the lock for _mutex.
+    mavlink_message_t* front(unsigned& priority);
+    // Assumes to have the lock for _mutex.
+    void pop(unsigned priority);
+    // Assumes to have the lock for _mutex.
+    void refill_tokens(std::chrono::steady_clock::time_point now);
+    // Assumes to have the lock for _mutex.
+    void update_rate(std::chrono::steady_clock::time_point now, unsigned bytes);
+    // Assumes to have the lock for _mutex.
+    void count_write(
+        bool success,
+        uint64_t messages,
+        unsigned bytes,
+        std::chrono::steady_clock::time_point now);
+
+    const WriteFunction _write_function;
+    WriteBytesFunction _write_bytes_function{};
+    std::chrono::microseconds _coalescing_latency{0};
+    MavlinkSigning* _signing{nullptr};
+
+    mutable std::mutex _mutex{};
+    std::condition_variable _cv{};
+
+    struct Ring {
+        std::vector<mavlink_message_t> slots{};
+        std::size_t first{0};
+        std::size_t size{0};
+        // The front message stays in its slot while it's written, so there is
+        // one slot more than QUEUE_SIZES which is not counted as queued then.
+        bool writing{false};
+
+        [[nodiscard]] std::size_t queued() const { return writing ? size - 1 : size; }
+    };
+    std::array<Ring, NUM_PRIORITIES> _queues{};
+    Stats _stats{};
+    bool _should_exit{true};
+
+    double _tokens{0.0};
+    std::chrono::steady_clock::time_point _last_refill{};
+    std::chrono::steady_clock::time_point _rate_window_start{};
+    uint64_t _rate_window_bytes{0};
+
+    // Only used by the writer thread.
+    std::vector<uint8_t> _batch{};
+    uint64_t _batch_messages{0};
+    std::chrono::steady_clock::time_point _batch_deadline{};
+
+    std::unique_ptr<std::thread> _write_thread{};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,384 @@
+#include "send_queue.h"
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace mavsdk;
+
+static mavlink_message_t make_message(uint32_t message_id)
+{
+    mavlink_message_t message{};
+    message.msgid = message_id;
+    return message;
+}
+
+// Lets the test hold up writing, like a slow serial port would.
+class BlockingWriter {
+public:
+    bool write(const mavlink_message_t& message)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _writing = true;
+        _cv.notify_all();
+        _cv.wait(lock, [this]() { return !_blocked; });
+        _written.push_back(message.msgid);
+        _written_messages.push_back(message);
+        return true;
+    }
+
+    void block()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _blocked = true;
+        _writing = false;
+    }
+
+    void wait_until_writing()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.wait(lock, [this]() { return _writing; });
+    }
+
+    void unblock()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _blocked = false;
+        }
+        _cv.notify_all();
+    }
+
+    std::vector<uint32_t> written()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _written;
+    }
+
+    std::vector<mavlink_message_t> written_messages()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _written_messages;
+    }
+
+private:
+    std::mutex _mutex{};
+    std::condition_variable _cv{};
+    bool _blocked{false};
+    bool _writing{false};
+    std::vector<uint32_t> _written{};
+    std::vector<mavlink_message_t> _written_messages{};
+};
+
+class SendQueueTest : public ::testing::Test {
+protected:
+    SendQueueTest() :
+        ::testing::Test(),
+        queue([this](const mavlink_message_t& message) { return writer.write(message); })
+    {}
+
+    BlockingWriter writer;
+    SendQueue queue;
+};
+
+TEST_F(SendQueueTest, WritesByPriority)
+{
+    queue.start();
+
+    // The first one is taken by the writer thread and held up there.
+    writer.block();
+    EXPECT_TRUE(queue.push(make_message(MAVLINK_MSG_ID_PARAM_VALUE)));
+    writer.wait_until_writing();
+
+    EXPECT_TRUE(queue.push(make_message(MAVLINK_MSG_ID_MISSION_ITEM_INT)));
+    EXPECT_TRUE(queue.push(make_message(MAVLINK_MSG_ID_COMMAND_LONG)));
+    EXPECT_TRUE(queue.push(make_message(MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED)));
+    EXPECT_TRUE(queue.push(make_message(MAVLINK_MSG_ID_ATTITUDE)));
+    EXPECT_TRUE(queue.push(make_message(MAVLINK_MSG_ID_HEARTBEAT)));
+
+    writer.unblock();
+    queue.stop();
+
+    EXPECT_EQ(
+        writer.written(),
+        (std::vector<uint32_t>{
+            MAVLINK_MSG_ID_PARAM_VALUE,
+            MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED,
+            MAVLINK_MSG_ID_HEARTBEAT,
+            MAVLINK_MSG_ID_COMMAND_LONG,
+            MAVLINK_MSG_ID_ATTITUDE,
+            MAVLINK_MSG_ID_MISSION_ITEM_INT}));
+
+    const auto stats = queue.stats();
+    EXPECT_EQ(stats.written, 6u);
+    EXPECT_EQ(stats.write_failed, 0u);
+}
+
+TEST_F(SendQueueTest, SignsInTheOrderOfWriting)
+{
+    const std::array<uint8_t, MavlinkSigning::KEY_LEN> key{
+        1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 16,
+        17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32};
+    MavlinkSigning signing;
+    signing.enable(key, 1, false);
+    MavlinkSigning receiver;
+    receiver.enable(key, 1, false);
+
+    mavlink_message_t heartbeat;
+    mavlink_msg_heartbeat_pack(
+        1,
+        MAV_COMP_ID_AUTOPILOT1,
+        &heartbeat,
+        MAV_TYPE_QUADROTOR,
+        MAV_AUTOPILOT_PX4,
+        MAV_MODE_FLAG_CUSTOM_MODE_ENABLED,
+        0,
+        MAV_STATE_ACTIVE);
+    mavlink_message_t param_set;
+    mavlink_msg_param_set_pack(
+        1,
+        MAV_COMP_ID_AUTOPILOT1,
+        &param_set,
+        1,
+        1,
+        "MPC_XY_VEL_MAX",
+        12.0f,
+        MAV_PARAM_TYPE_REAL32);
+
+    queue.set_signing(&signing);
+    queue.start();
+
+    writer.block();
+    EXPECT_TRUE(queue.push(param_set));
+    writer.wait_until_writing();
+
+    // The heartbeats overtake the params which were queued before them.
+    for (unsigned i = 0; i < 10; ++i) {
+        EXPECT_TRUE(queue.push(param_set));
+    }
+    for (unsigned i = 0; i < 10; ++i) {
+        EXPECT_TRUE(queue.push(heartbeat));
+    }
+
+    writer.unblock();
+    queue.stop();
+
+    const auto written = writer.written_messages();
+    ASSERT_EQ(written.size(), 21u);
+    EXPECT_EQ(written[1].msgid, MAVLINK_MSG_ID_HEARTBEAT);
+    EXPECT_EQ(written[20].msgid, MAVLINK_MSG_ID_PARAM_SET);
+
+    // Checked in the order they arrive, all of them need to pass.
+    for (const auto& message : written) {
+        EXPECT_TRUE(message.incompat_flags & MAVLINK_IFLAG_SIGNED);
+        EXPECT_TRUE(receiver.verify(message)) << message.msgid;
+    }
+    EXPECT_EQ(receiver.stats().accepted, 21u);
+    EXPECT_EQ(receiver.stats().bad_timestamp, 0u);
+}
+
+TEST_F(SendQueueTest, DropsWhenPriorityIsFull)
+{
+    queue.start();
+
+    writer.block();
+    EXPECT_TRUE(queue.push(make_message(MAVLINK_MSG_ID_PARAM_VALUE)));
+    writer.wait_until_writing();
+
+    const auto bulk_size = SendQueue::QUEUE_SIZES[static_cast<unsigned>(SendQueue::Priority::Bulk)];
+    for (std::size_t i = 0; i < bulk_size; ++i) {
+        EXPECT_TRUE(queue.push(make_message(MAVLINK_MSG_ID_PARAM_VALUE)));
+    }
+    EXPECT_FALSE(queue.push(make_message(MAVLINK_MSG_ID_PARAM_VALUE)));
+    EXPECT_FALSE(queue.push(make_message(MAVLINK_MSG_ID_PARAM_VALUE)));
+
+    // The other priorities are not affected.
+    EXPECT_TRUE(queue.push(make_message(MAVLINK_MSG_ID_HEARTBEAT)));
+    EXPECT_TRUE(queue.push(make_message(MAVLINK_MSG_ID_COMMAND_LONG)));
+
+    writer.unblock();
+    queue.stop();
+
+    const auto stats = queue.stats();
+    EXPECT_EQ(stats.written, bulk_size + 3);
+    EXPECT_EQ(stats.dropped[static_cast<unsigned>(SendQueue::Priority::Bulk)], 2u);
+    EXPECT_EQ(stats.dropped[static_cast<unsigned>(SendQueue::Priority::Control)], 0u);
+    EXPECT_EQ(stats.max_queued[static_cast<unsigned>(SendQueue::Priority::Bulk)], bulk_size);
+}
+
+TEST_F(SendQueueTest, RejectsWhenStopped)
+{
+    EXPECT_FALSE(queue.push(make_message(MAVLINK_MSG_ID_HEARTBEAT)));
+
+    queue.start();
+    EXPECT_TRUE(queue.push(make_message(MAVLINK_MSG_ID_HEARTBEAT)));
+    queue.stop();
+
+    EXPECT_FALSE(queue.push(make_message(MAVLINK_MSG_ID_HEARTBEAT)));
+    EXPECT_EQ(writer.written().size(), 1u);
+}
+
+TEST_F(SendQueueTest, PacksInPlace)
+{
+    queue.start();
+
+    EXPECT_TRUE(queue.emplace(MAVLINK_MSG_ID_ATTITUDE, [](mavlink_message_t& message) {
+        message = make_message(MAVLINK_MSG_ID_ATTITUDE);
+        message.seq = 42;
+        return true;
+    }));
+
+    // Not queued if packing is given up.
+    EXPECT_FALSE(queue.emplace(MAVLINK_MSG_ID_HEARTBEAT, [](mavlink_message_t& message) {
+        message = make_message(MAVLINK_MSG_ID_HEARTBEAT);
+        return false;
+    }));
+
+    queue.stop();
+
+    const auto written = writer.written_messages();
+    ASSERT_EQ(written.size(), 1u);
+    EXPECT_EQ(written[0].msgid, static_cast<uint32_t>(MAVLINK_MSG_ID_ATTITUDE));
+    EXPECT_EQ(written[0].seq, 42);
+    EXPECT_EQ(queue.stats().written, 1u);
+}
+
+TEST_F(SendQueueTest, LimitsBytesPerSecond)
+{
+    // 100 bytes each, 2000 bytes in total.
+    auto message = make_message(MAVLINK_MSG_ID_PARAM_VALUE);
+    message.len = 100 - MAVLINK_NUM_NON_PAYLOAD_BYTES;
+    ASSERT_EQ(mavlink_msg_get_send_buffer_length(&message), 100);
+
+    // A full bucket holds 1000 bytes, the rest has to wait for at least 100 ms.
+    queue.set_max_bytes_per_s(10000);
+    queue.start();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < 20; ++i) {
+        EXPECT_TRUE(queue.push(message));
+    }
+    while (queue.stats().written < 20 &&
+           std::chrono::steady_clock::now() - start < std::chrono::seconds(2)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    const auto stats = queue.stats();
+    EXPECT_EQ(stats.written, 20u);
+    EXPECT_EQ(stats.bytes_written, 2000u);
+    EXPECT_EQ(stats.max_bytes_per_s, 10000u);
+    EXPECT_GE(elapsed, std::chrono::milliseconds(90));
+
+    queue.stop();
+}
+
+TEST_F(SendQueueTest, StopsWithoutWaitingForLimit)
+{
+    // That would take 10 s.
+    queue.set_max_bytes_per_s(100);
+    queue.start();
+
+    for (unsigned i = 0; i < 100; ++i) {
+        EXPECT_TRUE(queue.push(make_message(MAVLINK_MSG_ID_ATTITUDE)));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    queue.stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+    EXPECT_EQ(writer.written().size(), 100u);
+}
+
+TEST_F(SendQueueTest, HasRoomUntilHalfFull)
+{
+    queue.start();
+
+    writer.block();
+    EXPECT_TRUE(queue.push(make_message(MAVLINK_MSG_ID_PARAM_VALUE)));
+    writer.wait_until_writing();
+
+    const auto bulk_size = SendQueue::QUEUE_SIZES[static_cast<unsigned>(SendQueue::Priority::Bulk)];
+    for (std::size_t i = 0; i < bulk_size / 2; ++i) {
+        EXPECT_TRUE(queue.has_room(SendQueue::Priority::Bulk));
+        EXPECT_TRUE(queue.push(make_message(MAVLINK_MSG_ID_PARAM_VALUE)));
+    }
+    EXPECT_FALSE(queue.has_room(SendQueue::Priority::Bulk));
+    EXPECT_TRUE(queue.has_room(SendQueue::Priority::Control));
+
+    writer.unblock();
+    queue.stop();
+    EXPECT_TRUE(queue.has_room(SendQueue::Priority::Bulk));
+}
+
+TEST(SendQueueCoalescing, PacksConsecutiveMessagesIntoOneWrite)
+{
+    std::mutex mutex;
+    std::vector<std::size_t> write_lengths;
+    SendQueue queue([](const mavlink_message_t&) { return false; });
+    queue.set_coalescing(std::chrono::seconds(10), [&](const uint8_t*, std::size_t length) {
+        std::lock_guard<std::mutex> lock(mutex);
+        write_lengths.push_back(length);
+        return true;
+    });
+    queue.start();
+
+    for (unsigned i = 0; i < 10; ++i) {
+        EXPECT_TRUE(queue.push(make_message(MAVLINK_MSG_ID_ATTITUDE)));
+    }
+
+    // Nothing is held back when stopping.
+    queue.stop();
+
+    const auto stats = queue.stats();
+    EXPECT_EQ(stats.written, 10u);
+    EXPECT_EQ(stats.write_calls, 1u);
+    ASSERT_EQ(write_lengths.size(), 1u);
+    EXPECT_EQ(write_lengths[0], 10 * MAVLINK_NUM_NON_PAYLOAD_BYTES);
+}
+
+TEST(SendQueueCoalescing, WritesControlMessagesRightAway)
+{
+    SendQueue queue([](const mavlink_message_t&) { return false; });
+    queue.set_coalescing(
+        std::chrono::seconds(10), [](const uint8_t*, std::size_t) { return true; });
+    queue.start();
+
+    EXPECT_TRUE(queue.push(make_message(MAVLINK_MSG_ID_ATTITUDE)));
+    EXPECT_TRUE(queue.push(make_message(MAVLINK_MSG_ID_HEARTBEAT)));
+
+    // Way before the latency budget runs out.
+    const auto start = std::chrono::steady_clock::now();
+    while (queue.stats().written == 0 &&
+           std::chrono::steady_clock::now() - start < std::chrono::seconds(2)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_GE(queue.stats().written, 1u);
+
+    queue.stop();
+    EXPECT_EQ(queue.stats().written, 2u);
+}
+
+TEST(SendQueueCoalescing, WritesOnceLatencyIsUsedUp)
+{
+    SendQueue queue([](const mavlink_message_t&) { return false; });
+    queue.set_coalescing(
+        std::chrono::milliseconds(20), [](const uint8_t*, std::size_t) { return true; });
+    queue.start();
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(queue.push(make_message(MAVLINK_MSG_ID_ATTITUDE)));
+    while (queue.stats().written == 0 &&
+           std::chrono::steady_clock::now() - start < std::chrono::seconds(2)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(queue.stats().written, 1u);
+    EXPECT_GE(elapsed, std::chrono::milliseconds(15));
+    EXPECT_LT(elapsed, std::chrono::seconds(1));
+
+    queue.stop();
+}
@@ -20,6 +20,10 @@ public:
     [[nodiscard]] virtual uint8_t get_own_component_id() const = 0;
     [[nodiscard]] virtual uint8_t get_system_id() const = 0;
     [[nodiscard]] virtual Autopilot autopilot() const = 0;
+
+    // Bulk transfers check this before sending the next message, so they
+    // don't flood a slow link. Senders without a send queue always have room.
+    [[nodiscard]] virtual bool has_bulk_capacity() const { return true; }
 };
 
 } // namespace mavsdk
\ No newline at end of file
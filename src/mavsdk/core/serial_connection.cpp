@@ -1,4 +1,5 @@
 #include "serial_connection.h"
+#include "io_reactor.h"
 #include "log.h"
 
 #if defined(APPLE) || defined(LINUX)
@@ -74,6 +75,9 @@ ConnectionResult SerialConnection::start()
         return ret;
     }
 
+    enable_write_coalescing(
+        [this](const uint8_t* data, std::size_t length) { return write_bytes(data, length); });
+    start_send_queue();
     start_recv_thread();
 
     return ConnectionResult::Success;
@@ -224,13 +228,36 @@ ConnectionResult SerialConnection::setup_port()
 
 void SerialConnection::start_recv_thread()
 {
+#if defined(LINUX)
+    if (_io_reactor != nullptr &&
+        _io_reactor->add(_fd, IoReactor::Events::Readable, [this]() {
+            if (!receive_once()) {
+                // Otherwise we'd be called again and again, e.g. once the
+                // device is unplugged.
+                LogErr() << "Serial port " << _serial_node << " can't be read anymore";
+                _io_reactor->remove(_fd);
+            }
+        })) {
+        return;
+    }
+#endif
     _recv_thread = std::make_unique<std::thread>(&SerialConnection::receive, this);
 }
 
 ConnectionResult SerialConnection::stop()
 {
+    // Write what is queued while the port is still open.
+    stop_send_queue();
+
     _should_exit = true;
 
+#if defined(LINUX)
+    if (_io_reactor != nullptr) {
+        // Before closing, so the port is not used anymore once it's gone.
+        _io_reactor->remove(_fd);
+    }
+#endif
+
     if (_recv_thread) {
         _recv_thread->join();
         _recv_thread.reset();
@@ -249,7 +276,7 @@ ConnectionResult SerialConnection::stop()
     return ConnectionResult::Success;
 }
 
-bool SerialConnection::send_message(const mavlink_message_t& message)
+bool SerialConnection::write_message(const mavlink_message_t& message)
 {
     if (_serial_node.empty()) {
         LogErr() << "Dev Path unknown";
@@ -264,17 +291,22 @@ bool SerialConnection::send_message(const mavlink_message_t& message)
     uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
     uint16_t buffer_len = mavlink_msg_to_send_buffer(buffer, &message);
 
+    return write_bytes(buffer, buffer_len);
+}
+
+bool SerialConnection::write_bytes(const uint8_t* data, std::size_t length)
+{
     int send_len;
 #if defined(LINUX) || defined(APPLE)
-    send_len = static_cast<int>(write(_fd, buffer, buffer_len));
+    send_len = static_cast<int>(write(_fd, data, length));
 #else
-    if (!WriteFile(_handle, buffer, buffer_len, LPDWORD(&send_len), NULL)) {
+    if (!WriteFile(_handle, data, DWORD(length), LPDWORD(&send_len), NULL)) {
         LogErr() << "WriteFile failure: " << GET_ERROR();
         return false;
     }
 #endif
 
-    if (send_len != buffer_len) {
+    if (send_len != static_cast<int>(length)) {
         LogErr() << "write failure: " << GET_ERROR();
         return false;
     }
@@ -284,9 +316,6 @@ bool SerialConnection::send_message(const mavlink_message_t& message)
 
 void SerialConnection::receive()
 {
-    // Enough for MTU 1500 bytes.
-    char buffer[2048];
-
 #if defined(LINUX) || defined(APPLE)
     struct pollfd fds[1];
     fds[0].fd = _fd;
@@ -294,7 +323,6 @@ void SerialConnection::receive()
 #endif
 
     while (!_should_exit) {
-        int recv_len;
 #if defined(LINUX) || defined(APPLE)
         int pollrc = poll(fds, 1, 1000);
         if (pollrc == 0 || !(fds[0].revents & POLLIN)) {
@@ -303,25 +331,43 @@ void SerialConnection::receive()
             LogErr() << "read poll failure: " << GET_ERROR();
         }
         // We enter here if (fds[0].revents & POLLIN) == true
-        recv_len = static_cast<int>(read(_fd, buffer, sizeof(buffer)));
-        if (recv_len < -1) {
-            LogErr() << "read failure: " << GET_ERROR();
-        }
+#endif
+        receive_once();
+    }
+}
+
+bool SerialConnection::receive_once()
+{
+    // Enough for MTU 1500 bytes.
+    char buffer[2048];
+
+    int recv_len;
+#if defined(LINUX) || defined(APPLE)
+    recv_len = static_cast<int>(read(_fd, buffer, sizeof(buffer)));
+    if (recv_len < 0) {
+        LogErr() << "read failure: " << GET_ERROR();
+        return false;
+    }
 #else
-        if (!ReadFile(_handle, buffer, sizeof(buffer), LPDWORD(&recv_len), NULL)) {
-            LogErr() << "ReadFile failure: " << GET_ERROR();
-            continue;
-        }
+    if (!ReadFile(_handle, buffer, sizeof(buffer), LPDWORD(&recv_len), NULL)) {
+        LogErr() << "ReadFile failure: " << GET_ERROR();
+        return false;
+    }
 #endif
-        if (recv_len > static_cast<int>(sizeof(buffer)) || recv_len == 0) {
-            continue;
-        }
-        _mavlink_receiver->set_new_datagram(buffer, recv_len);
-        // Parse all mavlink messages in one data packet. Once exhausted, we'll exit while.
-        while (_mavlink_receiver->parse_message()) {
-            receive_message(_mavlink_receiver->get_last_message(), this);
-        }
+    if (recv_len == 0) {
+        // Either a timeout or, if we were told there is something to read,
+        // the device is gone.
+        return false;
+    }
+    if (recv_len > static_cast<int>(sizeof(buffer))) {
+        return true;
     }
+    _mavlink_receiver->set_new_datagram(buffer, recv_len);
+    // Parse all mavlink messages in one data packet. Once exhausted, we'll exit while.
+    while (_mavlink_receiver->parse_message()) {
+        receive_message(_mavlink_receiver->get_last_message(), this);
+    }
+    return true;
 }
 
 #if defined(LINUX)
@@ -24,16 +24,19 @@ public:
     ConnectionResult stop() override;
     ~SerialConnection() override;
 
-    bool send_message(const mavlink_message_t& message) override;
-
     // Non-copyable
     SerialConnection(const SerialConnection&) = delete;
     const SerialConnection& operator=(const SerialConnection&) = delete;
 
 private:
+    bool write_message(const mavlink_message_t& message) override;
+    bool write_bytes(const uint8_t* data, std::size_t length);
+
     ConnectionResult setup_port();
     void start_recv_thread();
     void receive();
+    // Reads and parses once, returns false if the port can't be read.
+    bool receive_once();
 
 #if defined(LINUX)
     static int define_from_baudrate(int baudrate);
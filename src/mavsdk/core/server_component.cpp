@@ -7,4 +7,14 @@ ServerComponent::ServerComponent(MavsdkImpl& mavsdk_impl, uint8_t component_id)
     _impl(std::make_unique<ServerComponentImpl>(mavsdk_impl, component_id))
 {}
 
+void ServerComponent::set_parameter_max_messages_per_s(double max_messages_per_s)
+{
+    _impl->mavlink_parameter_server().set_max_messages_per_s(max_messages_per_s);
+}
+
+void ServerComponent::set_parameter_max_bytes_per_s(double max_bytes_per_s)
+{
+    _impl->mavlink_parameter_server().set_max_bytes_per_s(max_bytes_per_s);
+}
+
 } // namespace mavsdk
@@ -14,7 +14,7 @@ ServerComponentImpl::ServerComponentImpl(MavsdkImpl& mavsdk_impl, uint8_t compon
         mavsdk_impl.mavlink_message_handler,
         mavsdk_impl.timeout_handler,
         [this]() { return _mavsdk_impl.timeout_s(); }),
-    _mavlink_parameter_server(_our_sender, mavsdk_impl.mavlink_message_handler),
+    _mavlink_parameter_server(_our_sender, mavsdk_impl.mavlink_message_handler, mavsdk_impl.time),
     _mavlink_request_message_handler(mavsdk_impl, *this, _mavlink_command_receiver)
 {
     register_mavlink_command_handler(
@@ -377,6 +377,11 @@ uint8_t ServerComponentImpl::OurSender::get_system_id() const
     return current_target_system_id;
 }
 
+bool ServerComponentImpl::OurSender::has_bulk_capacity() const
+{
+    return _mavsdk_impl.has_bulk_capacity();
+}
+
 Sender::Autopilot ServerComponentImpl::OurSender::autopilot() const
 {
     // FIXME: hard-coded to PX4 for now to avoid the dependency into mavsdk_impl.
@@ -35,6 +35,7 @@ public:
         [[nodiscard]] uint8_t get_own_component_id() const override;
         [[nodiscard]] uint8_t get_system_id() const override;
         [[nodiscard]] Autopilot autopilot() const override;
+        [[nodiscard]] bool has_bulk_capacity() const override;
 
         uint8_t current_target_system_id{0};
 
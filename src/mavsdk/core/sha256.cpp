@@ -0,0 +1,150 @@
+#include "sha256.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace mavsdk {
+
+namespace {
+constexpr std::array<uint32_t, 64> round_constants{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+    0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+    0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+    0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+    0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+    0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+    0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+    0xc67178f2};
+
+constexpr uint32_t rotr(uint32_t value, unsigned bits)
+{
+    return (value >> bits) | (value << (32 - bits));
+}
+
+constexpr uint32_t load_be32(const uint8_t* bytes)
+{
+    return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+           (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+}
+} // namespace
+
+void Sha256::update(const uint8_t* data, std::size_t length)
+{
+    _total_len += length;
+
+    if (_buffered > 0) {
+        const std::size_t to_copy = std::min(length, BLOCK_LEN - _buffered);
+        std::memcpy(&_buffer[_buffered], data, to_copy);
+        _buffered += to_copy;
+        data += to_copy;
+        length -= to_copy;
+
+        if (_buffered < BLOCK_LEN) {
+            return;
+        }
+        compress(_buffer.data());
+        _buffered = 0;
+    }
+
+    while (length >= BLOCK_LEN) {
+        compress(data);
+        data += BLOCK_LEN;
+        length -= BLOCK_LEN;
+    }
+
+    if (length > 0) {
+        std::memcpy(_buffer.data(), data, length);
+        _buffered = length;
+    }
+}
+
+std::array<uint8_t, Sha256::DIGEST_LEN> Sha256::finalize()
+{
+    const uint64_t total_bits = _total_len * 8;
+
+    _buffer[_buffered++] = 0x80;
+    if (_buffered > BLOCK_LEN - 8) {
+        std::memset(&_buffer[_buffered], 0, BLOCK_LEN - _buffered);
+        compress(_buffer.data());
+        _buffered = 0;
+    }
+    std::memset(&_buffer[_buffered], 0, BLOCK_LEN - 8 - _buffered);
+    for (unsigned i = 0; i < 8; ++i) {
+        _buffer[BLOCK_LEN - 1 - i] = static_cast<uint8_t>(total_bits >> (8 * i));
+    }
+    compress(_buffer.data());
+
+    std::array<uint8_t, DIGEST_LEN> digest;
+    for (unsigned i = 0; i < _state.size(); ++i) {
+        digest[4 * i] = static_cast<uint8_t>(_state[i] >> 24);
+        digest[4 * i + 1] = static_cast<uint8_t>(_state[i] >> 16);
+        digest[4 * i + 2] = static_cast<uint8_t>(_state[i] >> 8);
+        digest[4 * i + 3] = static_cast<uint8_t>(_state[i]);
+    }
+
+    reset();
+    return digest;
+}
+
+void Sha256::compress(const uint8_t* block)
+{
+    // The message schedule is kept as a rolling window of 16 words instead of
+    // all 64, which keeps it in registers and the cache.
+    std::array<uint32_t, 16> w;
+    for (unsigned i = 0; i < 16; ++i) {
+        w[i] = load_be32(block + 4 * i);
+    }
+
+    uint32_t a = _state[0];
+    uint32_t b = _state[1];
+    uint32_t c = _state[2];
+    uint32_t d = _state[3];
+    uint32_t e = _state[4];
+    uint32_t f = _state[5];
+    uint32_t g = _state[6];
+    uint32_t h = _state[7];
+
+    for (unsigned i = 0; i < 64; ++i) {
+        if (i >= 16) {
+            const uint32_t w15 = w[(i - 15) & 15];
+            const uint32_t w2 = w[(i - 2) & 15];
+            const uint32_t s0 = rotr(w15, 7) ^ rotr(w15, 18) ^ (w15 >> 3);
+            const uint32_t s1 = rotr(w2, 17) ^ rotr(w2, 19) ^ (w2 >> 10);
+            w[i & 15] += s0 + w[(i - 7) & 15] + s1;
+        }
+
+        const uint32_t sum1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+        const uint32_t choose = (e & f) ^ (~e & g);
+        const uint32_t temp1 = h + sum1 + choose + round_constants[i] + w[i & 15];
+        const uint32_t sum0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+        const uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+        const uint32_t temp2 = sum0 + majority;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+    }
+
+    _state[0] += a;
+    _state[1] += b;
+    _state[2] += c;
+    _state[3] += d;
+    _state[4] += e;
+    _state[5] += f;
+    _state[6] += g;
+    _state[7] += h;
+}
+
+void Sha256::reset()
+{
+    *this = Sha256{};
+}
+
+} // namespace mavsdk
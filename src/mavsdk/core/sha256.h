@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace mavsdk {
+
+// SHA-256 as used for MAVLink 2 message signing.
+//
+// Full blocks are compressed straight from the input, only what's left over
+// is copied, so hashing a message in a few parts doesn't cost more than
+// hashing it in one go.
+class Sha256 {
+public:
+    static constexpr std::size_t DIGEST_LEN = 32;
+
+    void update(const uint8_t* data, std::size_t length);
+
+    // Pads and returns the hash. Afterwards, it starts over.
+    std::array<uint8_t, DIGEST_LEN> finalize();
+
+private:
+    static constexpr std::size_t BLOCK_LEN = 64;
+
+    void compress(const uint8_t* block);
+    void reset();
+
+    std::array<uint32_t, 8> _state{
+        0x6a09e667,
+        0xbb67ae85,
+        0x3c6ef372,
+        0xa54ff53a,
+        0x510e527f,
+        0x9b05688c,
+        0x1f83d9ab,
+        0x5be0cd19};
+    std::array<uint8_t, BLOCK_LEN> _buffer{};
+    std::size_t _buffered{0};
+    uint64_t _total_len{0};
+};
+
+} // namespace mavsdk
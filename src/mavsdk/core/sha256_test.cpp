@@ -0,0 +1,70 @@
+#include "sha256.h"
+#include <gtest/gtest.h>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+using namespace mavsdk;
+
+namespace {
+std::string to_hex(const std::array<uint8_t, Sha256::DIGEST_LEN>& digest)
+{
+    std::stringstream ss;
+    for (const auto byte : digest) {
+        ss << std::hex << std::setw(2) << std::setfill('0') << static_cast<unsigned>(byte);
+    }
+    return ss.str();
+}
+
+std::string hash(const std::string& input)
+{
+    Sha256 sha256;
+    sha256.update(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+    return to_hex(sha256.finalize());
+}
+} // namespace
+
+TEST(Sha256, KnownDigests)
+{
+    EXPECT_EQ(hash(""), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    EXPECT_EQ(hash("abc"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    EXPECT_EQ(
+        hash("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+        "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+    EXPECT_EQ(
+        hash(std::string(1000, 'a')),
+        "41edece42d63e8d9bf515a9ba6932e1c20cbc9f5a5d134645adb5db1b9737ea3");
+}
+
+TEST(Sha256, SameInPartsAsAtOnce)
+{
+    std::string input;
+    for (unsigned i = 0; i < 300; ++i) {
+        input.push_back(static_cast<char>(i * 7));
+    }
+    const auto expected = hash(input);
+
+    // Split in all kinds of ways, across block boundaries.
+    for (std::size_t first = 0; first < input.size(); first += 13) {
+        for (std::size_t second = first; second < input.size(); second += 29) {
+            Sha256 sha256;
+            const auto* data = reinterpret_cast<const uint8_t*>(input.data());
+            sha256.update(data, first);
+            sha256.update(data + first, second - first);
+            sha256.update(data + second, input.size() - second);
+            EXPECT_EQ(to_hex(sha256.finalize()), expected);
+        }
+    }
+}
+
+TEST(Sha256, StartsOverAfterFinalize)
+{
+    Sha256 sha256;
+    sha256.update(reinterpret_cast<const uint8_t*>("xyz"), 3);
+    sha256.finalize();
+
+    sha256.update(reinterpret_cast<const uint8_t*>("abc"), 3);
+    EXPECT_EQ(
+        to_hex(sha256.finalize()),
+        "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+}
@@ -28,11 +28,11 @@ SystemImpl::SystemImpl(MavsdkImpl& parent) :
     _ping(*this),
     _mission_transfer(
         *this,
-        _mavsdk_impl.mavlink_message_handler,
+        _mavlink_message_handler,
         _mavsdk_impl.timeout_handler,
         [this]() { return timeout_s(); }),
     _request_message(
-        *this, _command_sender, _mavsdk_impl.mavlink_message_handler, _mavsdk_impl.timeout_handler),
+        *this, _command_sender, _mavlink_message_handler, _mavsdk_impl.timeout_handler),
     _mavlink_ftp(*this)
 {
     _system_thread = new std::thread(&SystemImpl::system_thread, this);
@@ -41,9 +41,7 @@ SystemImpl::SystemImpl(MavsdkImpl& parent) :
 SystemImpl::~SystemImpl()
 {
     _should_exit = true;
-    _mavsdk_impl.mavlink_message_handler.unregister_all(this);
-
-    unregister_timeout_handler(_heartbeat_timeout_cookie);
+    _mavlink_message_handler.unregister_all(this);
 
     if (_system_thread != nullptr) {
         _system_thread->join();
@@ -58,17 +56,17 @@ void SystemImpl::init(uint8_t system_id, uint8_t comp_id)
     // We use this as a default.
     _target_address.component_id = MAV_COMP_ID_AUTOPILOT1;
 
-    _mavsdk_impl.mavlink_message_handler.register_one(
+    _mavlink_message_handler.register_one(
         MAVLINK_MSG_ID_HEARTBEAT,
         [this](const mavlink_message_t& message) { process_heartbeat(message); },
         this);
 
-    _mavsdk_impl.mavlink_message_handler.register_one(
+    _mavlink_message_handler.register_one(
         MAVLINK_MSG_ID_STATUSTEXT,
         [this](const mavlink_message_t& message) { process_statustext(message); },
         this);
 
-    _mavsdk_impl.mavlink_message_handler.register_one(
+    _mavlink_message_handler.register_one(
         MAVLINK_MSG_ID_AUTOPILOT_VERSION,
         [this](const mavlink_message_t& message) { process_autopilot_version(message); },
         this);
@@ -91,6 +89,11 @@ void SystemImpl::init(uint8_t system_id, uint8_t comp_id)
     add_new_component(comp_id);
 }
 
+void SystemImpl::process_mavlink_message(const mavlink_message_t& message)
+{
+    _mavlink_message_handler.process_message(message);
+}
+
 bool SystemImpl::is_connected() const
 {
     return _connected;
@@ -99,29 +102,35 @@ bool SystemImpl::is_connected() const
 void SystemImpl::register_mavlink_message_handler(
     uint16_t msg_id, const MavlinkMessageHandler& callback, const void* cookie)
 {
-    _mavsdk_impl.mavlink_message_handler.register_one(msg_id, callback, cookie);
+    _mavlink_message_handler.register_one(msg_id, callback, cookie);
 }
 
 void SystemImpl::register_mavlink_message_handler(
     uint16_t msg_id, uint8_t cmp_id, const MavlinkMessageHandler& callback, const void* cookie)
 {
-    _mavsdk_impl.mavlink_message_handler.register_one(msg_id, cmp_id, callback, cookie);
+    _mavlink_message_handler.register_one(msg_id, cmp_id, callback, cookie);
+}
+
+void SystemImpl::register_mavlink_message_handler_for_all(
+    const MavlinkMessageHandler& callback, const void* cookie)
+{
+    _mavlink_message_handler.register_all(callback, cookie);
 }
 
 void SystemImpl::unregister_mavlink_message_handler(uint16_t msg_id, const void* cookie)
 {
-    _mavsdk_impl.mavlink_message_handler.unregister_one(msg_id, cookie);
+    _mavlink_message_handler.unregister_one(msg_id, cookie);
 }
 
 void SystemImpl::unregister_all_mavlink_message_handlers(const void* cookie)
 {
-    _mavsdk_impl.mavlink_message_handler.unregister_all(cookie);
+    _mavlink_message_handler.unregister_all(cookie);
 }
 
 void SystemImpl::update_componentid_messages_handler(
     uint16_t msg_id, uint8_t cmp_id, const void* cookie)
 {
-    _mavsdk_impl.mavlink_message_handler.update_component_id(msg_id, cmp_id, cookie);
+    _mavlink_message_handler.update_component_id(msg_id, cmp_id, cookie);
 }
 
 void SystemImpl::register_timeout_handler(
@@ -234,7 +243,11 @@ void SystemImpl::process_heartbeat(const mavlink_message_t& message)
             to_flight_mode_from_custom_mode(_autopilot, _vehicle_type, heartbeat.custom_mode);
     }
 
-    set_connected();
+    // Timing out is up to the liveness check of MavsdkImpl.
+    _mavsdk_impl.liveness_tracker.heartbeat(message.sysid, message.compid);
+    if (!_connected) {
+        set_connected();
+    }
 }
 
 void SystemImpl::process_statustext(const mavlink_message_t& message)
@@ -367,9 +380,15 @@ void SystemImpl::add_new_component(uint8_t component_id)
         return;
     }
 
-    auto res_pair = _components.insert(component_id);
-    if (res_pair.second) {
-        std::lock_guard<std::mutex> lock(_component_discovered_callback_mutex);
+    // This is the case for almost every message.
+    if (_components.contains(component_id)) {
+        return;
+    }
+
+    // Subscribing queues the known components with the same lock held, so
+    // a new component is either reported there or here but not twice.
+    std::lock_guard<std::mutex> lock(_component_discovered_callback_mutex);
+    if (_components.insert(component_id)) {
         _component_discovered_callbacks.queue(
             component_type(component_id), [this](const auto& func) { call_user_callback(func); });
         _component_discovered_id_callbacks.queue(
@@ -393,7 +412,7 @@ SystemImpl::subscribe_component_discovered(const System::ComponentDiscoveredCall
     const auto handle = _component_discovered_callbacks.subscribe(callback);
 
     if (total_components() > 0) {
-        for (const auto& elem : _components) {
+        for (const auto elem : _components.ids()) {
             _component_discovered_callbacks.queue(
                 component_type(elem), [this](const auto& func) { call_user_callback(func); });
         }
@@ -414,7 +433,7 @@ SystemImpl::subscribe_component_discovered_id(const System::ComponentDiscoveredI
     const auto handle = _component_discovered_id_callbacks.subscribe(callback);
 
     if (total_components() > 0) {
-        for (const auto& elem : _components) {
+        for (const auto elem : _components.ids()) {
             _component_discovered_id_callbacks.queue(
                 component_type(elem), elem, [this](const auto& func) { call_user_callback(func); });
         }
@@ -453,15 +472,12 @@ bool SystemImpl::has_camera(int camera_id) const
     int camera_comp_id = (camera_id == -1) ? camera_id : (MAV_COMP_ID_CAMERA + camera_id);
 
     if (camera_comp_id == -1) { // Check whether the system has any camera.
-        if (std::any_of(_components.begin(), _components.end(), is_camera)) {
+        const auto component_ids = _components.ids();
+        if (std::any_of(component_ids.begin(), component_ids.end(), is_camera)) {
             return true;
         }
     } else { // Look for the camera whose id is `camera_id`.
-        for (auto compid : _components) {
-            if (compid == camera_comp_id) {
-                return true;
-            }
-        }
+        return _components.contains(static_cast<uint8_t>(camera_comp_id));
     }
     return false;
 }
@@ -476,6 +492,16 @@ bool SystemImpl::send_message(mavlink_message_t& message)
     return _mavsdk_impl.send_message(message);
 }
 
+bool SystemImpl::send_message_in_place(uint32_t message_id, const MessagePacker& pack)
+{
+    return _mavsdk_impl.send_message_in_place(message_id, pack);
+}
+
+bool SystemImpl::has_bulk_capacity() const
+{
+    return _mavsdk_impl.has_bulk_capacity();
+}
+
 void SystemImpl::send_autopilot_version_request()
 {
     auto prom = std::promise<MavlinkCommandSender::Result>();
@@ -562,20 +588,11 @@ void SystemImpl::set_connected()
                 _mavsdk_impl.start_sending_heartbeats();
             });
 
-            register_timeout_handler(
-                [this] { heartbeats_timed_out(); },
-                HEARTBEAT_TIMEOUT_S,
-                &_heartbeat_timeout_cookie);
-
             enable_needed = true;
 
             _is_connected_callbacks.queue(
                 true, [this](const auto& func) { _mavsdk_impl.call_user_callback(func); });
-
-        } else if (_connected) {
-            refresh_timeout_handler(_heartbeat_timeout_cookie);
         }
-        // If not yet connected there is nothing to do/
     }
     if (enable_needed) {
         if (has_autopilot()) {
@@ -594,11 +611,6 @@ void SystemImpl::set_disconnected()
     {
         std::lock_guard<std::mutex> lock(_connection_mutex);
 
-        // This might not be needed because this is probably called from the triggered
-        // timeout anyway, but it should also do no harm.
-        // unregister_timeout_handler(_heartbeat_timeout_cookie);
-        //_heartbeat_timeout_cookie = nullptr;
-
         _connected = false;
         _mavsdk_impl.notify_on_timeout();
         _is_connected_callbacks.queue(
@@ -622,7 +634,7 @@ uint8_t SystemImpl::get_system_id() const
 
 std::vector<uint8_t> SystemImpl::component_ids() const
 {
-    return std::vector<uint8_t>{_components.begin(), _components.end()};
+    return _components.ids();
 }
 
 void SystemImpl::set_system_id(uint8_t system_id)
@@ -1094,10 +1106,9 @@ void SystemImpl::receive_int_param(
 
 uint8_t SystemImpl::get_autopilot_id() const
 {
-    for (auto compid : _components)
-        if (compid == MavlinkCommandSender::DEFAULT_COMPONENT_ID_AUTOPILOT) {
-            return compid;
-        }
+    if (_components.contains(MavlinkCommandSender::DEFAULT_COMPONENT_ID_AUTOPILOT)) {
+        return MavlinkCommandSender::DEFAULT_COMPONENT_ID_AUTOPILOT;
+    }
     // FIXME: Not sure what should be returned if autopilot is not found
     return uint8_t(0);
 }
@@ -1106,7 +1117,7 @@ std::vector<uint8_t> SystemImpl::get_camera_ids() const
 {
     std::vector<uint8_t> camera_ids{};
 
-    for (auto compid : _components)
+    for (auto compid : _components.ids())
         if (compid >= MAV_COMP_ID_CAMERA && compid <= MAV_COMP_ID_CAMERA6) {
             camera_ids.push_back(compid);
         }
@@ -1115,10 +1126,9 @@ std::vector<uint8_t> SystemImpl::get_camera_ids() const
 
 uint8_t SystemImpl::get_gimbal_id() const
 {
-    for (auto compid : _components)
-        if (compid == MAV_COMP_ID_GIMBAL) {
-            return compid;
-        }
+    if (_components.contains(MAV_COMP_ID_GIMBAL)) {
+        return MAV_COMP_ID_GIMBAL;
+    }
     return uint8_t(0);
 }
 
@@ -1330,7 +1340,7 @@ MavlinkParameterClient* SystemImpl::param_sender(uint8_t component_id, bool exte
     _mavlink_parameter_clients.push_back(
         {std::make_unique<MavlinkParameterClient>(
              *this,
-             _mavsdk_impl.mavlink_message_handler,
+             _mavlink_message_handler,
              _mavsdk_impl.timeout_handler,
              [this]() { return timeout_s(); },
              component_id,
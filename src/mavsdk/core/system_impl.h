@@ -1,6 +1,7 @@
 #pragma once
 
 #include "callback_list.h"
+#include "component_set.h"
 #include "flight_mode.h"
 #include "mavlink_address.h"
 #include "mavlink_include.h"
@@ -11,6 +12,7 @@
 #include "mavlink_mission_transfer.h"
 #include "mavlink_request_message_handler.h"
 #include "mavlink_statustext_handler.h"
+#include "message_packer.h"
 #include "request_message.h"
 #include "ardupilot_custom_mode.h"
 #include "ping.h"
@@ -22,7 +24,6 @@
 #include <functional>
 #include <atomic>
 #include <vector>
-#include <unordered_set>
 #include <unordered_map>
 #include <thread>
 #include <mutex>
@@ -47,7 +48,8 @@ public:
     System::IsConnectedHandle subscribe_is_connected(const System::IsConnectedCallback& callback);
     void unsubscribe_is_connected(System::IsConnectedHandle handle);
 
-    // void process_mavlink_message(mavlink_message_t& message);
+    // Passes a message of this system to the handlers registered with it.
+    void process_mavlink_message(const mavlink_message_t& message);
 
     using MavlinkMessageHandler = std::function<void(const mavlink_message_t&)>;
 
@@ -55,6 +57,8 @@ public:
         uint16_t msg_id, const MavlinkMessageHandler& callback, const void* cookie);
     void register_mavlink_message_handler(
         uint16_t msg_id, uint8_t cmp_id, const MavlinkMessageHandler& callback, const void* cookie);
+    void register_mavlink_message_handler_for_all(
+        const MavlinkMessageHandler& callback, const void* cookie);
 
     void unregister_mavlink_message_handler(uint16_t msg_id, const void* cookie);
     void unregister_all_mavlink_message_handlers(const void* cookie);
@@ -76,6 +80,10 @@ public:
     void unregister_statustext_handler(void* cookie);
 
     bool send_message(mavlink_message_t& message) override;
+    // Packs the message straight into the send queue if possible, for
+    // messages which are streamed at high rates such as setpoints.
+    bool send_message_in_place(uint32_t message_id, const MessagePacker& pack);
+    bool has_bulk_capacity() const override;
 
     Autopilot autopilot() const override { return _autopilot; };
 
@@ -263,6 +271,9 @@ public:
 
     bool is_connected() const;
 
+    // Called by MavsdkImpl once no heartbeats came in for a while.
+    void heartbeats_timed_out();
+
     Time& get_time();
     AutopilotTime& get_autopilot_time() { return _autopilot_time; };
 
@@ -298,7 +309,6 @@ private:
     void process_heartbeat(const mavlink_message_t& message);
     void process_autopilot_version(const mavlink_message_t& message);
     void process_statustext(const mavlink_message_t& message);
-    void heartbeats_timed_out();
     void set_connected();
     void set_disconnected();
 
@@ -362,15 +372,17 @@ private:
 
     MavsdkImpl& _mavsdk_impl;
 
+    // Only messages from our system ID end up here, so the cost of dispatching
+    // does not depend on how many other systems there are. It needs to outlive
+    // the members below which unregister in their destructors.
+    mavsdk::MavlinkMessageHandler _mavlink_message_handler{};
+
     std::thread* _system_thread{nullptr};
     std::atomic<bool> _should_exit{false};
 
-    static constexpr double HEARTBEAT_TIMEOUT_S = 3.0;
-
     std::mutex _connection_mutex{};
     std::atomic<bool> _connected{false};
     CallbackList<bool> _is_connected_callbacks{};
-    void* _heartbeat_timeout_cookie = nullptr;
 
     std::atomic<bool> _autopilot_version_pending{false};
 
@@ -395,8 +407,8 @@ private:
     std::mutex _plugin_impls_mutex{};
     std::vector<PluginImplBase*> _plugin_impls{};
 
-    // We used set to maintain unique component ids
-    std::unordered_set<uint8_t> _components{};
+    // This is checked for every incoming message, so it needs to be cheap.
+    ComponentSet _components{};
 
     std::mutex _param_changed_callbacks_mutex{};
     std::unordered_map<const void*, ParamChangedCallback> _param_changed_callbacks{};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace mavsdk::mavsdk_server {
+
+// The system the gRPC call handled on the current thread is addressed to.
+//
+// Clients select a system by sending its id as "mavsdk-system-id" metadata.
+// Calls without it go to the first discovered system, as before.
+class SystemSelection {
+public:
+    static constexpr const char* metadata_key = "mavsdk-system-id";
+
+    // Selected when the metadata can't be parsed, it doesn't match any system.
+    static constexpr uint8_t invalid_system_id = 0;
+
+    static std::optional<uint8_t> current() { return _current; }
+    static void set(std::optional<uint8_t> system_id) { _current = system_id; }
+
+    static std::optional<uint8_t> parse(std::string_view value)
+    {
+        if (value.empty() || value.size() > 3) {
+            return std::nullopt;
+        }
+
+        unsigned system_id = 0;
+        for (const char c : value) {
+            if (c < '0' || c > '9') {
+                return std::nullopt;
+            }
+            system_id = system_id * 10 + static_cast<unsigned>(c - '0');
+        }
+
+        if (system_id == invalid_system_id || system_id > 255) {
+            return std::nullopt;
+        }
+        return static_cast<uint8_t>(system_id);
+    }
+
+private:
+    static inline thread_local std::optional<uint8_t> _current{};
+};
+
+} // namespace mavsdk::mavsdk_server
@@ -1,4 +1,5 @@
 #include "tcp_connection.h"
+#include "io_reactor.h"
 #include "log.h"
 
 #ifdef WINDOWS
@@ -11,6 +12,7 @@
 #include <arpa/inet.h>
 #include <errno.h>
 #include <netdb.h>
+#include <fcntl.h>
 #include <unistd.h> // for close()
 #endif
 
@@ -54,6 +56,9 @@ ConnectionResult TcpConnection::start()
         return ret;
     }
 
+    enable_write_coalescing(
+        [this](const uint8_t* data, std::size_t length) { return write_bytes(data, length); });
+    start_send_queue();
     start_recv_thread();
 
     return ConnectionResult::Success;
@@ -70,29 +75,24 @@ ConnectionResult TcpConnection::setup_port()
     }
 #endif
 
-    _socket_fd = socket(AF_INET, SOCK_STREAM, 0);
+    const int socket_fd = socket(AF_INET, SOCK_STREAM, 0);
 
-    if (_socket_fd < 0) {
+    if (socket_fd < 0) {
         LogErr() << "socket error" << GET_ERROR(errno);
         _is_ok = false;
         return ConnectionResult::SocketError;
     }
 
-    struct sockaddr_in remote_addr {};
-    remote_addr.sin_family = AF_INET;
-    remote_addr.sin_port = htons(_remote_port_number);
+    // When reconnecting, the previous one gets closed.
+    replace_socket(socket_fd);
 
-    struct hostent* hp;
-    hp = gethostbyname(_remote_ip.c_str());
-    if (hp == nullptr) {
-        LogErr() << "Could not get host by name";
+    struct sockaddr_in remote_addr {};
+    if (!get_remote_addr(remote_addr)) {
         _is_ok = false;
         return ConnectionResult::SocketConnectionError;
     }
 
-    memcpy(&remote_addr.sin_addr, hp->h_addr, hp->h_length);
-
-    if (connect(_socket_fd, reinterpret_cast<sockaddr*>(&remote_addr), sizeof(struct sockaddr_in)) <
+    if (connect(socket_fd, reinterpret_cast<sockaddr*>(&remote_addr), sizeof(struct sockaddr_in)) <
         0) {
         LogErr() << "connect error: " << GET_ERROR(errno);
         _is_ok = false;
@@ -103,26 +103,99 @@ ConnectionResult TcpConnection::setup_port()
     return ConnectionResult::Success;
 }
 
+void TcpConnection::replace_socket(int new_socket_fd)
+{
+    const int old_socket_fd = _socket_fd;
+    if (old_socket_fd == new_socket_fd) {
+        return;
+    }
+
+    // This makes a write that is blocked on the old socket return, so that
+    // we don't have to wait long for the lock.
+    if (old_socket_fd != -1) {
+#ifndef WINDOWS
+        shutdown(old_socket_fd, SHUT_RDWR);
+#else
+        shutdown(old_socket_fd, SD_BOTH);
+#endif
+    }
+
+    int closing_socket_fd;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        closing_socket_fd = _socket_fd.exchange(new_socket_fd);
+    }
+
+    if (closing_socket_fd == -1) {
+        return;
+    }
+
+#ifndef WINDOWS
+    // On Mac, closing is also needed to stop blocking recv/recvfrom.
+    close(closing_socket_fd);
+#else
+    closesocket(closing_socket_fd);
+#endif
+}
+
+bool TcpConnection::get_remote_addr(struct sockaddr_in& remote_addr) const
+{
+    remote_addr.sin_family = AF_INET;
+    remote_addr.sin_port = htons(_remote_port_number);
+
+    struct hostent* hp;
+    hp = gethostbyname(_remote_ip.c_str());
+    if (hp == nullptr) {
+        LogErr() << "Could not get host by name";
+        return false;
+    }
+
+    memcpy(&remote_addr.sin_addr, hp->h_addr, hp->h_length);
+    return true;
+}
+
 void TcpConnection::start_recv_thread()
 {
+#if defined(LINUX)
+    if (_io_reactor != nullptr &&
+        _io_reactor->add(
+            _socket_fd, IoReactor::Events::Readable, [this]() { receive_from_reactor(); })) {
+        return;
+    }
+#endif
     _recv_thread = std::make_unique<std::thread>(&TcpConnection::receive, this);
 }
 
 ConnectionResult TcpConnection::stop()
 {
-    _should_exit = true;
+    // Write what is queued while the port is still open.
+    stop_send_queue();
 
-#ifndef WINDOWS
-    // This should interrupt a recv/recvfrom call.
-    shutdown(_socket_fd, SHUT_RDWR);
+    _should_exit = true;
 
-    // But on Mac, closing is also needed to stop blocking recv/recvfrom.
-    close(_socket_fd);
-#else
-    shutdown(_socket_fd, SD_BOTH);
+#if defined(LINUX)
+    if (_io_reactor != nullptr) {
+        uint64_t reconnect_timer;
+        int connecting_fd;
+        {
+            // Reconnecting doesn't go any further once we have the lock.
+            std::lock_guard<std::mutex> lock(_reconnect_mutex);
+            reconnect_timer = _reconnect_timer;
+            connecting_fd = std::exchange(_connecting_fd, -1);
+        }
+        _io_reactor->cancel(reconnect_timer);
+        if (connecting_fd != -1) {
+            _io_reactor->remove(connecting_fd);
+            close(connecting_fd);
+        }
+        _io_reactor->remove(_socket_fd);
+    }
+#endif
 
-    closesocket(_socket_fd);
+    // Shutting down should interrupt a recv/recvfrom call.
+    replace_socket(-1);
 
+#ifdef WINDOWS
     WSACleanup();
 #endif
 
@@ -138,7 +211,18 @@ ConnectionResult TcpConnection::stop()
     return ConnectionResult::Success;
 }
 
-bool TcpConnection::send_message(const mavlink_message_t& message)
+bool TcpConnection::write_message(const mavlink_message_t& message)
+{
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    uint16_t buffer_len = mavlink_msg_to_send_buffer(buffer, &message);
+
+    // TODO: remove this assert again
+    assert(buffer_len <= MAVLINK_MAX_PACKET_LEN);
+
+    return write_bytes(buffer, buffer_len);
+}
+
+bool TcpConnection::write_bytes(const uint8_t* data, std::size_t length)
 {
     if (!_is_ok) {
         return false;
@@ -154,6 +238,12 @@ bool TcpConnection::send_message(const mavlink_message_t& message)
         return false;
     }
 
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_socket_fd == -1) {
+        return false;
+    }
+
     struct sockaddr_in dest_addr {};
     dest_addr.sin_family = AF_INET;
 
@@ -161,12 +251,6 @@ bool TcpConnection::send_message(const mavlink_message_t& message)
 
     dest_addr.sin_port = htons(_remote_port_number);
 
-    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
-    uint16_t buffer_len = mavlink_msg_to_send_buffer(buffer, &message);
-
-    // TODO: remove this assert again
-    assert(buffer_len <= MAVLINK_MAX_PACKET_LEN);
-
 #if !defined(MSG_NOSIGNAL)
     auto flags = 0;
 #else
@@ -175,13 +259,13 @@ bool TcpConnection::send_message(const mavlink_message_t& message)
 
     const auto send_len = sendto(
         _socket_fd,
-        reinterpret_cast<char*>(buffer),
-        buffer_len,
+        reinterpret_cast<const char*>(data),
+        length,
         flags,
         reinterpret_cast<const sockaddr*>(&dest_addr),
         sizeof(dest_addr));
 
-    if (send_len != buffer_len) {
+    if (send_len < 0 || static_cast<std::size_t>(send_len) != length) {
         LogErr() << "sendto failure: " << GET_ERROR(errno);
         _is_ok = false;
         return false;
@@ -191,41 +275,157 @@ bool TcpConnection::send_message(const mavlink_message_t& message)
 
 void TcpConnection::receive()
 {
-    // Enough for MTU 1500 bytes.
-    char buffer[2048];
-
     while (!_should_exit) {
         if (!_is_ok) {
             LogErr() << "TCP receive error, trying to reconnect...";
             std::this_thread::sleep_for(std::chrono::seconds(1));
+            if (_should_exit) {
+                break;
+            }
             setup_port();
         }
 
-        const auto recv_len = recv(_socket_fd, buffer, sizeof(buffer), 0);
+        receive_once();
+    }
+}
 
-        if (recv_len == 0) {
-            // This can happen when shutdown is called on the socket,
-            // therefore we check _should_exit again.
-            _is_ok = false;
-            continue;
-        }
+void TcpConnection::receive_once()
+{
+    // Enough for MTU 1500 bytes.
+    char buffer[2048];
 
-        if (recv_len < 0) {
-            // This happens on desctruction when close(_socket_fd) is called,
-            // therefore be quiet.
-            // LogErr() << "recvfrom error: " << GET_ERROR(errno);
-            // Something went wrong, we should try to re-connect in next iteration.
-            _is_ok = false;
-            continue;
-        }
+    const auto recv_len = recv(_socket_fd, buffer, sizeof(buffer), 0);
 
-        _mavlink_receiver->set_new_datagram(buffer, static_cast<int>(recv_len));
+    if (recv_len == 0) {
+        // This can happen when shutdown is called on the socket,
+        // therefore we check _should_exit again.
+        _is_ok = false;
+        return;
+    }
 
-        // Parse all mavlink messages in one data packet. Once exhausted, we'll exit while.
-        while (_mavlink_receiver->parse_message()) {
-            receive_message(_mavlink_receiver->get_last_message(), this);
-        }
+    if (recv_len < 0) {
+        // This happens on desctruction when close(_socket_fd) is called,
+        // therefore be quiet.
+        // LogErr() << "recvfrom error: " << GET_ERROR(errno);
+        // Something went wrong, we should try to re-connect in next iteration.
+        _is_ok = false;
+        return;
+    }
+
+    _mavlink_receiver->set_new_datagram(buffer, static_cast<int>(recv_len));
+
+    // Parse all mavlink messages in one data packet. Once exhausted, we'll exit while.
+    while (_mavlink_receiver->parse_message()) {
+        receive_message(_mavlink_receiver->get_last_message(), this);
     }
 }
 
+#if defined(LINUX)
+// With a reactor, everything below is called on its I/O thread, and
+// reconnecting doesn't block it, apart from resolving the host name.
+
+void TcpConnection::receive_from_reactor()
+{
+    receive_once();
+
+    if (!_is_ok) {
+        std::lock_guard<std::mutex> lock(_reconnect_mutex);
+        reconnect_later();
+    }
+}
+
+void TcpConnection::reconnect_later()
+{
+    if (_should_exit) {
+        return;
+    }
+
+    if (_connecting_fd != -1) {
+        _io_reactor->remove(_connecting_fd);
+        close(_connecting_fd);
+        _connecting_fd = -1;
+    }
+
+    if (_socket_fd != -1) {
+        _io_reactor->remove(_socket_fd);
+        replace_socket(-1);
+    }
+
+    LogErr() << "TCP receive error, trying to reconnect...";
+    _reconnect_timer = _io_reactor->call_after(std::chrono::seconds(1), [this]() {
+        std::lock_guard<std::mutex> lock(_reconnect_mutex);
+        start_connecting();
+    });
+}
+
+void TcpConnection::start_connecting()
+{
+    if (_should_exit) {
+        return;
+    }
+
+    struct sockaddr_in remote_addr {};
+    if (!get_remote_addr(remote_addr)) {
+        reconnect_later();
+        return;
+    }
+
+    _connecting_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (_connecting_fd < 0) {
+        LogErr() << "socket error" << GET_ERROR(errno);
+        _connecting_fd = -1;
+        reconnect_later();
+        return;
+    }
+
+    if (connect(_connecting_fd, reinterpret_cast<sockaddr*>(&remote_addr), sizeof(remote_addr)) ==
+        0) {
+        connected();
+    } else if (
+        errno != EINPROGRESS ||
+        !_io_reactor->add(_connecting_fd, IoReactor::Events::Writable, [this]() {
+            std::lock_guard<std::mutex> lock(_reconnect_mutex);
+            finish_connecting();
+        })) {
+        reconnect_later();
+    }
+}
+
+void TcpConnection::finish_connecting()
+{
+    if (_should_exit) {
+        return;
+    }
+
+    _io_reactor->remove(_connecting_fd);
+
+    int error = 0;
+    socklen_t error_len = sizeof(error);
+    if (getsockopt(_connecting_fd, SOL_SOCKET, SO_ERROR, &error, &error_len) != 0 || error != 0) {
+        reconnect_later();
+        return;
+    }
+
+    connected();
+}
+
+void TcpConnection::connected()
+{
+    // Back to blocking, so a send is never cut short.
+    fcntl(_connecting_fd, F_SETFL, fcntl(_connecting_fd, F_GETFL) & ~O_NONBLOCK);
+
+    // Only now the writer thread gets to use it.
+    replace_socket(std::exchange(_connecting_fd, -1));
+
+    if (!_io_reactor->add(
+            _socket_fd, IoReactor::Events::Readable, [this]() { receive_from_reactor(); })) {
+        reconnect_later();
+        return;
+    }
+
+    LogInfo() << "TCP reconnected to " << _remote_ip << ":" << _remote_port_number;
+    _is_ok = true;
+}
+#endif
+
 } // namespace mavsdk
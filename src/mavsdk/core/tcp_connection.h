@@ -28,26 +28,52 @@ public:
     ConnectionResult start() override;
     ConnectionResult stop() override;
 
-    bool send_message(const mavlink_message_t& message) override;
-
     // Non-copyable
     TcpConnection(const TcpConnection&) = delete;
     const TcpConnection& operator=(const TcpConnection&) = delete;
 
 private:
+    bool write_message(const mavlink_message_t& message) override;
+    bool write_bytes(const uint8_t* data, std::size_t length);
+
     ConnectionResult setup_port();
+    // Shuts down and closes the current socket once no one writes to it.
+    void replace_socket(int new_socket_fd);
+    bool get_remote_addr(struct sockaddr_in& remote_addr) const;
     void start_recv_thread();
     void receive();
+    void receive_once();
+
+#if defined(LINUX)
+    void receive_from_reactor();
+    // Assumes to have the lock for _reconnect_mutex.
+    void reconnect_later();
+    // Assumes to have the lock for _reconnect_mutex.
+    void start_connecting();
+    // Assumes to have the lock for _reconnect_mutex.
+    void finish_connecting();
+    // Assumes to have the lock for _reconnect_mutex.
+    void connected();
+#endif
 
     std::string _remote_ip = {};
     int _remote_port_number;
 
+    // The socket is replaced when reconnecting, while the send queue's
+    // writer thread might be using it. Writing holds _mutex, and the old
+    // socket is only closed once it has been swapped out under it.
     std::mutex _mutex = {};
-    int _socket_fd = -1;
+    std::atomic<int> _socket_fd{-1};
 
     std::unique_ptr<std::thread> _recv_thread{};
     std::atomic_bool _should_exit;
     std::atomic_bool _is_ok{false};
+
+    // Only used with a reactor.
+    std::mutex _reconnect_mutex{};
+    uint64_t _reconnect_timer{0};
+    // The new socket until it is connected and replaces _socket_fd.
+    int _connecting_fd{-1};
 };
 
 } // namespace mavsdk
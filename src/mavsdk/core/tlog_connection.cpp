@@ -0,0 +1,169 @@
+#include "tlog_connection.h"
+#include "log.h"
+#include "unused.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace mavsdk {
+
+TlogConnection::TlogConnection(
+    Connection::ReceiverCallback receiver_callback,
+    std::string path,
+    double speed,
+    ForwardingOption forwarding_option) :
+    Connection(std::move(receiver_callback), forwarding_option),
+    _path(std::move(path)),
+    _speed(speed)
+{}
+
+TlogConnection::~TlogConnection()
+{
+    // If no one explicitly called stop before, we should at least do it.
+    stop();
+}
+
+ConnectionResult TlogConnection::start()
+{
+    if (!start_mavlink_receiver()) {
+        return ConnectionResult::ConnectionsExhausted;
+    }
+
+    _file.open(_path, std::ios::in | std::ios::binary);
+    if (!_file) {
+        LogErr() << "Could not open " << _path << " for replay";
+        return ConnectionResult::ConnectionError;
+    }
+
+    _should_exit = false;
+    _replay_thread = std::make_unique<std::thread>(&TlogConnection::replay, this);
+
+    return ConnectionResult::Success;
+}
+
+ConnectionResult TlogConnection::stop()
+{
+    _should_exit = true;
+
+    if (_replay_thread) {
+        _replay_thread->join();
+        _replay_thread.reset();
+    }
+
+    if (_file.is_open()) {
+        _file.close();
+    }
+
+    // We need to stop this after stopping the replay thread, otherwise
+    // it can happen that we interfere with the parsing of a message.
+    stop_mavlink_receiver();
+
+    return ConnectionResult::Success;
+}
+
+bool TlogConnection::write_message(const mavlink_message_t& message)
+{
+    // There is no one on the other end of a log, so anything sent is dropped.
+    // We still report success, otherwise each attempt would be flagged as error.
+    UNUSED(message);
+    return true;
+}
+
+void TlogConnection::replay()
+{
+    char frame[MAVLINK_MAX_PACKET_LEN];
+    unsigned frame_len = 0;
+    uint64_t timestamp_us = 0;
+
+    uint64_t first_timestamp_us = 0;
+    SteadyTimePoint start_time{};
+    bool first = true;
+    uint64_t count = 0;
+
+    while (!_should_exit) {
+        if (!read_frame(timestamp_us, frame, frame_len)) {
+            break;
+        }
+
+        if (first) {
+            first_timestamp_us = timestamp_us;
+            start_time = _time.steady_time();
+            first = false;
+        }
+
+        // Timestamps can go backwards when the clock of the recording
+        // machine was adjusted, in which case we just don't wait.
+        if (_speed > 0.0 && timestamp_us > first_timestamp_us) {
+            const auto offset = std::chrono::duration<double, std::micro>(
+                static_cast<double>(timestamp_us - first_timestamp_us) / _speed);
+            wait_until(start_time + std::chrono::duration_cast<std::chrono::microseconds>(offset));
+        }
+
+        _mavlink_receiver->set_new_datagram(frame, frame_len);
+        while (_mavlink_receiver->parse_message()) {
+            receive_message(_mavlink_receiver->get_last_message(), this);
+        }
+        ++count;
+    }
+
+    LogInfo() << "Replay of " << _path << " done after " << count << " messages";
+}
+
+bool TlogConnection::read_frame(uint64_t& timestamp_us, char* frame, unsigned& frame_len)
+{
+    unsigned char timestamp[8];
+    if (!_file.read(reinterpret_cast<char*>(timestamp), sizeof(timestamp))) {
+        return false;
+    }
+
+    timestamp_us = 0;
+    for (const auto byte : timestamp) {
+        timestamp_us = (timestamp_us << 8) | byte;
+    }
+
+    // Read the start of the header to find out how long the frame is.
+    if (!_file.read(frame, 3)) {
+        return false;
+    }
+
+    const auto magic = static_cast<uint8_t>(frame[0]);
+    const auto payload_len = static_cast<uint8_t>(frame[1]);
+
+    if (magic == MAVLINK_STX) {
+        frame_len = 1 + MAVLINK_CORE_HEADER_LEN + payload_len + MAVLINK_NUM_CHECKSUM_BYTES;
+        if ((static_cast<uint8_t>(frame[2]) & MAVLINK_IFLAG_SIGNED) != 0) {
+            frame_len += MAVLINK_SIGNATURE_BLOCK_LEN;
+        }
+    } else if (magic == MAVLINK_STX_MAVLINK1) {
+        frame_len =
+            1 + MAVLINK_CORE_HEADER_MAVLINK1_LEN + payload_len + MAVLINK_NUM_CHECKSUM_BYTES;
+    } else {
+        LogErr() << "Invalid frame in " << _path << " at " << _file.tellg();
+        return false;
+    }
+
+    if (!_file.read(frame + 3, frame_len - 3)) {
+        LogWarn() << "Truncated frame at the end of " << _path;
+        return false;
+    }
+
+    return true;
+}
+
+void TlogConnection::wait_until(const SteadyTimePoint& time_point)
+{
+    // Sleep in small steps, so that we can still stop quickly when there is
+    // a long gap in the log.
+    while (!_should_exit) {
+        const auto now = _time.steady_time();
+        if (now >= time_point) {
+            return;
+        }
+        _time.sleep_for(std::min(
+            std::chrono::duration_cast<std::chrono::microseconds>(time_point - now),
+            std::chrono::microseconds(100000)));
+    }
+}
+
+} // namespace mavsdk
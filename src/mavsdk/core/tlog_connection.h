@@ -0,0 +1,50 @@
+#pragma once
+
+#include "connection.h"
+#include "mavsdk_time.h"
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace mavsdk {
+
+// Replays a telemetry log (tlog) as if the messages were coming in live.
+//
+// With a speed of 1 the messages are paced according to their recorded
+// timestamps, with a speed of N they are played N times faster, and with a
+// speed of 0 they are played as fast as they can be processed.
+class TlogConnection : public Connection {
+public:
+    explicit TlogConnection(
+        Connection::ReceiverCallback receiver_callback,
+        std::string path,
+        double speed,
+        ForwardingOption forwarding_option = ForwardingOption::ForwardingOff);
+    ConnectionResult start() override;
+    ConnectionResult stop() override;
+    ~TlogConnection() override;
+
+    // Non-copyable
+    TlogConnection(const TlogConnection&) = delete;
+    const TlogConnection& operator=(const TlogConnection&) = delete;
+
+private:
+    bool write_message(const mavlink_message_t& message) override;
+
+    void replay();
+    bool read_frame(uint64_t& timestamp_us, char* frame, unsigned& frame_len);
+    void wait_until(const SteadyTimePoint& time_point);
+
+    const std::string _path;
+    const double _speed;
+
+    std::ifstream _file{};
+    Time _time{};
+
+    std::unique_ptr<std::thread> _replay_thread{};
+    std::atomic_bool _should_exit{false};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,113 @@
+#include "tlog_connection.h"
+#include "tlog_recorder.h"
+#include "fs.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace mavsdk;
+
+class TlogConnectionTest : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        auto maybe_tmp_dir = create_tmp_directory("mavsdk-tlog-connection-test");
+        ASSERT_TRUE(maybe_tmp_dir);
+        _path = maybe_tmp_dir.value() + path_separator + "replay.tlog";
+    }
+
+    // Records messages with time_boot_ms 0 to NUM_MESSAGES - 1, GAP apart.
+    void record()
+    {
+        TlogRecorder recorder(_path);
+        ASSERT_TRUE(recorder.start());
+
+        for (uint32_t i = 0; i < NUM_MESSAGES; ++i) {
+            if (i > 0) {
+                std::this_thread::sleep_for(GAP);
+            }
+            mavlink_message_t message;
+            mavlink_msg_attitude_pack(1, MAV_COMP_ID_AUTOPILOT1, &message, i, 0, 0, 0, 0, 0, 0);
+            recorder.record(message);
+        }
+
+        recorder.stop();
+        EXPECT_EQ(recorder.dropped(), 0u);
+    }
+
+    // Returns how long it took from the first to the last message.
+    std::chrono::steady_clock::duration replay(double speed)
+    {
+        std::mutex mutex;
+        std::vector<uint32_t> received;
+        std::chrono::steady_clock::time_point first{};
+        std::chrono::steady_clock::time_point last{};
+
+        TlogConnection connection(
+            [&](mavlink_message_t& message, Connection*) {
+                std::lock_guard<std::mutex> lock(mutex);
+                last = std::chrono::steady_clock::now();
+                if (received.empty()) {
+                    first = last;
+                }
+                received.push_back(mavlink_msg_attitude_get_time_boot_ms(&message));
+            },
+            _path,
+            speed);
+        EXPECT_EQ(connection.start(), ConnectionResult::Success);
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (std::chrono::steady_clock::now() < deadline) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (received.size() >= NUM_MESSAGES) {
+                    break;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        connection.stop();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_EQ(received.size(), NUM_MESSAGES);
+        for (uint32_t i = 0; i < received.size(); ++i) {
+            EXPECT_EQ(received[i], i);
+        }
+        return last - first;
+    }
+
+    static constexpr uint32_t NUM_MESSAGES = 5;
+    static constexpr std::chrono::milliseconds GAP{50};
+    // The recording takes at least this long from the first to the last one.
+    static constexpr std::chrono::milliseconds RECORDED{(NUM_MESSAGES - 1) * GAP.count()};
+
+    std::string _path;
+};
+
+TEST_F(TlogConnectionTest, ReplaysAtRecordedPace)
+{
+    record();
+
+    const auto elapsed = replay(1.0);
+    // Allow for the timer resolution.
+    EXPECT_GE(elapsed, RECORDED - std::chrono::milliseconds(5));
+}
+
+TEST_F(TlogConnectionTest, ReplaysFaster)
+{
+    record();
+
+    const auto elapsed = replay(4.0);
+    EXPECT_GE(elapsed, RECORDED / 4 - std::chrono::milliseconds(5));
+    EXPECT_LT(elapsed, RECORDED);
+}
+
+TEST_F(TlogConnectionTest, ReplaysWithoutPacingAtSpeedZero)
+{
+    record();
+
+    const auto elapsed = replay(0.0);
+    EXPECT_LT(elapsed, RECORDED / 4);
+}
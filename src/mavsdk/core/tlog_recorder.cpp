@@ -0,0 +1,104 @@
+#include "tlog_recorder.h"
+#include "log.h"
+
+#include <chrono>
+#include <utility>
+
+namespace mavsdk {
+
+TlogRecorder::TlogRecorder(std::string path) : _path(std::move(path)) {}
+
+TlogRecorder::~TlogRecorder()
+{
+    // If no one explicitly called stop before, we should at least do it.
+    stop();
+}
+
+bool TlogRecorder::start()
+{
+    _file.open(_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!_file) {
+        LogErr() << "Could not open " << _path << " for recording";
+        return false;
+    }
+
+    _ring = std::make_unique<LockFreeRing<Frame, RING_SIZE>>();
+    _should_exit = false;
+    _write_thread = std::make_unique<std::thread>(&TlogRecorder::write_thread, this);
+
+    LogInfo() << "Recording MAVLink to " << _path;
+    return true;
+}
+
+void TlogRecorder::stop()
+{
+    _should_exit = true;
+
+    if (_write_thread) {
+        _write_thread->join();
+        _write_thread.reset();
+    }
+
+    if (_file.is_open()) {
+        _file.close();
+    }
+
+    if (_dropped > 0) {
+        LogWarn() << "Dropped " << _dropped << " frames while recording";
+    }
+}
+
+void TlogRecorder::record(const mavlink_message_t& message)
+{
+    if (!_ring || _should_exit) {
+        return;
+    }
+
+    Frame frame;
+    frame.timestamp_us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count());
+    frame.len = mavlink_msg_to_send_buffer(frame.data.data(), &message);
+
+    if (!_ring->try_push(frame)) {
+        ++_dropped;
+    }
+}
+
+void TlogRecorder::write_thread()
+{
+    Frame frame;
+    while (!_should_exit) {
+        bool wrote_any = false;
+        while (_ring->try_pop(frame)) {
+            write_frame(frame);
+            wrote_any = true;
+        }
+
+        if (wrote_any) {
+            _file.flush();
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    // Write whatever is left.
+    while (_ring->try_pop(frame)) {
+        write_frame(frame);
+    }
+    _file.flush();
+}
+
+void TlogRecorder::write_frame(const Frame& frame)
+{
+    char timestamp[8];
+    for (unsigned i = 0; i < sizeof(timestamp); ++i) {
+        timestamp[i] = static_cast<char>((frame.timestamp_us >> (56 - 8 * i)) & 0xff);
+    }
+
+    _file.write(timestamp, sizeof(timestamp));
+    _file.write(reinterpret_cast<const char*>(frame.data.data()), frame.len);
+}
+
+} // namespace mavsdk
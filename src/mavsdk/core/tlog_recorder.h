@@ -0,0 +1,61 @@
+#pragma once
+
+#include "lock_free_ring.h"
+#include "mavlink_include.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace mavsdk {
+
+// Records MAVLink frames to a telemetry log (tlog) file.
+//
+// Each frame is prefixed with the time it was recorded in us since epoch
+// as big-endian uint64, as done by QGroundControl and MAVProxy, so the
+// files can be opened with either and replayed using a tlog:// connection.
+//
+// Frames are handed over to a background thread via a lock-free ring so
+// that the receive and send paths never block on file I/O. If the writer
+// can't keep up, frames are dropped and counted.
+class TlogRecorder {
+public:
+    explicit TlogRecorder(std::string path);
+    ~TlogRecorder();
+
+    bool start();
+    void stop();
+
+    void record(const mavlink_message_t& message);
+
+    [[nodiscard]] uint64_t dropped() const { return _dropped; }
+
+    // Non-copyable
+    TlogRecorder(const TlogRecorder&) = delete;
+    const TlogRecorder& operator=(const TlogRecorder&) = delete;
+
+private:
+    struct Frame {
+        uint64_t timestamp_us{0};
+        uint16_t len{0};
+        std::array<uint8_t, MAVLINK_MAX_PACKET_LEN> data{};
+    };
+
+    void write_thread();
+    void write_frame(const Frame& frame);
+
+    static constexpr std::size_t RING_SIZE = 1024;
+
+    const std::string _path;
+    std::ofstream _file{};
+
+    std::unique_ptr<LockFreeRing<Frame, RING_SIZE>> _ring{};
+    std::unique_ptr<std::thread> _write_thread{};
+    std::atomic_bool _should_exit{false};
+    std::atomic<uint64_t> _dropped{0};
+};
+
+} // namespace mavsdk
@@ -1,4 +1,5 @@
 #include "udp_connection.h"
+#include "io_reactor.h"
 #include "log.h"
 
 #ifdef WINDOWS
@@ -54,6 +55,7 @@ ConnectionResult UdpConnection::start()
         return ret;
     }
 
+    start_send_queue();
     start_recv_thread();
 
     return ConnectionResult::Success;
@@ -91,13 +93,30 @@ ConnectionResult UdpConnection::setup_port()
 
 void UdpConnection::start_recv_thread()
 {
+#if defined(LINUX)
+    if (_io_reactor != nullptr &&
+        _io_reactor->add(
+            _socket_fd, IoReactor::Events::Readable, [this]() { receive_datagram(); })) {
+        return;
+    }
+#endif
     _recv_thread = std::make_unique<std::thread>(&UdpConnection::receive, this);
 }
 
 ConnectionResult UdpConnection::stop()
 {
+    // Write what is queued while the port is still open.
+    stop_send_queue();
+
     _should_exit = true;
 
+#if defined(LINUX)
+    if (_io_reactor != nullptr) {
+        // Before closing, so the socket is not used anymore once it's gone.
+        _io_reactor->remove(_socket_fd);
+    }
+#endif
+
 #ifndef WINDOWS
     // This should interrupt a recv/recvfrom call.
     shutdown(_socket_fd, SHUT_RDWR);
@@ -124,7 +143,7 @@ ConnectionResult UdpConnection::stop()
     return ConnectionResult::Success;
 }
 
-bool UdpConnection::send_message(const mavlink_message_t& message)
+bool UdpConnection::write_message(const mavlink_message_t& message)
 {
     std::lock_guard<std::mutex> lock(_remote_mutex);
 
@@ -133,6 +152,10 @@ bool UdpConnection::send_message(const mavlink_message_t& message)
         return false;
     }
 
+    // The same bytes go to every remote.
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t buffer_len = mavlink_msg_to_send_buffer(buffer, &message);
+
     // Send the message to all the remotes. A remote is a UDP endpoint
     // identified by its <ip, port>. This means that if we have two
     // systems on two different endpoints, then messages directed towards
@@ -142,13 +165,9 @@ bool UdpConnection::send_message(const mavlink_message_t& message)
     for (auto& remote : _remotes) {
         struct sockaddr_in dest_addr {};
         dest_addr.sin_family = AF_INET;
-
-        inet_pton(AF_INET, remote.ip.c_str(), &dest_addr.sin_addr.s_addr);
+        dest_addr.sin_addr.s_addr = remote.address;
         dest_addr.sin_port = htons(remote.port_number);
 
-        uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
-        uint16_t buffer_len = mavlink_msg_to_send_buffer(buffer, &message);
-
         const auto send_len = sendto(
             _socket_fd,
             reinterpret_cast<char*>(buffer),
@@ -179,6 +198,7 @@ void UdpConnection::add_remote_with_remote_sysid(
     Remote new_remote;
     new_remote.ip = remote_ip;
     new_remote.port_number = remote_port;
+    inet_pton(AF_INET, remote_ip.c_str(), &new_remote.address);
 
     auto existing_remote =
         std::find_if(_remotes.begin(), _remotes.end(), [&new_remote](Remote& remote) {
@@ -198,46 +218,51 @@ void UdpConnection::add_remote_with_remote_sysid(
 
 void UdpConnection::receive()
 {
-    // Enough for MTU 1500 bytes.
-    char buffer[2048];
-
     while (!_should_exit) {
-        struct sockaddr_in src_addr = {};
-        socklen_t src_addr_len = sizeof(src_addr);
-        const auto recv_len = recvfrom(
-            _socket_fd,
-            buffer,
-            sizeof(buffer),
-            0,
-            reinterpret_cast<struct sockaddr*>(&src_addr),
-            &src_addr_len);
+        receive_datagram();
+    }
+}
 
-        if (recv_len == 0) {
-            // This can happen when shutdown is called on the socket,
-            // therefore we check _should_exit again.
-            continue;
-        }
+void UdpConnection::receive_datagram()
+{
+    // Enough for MTU 1500 bytes.
+    char buffer[2048];
 
-        if (recv_len < 0) {
-            // This happens on destruction when close(_socket_fd) is called,
-            // therefore be quiet.
-            // LogErr() << "recvfrom error: " << GET_ERROR(errno);
-            continue;
-        }
+    struct sockaddr_in src_addr = {};
+    socklen_t src_addr_len = sizeof(src_addr);
+    const auto recv_len = recvfrom(
+        _socket_fd,
+        buffer,
+        sizeof(buffer),
+        0,
+        reinterpret_cast<struct sockaddr*>(&src_addr),
+        &src_addr_len);
+
+    if (recv_len == 0) {
+        // This can happen when shutdown is called on the socket,
+        // therefore we check _should_exit again.
+        return;
+    }
 
-        _mavlink_receiver->set_new_datagram(buffer, static_cast<int>(recv_len));
+    if (recv_len < 0) {
+        // This happens on destruction when close(_socket_fd) is called,
+        // therefore be quiet.
+        // LogErr() << "recvfrom error: " << GET_ERROR(errno);
+        return;
+    }
 
-        // Parse all mavlink messages in one datagram. Once exhausted, we'll exit while.
-        while (_mavlink_receiver->parse_message()) {
-            const uint8_t sysid = _mavlink_receiver->get_last_message().sysid;
+    _mavlink_receiver->set_new_datagram(buffer, static_cast<int>(recv_len));
 
-            if (sysid != 0) {
-                add_remote_with_remote_sysid(
-                    inet_ntoa(src_addr.sin_addr), ntohs(src_addr.sin_port), sysid);
-            }
+    // Parse all mavlink messages in one datagram. Once exhausted, we'll exit while.
+    while (_mavlink_receiver->parse_message()) {
+        const uint8_t sysid = _mavlink_receiver->get_last_message().sysid;
 
-            receive_message(_mavlink_receiver->get_last_message(), this);
+        if (sysid != 0) {
+            add_remote_with_remote_sysid(
+                inet_ntoa(src_addr.sin_addr), ntohs(src_addr.sin_port), sysid);
         }
+
+        receive_message(_mavlink_receiver->get_last_message(), this);
     }
 }
 
@@ -22,8 +22,6 @@ public:
     ConnectionResult start() override;
     ConnectionResult stop() override;
 
-    bool send_message(const mavlink_message_t& message) override;
-
     void add_remote(const std::string& remote_ip, int remote_port);
 
     // Non-copyable
@@ -31,10 +29,14 @@ public:
     const UdpConnection& operator=(const UdpConnection&) = delete;
 
 private:
+    bool write_message(const mavlink_message_t& message) override;
+
     ConnectionResult setup_port();
     void start_recv_thread();
 
     void receive();
+    // Receives and parses one datagram.
+    void receive_datagram();
 
     void add_remote_with_remote_sysid(
         const std::string& remote_ip, int remote_port, uint8_t remote_sysid);
@@ -46,6 +48,8 @@ private:
     struct Remote {
         std::string ip{};
         int port_number{0};
+        // Parsed once when added, in network byte order.
+        uint32_t address{0};
 
         bool operator==(const UdpConnection::Remote& other) const
         {
@@ -1,5 +1,6 @@
 #include "log.h"
 #include "camera_definition.h"
+#include <algorithm>
 
 namespace mavsdk {
 
@@ -9,45 +10,146 @@ CameraDefinition::~CameraDefinition() {}
 
 bool CameraDefinition::load_file(const std::string& filepath)
 {
-    tinyxml2::XMLError xml_error = _doc.LoadFile(filepath.c_str());
+    tinyxml2::XMLDocument doc;
+    tinyxml2::XMLError xml_error = doc.LoadFile(filepath.c_str());
     if (xml_error != tinyxml2::XML_SUCCESS) {
-        LogErr() << "tinyxml2::LoadFile failed: " << _doc.ErrorStr();
+        LogErr() << "tinyxml2::LoadFile failed: " << doc.ErrorStr();
         return false;
     }
 
-    return parse_xml();
+    return parse_xml(doc);
 }
 
 bool CameraDefinition::load_string(const std::string& content)
 {
-    tinyxml2::XMLError xml_error = _doc.Parse(content.c_str());
+    tinyxml2::XMLDocument doc;
+    tinyxml2::XMLError xml_error = doc.Parse(content.c_str());
     if (xml_error != tinyxml2::XML_SUCCESS) {
-        LogErr() << "tinyxml2::Parse failed: " << _doc.ErrorStr();
+        LogErr() << "tinyxml2::Parse failed: " << doc.ErrorStr();
         return false;
     }
 
-    return parse_xml();
+    return parse_xml(doc);
+}
+
+CameraDefinition::ModelCache& CameraDefinition::model_cache()
+{
+    static ModelCache cache{};
+    return cache;
+}
+
+std::list<CameraDefinition::CachedModel>::iterator
+CameraDefinition::ModelCache::find(const std::string& uri, uint32_t version)
+{
+    auto it = std::find_if(models.begin(), models.end(), [&](const CachedModel& cached) {
+        return cached.uri == uri && cached.version == version;
+    });
+    if (it != models.end()) {
+        models.splice(models.begin(), models, it);
+    }
+    return it;
+}
+
+bool CameraDefinition::load_cached(const std::string& uri, uint32_t version)
+{
+    std::shared_ptr<const Model> model;
+    {
+        auto& cache = model_cache();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        auto it = cache.find(uri, version);
+        if (it == cache.models.end()) {
+            return false;
+        }
+        model = it->model;
+    }
+
+    set_model(std::move(model));
+    return true;
+}
+
+void CameraDefinition::add_to_cache(const std::string& uri, uint32_t version) const
+{
+    std::shared_ptr<const Model> model;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        model = _model;
+    }
+
+    if (!model) {
+        return;
+    }
+
+    auto& cache = model_cache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto it = cache.find(uri, version);
+    if (it != cache.models.end()) {
+        it->model = std::move(model);
+        return;
+    }
+
+    cache.models.push_front(CachedModel{uri, version, std::move(model)});
+    if (cache.models.size() > MAX_CACHED_MODELS) {
+        cache.models.pop_back();
+    }
+}
+
+void CameraDefinition::set_model(std::shared_ptr<const Model> model)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _model = std::move(model);
+
+    // All settings need to be fetched first.
+    _current_settings.assign(_model->parameters.size(), InternalCurrentSetting{});
+    for (auto& setting : _current_settings) {
+        setting.needs_updating = true;
+    }
+    _exclusions_outdated = true;
+}
+
+std::size_t CameraDefinition::Model::index_of(const std::string& name) const
+{
+    auto it = parameter_indices.find(name);
+    if (it == parameter_indices.end()) {
+        return NO_INDEX;
+    }
+    return it->second;
+}
+
+const CameraDefinition::Parameter* CameraDefinition::find_parameter(const std::string& name) const
+{
+    // Assumes to have the lock for _mutex.
+
+    if (!_model) {
+        return nullptr;
+    }
+
+    const auto index = _model->index_of(name);
+    if (index == NO_INDEX || !_model->parameters[index].is_valid) {
+        return nullptr;
+    }
+    return &_model->parameters[index];
 }
 
 std::string CameraDefinition::get_model() const
 {
     std::lock_guard<std::mutex> lock(_mutex);
 
-    return _model;
+    return _model ? _model->model : std::string{};
 }
 
 std::string CameraDefinition::get_vendor() const
 {
     std::lock_guard<std::mutex> lock(_mutex);
 
-    return _vendor;
+    return _model ? _model->vendor : std::string{};
 }
 
-bool CameraDefinition::parse_xml()
+bool CameraDefinition::parse_xml(const tinyxml2::XMLDocument& doc)
 {
-    std::lock_guard<std::mutex> lock(_mutex);
+    auto model = std::make_shared<Model>();
 
-    auto e_mavlinkcamera = _doc.FirstChildElement("mavlinkcamera");
+    auto e_mavlinkcamera = doc.FirstChildElement("mavlinkcamera");
     if (!e_mavlinkcamera) {
         LogErr() << "Tag mavlinkcamera not found";
         return false;
@@ -65,7 +167,7 @@ bool CameraDefinition::parse_xml()
         return false;
     }
 
-    _model = e_model->GetText();
+    model->model = e_model->GetText();
 
     auto e_vendor = e_definition->FirstChildElement("vendor");
     if (!e_vendor) {
@@ -73,7 +175,7 @@ bool CameraDefinition::parse_xml()
         return false;
     }
 
-    _vendor = e_vendor->GetText();
+    model->vendor = e_vendor->GetText();
 
     auto e_parameters = e_mavlinkcamera->FirstChildElement("parameters");
     if (!e_parameters) {
@@ -98,18 +200,30 @@ bool CameraDefinition::parse_xml()
         }
 
         type_map[param_name] = type_str;
+
+        // Intern all names up front, so that exclusions and updates can refer
+        // to parameters further down by index.
+        if (model->parameter_indices.find(param_name) == model->parameter_indices.end()) {
+            model->parameter_indices[param_name] = model->parameters.size();
+            model->parameters.emplace_back();
+            model->parameters.back().name = param_name;
+        }
     }
 
     for (auto e_parameter = e_parameters->FirstChildElement("parameter"); e_parameter != nullptr;
          e_parameter = e_parameter->NextSiblingElement("parameter")) {
-        auto new_parameter = std::make_shared<Parameter>();
-
         const char* param_name = e_parameter->Attribute("name");
         if (!param_name) {
             LogErr() << "name attribute missing";
             return false;
         }
 
+        Parameter* new_parameter = &model->parameters[model->index_of(param_name)];
+        if (new_parameter->is_valid) {
+            LogWarn() << "Ignoring duplicate parameter " << param_name;
+            continue;
+        }
+
         const char* type_str_res = e_parameter->Attribute("type");
         if (!type_str_res) {
             LogErr() << "type attribute missing for " << param_name;
@@ -187,7 +301,12 @@ bool CameraDefinition::parse_xml()
             for (auto e_update = e_updates->FirstChildElement("update"); e_update != nullptr;
                  e_update = e_update->NextSiblingElement("update")) {
                 // LogDebug() << "Updates: " << e_update->GetText();
-                new_parameter->updates.push_back(e_update->GetText());
+                const auto update_index = model->index_of(e_update->GetText());
+                if (update_index == NO_INDEX) {
+                    // LogDebug() << "Update to '" << e_update->GetText() << "' not understood.";
+                    continue;
+                }
+                new_parameter->updates.push_back(update_index);
             }
         }
 
@@ -210,7 +329,7 @@ bool CameraDefinition::parse_xml()
 
         auto e_options = e_parameter->FirstChildElement("options");
         if (e_options) {
-            auto maybe_options = parse_options(e_options, param_name, type_map);
+            auto maybe_options = parse_options(e_options, param_name, type_map, *model);
             if (!maybe_options.first) {
                 continue;
             }
@@ -230,9 +349,7 @@ bool CameraDefinition::parse_xml()
             true_option.name = "off";
             false_option.value.set<uint8_t>(false);
 
-            new_parameter->options = {
-                std::make_shared<Option>(std::move(true_option)),
-                std::make_shared<Option>(std::move(false_option))};
+            new_parameter->options = {std::move(true_option), std::move(false_option)};
 
             if (auto default_option = get_default_opt()) {
                 new_parameter->default_option = *default_option;
@@ -251,23 +368,21 @@ bool CameraDefinition::parse_xml()
             new_parameter->default_option = std::get<2>(maybe_range_options);
         }
 
-        _parameter_map[param_name] = new_parameter;
-
-        InternalCurrentSetting empty_setting{};
-        empty_setting.needs_updating = true;
-        _current_settings[param_name] = empty_setting;
+        new_parameter->is_valid = true;
     }
 
+    set_model(std::move(model));
+
     return true;
 }
 
-std::pair<bool, std::vector<std::shared_ptr<CameraDefinition::Option>>>
-CameraDefinition::parse_options(
+std::pair<bool, std::vector<CameraDefinition::Option>> CameraDefinition::parse_options(
     const tinyxml2::XMLElement* options_handle,
     const std::string& param_name,
-    std::unordered_map<std::string, std::string>& type_map)
+    std::unordered_map<std::string, std::string>& type_map,
+    const Model& model)
 {
-    std::vector<std::shared_ptr<Option>> options{};
+    std::vector<Option> options{};
 
     for (auto e_option = options_handle->FirstChildElement("option"); e_option != nullptr;
          e_option = e_option->NextSiblingElement("option")) {
@@ -283,11 +398,11 @@ CameraDefinition::parse_options(
             return std::make_pair<>(false, options);
         }
 
-        auto new_option = std::make_shared<Option>();
+        Option new_option{};
 
-        new_option->name = option_name;
+        new_option.name = option_name;
 
-        new_option->value.set_from_xml(type_map[param_name], option_value);
+        new_option.value.set_from_xml(type_map[param_name], option_value);
 
         // LogDebug() << "Type: " << type_map[param_name] << ", name: " << option_name;
 
@@ -296,7 +411,10 @@ CameraDefinition::parse_options(
             for (auto e_exclude = e_exclusions->FirstChildElement("exclude"); e_exclude != nullptr;
                  e_exclude = e_exclude->NextSiblingElement("exclude")) {
                 // LogDebug() << "Exclude: " << e_exclude->GetText();
-                new_option->exclusions.push_back(e_exclude->GetText());
+                const auto exclude_index = model.index_of(e_exclude->GetText());
+                if (exclude_index != NO_INDEX) {
+                    new_option.exclusions.push_back(exclude_index);
+                }
             }
         }
 
@@ -311,7 +429,7 @@ CameraDefinition::parse_options(
                     return std::make_pair<>(false, options);
                 }
 
-                ParameterRange new_parameter_range;
+                std::vector<ParamValue> new_parameter_range;
 
                 for (auto e_roption = e_parameterrange->FirstChildElement("roption");
                      e_roption != nullptr;
@@ -336,7 +454,7 @@ CameraDefinition::parse_options(
                     ParamValue new_param_value;
                     new_param_value.set_from_xml(
                         type_map[roption_parameter_str], roption_value_str);
-                    new_parameter_range[roption_name_str] = new_param_value;
+                    new_parameter_range.push_back(new_param_value);
 
                     // LogDebug() << "range option: "
                     //            << roption_name_str
@@ -345,24 +463,25 @@ CameraDefinition::parse_options(
                     //            << " (" << new_param_value.typestr() << ")";
                 }
 
-                new_option->parameter_ranges[roption_parameter_str] = new_parameter_range;
+                new_option.parameter_ranges.emplace_back(
+                    model.index_of(roption_parameter_str), std::move(new_parameter_range));
 
                 // LogDebug() << "adding to: " << roption_parameter_str;
             }
         }
 
-        options.push_back(new_option);
+        options.push_back(std::move(new_option));
     }
     return std::make_pair<>(true, options);
 }
 
-std::tuple<bool, std::vector<std::shared_ptr<CameraDefinition::Option>>, CameraDefinition::Option>
+std::tuple<bool, std::vector<CameraDefinition::Option>, CameraDefinition::Option>
 CameraDefinition::parse_range_options(
     const tinyxml2::XMLElement* param_handle,
     const std::string& param_name,
     std::unordered_map<std::string, std::string>& type_map)
 {
-    std::vector<std::shared_ptr<Option>> options{};
+    std::vector<Option> options{};
     Option default_option{};
 
     const char* min_str = param_handle->Attribute("min");
@@ -380,16 +499,16 @@ CameraDefinition::parse_range_options(
         return std::make_tuple<>(false, options, default_option);
     }
 
-    auto min_option = std::make_shared<Option>();
-    min_option->name = "min";
-    min_option->value = min_value;
+    Option min_option{};
+    min_option.name = "min";
+    min_option.value = min_value;
 
     ParamValue max_value;
     max_value.set_from_xml(type_map[param_name], max_str);
 
-    auto max_option = std::make_shared<Option>();
-    max_option->name = "max";
-    max_option->value = max_value;
+    Option max_option{};
+    max_option.name = "max";
+    max_option.value = max_value;
 
     const char* step_str = param_handle->Attribute("step");
     if (!step_str) {
@@ -400,9 +519,9 @@ CameraDefinition::parse_range_options(
         ParamValue step_value;
         step_value.set_from_xml(type_map[param_name], step_str);
 
-        auto step_option = std::make_shared<Option>();
-        step_option->name = "step";
-        step_option->value = step_value;
+        Option step_option{};
+        step_option.name = "step";
+        step_option.value = step_value;
 
         options.push_back(min_option);
         options.push_back(max_option);
@@ -427,16 +546,16 @@ CameraDefinition::parse_range_options(
     return std::make_tuple<>(true, options, default_option);
 }
 
-std::pair<bool, CameraDefinition::Option> CameraDefinition::find_default(
-    const std::vector<std::shared_ptr<Option>>& options, const std::string& default_str)
+std::pair<bool, CameraDefinition::Option>
+CameraDefinition::find_default(const std::vector<Option>& options, const std::string& default_str)
 {
     Option default_option{};
 
     bool found_default = false;
     for (auto& option : options) {
-        if (option->value == default_str) {
+        if (option.value == default_str) {
             if (!found_default) {
-                default_option = *option;
+                default_option = option;
                 found_default = true;
             } else {
                 LogErr() << "Found more than one default";
@@ -455,34 +574,68 @@ void CameraDefinition::assume_default_settings()
 {
     std::lock_guard<std::mutex> lock(_mutex);
 
-    _current_settings.clear();
+    if (!_model) {
+        return;
+    }
 
-    for (const auto& parameter : _parameter_map) {
-        // if (parameter.second->is_range) {
+    for (std::size_t i = 0; i < _model->parameters.size(); ++i) {
+        if (!_model->parameters[i].is_valid) {
+            continue;
+        }
+        set_current_value(i, _model->parameters[i].default_option.value, false);
+    }
+}
+
+void CameraDefinition::set_current_value(
+    std::size_t index, const ParamValue& value, bool needs_updating)
+{
+    // Assumes to have the lock for _mutex.
+
+    auto& setting = _current_settings[index];
+    setting.value = value;
+    setting.needs_updating = needs_updating;
+
+    // Look up the matching option once here rather than every time the
+    // possible settings are evaluated.
+    setting.option_index = NO_INDEX;
+    const auto& options = _model->parameters[index].options;
+    for (std::size_t i = 0; i < options.size(); ++i) {
+        if (options[i].value == value) {
+            setting.option_index = i;
+            break;
+        }
+    }
+
+    _exclusions_outdated = true;
+}
 
-        InternalCurrentSetting new_setting;
-        new_setting.value = parameter.second->default_option.value;
-        new_setting.needs_updating = false;
-        _current_settings[parameter.first] = new_setting;
+void CameraDefinition::update_exclusions()
+{
+    // Assumes to have the lock for _mutex.
+
+    if (!_exclusions_outdated) {
+        return;
+    }
 
-        //} else {
+    _excluded.assign(_model->parameters.size(), false);
+    _excluded_by_known.assign(_model->parameters.size(), false);
 
-        //    for (const auto &option : parameter.second->options) {
-        //        if (!option->is_default) {
-        //            //LogDebug() << option->name << " not default";
-        //            continue;
-        //        }
-        //        //LogDebug() << option->name << " default value: " << option->value << " (type: "
-        //        <<
-        //        // option->value.typestr() << ")";
+    for (std::size_t i = 0; i < _model->parameters.size(); ++i) {
+        const auto& setting = _current_settings[i];
+        if (!_model->parameters[i].is_valid || setting.option_index == NO_INDEX) {
+            continue;
+        }
 
-        //        InternalCurrentSetting new_setting;
-        //        new_setting.value = option->value;
-        //        new_setting.needs_updating = false;
-        //        _current_settings[parameter.first] = new_setting;
-        //    }
-        //}
+        const auto& option = _model->parameters[i].options[setting.option_index];
+        for (const auto exclusion : option.exclusions) {
+            _excluded[exclusion] = true;
+            if (!setting.needs_updating) {
+                _excluded_by_known[exclusion] = true;
+            }
+        }
     }
+
+    _exclusions_outdated = false;
 }
 
 bool CameraDefinition::get_all_settings(std::unordered_map<std::string, ParamValue>& settings)
@@ -490,8 +643,16 @@ bool CameraDefinition::get_all_settings(std::unordered_map<std::string, ParamVal
     std::lock_guard<std::mutex> lock(_mutex);
 
     settings.clear();
-    for (const auto& current_setting : _current_settings) {
-        settings[current_setting.first] = current_setting.second.value;
+
+    if (!_model) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < _model->parameters.size(); ++i) {
+        if (!_model->parameters[i].is_valid) {
+            continue;
+        }
+        settings[_model->parameters[i].name] = _current_settings[i].value;
     }
 
     return (settings.size() > 0);
@@ -501,45 +662,20 @@ bool CameraDefinition::get_possible_settings(std::unordered_map<std::string, Par
 {
     std::lock_guard<std::mutex> lock(_mutex);
 
-    return get_possible_settings_locked(settings);
-}
-
-bool CameraDefinition::get_possible_settings_locked(
-    std::unordered_map<std::string, ParamValue>& settings)
-{
     settings.clear();
 
-    // Find all exclusions
-    // TODO: use set instead of vector
-    std::vector<std::string> exclusions{};
-
-    for (const auto& parameter : _parameter_map) {
-        for (const auto& option : parameter.second->options) {
-            if (_current_settings[parameter.first].value == option->value) {
-                for (const auto& exclusion : option->exclusions) {
-                    // LogDebug() << "found exclusion for " << parameter.first
-                    //            << "(" << option->value << "): " << exclusion;
-                    exclusions.push_back(exclusion);
-                }
-            }
-        }
+    if (!_model) {
+        return false;
     }
 
-    for (const auto& setting : _current_settings) {
-        bool excluded = false;
-        for (const auto& exclusion : exclusions) {
-            if (setting.first == exclusion) {
-                excluded = true;
-            }
-        }
-        if (!_parameter_map[setting.first]->is_control) {
-            continue;
-        }
+    update_exclusions();
 
-        if (excluded) {
+    for (std::size_t i = 0; i < _model->parameters.size(); ++i) {
+        const auto& parameter = _model->parameters[i];
+        if (!parameter.is_valid || !parameter.is_control || _excluded[i]) {
             continue;
         }
-        settings[setting.first] = setting.second.value;
+        settings[parameter.name] = _current_settings[i].value;
     }
 
     return (settings.size() > 0);
@@ -549,20 +685,21 @@ bool CameraDefinition::set_setting(const std::string& name, const ParamValue& va
 {
     std::lock_guard<std::mutex> lock(_mutex);
 
-    if (_parameter_map.find(name) == _parameter_map.end()) {
+    const auto* parameter = find_parameter(name);
+    if (parameter == nullptr) {
         LogErr() << "Unknown setting to set: " << name;
         return false;
     }
 
     // For range params, we need to verify the range.
-    if (_parameter_map[name]->is_range) {
+    if (parameter->is_range) {
         // Check against the minimum
-        if (value < _parameter_map[name]->options[0]->value) {
+        if (value < parameter->options[0].value) {
             LogErr() << "Chosen value smaller than minimum";
             return false;
         }
 
-        if (value > _parameter_map[name]->options[1]->value) {
+        if (value > parameter->options[1].value) {
             LogErr() << "Chosen value bigger than maximum";
             return false;
         }
@@ -570,15 +707,13 @@ bool CameraDefinition::set_setting(const std::string& name, const ParamValue& va
         // TODO: Check step as well, until now we have only seen steps of 1 in the wild though.
     }
 
-    _current_settings[name].value = value;
-    _current_settings[name].needs_updating = false;
+    set_current_value(_model->index_of(name), value, false);
 
     // Some param changes cause other params to change, so they need to be updated.
     // The camera definition just keeps track of these params but the actual param fetching
     // needs to happen outside of this class.
-    for (const auto& update : _parameter_map[name]->updates) {
-        if (_current_settings.find(update) == _current_settings.end()) {
-            // LogDebug() << "Update to '" << update << "' not understood.";
+    for (const auto update : parameter->updates) {
+        if (!_model->parameters[update].is_valid) {
             continue;
         }
         _current_settings[update].needs_updating = true;
@@ -591,13 +726,14 @@ bool CameraDefinition::get_setting(const std::string& name, ParamValue& value)
 {
     std::lock_guard<std::mutex> lock(_mutex);
 
-    if (_current_settings.find(name) == _current_settings.end()) {
+    if (find_parameter(name) == nullptr) {
         LogErr() << "Unknown setting to get: " << name;
         return false;
     }
 
-    if (!_current_settings.at(name).needs_updating) {
-        value = _current_settings.at(name).value;
+    const auto& setting = _current_settings[_model->index_of(name)];
+    if (!setting.needs_updating) {
+        value = setting.value;
         return true;
     } else {
         return false;
@@ -609,14 +745,15 @@ bool CameraDefinition::get_option_value(
 {
     std::lock_guard<std::mutex> lock(_mutex);
 
-    if (_parameter_map.find(param_name) == _parameter_map.end()) {
+    const auto* parameter = find_parameter(param_name);
+    if (parameter == nullptr) {
         LogErr() << "Unknown parameter to get option: " << param_name;
         return false;
     }
 
-    for (const auto& option : _parameter_map[param_name]->options) {
-        if (option->value == option_value) {
-            value = option->value;
+    for (const auto& option : parameter->options) {
+        if (option.value == option_value) {
+            value = option.value;
             return true;
         }
     }
@@ -630,13 +767,14 @@ bool CameraDefinition::get_all_options(const std::string& name, std::vector<Para
 
     values.clear();
 
-    if (_parameter_map.find(name) == _parameter_map.end()) {
+    const auto* parameter = find_parameter(name);
+    if (parameter == nullptr) {
         LogErr() << "Unknown parameter to get all options";
         return false;
     }
 
-    for (const auto& option : _parameter_map[name]->options) {
-        values.push_back(option->value);
+    for (const auto& option : parameter->options) {
+        values.push_back(option.value);
     }
 
     return true;
@@ -649,88 +787,56 @@ bool CameraDefinition::get_possible_options(
 
     values.clear();
 
-    if (_parameter_map.find(name) == _parameter_map.end()) {
+    const auto* parameter = find_parameter(name);
+    if (parameter == nullptr) {
         LogErr() << "Unknown parameter to get possible options";
         return false;
     }
 
-    std::unordered_map<std::string, ParamValue> settings;
-    if (!get_possible_settings_locked(settings)) {
-        return false;
-    }
-    if (settings.find(name) == settings.end()) {
-        LogErr() << "Setting " << name << " currently not applicable";
-        return false;
-    }
+    const auto index = _model->index_of(name);
 
-    // Find all exclusions because excluded parameters need to be neglected for range
-    // check below.
-    // TODO: use set instead of vector
-    std::vector<std::string> exclusions{};
+    update_exclusions();
 
-    for (const auto& parameter : _parameter_map) {
-        for (const auto& option : parameter.second->options) {
-            if (_current_settings[parameter.first].needs_updating) {
-                // LogWarn() << parameter.first << " needs updating";
-                continue;
-            }
-            if (_current_settings[parameter.first].value == option->value) {
-                for (const auto& exclusion : option->exclusions) {
-                    // LogDebug() << "found exclusion for " << parameter.first
-                    //            << "(" << option->value << "): " << exclusion;
-                    exclusions.push_back(exclusion);
-                }
-            }
-        }
+    if (!parameter->is_control || _excluded[index]) {
+        LogErr() << "Setting " << name << " currently not applicable";
+        return false;
     }
 
-    // TODO: use set instead of vector for this
-    std::vector<ParamValue> allowed_ranges{};
+    // Collect the ranges the currently set options allow for this parameter.
+    // Parameters which are excluded or not known yet are neglected.
+    std::vector<const ParamValue*> allowed_ranges{};
 
-    // Check allowed ranges.
-    for (const auto& parameter : _parameter_map) {
-        if (!parameter.second->is_control) {
-            continue;
-        }
+    for (std::size_t i = 0; i < _model->parameters.size(); ++i) {
+        const auto& other = _model->parameters[i];
+        const auto& setting = _current_settings[i];
 
-        bool excluded = false;
-        for (const auto& exclusion : exclusions) {
-            if (parameter.first == exclusion) {
-                excluded = true;
-            }
-        }
-        if (excluded) {
+        if (!other.is_valid || !other.is_control || _excluded_by_known[i] ||
+            setting.needs_updating || setting.option_index == NO_INDEX) {
             continue;
         }
 
-        for (const auto& option : parameter.second->options) {
-            if (_current_settings[parameter.first].needs_updating) {
-                // LogWarn() << parameter.first << " needs updating";
+        // Only look at current set option.
+        for (const auto& range : other.options[setting.option_index].parameter_ranges) {
+            if (range.first != index) {
                 continue;
             }
-            // Only look at current set option.
-            if (_current_settings[parameter.first].value == option->value) {
-                // Go through parameter ranges but only concerning the parameter that
-                // we're interested in..
-                if (option->parameter_ranges.find(name) != option->parameter_ranges.end()) {
-                    for (const auto& range : option->parameter_ranges[name]) {
-                        allowed_ranges.push_back(range.second);
-                    }
-                }
+            for (const auto& allowed : range.second) {
+                allowed_ranges.push_back(&allowed);
             }
         }
     }
 
     // Intersect
-    for (const auto& option : _parameter_map[name]->options) {
-        bool option_allowed = false;
-        for (const auto& allowed_range : allowed_ranges) {
-            if (option->value == allowed_range) {
+    for (const auto& option : parameter->options) {
+        bool option_allowed = allowed_ranges.empty();
+        for (const auto* allowed_range : allowed_ranges) {
+            if (option.value == *allowed_range) {
                 option_allowed = true;
+                break;
             }
         }
-        if (option_allowed || allowed_ranges.size() == 0) {
-            values.push_back(option->value);
+        if (option_allowed) {
+            values.push_back(option.value);
         }
     }
 
@@ -743,9 +849,14 @@ void CameraDefinition::get_unknown_params(std::vector<std::pair<std::string, Par
 
     params.clear();
 
-    for (const auto& parameter : _parameter_map) {
-        if (_current_settings[parameter.first].needs_updating) {
-            params.push_back(std::make_pair<>(parameter.first, parameter.second->type));
+    if (!_model) {
+        return;
+    }
+
+    for (std::size_t i = 0; i < _model->parameters.size(); ++i) {
+        const auto& parameter = _model->parameters[i];
+        if (parameter.is_valid && _current_settings[i].needs_updating) {
+            params.push_back(std::make_pair<>(parameter.name, parameter.type));
         }
     }
 }
@@ -754,21 +865,23 @@ void CameraDefinition::set_all_params_unknown()
 {
     std::lock_guard<std::mutex> lock(_mutex);
 
-    for (auto& parameter : _parameter_map) {
-        _current_settings[parameter.first].needs_updating = true;
+    for (auto& setting : _current_settings) {
+        setting.needs_updating = true;
     }
+    _exclusions_outdated = true;
 }
 
 bool CameraDefinition::is_setting_range(const std::string& name)
 {
     std::lock_guard<std::mutex> lock(_mutex);
 
-    if (_parameter_map.find(name) == _parameter_map.end()) {
+    const auto* parameter = find_parameter(name);
+    if (parameter == nullptr) {
         LogWarn() << "Setting " << name << " not found.";
         return false;
     }
 
-    return _parameter_map[name]->is_range;
+    return parameter->is_range;
 }
 
 bool CameraDefinition::get_setting_str(const std::string& name, std::string& description)
@@ -777,12 +890,13 @@ bool CameraDefinition::get_setting_str(const std::string& name, std::string& des
 
     description.clear();
 
-    if (_parameter_map.find(name) == _parameter_map.end()) {
+    const auto* parameter = find_parameter(name);
+    if (parameter == nullptr) {
         LogWarn() << "Setting " << name << " not found.";
         return false;
     }
 
-    description = _parameter_map[name]->description;
+    description = parameter->description;
     return true;
 }
 
@@ -793,16 +907,15 @@ bool CameraDefinition::get_option_str(
 
     description.clear();
 
-    if (_parameter_map.find(setting_name) == _parameter_map.end()) {
+    const auto* parameter = find_parameter(setting_name);
+    if (parameter == nullptr) {
         LogWarn() << "Setting " << setting_name << " not found.";
         return false;
     }
 
-    for (const auto& option : _parameter_map[setting_name]->options) {
-        std::stringstream value_ss{};
-        value_ss << option->value;
-        if (option->value == option_name) {
-            description = option->name;
+    for (const auto& option : parameter->options) {
+        if (option.value == option_name) {
+            description = option.name;
             return true;
         }
     }
@@ -2,6 +2,9 @@
 
 #include "mavlink_parameter_client.h"
 #include <tinyxml2.h>
+#include <limits>
+#include <list>
+#include <map>
 #include <vector>
 #include <memory>
 #include <unordered_map>
@@ -20,6 +23,15 @@ public:
     bool load_file(const std::string& filepath);
     bool load_string(const std::string& content);
 
+    // Parsed definitions can be cached by URI and version so that they don't
+    // need to be downloaded and parsed again, e.g. when switching between
+    // cameras of the same type. Only the MAX_CACHED_MODELS most recently used
+    // ones are kept.
+    bool load_cached(const std::string& uri, uint32_t version);
+    void add_to_cache(const std::string& uri, uint32_t version) const;
+
+    static constexpr std::size_t MAX_CACHED_MODELS = 8;
+
     std::string get_vendor() const;
     std::string get_model() const;
 
@@ -54,59 +66,102 @@ public:
     const CameraDefinition& operator=(const CameraDefinition&) = delete;
 
 private:
-    bool get_possible_settings_locked(std::unordered_map<std::string, ParamValue>& settings);
-
-    using ParameterRange = std::unordered_map<std::string, ParamValue>;
+    static constexpr std::size_t NO_INDEX = std::numeric_limits<std::size_t>::max();
 
     struct Option {
         std::string name{};
         ParamValue value{};
-        std::vector<std::string> exclusions{};
-        std::unordered_map<std::string, ParameterRange> parameter_ranges{};
+        // Parameters (by index) which don't apply while this option is set.
+        std::vector<std::size_t> exclusions{};
+        // Values other parameters (by index) are limited to while this option is set.
+        std::vector<std::pair<std::size_t, std::vector<ParamValue>>> parameter_ranges{};
     };
 
     struct Parameter {
+        std::string name{};
+        // Parameters of types we don't support are kept so that indices of
+        // all parameters are known while parsing, but are otherwise ignored.
+        bool is_valid{false};
         std::string description{};
         bool is_control{false};
         bool is_readonly{false};
         bool is_writeonly{false};
         ParamValue type{}; // for type only, doesn't hold a value
-        std::vector<std::string> updates{};
-        std::vector<std::shared_ptr<Option>> options{};
+        std::vector<std::size_t> updates{};
+        std::vector<Option> options{};
         Option default_option{};
         bool is_range{false};
     };
 
-    bool parse_xml();
+    // Everything parsed from the XML. Once compiled, it is never changed
+    // and can be shared between instances.
+    struct Model {
+        std::string model{};
+        std::string vendor{};
+        std::vector<Parameter> parameters{};
+        std::unordered_map<std::string, std::size_t> parameter_indices{};
+
+        std::size_t index_of(const std::string& name) const;
+    };
+
+    struct CachedModel {
+        std::string uri;
+        uint32_t version;
+        std::shared_ptr<const Model> model;
+    };
+
+    // Most recently used first. There are only a few, so they are simply
+    // searched one after the other.
+    struct ModelCache {
+        std::mutex mutex{};
+        std::list<CachedModel> models{};
+
+        // Assumes to have the lock for mutex. Moves the entry to the front.
+        std::list<CachedModel>::iterator find(const std::string& uri, uint32_t version);
+    };
+    static ModelCache& model_cache();
+
+    bool parse_xml(const tinyxml2::XMLDocument& doc);
+    void set_model(std::shared_ptr<const Model> model);
 
     // Until we have std::optional we need to use std::pair to return something that might be
     // nothing.
-    std::pair<bool, std::vector<std::shared_ptr<Option>>> parse_options(
+    static std::pair<bool, std::vector<Option>> parse_options(
         const tinyxml2::XMLElement* options_handle,
         const std::string& param_name,
-        std::unordered_map<std::string, std::string>& type_map);
-    std::tuple<bool, std::vector<std::shared_ptr<Option>>, Option> parse_range_options(
+        std::unordered_map<std::string, std::string>& type_map,
+        const Model& model);
+    static std::tuple<bool, std::vector<Option>, Option> parse_range_options(
         const tinyxml2::XMLElement* param_handle,
         const std::string& param_name,
         std::unordered_map<std::string, std::string>& type_map);
-    std::pair<bool, Option> find_default(
-        const std::vector<std::shared_ptr<Option>>& options, const std::string& default_str);
+    static std::pair<bool, Option>
+    find_default(const std::vector<Option>& options, const std::string& default_str);
 
-    mutable std::mutex _mutex{};
+    const Parameter* find_parameter(const std::string& name) const;
+    void set_current_value(std::size_t index, const ParamValue& value, bool needs_updating);
+    void update_exclusions();
 
-    tinyxml2::XMLDocument _doc{};
+    mutable std::mutex _mutex{};
 
-    std::unordered_map<std::string, std::shared_ptr<Parameter>> _parameter_map{};
+    std::shared_ptr<const Model> _model{};
 
     struct InternalCurrentSetting {
         ParamValue value{};
         bool needs_updating{false};
+        // Index of the option matching the value, if any.
+        std::size_t option_index{NO_INDEX};
     };
 
-    std::unordered_map<std::string, InternalCurrentSetting> _current_settings{};
+    // Indexed like the parameters of the model.
+    std::vector<InternalCurrentSetting> _current_settings{};
 
-    std::string _model{};
-    std::string _vendor{};
+    // Parameters excluded by the current options, considering all settings
+    // or only the ones that are known to be up-to-date. These are only
+    // recomputed after settings changed.
+    bool _exclusions_outdated{true};
+    std::vector<bool> _excluded{};
+    std::vector<bool> _excluded_by_known{};
 };
 
 } // namespace mavsdk
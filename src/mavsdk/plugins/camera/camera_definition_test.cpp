@@ -33,6 +33,70 @@ TEST(CameraDefinition, E90LoadInfoString)
     EXPECT_STREQ(cd.get_model().c_str(), "E90");
 }
 
+TEST(CameraDefinition, E90LoadCached)
+{
+    const std::string uri = "http://unit-test/e90.xml";
+
+    CameraDefinition cd_uncached;
+    EXPECT_FALSE(cd_uncached.load_cached(uri, 1));
+
+    {
+        CameraDefinition cd;
+        ASSERT_TRUE(cd.load_file(e90_unit_test_file));
+        cd.add_to_cache(uri, 1);
+    }
+
+    // A different version needs to be fetched again.
+    CameraDefinition cd_other_version;
+    EXPECT_FALSE(cd_other_version.load_cached(uri, 2));
+
+    CameraDefinition cd;
+    ASSERT_TRUE(cd.load_cached(uri, 1));
+    EXPECT_STREQ(cd.get_vendor().c_str(), "Yuneec");
+    EXPECT_STREQ(cd.get_model().c_str(), "E90");
+
+    // Settings are not shared between instances using the same definition.
+    cd.assume_default_settings();
+
+    CameraDefinition cd_second;
+    ASSERT_TRUE(cd_second.load_cached(uri, 1));
+
+    std::unordered_map<std::string, ParamValue> settings{};
+    EXPECT_TRUE(cd.get_all_settings(settings));
+    EXPECT_EQ(settings.size(), 17);
+
+    std::vector<std::pair<std::string, ParamValue>> params{};
+    cd.get_unknown_params(params);
+    EXPECT_EQ(params.size(), 0);
+    cd_second.get_unknown_params(params);
+    EXPECT_EQ(params.size(), 17);
+}
+
+TEST(CameraDefinition, CacheKeepsMostRecentlyUsed)
+{
+    const auto uri = [](std::size_t i) { return "http://unit-test/lru-" + std::to_string(i); };
+
+    {
+        CameraDefinition cd;
+        ASSERT_TRUE(cd.load_file(e90_unit_test_file));
+        for (std::size_t i = 0; i < CameraDefinition::MAX_CACHED_MODELS; ++i) {
+            cd.add_to_cache(uri(i), 1);
+        }
+
+        // Using the first one again keeps it, so the second one goes instead.
+        CameraDefinition cd_first;
+        EXPECT_TRUE(cd_first.load_cached(uri(0), 1));
+        cd.add_to_cache(uri(CameraDefinition::MAX_CACHED_MODELS), 1);
+    }
+
+    CameraDefinition cd;
+    EXPECT_TRUE(cd.load_cached(uri(0), 1));
+    EXPECT_FALSE(cd.load_cached(uri(1), 1));
+    for (std::size_t i = 2; i <= CameraDefinition::MAX_CACHED_MODELS; ++i) {
+        EXPECT_TRUE(cd.load_cached(uri(i), 1)) << i;
+    }
+}
+
 TEST(CameraDefinition, E90CheckDefaultSettings)
 {
     // Run this from root.
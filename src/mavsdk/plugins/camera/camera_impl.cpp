@@ -1122,7 +1122,7 @@ void CameraImpl::process_camera_information(const mavlink_message_t& message)
     camera_information.model_name[sizeof(camera_information.model_name) - 1] = '\0';
     camera_information.cam_definition_uri[sizeof(camera_information.cam_definition_uri) - 1] = '\0';
 
-    std::lock_guard<std::mutex> lock(_information.mutex);
+    std::unique_lock<std::mutex> lock(_information.mutex);
 
     _information.data.vendor_name = (char*)(camera_information.vendor_name);
     _information.data.model_name = (char*)(camera_information.model_name);
@@ -1136,6 +1136,27 @@ void CameraImpl::process_camera_information(const mavlink_message_t& message)
         _information.data, [this](const auto& func) { _system_impl->call_user_callback(func); });
 
     if (should_fetch_camera_definition(camera_information.cam_definition_uri)) {
+        // Another camera of the same type might have been set up before, in which
+        // case there is no need to download and parse the definition again.
+        auto cached_definition = std::make_unique<CameraDefinition>();
+        if (cached_definition->load_cached(
+                camera_information.cam_definition_uri,
+                camera_information.cam_definition_version)) {
+            LogDebug() << "Using cached camera definition";
+
+            // The definition needs to be in place before anyone hears about
+            // it, and the params are requested without holding the lock.
+            _camera_definition = std::move(cached_definition);
+            lock.unlock();
+
+            refresh_params();
+
+            if (_camera_definition_callback) {
+                _system_impl->call_user_callback([this]() { _camera_definition_callback(true); });
+            }
+            return;
+        }
+
         _is_fetching_camera_definition = true;
 
         std::thread([this, camera_information]() {
@@ -1145,14 +1166,18 @@ void CameraImpl::process_camera_information(const mavlink_message_t& message)
             if (has_succeeded) {
                 LogDebug() << "Successfully loaded camera definition";
 
+                _camera_definition.reset(new CameraDefinition());
+                if (_camera_definition->load_string(content)) {
+                    _camera_definition->add_to_cache(
+                        camera_information.cam_definition_uri,
+                        camera_information.cam_definition_version);
+                }
+                refresh_params();
+
                 if (_camera_definition_callback) {
                     _system_impl->call_user_callback(
                         [this]() { _camera_definition_callback(true); });
                 }
-
-                _camera_definition.reset(new CameraDefinition());
-                _camera_definition->load_string(content);
-                refresh_params();
             } else {
                 LogDebug() << "Failed to fetch camera definition!";
 
@@ -82,6 +82,40 @@ void FtpImpl::upload_async(
         });
 }
 
+void FtpImpl::download_data_async(const std::string& remote_path, DownloadDataCallback callback)
+{
+    _system_impl->mavlink_ftp().download_data_async(
+        remote_path,
+        [callback, this](
+            MavlinkFtp::ClientResult result,
+            const std::vector<uint8_t>& data,
+            MavlinkFtp::ProgressData progress_data) {
+            callback(
+                result_from_mavlink_ftp_result(result),
+                data,
+                progress_data_from_mavlink_ftp_progress_data(progress_data));
+        });
+}
+
+void FtpImpl::upload_data_async(const std::string& remote_path, Ftp::ResultCallback callback)
+{
+    _system_impl->mavlink_ftp().upload_data_async(
+        remote_path, [callback, this](MavlinkFtp::ClientResult result) {
+            callback(result_from_mavlink_ftp_result(result));
+        });
+}
+
+Ftp::Result FtpImpl::write_upload_data(const std::vector<uint8_t>& data)
+{
+    return _system_impl->mavlink_ftp().write_upload_data(data) ? Ftp::Result::Success :
+                                                                 Ftp::Result::ProtocolError;
+}
+
+void FtpImpl::finish_upload_data()
+{
+    _system_impl->mavlink_ftp().finish_upload_data();
+}
+
 std::pair<Ftp::Result, std::vector<std::string>> FtpImpl::list_directory(const std::string& path)
 {
     auto ret = _system_impl->mavlink_ftp().list_directory(path);
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <fstream>
+#include <functional>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "mavlink_include.h"
 #include "plugins/ftp/ftp.h"
@@ -27,6 +29,10 @@ public:
 
     ~FtpImpl() override;
 
+    // Not part of the Ftp API until ftp.proto has the matching RPCs.
+    using DownloadDataCallback =
+        std::function<void(Ftp::Result, const std::vector<uint8_t>&, Ftp::ProgressData)>;
+
     void init() override;
     void deinit() override;
 
@@ -50,6 +56,10 @@ public:
         const std::string& local_file_path,
         const std::string& remote_folder,
         Ftp::UploadCallback callback);
+    void download_data_async(const std::string& remote_file_path, DownloadDataCallback callback);
+    void upload_data_async(const std::string& remote_file_path, Ftp::ResultCallback callback);
+    Ftp::Result write_upload_data(const std::vector<uint8_t>& data);
+    void finish_upload_data();
     void list_directory_async(
         const std::string& path, Ftp::ListDirectoryCallback callback, uint32_t offset = 0);
     void create_directory_async(const std::string& path, Ftp::ResultCallback callback);
@@ -0,0 +1,134 @@
+#include "chunk_bitmap.h"
+
+#include <algorithm>
+#include <bitset>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace mavsdk {
+
+namespace {
+
+unsigned count_trailing_zeros(uint64_t word)
+{
+    // Assumes word is not 0.
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+}
+
+unsigned count_ones(uint64_t word)
+{
+    return static_cast<unsigned>(std::bitset<64>(word).count());
+}
+
+} // namespace
+
+void ChunkBitmap::reset(std::size_t num_chunks)
+{
+    _words.assign((num_chunks + BITS_PER_WORD - 1) / BITS_PER_WORD, 0);
+    _size = num_chunks;
+    _count = 0;
+}
+
+void ChunkBitmap::clear()
+{
+    _words.clear();
+    _words.shrink_to_fit();
+    _size = 0;
+    _count = 0;
+}
+
+bool ChunkBitmap::set(std::size_t index)
+{
+    if (index >= _size) {
+        return false;
+    }
+
+    const uint64_t mask = uint64_t(1) << (index % BITS_PER_WORD);
+    uint64_t& word = _words[index / BITS_PER_WORD];
+    if ((word & mask) != 0) {
+        return false;
+    }
+
+    word |= mask;
+    ++_count;
+    return true;
+}
+
+bool ChunkBitmap::test(std::size_t index) const
+{
+    if (index >= _size) {
+        return false;
+    }
+
+    return (_words[index / BITS_PER_WORD] & (uint64_t(1) << (index % BITS_PER_WORD))) != 0;
+}
+
+std::size_t ChunkBitmap::count(std::size_t begin, std::size_t end) const
+{
+    end = std::min(end, _size);
+    if (begin >= end) {
+        return 0;
+    }
+
+    const std::size_t first_word = begin / BITS_PER_WORD;
+    const std::size_t last_word = (end - 1) / BITS_PER_WORD;
+
+    std::size_t result = 0;
+    for (std::size_t i = first_word; i <= last_word; ++i) {
+        uint64_t word = _words[i];
+        if (i == first_word) {
+            word &= ~uint64_t(0) << (begin % BITS_PER_WORD);
+        }
+        if (i == last_word && (end % BITS_PER_WORD) != 0) {
+            word &= ~uint64_t(0) >> (BITS_PER_WORD - (end % BITS_PER_WORD));
+        }
+        result += count_ones(word);
+    }
+    return result;
+}
+
+std::size_t ChunkBitmap::find_first_missing(std::size_t from) const
+{
+    return find_first(from, false);
+}
+
+std::size_t ChunkBitmap::find_first_set(std::size_t from) const
+{
+    return find_first(from, true);
+}
+
+std::size_t ChunkBitmap::find_first(std::size_t from, bool value) const
+{
+    if (from >= _size) {
+        return _size;
+    }
+
+    std::size_t word_index = from / BITS_PER_WORD;
+
+    // Invert the words when looking for missing chunks so that we can
+    // always look for the first bit which is set.
+    uint64_t word = value ? _words[word_index] : ~_words[word_index];
+    word &= ~uint64_t(0) << (from % BITS_PER_WORD);
+
+    while (word == 0) {
+        ++word_index;
+        if (word_index >= _words.size()) {
+            return _size;
+        }
+        word = value ? _words[word_index] : ~_words[word_index];
+    }
+
+    // The padding bits of the last word are never set, so an inverted last
+    // word might point past the end.
+    return std::min(word_index * BITS_PER_WORD + count_trailing_zeros(word), _size);
+}
+
+} // namespace mavsdk
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mavsdk {
+
+// Keeps track of which chunks of a transfer have been received.
+//
+// One bit is used per chunk, so even multi-GB logs in chunks of 90 bytes
+// only need a few MB. Searching for gaps is done word by word, skipping
+// 64 chunks at a time where possible.
+class ChunkBitmap {
+public:
+    ChunkBitmap() = default;
+    ~ChunkBitmap() = default;
+
+    void reset(std::size_t num_chunks);
+    void clear();
+
+    // Returns true if the chunk was not set before.
+    bool set(std::size_t index);
+    bool test(std::size_t index) const;
+
+    std::size_t size() const { return _size; }
+    std::size_t count() const { return _count; }
+    bool complete() const { return _count == _size; }
+
+    // Number of chunks set in [begin, end).
+    std::size_t count(std::size_t begin, std::size_t end) const;
+
+    // Index of the first chunk at or after `from` which is missing,
+    // or size() if there is none.
+    std::size_t find_first_missing(std::size_t from) const;
+
+    // Index of the first chunk at or after `from` which is set,
+    // or size() if there is none.
+    std::size_t find_first_set(std::size_t from) const;
+
+private:
+    std::size_t find_first(std::size_t from, bool value) const;
+
+    static constexpr std::size_t BITS_PER_WORD = 64;
+
+    std::vector<uint64_t> _words{};
+    std::size_t _size{0};
+    std::size_t _count{0};
+};
+
+} // namespace mavsdk
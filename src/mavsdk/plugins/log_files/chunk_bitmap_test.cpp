@@ -0,0 +1,108 @@
+#include "chunk_bitmap.h"
+#include <gtest/gtest.h>
+
+using namespace mavsdk;
+
+TEST(ChunkBitmap, SetAndTest)
+{
+    ChunkBitmap bitmap;
+    bitmap.reset(100);
+
+    EXPECT_EQ(bitmap.size(), 100);
+    EXPECT_EQ(bitmap.count(), 0);
+    EXPECT_FALSE(bitmap.test(42));
+
+    EXPECT_TRUE(bitmap.set(42));
+    EXPECT_TRUE(bitmap.test(42));
+    EXPECT_EQ(bitmap.count(), 1);
+
+    // Setting twice is not counted twice.
+    EXPECT_FALSE(bitmap.set(42));
+    EXPECT_EQ(bitmap.count(), 1);
+
+    // Out of range is ignored.
+    EXPECT_FALSE(bitmap.set(100));
+    EXPECT_FALSE(bitmap.test(100));
+    EXPECT_EQ(bitmap.count(), 1);
+}
+
+TEST(ChunkBitmap, Complete)
+{
+    ChunkBitmap bitmap;
+    bitmap.reset(130);
+
+    for (std::size_t i = 0; i < 130; ++i) {
+        EXPECT_FALSE(bitmap.complete());
+        bitmap.set(i);
+    }
+    EXPECT_TRUE(bitmap.complete());
+    EXPECT_EQ(bitmap.find_first_missing(0), 130);
+}
+
+TEST(ChunkBitmap, FindFirstMissing)
+{
+    ChunkBitmap bitmap;
+    bitmap.reset(200);
+
+    EXPECT_EQ(bitmap.find_first_missing(0), 0);
+
+    for (std::size_t i = 0; i < 150; ++i) {
+        bitmap.set(i);
+    }
+    EXPECT_EQ(bitmap.find_first_missing(0), 150);
+    EXPECT_EQ(bitmap.find_first_missing(160), 160);
+    EXPECT_EQ(bitmap.find_first_missing(200), 200);
+
+    for (std::size_t i = 150; i < 200; ++i) {
+        bitmap.set(i);
+    }
+    // The padding in the last word must not be reported as missing.
+    EXPECT_EQ(bitmap.find_first_missing(0), 200);
+    EXPECT_EQ(bitmap.find_first_missing(190), 200);
+}
+
+TEST(ChunkBitmap, FindFirstSet)
+{
+    ChunkBitmap bitmap;
+    bitmap.reset(300);
+
+    EXPECT_EQ(bitmap.find_first_set(0), 300);
+
+    bitmap.set(5);
+    bitmap.set(257);
+
+    EXPECT_EQ(bitmap.find_first_set(0), 5);
+    EXPECT_EQ(bitmap.find_first_set(5), 5);
+    EXPECT_EQ(bitmap.find_first_set(6), 257);
+    EXPECT_EQ(bitmap.find_first_set(258), 300);
+}
+
+TEST(ChunkBitmap, CountRange)
+{
+    ChunkBitmap bitmap;
+    bitmap.reset(256);
+
+    for (std::size_t i = 10; i < 140; i += 2) {
+        bitmap.set(i);
+    }
+
+    EXPECT_EQ(bitmap.count(0, 256), 65);
+    EXPECT_EQ(bitmap.count(10, 11), 1);
+    EXPECT_EQ(bitmap.count(11, 12), 0);
+    EXPECT_EQ(bitmap.count(60, 70), 5);
+    EXPECT_EQ(bitmap.count(63, 129), 33);
+    EXPECT_EQ(bitmap.count(100, 100), 0);
+    EXPECT_EQ(bitmap.count(0, 1000), 65);
+}
+
+TEST(ChunkBitmap, Clear)
+{
+    ChunkBitmap bitmap;
+    bitmap.reset(10);
+    bitmap.set(1);
+    bitmap.clear();
+
+    EXPECT_EQ(bitmap.size(), 0);
+    EXPECT_EQ(bitmap.count(), 0);
+    EXPECT_TRUE(bitmap.complete());
+}
@@ -0,0 +1,132 @@
+#include "log_download_sidecar.h"
+#include "filesystem_include.h"
+#include "log.h"
+
+#include <fstream>
+#include <iomanip>
+#include <utility>
+
+namespace mavsdk {
+
+namespace {
+constexpr const char* header = "mavsdk-log-ranges";
+constexpr unsigned version = 1;
+} // namespace
+
+void LogDownloadSidecar::set(
+    const std::string& file_path, unsigned id, unsigned size_bytes, std::string date)
+{
+    _path = file_path + SUFFIX;
+    _id = id;
+    _size_bytes = size_bytes;
+    _date = std::move(date);
+}
+
+void LogDownloadSidecar::clear()
+{
+    _path.clear();
+    _id = 0;
+    _size_bytes = 0;
+    _date.clear();
+}
+
+bool LogDownloadSidecar::exists() const
+{
+    std::error_code ignored;
+    return !_path.empty() && fs::exists(fs::path(_path), ignored);
+}
+
+bool LogDownloadSidecar::load(ChunkBitmap& chunks) const
+{
+    std::ifstream file(_path);
+    if (!file) {
+        return false;
+    }
+
+    std::string read_header;
+    unsigned read_version = 0;
+    unsigned read_id = 0;
+    unsigned read_size_bytes = 0;
+    std::string read_date;
+    std::size_t num_ranges = 0;
+
+    file >> read_header >> read_version >> read_id >> read_size_bytes >>
+        std::quoted(read_date) >> num_ranges;
+
+    if (!file || read_header != header || read_version != version) {
+        LogWarn() << "Ignoring invalid sidecar " << _path;
+        return false;
+    }
+
+    if (read_id != _id || read_size_bytes != _size_bytes || read_date != _date) {
+        LogWarn() << "Sidecar " << _path << " belongs to a different log";
+        return false;
+    }
+
+    for (std::size_t i = 0; i < num_ranges; ++i) {
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        file >> begin >> end;
+        if (!file || begin > end || end > chunks.size()) {
+            LogWarn() << "Ignoring corrupt sidecar " << _path;
+            chunks.reset(chunks.size());
+            return false;
+        }
+        for (std::size_t chunk = begin; chunk < end; ++chunk) {
+            chunks.set(chunk);
+        }
+    }
+
+    return true;
+}
+
+bool LogDownloadSidecar::save(const ChunkBitmap& chunks) const
+{
+    // Collect ranges first, there are usually only a few.
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    std::size_t begin = chunks.find_first_set(0);
+    while (begin < chunks.size()) {
+        const std::size_t end = chunks.find_first_missing(begin);
+        ranges.emplace_back(begin, end);
+        begin = chunks.find_first_set(end);
+    }
+
+    // Write to a temporary file and swap it in, so that a crash during
+    // writing leaves the previous sidecar intact.
+    const std::string tmp_path = _path + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::out | std::ios::trunc);
+        if (!file) {
+            LogWarn() << "Could not write sidecar " << tmp_path;
+            return false;
+        }
+
+        file << header << ' ' << version << '\n'
+             << _id << ' ' << _size_bytes << ' ' << std::quoted(_date) << '\n'
+             << ranges.size() << '\n';
+        for (const auto& range : ranges) {
+            file << range.first << ' ' << range.second << '\n';
+        }
+
+        if (!file) {
+            LogWarn() << "Could not write sidecar " << tmp_path;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(fs::path(tmp_path), fs::path(_path), ec);
+    if (ec) {
+        LogWarn() << "Could not replace sidecar " << _path << ": " << ec.message();
+        return false;
+    }
+    return true;
+}
+
+void LogDownloadSidecar::remove() const
+{
+    std::error_code ignored;
+    fs::remove(fs::path(_path), ignored);
+}
+
+} // namespace mavsdk
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "chunk_bitmap.h"
+
+#include <string>
+
+namespace mavsdk {
+
+// Sidecar file stored next to a log file while it is being downloaded.
+//
+// It records which chunks have already been written to the log file so that
+// an interrupted download can be resumed instead of started from scratch.
+// The log is identified by id, size and date, so a sidecar is never applied
+// to a different log which happens to have the same id.
+class LogDownloadSidecar {
+public:
+    LogDownloadSidecar() = default;
+    ~LogDownloadSidecar() = default;
+
+    void set(const std::string& file_path, unsigned id, unsigned size_bytes, std::string date);
+    void clear();
+
+    const std::string& path() const { return _path; }
+    bool exists() const;
+
+    // Sets the chunks recorded in the sidecar. Returns false if there is no
+    // sidecar, or it is corrupt or belongs to a different log.
+    // The chunks need to be reset to the right size before.
+    bool load(ChunkBitmap& chunks) const;
+
+    // Atomically replaces the sidecar with the chunks given.
+    bool save(const ChunkBitmap& chunks) const;
+
+    void remove() const;
+
+    static constexpr const char* SUFFIX = ".ranges";
+
+private:
+    std::string _path{};
+    unsigned _id{0};
+    unsigned _size_bytes{0};
+    std::string _date{};
+};
+
+} // namespace mavsdk
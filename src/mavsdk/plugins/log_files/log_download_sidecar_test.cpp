@@ -0,0 +1,84 @@
+#include "log_download_sidecar.h"
+#include "fs.h"
+#include <gtest/gtest.h>
+#include <fstream>
+
+using namespace mavsdk;
+
+class LogDownloadSidecarTest : public testing::Test {
+protected:
+    void SetUp() override
+    {
+        auto maybe_tmp_dir = create_tmp_directory("mavsdk-log-download-sidecar-test");
+        ASSERT_TRUE(maybe_tmp_dir);
+        _file_path = maybe_tmp_dir.value() + path_separator + "log.ulg";
+    }
+
+    std::string _file_path;
+};
+
+TEST_F(LogDownloadSidecarTest, SaveAndLoad)
+{
+    LogDownloadSidecar sidecar;
+    sidecar.set(_file_path, 3, 10000, "2021-08-31T20:50:42Z");
+    EXPECT_FALSE(sidecar.exists());
+
+    ChunkBitmap chunks;
+    chunks.reset(112);
+    for (std::size_t i = 0; i < 50; ++i) {
+        chunks.set(i);
+    }
+    chunks.set(60);
+    for (std::size_t i = 100; i < 112; ++i) {
+        chunks.set(i);
+    }
+
+    ASSERT_TRUE(sidecar.save(chunks));
+    EXPECT_TRUE(sidecar.exists());
+
+    ChunkBitmap loaded;
+    loaded.reset(112);
+    ASSERT_TRUE(sidecar.load(loaded));
+    EXPECT_EQ(loaded.count(), chunks.count());
+    for (std::size_t i = 0; i < 112; ++i) {
+        EXPECT_EQ(loaded.test(i), chunks.test(i));
+    }
+
+    sidecar.remove();
+    EXPECT_FALSE(sidecar.exists());
+}
+
+TEST_F(LogDownloadSidecarTest, DifferentLog)
+{
+    LogDownloadSidecar sidecar;
+    sidecar.set(_file_path, 3, 10000, "2021-08-31T20:50:42Z");
+
+    ChunkBitmap chunks;
+    chunks.reset(112);
+    chunks.set(0);
+    ASSERT_TRUE(sidecar.save(chunks));
+
+    LogDownloadSidecar other;
+    other.set(_file_path, 3, 10000, "2021-09-01T10:00:00Z");
+
+    ChunkBitmap loaded;
+    loaded.reset(112);
+    EXPECT_FALSE(other.load(loaded));
+    EXPECT_EQ(loaded.count(), 0);
+}
+
+TEST_F(LogDownloadSidecarTest, Corrupt)
+{
+    LogDownloadSidecar sidecar;
+    sidecar.set(_file_path, 3, 900, "");
+
+    {
+        std::ofstream file(sidecar.path());
+        file << "mavsdk-log-ranges 1\n3 900 \"\"\n1\n0 500\n";
+    }
+
+    ChunkBitmap loaded;
+    loaded.reset(10);
+    EXPECT_FALSE(sidecar.load(loaded));
+    EXPECT_EQ(loaded.count(), 0);
+}
@@ -43,14 +43,41 @@ void LogFilesImpl::init()
 
 void LogFilesImpl::deinit()
 {
+    // Everyone still waiting gets an answer, otherwise the blocking calls
+    // would never return.
     {
         std::lock_guard<std::mutex> lock(_entries.mutex);
         _system_impl->unregister_timeout_handler(_entries.cookie);
+
+        if (_entries.callback) {
+            const auto tmp_callback = _entries.callback;
+            _system_impl->call_user_callback([tmp_callback]() {
+                std::vector<LogFiles::Entry> empty_vector{};
+                tmp_callback(LogFiles::Result::NoSystem, empty_vector);
+            });
+            _entries.callback = nullptr;
+        }
     }
 
     {
         std::lock_guard<std::mutex> lock(_data.mutex);
         _system_impl->unregister_timeout_handler(_data.cookie);
+        _system_impl->remove_call_every(_data.check_cookie);
+
+        // Keep what we have so far to resume later.
+        if (_data.downloading) {
+            save_sidecar();
+            finish_logfile();
+            call_download_callback(_data.callback, LogFiles::Result::NoSystem, NAN);
+            call_data_callback(_data.data_callback, LogFiles::Result::NoSystem);
+            reset_data();
+        }
+
+        for (const auto& download : _data.queue) {
+            call_download_callback(download.callback, LogFiles::Result::NoSystem, NAN);
+            call_data_callback(download.data_callback, LogFiles::Result::NoSystem);
+        }
+        _data.queue.clear();
     }
     _system_impl->unregister_all_mavlink_message_handlers(this);
 }
@@ -139,6 +166,7 @@ void LogFilesImpl::process_log_entry(const mavlink_message_t& message)
             _system_impl->call_user_callback([tmp_callback, empty_list]() {
                 tmp_callback(LogFiles::Result::NoLogfiles, empty_list);
             });
+            _entries.callback = nullptr;
         }
         return;
     }
@@ -178,6 +206,7 @@ void LogFilesImpl::list_timeout()
             _system_impl->call_user_callback([tmp_callback, entry_list]() {
                 tmp_callback(LogFiles::Result::Success, entry_list);
             });
+            _entries.callback = nullptr;
         }
     } else {
         if (_entries.retries > 3) {
@@ -188,6 +217,7 @@ void LogFilesImpl::list_timeout()
                     std::vector<LogFiles::Entry> empty_vector{};
                     tmp_callback(LogFiles::Result::Timeout, empty_vector);
                 });
+                _entries.callback = nullptr;
             }
         } else {
             for (unsigned i = 0; i < _entries.max_list_id; ++i) {
@@ -224,94 +254,237 @@ LogFilesImpl::download_log_file(LogFiles::Entry entry, const std::string& file_p
 void LogFilesImpl::download_log_file_async(
     LogFiles::Entry entry, const std::string& file_path, LogFiles::DownloadLogFileCallback callback)
 {
-    unsigned bytes_to_get;
+    queue_download(QueuedDownload{entry, file_path, callback, nullptr});
+}
+
+void LogFilesImpl::download_log_file_data_async(
+    LogFiles::Entry entry, DownloadLogFileDataCallback callback)
+{
+    queue_download(QueuedDownload{entry, "", nullptr, callback});
+}
+
+void LogFilesImpl::queue_download(QueuedDownload download)
+{
     {
         std::lock_guard<std::mutex> lock(_entries.mutex);
 
-        auto it = _entries.entry_map.find(entry.id);
-        if (it == _entries.entry_map.end()) {
-            LogErr() << "Log entry id " << entry.id << " not found";
-            if (callback) {
-                const auto tmp_callback = callback;
-                _system_impl->call_user_callback([tmp_callback]() {
-                    LogFiles::ProgressData progress;
-                    progress.progress = 0.0f;
-                    tmp_callback(LogFiles::Result::InvalidArgument, progress);
-                });
-            }
+        auto it = _entries.entry_map.find(download.entry.id);
+        if (it != _entries.entry_map.end()) {
+            download.entry = it->second;
+        } else if (download.entry.size_bytes == 0) {
+            // Without a size from a previous listing we can't download it.
+            LogErr() << "Log entry id " << download.entry.id << " not found";
+            call_download_callback(download.callback, LogFiles::Result::InvalidArgument, 0.0f);
+            call_data_callback(download.data_callback, LogFiles::Result::InvalidArgument);
             return;
         }
+    }
+
+    std::lock_guard<std::mutex> lock(_data.mutex);
+
+    _data.queue.push_back(std::move(download));
 
-        bytes_to_get = _entries.entry_map[entry.id].size_bytes;
+    if (!_data.downloading) {
+        start_next_download();
     }
+}
 
-    {
-        std::lock_guard<std::mutex> lock(_data.mutex);
+void LogFilesImpl::start_next_download()
+{
+    // Assumes to have the lock for _data.mutex.
 
-        if (is_directory(file_path)) {
-            if (callback) {
-                const auto tmp_callback = callback;
-                _system_impl->call_user_callback([tmp_callback]() {
-                    LogFiles::ProgressData progress;
-                    progress.progress = NAN;
-                    LogErr()
-                        << "Invalid path! The path must point to an unexisting file, and it points to a directory!";
-                    tmp_callback(LogFiles::Result::InvalidArgument, progress);
-                });
-            }
+    while (!_data.queue.empty()) {
+        const auto download = _data.queue.front();
+        _data.queue.pop_front();
+
+        if (start_download(download)) {
             return;
         }
+    }
+}
 
-        if (file_exists(file_path)) {
-            if (callback) {
-                const auto tmp_callback = callback;
-                _system_impl->call_user_callback([tmp_callback]() {
-                    LogFiles::ProgressData progress;
-                    progress.progress = NAN;
-                    LogErr() << "Target log file already exists!";
-                    tmp_callback(LogFiles::Result::InvalidArgument, progress);
-                });
-            }
-            return;
+bool LogFilesImpl::start_download(const QueuedDownload& download)
+{
+    // Assumes to have the lock for _data.mutex.
+
+    const auto& entry = download.entry;
+
+    const auto num_chunks = entry.size_bytes / MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN +
+                            ((entry.size_bytes % MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN) != 0);
+    _data.chunks_received.reset(num_chunks);
+
+    // When streaming there is no file to prepare and nothing to resume.
+    bool resume = false;
+    if (!download.data_callback && !prepare_logfile(download, resume)) {
+        return false;
+    }
+
+    _data.downloading = true;
+    _data.id = entry.id;
+    _data.callback = download.callback;
+    _data.data_callback = download.data_callback;
+    if (_data.data_callback) {
+        _data.stream_queued_bytes = std::make_shared<std::atomic<std::size_t>>(0);
+    }
+    _data.file_path = download.file_path;
+    _data.time_started = _time.steady_time();
+    _data.bytes_to_get = entry.size_bytes;
+    _data.first_missing_chunk = 0;
+    // When resuming we don't know what was requested before, so we treat
+    // everything missing as gaps.
+    _data.next_chunk_to_request = resume ? num_chunks : 0;
+    _data.window_chunks = INITIAL_WINDOW_CHUNKS;
+    _data.retries = 0;
+    _data.file_pos = 0;
+
+    // Write the sidecar right away so that even a download interrupted
+    // right at the start can be resumed.
+    save_sidecar();
+
+    _system_impl->register_timeout_handler(
+        [this]() { LogFilesImpl::data_timeout(); }, _system_impl->timeout_s(), &_data.cookie);
+    _system_impl->add_call_every(
+        [this]() { check_download(); }, CHECK_INTERVAL_S, &_data.check_cookie);
+
+    call_download_callback(
+        _data.callback,
+        LogFiles::Result::Next,
+        num_chunks > 0 ? float(_data.chunks_received.count()) / float(num_chunks) : 0.0f);
+
+    request_next();
+    return true;
+}
+
+bool LogFilesImpl::prepare_logfile(const QueuedDownload& download, bool& resume)
+{
+    // Assumes to have the lock for _data.mutex.
+
+    const auto& entry = download.entry;
+    const auto& file_path = download.file_path;
+
+    if (is_directory(file_path)) {
+        LogErr()
+            << "Invalid path! The path must point to an unexisting file, and it points to a directory!";
+        reset_data();
+        call_download_callback(download.callback, LogFiles::Result::InvalidArgument, NAN);
+        return false;
+    }
+
+    _data.sidecar.set(file_path, entry.id, entry.size_bytes, entry.date);
+
+    // An existing file can only be continued if we left a sidecar next to it.
+    resume = file_exists(file_path);
+    if (resume) {
+        if (!_data.sidecar.exists()) {
+            LogErr() << "Target log file already exists!";
+            reset_data();
+            call_download_callback(download.callback, LogFiles::Result::InvalidArgument, NAN);
+            return false;
         }
 
-        if (!start_logfile(file_path)) {
-            if (callback) {
-                const auto tmp_callback = callback;
-                _system_impl->call_user_callback([tmp_callback]() {
-                    LogFiles::ProgressData progress;
-                    progress.progress = NAN;
-                    tmp_callback(LogFiles::Result::FileOpenFailed, progress);
-                });
-            }
-            return;
+        if (!_data.sidecar.load(_data.chunks_received)) {
+            LogErr() << "Cannot resume download into " << file_path;
+            reset_data();
+            call_download_callback(download.callback, LogFiles::Result::InvalidArgument, NAN);
+            return false;
         }
 
-        _data.id = entry.id;
-        _data.callback = callback;
-        _data.time_started = _time.steady_time();
-        _data.bytes_to_get = bytes_to_get;
-        _data.part_start = 0;
-        const auto part_size = determine_part_end() - _data.part_start;
-        _data.bytes.resize(part_size);
-        _data.chunks_received.resize(
-            part_size / MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN +
-            ((part_size % MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN) != 0));
+        LogInfo() << "Resuming download of log " << entry.id << " with "
+                  << _data.chunks_received.count() << " of " << _data.chunks_received.size()
+                  << " chunks";
+    }
 
-        _system_impl->register_timeout_handler(
-            [this]() { LogFilesImpl::data_timeout(); }, _system_impl->timeout_s(), &_data.cookie);
+    if (!start_logfile(file_path, resume)) {
+        reset_data();
+        call_download_callback(download.callback, LogFiles::Result::FileOpenFailed, NAN);
+        return false;
+    }
 
-        request_log_data(_data.id, _data.part_start, _data.bytes.size());
+    return true;
+}
 
-        if (_data.callback) {
-            const auto tmp_callback = _data.callback;
-            _system_impl->call_user_callback([tmp_callback]() {
-                LogFiles::ProgressData progress;
-                progress.progress = 0.0f;
-                tmp_callback(LogFiles::Result::Next, progress);
-            });
+void LogFilesImpl::finish_download(LogFiles::Result result, float progress)
+{
+    // Assumes to have the lock for _data.mutex.
+
+    _system_impl->unregister_timeout_handler(_data.cookie);
+    _system_impl->remove_call_every(_data.check_cookie);
+
+    if (_data.data_callback) {
+        if (result == LogFiles::Result::Success) {
+            flush_stream();
         }
+        call_data_callback(_data.data_callback, result);
+
+        reset_data();
+        start_next_download();
+        return;
     }
+
+    finish_logfile();
+
+    if (result == LogFiles::Result::Success) {
+        // Double check that the file ended up as big as the log before
+        // getting rid of the sidecar.
+        std::error_code ec;
+        const auto file_size = fs::file_size(fs::path(_data.file_path), ec);
+        if (ec || file_size != _data.bytes_to_get) {
+            LogErr() << "Log file has wrong size after download: " << file_size << " instead of "
+                     << _data.bytes_to_get << " B";
+            result = LogFiles::Result::Unknown;
+            progress = NAN;
+        } else {
+            _data.sidecar.remove();
+        }
+    } else {
+        save_sidecar();
+    }
+
+    call_download_callback(_data.callback, result, progress);
+
+    reset_data();
+
+    start_next_download();
+}
+
+void LogFilesImpl::call_download_callback(
+    const LogFiles::DownloadLogFileCallback& callback, LogFiles::Result result, float progress)
+{
+    if (callback) {
+        const auto tmp_callback = callback;
+        _system_impl->call_user_callback([tmp_callback, result, progress]() {
+            LogFiles::ProgressData progress_data;
+            progress_data.progress = progress;
+            tmp_callback(result, progress_data);
+        });
+    }
+}
+
+void LogFilesImpl::call_data_callback(
+    const DownloadLogFileDataCallback& callback, LogFiles::Result result)
+{
+    if (callback) {
+        const auto tmp_callback = callback;
+        _system_impl->call_user_callback([tmp_callback, result]() {
+            const std::vector<uint8_t> no_data{};
+            tmp_callback(result, no_data);
+        });
+    }
+}
+
+void LogFilesImpl::save_sidecar()
+{
+    // Assumes to have the lock for _data.mutex.
+
+    if (_data.data_callback) {
+        // Nothing to resume into when streaming.
+        return;
+    }
+
+    // The data has to be on disk before the sidecar claims it is.
+    _data.file.flush();
+    _data.sidecar.save(_data.chunks_received);
+    _data.last_sidecar_save = _time.steady_time();
 }
 
 LogFiles::Result LogFilesImpl::erase_all_log_files()
@@ -329,15 +502,6 @@ LogFiles::Result LogFilesImpl::erase_all_log_files()
     return LogFiles::Result::Success;
 }
 
-std::size_t LogFilesImpl::determine_part_end()
-{
-    // Assumes to have the lock for _data.mutex.
-
-    return std::min(
-        _data.part_start + PART_SIZE * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN,
-        std::size_t(_data.bytes_to_get));
-}
-
 void LogFilesImpl::process_log_data(const mavlink_message_t& message)
 {
     mavlink_log_data_t log_data;
@@ -354,31 +518,133 @@ void LogFilesImpl::process_log_data(const mavlink_message_t& message)
 
     std::lock_guard<std::mutex> lock(_data.mutex);
 
+    if (!_data.downloading || log_data.id != _data.id) {
+        // Leftovers of a previous download.
+        return;
+    }
+
     _system_impl->refresh_timeout_handler(_data.cookie);
+    _data.retries = 0;
 
     if (log_data.count > MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN) {
         LogErr() << "Ignoring wrong count";
         return;
     }
 
-    if (log_data.ofs < _data.part_start ||
-        log_data.ofs + log_data.count > _data.part_start + _data.bytes.size()) {
+    if (log_data.ofs % MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN != 0 ||
+        uint64_t(log_data.ofs) + log_data.count > _data.bytes_to_get) {
         LogErr() << "Ignoring wrong offset";
         return;
     }
 
-    std::memcpy(&_data.bytes[log_data.ofs - _data.part_start], log_data.data, log_data.count);
-    _data.chunks_received[(log_data.ofs - _data.part_start) / MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN] =
-        true;
+    process_chunk(log_data.ofs, log_data.data, log_data.count);
+}
+
+void LogFilesImpl::process_chunk(uint32_t ofs, const uint8_t* data, uint8_t count)
+{
+    // Assumes to have the lock for _data.mutex.
+
+    const std::size_t index = ofs / MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
+    const unsigned expected_count =
+        std::min(unsigned(MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN), _data.bytes_to_get - ofs);
+
+    if (count != expected_count) {
+        LogErr() << "Ignoring chunk of wrong size";
+        return;
+    }
+
+    // Chunks can arrive several times if we re-requested them too eagerly,
+    // we only need to write them once.
+    if (!_data.chunks_received.test(index)) {
+        if (_data.data_callback) {
+            stream_chunk(index, data, count);
+        } else if (!write_chunk_to_disk(ofs, data, count)) {
+            LogErr() << "Writing to log file failed";
+            finish_download(LogFiles::Result::FileOpenFailed, NAN);
+            return;
+        }
+
+        _data.chunks_received.set(index);
+
+        if (index >= _data.request_begin && index < _data.request_end) {
+            ++_data.request_received;
+        }
+    }
+
+    if (index >= _data.request_begin && index < _data.request_end) {
+        ++_data.request_arrived;
+        _data.last_chunk_arrived = _time.steady_time();
+    }
 
-    if (log_data.ofs + log_data.count - _data.part_start == _data.bytes.size() ||
-        _data.rerequesting) {
-        // We received last message of this part.
-        _data.rerequesting = true;
-        check_part();
+    if (index + 1 == _data.request_end) {
+        // We received the last message of this request, keep going right
+        // away without waiting for anything else.
+        finish_request();
+        request_next();
     }
 }
 
+void LogFilesImpl::stream_chunk(std::size_t index, const uint8_t* data, uint8_t count)
+{
+    // Assumes to have the lock for _data.mutex.
+
+    if (index != _data.stream_next_chunk) {
+        _data.stream_pending.emplace(index, std::vector<uint8_t>(data, data + count));
+        return;
+    }
+
+    _data.stream_batch.insert(_data.stream_batch.end(), data, data + count);
+    ++_data.stream_next_chunk;
+
+    // The gap is filled, whatever was waiting behind it can go as well.
+    auto it = _data.stream_pending.begin();
+    while (it != _data.stream_pending.end() && it->first == _data.stream_next_chunk) {
+        _data.stream_batch.insert(_data.stream_batch.end(), it->second.begin(), it->second.end());
+        ++_data.stream_next_chunk;
+        it = _data.stream_pending.erase(it);
+    }
+
+    if (_data.stream_batch.size() >= STREAM_BATCH_BYTES) {
+        flush_stream();
+    }
+}
+
+void LogFilesImpl::flush_stream()
+{
+    // Assumes to have the lock for _data.mutex.
+
+    if (_data.stream_batch.empty()) {
+        return;
+    }
+
+    *_data.stream_queued_bytes += _data.stream_batch.size();
+
+    const auto tmp_callback = _data.data_callback;
+    const auto queued_bytes = _data.stream_queued_bytes;
+    auto batch = std::make_shared<std::vector<uint8_t>>(std::move(_data.stream_batch));
+    _data.stream_batch.clear();
+
+    _system_impl->call_user_callback([tmp_callback, queued_bytes, batch]() {
+        tmp_callback(LogFiles::Result::Next, *batch);
+        // Only once the user is done with it, we count it as consumed.
+        *queued_bytes -= batch->size();
+    });
+}
+
+void LogFilesImpl::resume_stream()
+{
+    // Assumes to have the lock for _data.mutex.
+
+    if (*_data.stream_queued_bytes >= MAX_STREAM_QUEUED_BYTES) {
+        return;
+    }
+
+    _data.stream_paused = false;
+    _system_impl->register_timeout_handler(
+        [this]() { LogFilesImpl::data_timeout(); }, _system_impl->timeout_s(), &_data.cookie);
+    request_next();
+}
+
 void LogFilesImpl::report_progress(unsigned transferred, unsigned total)
 {
     float progress = float(transferred) / float(total);
@@ -394,65 +660,94 @@ void LogFilesImpl::report_progress(unsigned transferred, unsigned total)
     }
 }
 
-void LogFilesImpl::check_part()
+void LogFilesImpl::finish_request()
 {
     // Assumes to have the lock for _data.mutex.
 
-    auto first_missing =
-        std::find(_data.chunks_received.begin(), _data.chunks_received.end(), false);
-    if (first_missing != _data.chunks_received.end()) {
-        auto first_missing_index = std::distance(_data.chunks_received.begin(), first_missing);
+    if (_data.request_expected > 0) {
+        const auto lost = _data.request_expected - _data.request_received;
+        const float loss_ratio = float(lost) / float(_data.request_expected);
 
-        auto first_not_missing = std::find(first_missing, _data.chunks_received.end(), true);
+        if (lost == 0) {
+            _data.window_chunks = std::min(_data.window_chunks * 2, std::size_t(MAX_WINDOW_CHUNKS));
+        } else if (loss_ratio > MAX_LOSS_RATIO) {
+            _data.window_chunks = std::max(_data.window_chunks / 2, std::size_t(MIN_WINDOW_CHUNKS));
+        }
+    }
 
-        auto first_not_missing_index =
-            std::distance(_data.chunks_received.begin(), first_not_missing);
+    const unsigned bytes_received = std::min(
+        unsigned(_data.chunks_received.count() * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN),
+        _data.bytes_to_get);
 
-        request_log_data(
-            _data.id,
-            _data.part_start + first_missing_index * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN,
-            (first_not_missing_index - first_missing_index) * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
-    } else {
-        _data.rerequesting = false;
+    report_progress(bytes_received, _data.bytes_to_get);
 
-        write_part_to_disk();
+    const float kib_s =
+        float(bytes_received) / float(_time.elapsed_since_s(_data.time_started)) / 1024.0f;
 
-        report_progress(_data.part_start + _data.bytes.size(), _data.bytes_to_get);
+    LogDebug() << bytes_received << " B of " << _data.bytes_to_get << " B (" << kib_s
+               << " kiB/s, window: " << _data.window_chunks << ")";
 
-        const float kib_s = float(_data.part_start + _data.bytes.size()) /
-                            float(_time.elapsed_since_s(_data.time_started)) / 1024.0f;
+    if (_data.data_callback) {
+        // Don't keep what we have back until the batch is full.
+        flush_stream();
+    } else if (_time.elapsed_since_s(_data.last_sidecar_save) > SIDECAR_SAVE_INTERVAL_S) {
+        save_sidecar();
+    }
+}
 
-        LogDebug() << _data.part_start + _data.bytes.size() << " B of " << _data.bytes_to_get
-                   << " B (" << kib_s << " kiB/s)";
+void LogFilesImpl::request_next()
+{
+    // Assumes to have the lock for _data.mutex.
 
-        if (_data.part_start + _data.bytes.size() == _data.bytes_to_get) {
-            _system_impl->unregister_timeout_handler(_data.cookie);
+    auto& chunks = _data.chunks_received;
 
-            finish_logfile();
+    _data.first_missing_chunk = chunks.find_first_missing(_data.first_missing_chunk);
 
-            if (_data.callback) {
-                const auto tmp_callback = _data.callback;
-                _system_impl->call_user_callback([tmp_callback]() {
-                    LogFiles::ProgressData progress_data;
-                    progress_data.progress = 1.0f;
-                    tmp_callback(LogFiles::Result::Success, progress_data);
-                });
-            }
-
-            reset_data();
-        } else {
-            _data.part_start = _data.part_start + _data.bytes.size();
+    if (_data.first_missing_chunk == chunks.size()) {
+        finish_download(LogFiles::Result::Success, 1.0f);
+        return;
+    }
 
-            const auto part_size = determine_part_end() - _data.part_start;
-            _data.bytes.resize(part_size);
-            _data.chunks_received.resize(
-                part_size / MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN +
-                ((part_size % MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN) != 0));
-            std::fill(_data.chunks_received.begin(), _data.chunks_received.end(), false);
+    if (_data.data_callback && *_data.stream_queued_bytes >= MAX_STREAM_QUEUED_BYTES) {
+        // The user is not keeping up, so we stop asking for more until
+        // enough of what was handed over has been consumed. Without that,
+        // the callback queue would grow with the size of the log.
+        _data.stream_paused = true;
+        _system_impl->unregister_timeout_handler(_data.cookie);
+        return;
+    }
 
-            request_log_data(_data.id, _data.part_start, _data.bytes.size());
+    std::size_t begin = _data.first_missing_chunk;
+    std::size_t end;
+
+    if (begin < _data.next_chunk_to_request) {
+        // There are gaps behind what we have requested so far. We fill as
+        // many of them as fit into one window with one request, even if that
+        // means that some chunks in between are sent again.
+        const auto limit = std::min(begin + _data.window_chunks, _data.next_chunk_to_request);
+        end = begin;
+        std::size_t i = begin;
+        while (i < limit) {
+            end = std::min(chunks.find_first_set(i), limit);
+            i = chunks.find_first_missing(end);
         }
+    } else {
+        end = std::min(begin + _data.window_chunks, chunks.size());
+        _data.next_chunk_to_request = end;
     }
+
+    _data.request_begin = begin;
+    _data.request_end = end;
+    _data.request_expected = (end - begin) - chunks.count(begin, end);
+    _data.request_received = 0;
+    _data.request_arrived = 0;
+    _data.request_sent = _time.steady_time();
+
+    const std::size_t start_byte = begin * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
+    const std::size_t end_byte =
+        std::min(end * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN, std::size_t(_data.bytes_to_get));
+
+    request_log_data(_data.id, unsigned(start_byte), unsigned(end_byte - start_byte));
 }
 
 void LogFilesImpl::request_log_data(unsigned id, unsigned start, unsigned count)
@@ -475,13 +770,57 @@ void LogFilesImpl::data_timeout()
 {
     {
         std::lock_guard<std::mutex> lock(_data.mutex);
+
+        if (++_data.retries > MAX_RETRIES) {
+            LogWarn() << "Too many log data retries, giving up.";
+            finish_download(LogFiles::Result::Timeout, NAN);
+            return;
+        }
+
         _system_impl->register_timeout_handler(
             [this]() { LogFilesImpl::data_timeout(); }, _system_impl->timeout_s(), &_data.cookie);
-        _data.rerequesting = true;
-        check_part();
+
+        // Whatever is still in flight is lost, so we need to go slower.
+        _data.window_chunks = std::max(_data.window_chunks / 2, std::size_t(MIN_WINDOW_CHUNKS));
+        request_next();
     }
 }
 
+void LogFilesImpl::check_download()
+{
+    std::lock_guard<std::mutex> lock(_data.mutex);
+
+    if (!_data.downloading) {
+        return;
+    }
+
+    if (_data.stream_paused) {
+        resume_stream();
+        return;
+    }
+
+    // Until the first chunk arrives, we don't know how fast they come, and
+    // the data timeout takes care of requests that get no answer at all.
+    if (_data.request_arrived == 0) {
+        return;
+    }
+
+    const double chunk_interval_s =
+        std::chrono::duration<double>(_data.last_chunk_arrived - _data.request_sent).count() /
+        static_cast<double>(_data.request_arrived);
+    const double tail_wait_s =
+        std::max(TAIL_WAIT_CHUNK_INTERVALS * chunk_interval_s, MIN_TAIL_WAIT_S);
+
+    if (_time.elapsed_since_s(_data.last_chunk_arrived) < tail_wait_s) {
+        return;
+    }
+
+    // The end of the request went by without its last chunk. Whatever is
+    // missing is requested again from the bitmap, along with what's next.
+    finish_request();
+    request_next();
+}
+
 bool LogFilesImpl::is_directory(const std::string& path) const
 {
     fs::path file_path(path);
@@ -496,21 +835,36 @@ bool LogFilesImpl::file_exists(const std::string& path) const
     return fs::exists(file_path, ignored);
 }
 
-bool LogFilesImpl::start_logfile(const std::string& path)
+bool LogFilesImpl::start_logfile(const std::string& path, bool resume)
 {
     // Assumes to have the lock for _data.mutex.
     // Assumes that the path is valid and points to a file (not a directory)
 
-    _data.file.open(path, std::ios::out | std::ios::binary);
+    if (resume) {
+        // Keep what is already there.
+        _data.file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+    } else {
+        _data.file.open(path, std::ios::out | std::ios::binary);
+    }
 
     return ((_data.file.rdstate() & std::ofstream::failbit) == 0);
 }
 
-void LogFilesImpl::write_part_to_disk()
+bool LogFilesImpl::write_chunk_to_disk(uint32_t ofs, const uint8_t* data, uint8_t count)
 {
     // Assumes to have the lock for _data.mutex.
 
-    _data.file.write(reinterpret_cast<char*>(_data.bytes.data()), _data.bytes.size());
+    // Chunks are written straight to their place in the file. As long as
+    // they arrive in order we don't need to seek and the stream buffers the
+    // writes for us.
+    if (_data.file_pos != ofs) {
+        _data.file.seekp(static_cast<std::streamoff>(ofs));
+    }
+
+    _data.file.write(reinterpret_cast<const char*>(data), count);
+    _data.file_pos = uint64_t(ofs) + count;
+
+    return _data.file.good();
 }
 
 void LogFilesImpl::finish_logfile()
@@ -523,15 +877,29 @@ void LogFilesImpl::finish_logfile()
 void LogFilesImpl::reset_data()
 {
     // Assumes to have the lock for _data.mutex.
+    _data.downloading = false;
     _data.id = 0;
     _data.bytes_to_get = 0;
-    _data.bytes.clear();
     _data.chunks_received.clear();
-    _data.part_start = 0;
+    _data.first_missing_chunk = 0;
+    _data.next_chunk_to_request = 0;
+    _data.window_chunks = INITIAL_WINDOW_CHUNKS;
+    _data.request_begin = 0;
+    _data.request_end = 0;
+    _data.request_expected = 0;
+    _data.request_received = 0;
+    _data.request_arrived = 0;
     _data.retries = 0;
-    _data.rerequesting = false;
-    _data.last_ofs_rerequested = -1;
+    _data.file_pos = 0;
+    _data.file_path.clear();
+    _data.sidecar.clear();
     _data.callback = nullptr;
+    _data.data_callback = nullptr;
+    _data.stream_pending.clear();
+    _data.stream_next_chunk = 0;
+    _data.stream_batch.clear();
+    _data.stream_queued_bytes.reset();
+    _data.stream_paused = false;
 }
 
 } // namespace mavsdk
@@ -4,7 +4,15 @@
 #include "plugins/log_files/log_files.h"
 #include "plugin_impl_base.h"
 #include "system.h"
+#include "chunk_bitmap.h"
+#include "log_download_sidecar.h"
+#include <atomic>
+#include <deque>
 #include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
 
 namespace mavsdk {
 
@@ -14,6 +22,10 @@ public:
     explicit LogFilesImpl(std::shared_ptr<System> system);
     ~LogFilesImpl() override;
 
+    // Not part of the LogFiles API until log_files.proto has the matching RPC.
+    using DownloadLogFileDataCallback =
+        std::function<void(LogFiles::Result, const std::vector<uint8_t>&)>;
+
     void init() override;
     void deinit() override;
 
@@ -31,6 +43,8 @@ public:
         const std::string& file_path,
         LogFiles::DownloadLogFileCallback callback);
 
+    void download_log_file_data_async(LogFiles::Entry entry, DownloadLogFileDataCallback callback);
+
     LogFiles::Result erase_all_log_files();
 
 private:
@@ -42,18 +56,42 @@ private:
 
     void request_list_entry(int entry_id);
 
-    void check_part();
+    struct QueuedDownload {
+        LogFiles::Entry entry{};
+        std::string file_path{};
+        LogFiles::DownloadLogFileCallback callback{nullptr};
+        // Set instead of a file path if the data is handed to the user.
+        DownloadLogFileDataCallback data_callback{nullptr};
+    };
+
+    void queue_download(QueuedDownload download);
+    void start_next_download();
+    bool start_download(const QueuedDownload& download);
+    bool prepare_logfile(const QueuedDownload& download, bool& resume);
+    void finish_download(LogFiles::Result result, float progress);
+    void call_download_callback(
+        const LogFiles::DownloadLogFileCallback& callback, LogFiles::Result result, float progress);
+    void save_sidecar();
+
+    void stream_chunk(std::size_t index, const uint8_t* data, uint8_t count);
+    void flush_stream();
+    void resume_stream();
+    void call_data_callback(const DownloadLogFileDataCallback& callback, LogFiles::Result result);
+
+    void process_chunk(uint32_t ofs, const uint8_t* data, uint8_t count);
+    void request_next();
+    void finish_request();
     void request_log_data(unsigned id, unsigned start, unsigned count);
     void data_timeout();
+    void check_download();
 
     bool is_directory(const std::string& path) const;
     bool file_exists(const std::string& path) const;
-    bool start_logfile(const std::string& path);
-    void write_part_to_disk();
+    bool start_logfile(const std::string& path, bool resume);
+    bool write_chunk_to_disk(uint32_t ofs, const uint8_t* data, uint8_t count);
     void finish_logfile();
     void report_progress(unsigned transferred, unsigned total);
 
-    std::size_t determine_part_end();
     void reset_data();
 
     Time _time{};
@@ -67,30 +105,86 @@ private:
         void* cookie{nullptr};
     } _entries{};
 
-    // We download data in parts of 512 * 90 bytes.
-    // If we request the whole file at once we get too much data at once and
-    // can't keep up (at least for PX4 SITL). Also, we need to keep track of
-    // way too many parts which makes the progress and re-transmission
-    // calculation too expensive.
+    // We download the log as a stream of requests, each covering a window of
+    // chunks (one LOG_DATA message each). As soon as the last chunk of a
+    // request arrives the next one is sent, either to fill gaps left behind
+    // or to continue ahead. If the last chunk is lost, the next request is
+    // sent once it is overdue, judging by how fast the others came in, rather
+    // than only after the data timeout.
     //
-    // This is very much inspired from how QGroundControl does it.
-    static constexpr unsigned PART_SIZE = 512;
-    // A part refers to the
+    // If we request the whole file at once we get too much data at once and
+    // can't keep up (at least for PX4 SITL), so the window is adapted to the
+    // loss observed: it grows while requests arrive complete and shrinks when
+    // chunks go missing or requests time out.
+    static constexpr unsigned INITIAL_WINDOW_CHUNKS = 512;
+    static constexpr unsigned MIN_WINDOW_CHUNKS = 16;
+    static constexpr unsigned MAX_WINDOW_CHUNKS = 4096;
+    // Shrink the window if more than this ratio of a request was lost.
+    static constexpr float MAX_LOSS_RATIO = 0.1f;
+    // Give up after this many timeouts in a row, the sidecar allows to
+    // resume later.
+    static constexpr unsigned MAX_RETRIES = 10;
+    // The last chunk of a request is overdue after this many times the
+    // average interval between chunks, but at least after the minimum.
+    static constexpr double TAIL_WAIT_CHUNK_INTERVALS = 4.0;
+    static constexpr double MIN_TAIL_WAIT_S = 0.05;
+    // For overdue requests and whether a paused stream can carry on.
+    static constexpr double CHECK_INTERVAL_S = 0.05;
+    static constexpr double SIDECAR_SAVE_INTERVAL_S = 1.0;
+    // When streaming, data is handed to the user in batches of about this
+    // size, and nothing more is requested from the vehicle while this much
+    // is still waiting to be consumed. Once enough of it is, the periodic
+    // check carries on with the download.
+    static constexpr std::size_t STREAM_BATCH_BYTES = 16 * 1024;
+    static constexpr std::size_t MAX_STREAM_QUEUED_BYTES = 1024 * 1024;
 
     struct {
         std::mutex mutex{};
         void* cookie{nullptr};
+        void* check_cookie{nullptr};
+        // Downloads are done one after the other, as the autopilot only
+        // serves one request at a time anyway.
+        std::deque<QueuedDownload> queue{};
+        bool downloading{false};
         unsigned id{0};
         unsigned bytes_to_get{0};
-        std::vector<uint8_t> bytes{};
-        std::vector<bool> chunks_received{};
-        std::size_t part_start{0};
+        ChunkBitmap chunks_received{};
+        // All chunks before this index have been received.
+        std::size_t first_missing_chunk{0};
+        // No chunk at or after this index has been requested yet.
+        std::size_t next_chunk_to_request{0};
+        std::size_t window_chunks{INITIAL_WINDOW_CHUNKS};
+        // The request currently in flight, in chunks.
+        std::size_t request_begin{0};
+        std::size_t request_end{0};
+        std::size_t request_expected{0};
+        std::size_t request_received{0};
+        // Chunks of the request which arrived, including the ones we
+        // already had, to know how fast they come in.
+        std::size_t request_arrived{0};
+        SteadyTimePoint request_sent{};
+        SteadyTimePoint last_chunk_arrived{};
         unsigned retries{0};
-        bool rerequesting{false};
-        int last_ofs_rerequested{-1};
+        uint64_t file_pos{0};
+        std::string file_path{};
+        LogDownloadSidecar sidecar{};
+        SteadyTimePoint last_sidecar_save{};
         SteadyTimePoint time_started{};
         std::ofstream file{};
         LogFiles::DownloadLogFileCallback callback{nullptr};
+        DownloadLogFileDataCallback data_callback{nullptr};
+        // Chunks that arrived after a gap, kept until they can be handed
+        // over in order. This is bounded by the request window.
+        std::map<std::size_t, std::vector<uint8_t>> stream_pending{};
+        std::size_t stream_next_chunk{0};
+        std::vector<uint8_t> stream_batch{};
+        // Bytes handed to the user but not consumed yet. This is shared with
+        // the queued callbacks rather than having them call back into the
+        // plugin, which might be gone by the time they run. Each download
+        // gets its own, so a batch consumed late doesn't count against the
+        // next download.
+        std::shared_ptr<std::atomic<std::size_t>> stream_queued_bytes{};
+        bool stream_paused{false};
     } _data{};
 };
 
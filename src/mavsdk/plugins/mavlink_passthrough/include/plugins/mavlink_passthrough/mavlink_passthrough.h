@@ -1,14 +1,18 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <functional>
 #include <optional>
+#include <vector>
 
 // This plugin provides/includes the mavlink 2.0 header files.
 #include "mavlink_include.h"
 #include "plugin_base.h"
 #include "handle.h"
+#include "message_packer.h"
 
 namespace mavsdk {
 
@@ -90,6 +94,26 @@ public:
      */
     Result send_message(mavlink_message_t& message);
 
+    /**
+     * @brief Send message by packing it straight into the outgoing queue.
+     *
+     * This avoids copying messages which are sent at high rates. The pack
+     * callback is given the message to fill, e.g. using one of the
+     * `mavlink_msg_*_pack` functions, and is called while the queue is locked,
+     * so it must not block or call back into MAVSDK. Any callable taking a
+     * `mavlink_message_t&` can be passed, it is not copied.
+     *
+     * The message is only packed into the queue if there is exactly one
+     * connection, and neither message logging nor interception of outgoing
+     * messages is on. Otherwise it is packed into a local message which is
+     * then sent like with send_message.
+     *
+     * @param message_id The ID of the message, to queue it with the right priority.
+     * @param pack Callback to pack the message.
+     * @return result of the request.
+     */
+    Result send_message_in_place(uint32_t message_id, const MessagePacker& pack);
+
     /**
      * @brief Type for MAVLink command_long.
      */
@@ -196,6 +220,78 @@ public:
      */
     void unsubscribe_message(MessageHandle handle);
 
+    /**
+     * @brief Options for message batch subscriptions.
+     *
+     * Like with subscribe_message, only messages of the system this plugin
+     * was created for are passed on.
+     */
+    struct MessageBatchOptions {
+        /** @brief Message IDs to pass on, empty for all messages. */
+        std::vector<uint16_t> message_ids{};
+        /** @brief Only pass on messages from this component ID, if set. */
+        std::optional<uint8_t> component_id{};
+        /** @brief How long a message can be held back to fill a batch. */
+        double max_latency_s{0.01};
+    };
+
+    /**
+     * @brief Callback type for message batch subscriptions.
+     *
+     * The messages are only valid during the callback.
+     */
+    using MessageBatchCallback =
+        std::function<void(const mavlink_message_t* messages, std::size_t count)>;
+
+    /**
+     * @brief Handle type for subscribe_message_batch.
+     */
+    using MessageBatchHandle = Handle<const mavlink_message_t*, std::size_t>;
+
+    /**
+     * @brief Set which messages are passed on to message batch subscriptions.
+     *
+     * By default, all messages are passed on.
+     *
+     * @param options Filter and latency.
+     */
+    void set_message_batch_options(const MessageBatchOptions& options);
+
+    /**
+     * @brief Subscribe to batches of received messages.
+     *
+     * This is meant for high message rates, e.g. for custom dialects. Instead
+     * of a callback per message, the messages are collected in a ring of
+     * MESSAGE_BATCH_CAPACITY messages and passed on in batches, in the order
+     * they were received. The ring is allocated once, so there is no
+     * allocation or copy per message and subscriber.
+     *
+     * A batch is passed on once the ring is a quarter full, and otherwise
+     * every max latency. Messages arriving while the ring is full are
+     * dropped, see message_batch_dropped.
+     *
+     * @param callback Callback to be called with each batch.
+     * @return Handle to unsubscribe again.
+     */
+    MessageBatchHandle subscribe_message_batch(const MessageBatchCallback& callback);
+
+    /**
+     * @brief Unsubscribe from subscribe_message_batch.
+     */
+    void unsubscribe_message_batch(MessageBatchHandle handle);
+
+    /**
+     * @brief Number of messages the ring for message batches can hold.
+     */
+    static constexpr std::size_t MESSAGE_BATCH_CAPACITY = 1024;
+
+    /**
+     * @brief Number of messages dropped because the ring for message batches was full.
+     *
+     * @return Messages dropped since subscribe_message_batch was first called.
+     */
+    uint64_t message_batch_dropped() const;
+
     /**
      * @brief Get our own system ID.
      *
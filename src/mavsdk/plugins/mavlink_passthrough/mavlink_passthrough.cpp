@@ -20,6 +20,12 @@ MavlinkPassthrough::Result MavlinkPassthrough::send_message(mavlink_message_t& m
     return _impl->send_message(message);
 }
 
+MavlinkPassthrough::Result
+MavlinkPassthrough::send_message_in_place(uint32_t message_id, const MessagePacker& pack)
+{
+    return _impl->send_message_in_place(message_id, pack);
+}
+
 MavlinkPassthrough::Result MavlinkPassthrough::send_command_int(const CommandInt& command)
 {
     return _impl->send_command_int(command);
@@ -62,6 +68,27 @@ void MavlinkPassthrough::unsubscribe_message(MessageHandle handle)
     _impl->unsubscribe_message(handle);
 }
 
+void MavlinkPassthrough::set_message_batch_options(const MessageBatchOptions& options)
+{
+    _impl->set_message_batch_options(options);
+}
+
+MavlinkPassthrough::MessageBatchHandle
+MavlinkPassthrough::subscribe_message_batch(const MessageBatchCallback& callback)
+{
+    return _impl->subscribe_message_batch(callback);
+}
+
+void MavlinkPassthrough::unsubscribe_message_batch(MessageBatchHandle handle)
+{
+    _impl->unsubscribe_message_batch(handle);
+}
+
+uint64_t MavlinkPassthrough::message_batch_dropped() const
+{
+    return _impl->message_batch_dropped();
+}
+
 std::ostream& operator<<(std::ostream& str, MavlinkPassthrough::Result const& result)
 {
     switch (result) {
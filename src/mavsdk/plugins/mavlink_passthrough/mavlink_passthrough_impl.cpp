@@ -6,6 +6,7 @@
 namespace mavsdk {
 
 template class CallbackList<const mavlink_message_t&>;
+template class CallbackList<const mavlink_message_t*, std::size_t>;
 
 MavlinkPassthroughImpl::MavlinkPassthroughImpl(System& system) : PluginImplBase(system)
 {
@@ -29,6 +30,13 @@ void MavlinkPassthroughImpl::deinit()
 {
     _system_impl->unregister_all_mavlink_message_handlers(this);
     _message_subscriptions.clear();
+
+    std::lock_guard<std::mutex> lock(_batch_mutex);
+    if (_batch_state) {
+        _system_impl->remove_call_every(_batch_call_every_cookie);
+        _system_impl->unregister_all_mavlink_message_handlers(_batch_state.get());
+        _batch_state.reset();
+    }
 }
 
 void MavlinkPassthroughImpl::enable() {}
@@ -43,6 +51,15 @@ MavlinkPassthrough::Result MavlinkPassthroughImpl::send_message(mavlink_message_
     return MavlinkPassthrough::Result::Success;
 }
 
+MavlinkPassthrough::Result
+MavlinkPassthroughImpl::send_message_in_place(uint32_t message_id, const MessagePacker& pack)
+{
+    if (!_system_impl->send_message_in_place(message_id, pack)) {
+        return MavlinkPassthrough::Result::ConnectionError;
+    }
+    return MavlinkPassthrough::Result::Success;
+}
+
 MavlinkPassthrough::Result
 MavlinkPassthroughImpl::send_command_long(const MavlinkPassthrough::CommandLong& command)
 {
@@ -208,6 +225,115 @@ void MavlinkPassthroughImpl::unsubscribe_message(MavlinkPassthrough::MessageHand
     }
 }
 
+void MavlinkPassthroughImpl::set_message_batch_options(
+    const MavlinkPassthrough::MessageBatchOptions& options)
+{
+    std::lock_guard<std::mutex> lock(_batch_mutex);
+    _batch_options = options;
+
+    if (_batch_state) {
+        _system_impl->unregister_all_mavlink_message_handlers(_batch_state.get());
+        register_message_batch_handlers();
+        _system_impl->change_call_every(
+            static_cast<float>(_batch_options.max_latency_s), _batch_call_every_cookie);
+    }
+}
+
+MavlinkPassthrough::MessageBatchHandle MavlinkPassthroughImpl::subscribe_message_batch(
+    const MavlinkPassthrough::MessageBatchCallback& callback)
+{
+    std::lock_guard<std::mutex> lock(_batch_mutex);
+
+    if (!_batch_state) {
+        _batch_state = std::make_shared<MessageBatchState>();
+        register_message_batch_handlers();
+        _system_impl->add_call_every(
+            [this]() { flush_message_batch(); },
+            static_cast<float>(_batch_options.max_latency_s),
+            &_batch_call_every_cookie);
+    }
+
+    return _batch_state->subscriptions.subscribe(callback);
+}
+
+void MavlinkPassthroughImpl::unsubscribe_message_batch(
+    MavlinkPassthrough::MessageBatchHandle handle)
+{
+    std::lock_guard<std::mutex> lock(_batch_mutex);
+
+    if (_batch_state) {
+        _batch_state->subscriptions.unsubscribe(handle);
+    }
+}
+
+uint64_t MavlinkPassthroughImpl::message_batch_dropped() const
+{
+    std::lock_guard<std::mutex> lock(_batch_mutex);
+    return _batch_state ? _batch_state->ring.dropped() : 0;
+}
+
+void MavlinkPassthroughImpl::register_message_batch_handlers()
+{
+    // Each handler holds on to the state, so there is no lookup per message.
+    // The handlers are registered with our system, so they only get its messages.
+    const auto handler = [this, state = _batch_state, component_id = _batch_options.component_id](
+                             const mavlink_message_t& message) {
+        if (component_id && message.compid != component_id.value()) {
+            return;
+        }
+
+        state->ring.push(message);
+
+        // Don't wait for the timer if it fills up quickly.
+        if (state->ring.size() >= state->ring.capacity() / 4) {
+            deliver_message_batch(state);
+        }
+    };
+
+    if (_batch_options.message_ids.empty()) {
+        _system_impl->register_mavlink_message_handler_for_all(handler, _batch_state.get());
+    } else {
+        for (const auto message_id : _batch_options.message_ids) {
+            _system_impl->register_mavlink_message_handler(
+                message_id, handler, _batch_state.get());
+        }
+    }
+}
+
+void MavlinkPassthroughImpl::flush_message_batch()
+{
+    std::shared_ptr<MessageBatchState> state;
+    {
+        std::lock_guard<std::mutex> lock(_batch_mutex);
+        state = _batch_state;
+    }
+
+    if (state) {
+        deliver_message_batch(state);
+    }
+}
+
+void MavlinkPassthroughImpl::deliver_message_batch(const std::shared_ptr<MessageBatchState>& state)
+{
+    // One batch at a time, the next one picks up whatever arrived meanwhile.
+    if (state->ring.size() == 0 || state->delivering.exchange(true)) {
+        return;
+    }
+
+    _system_impl->call_user_callback([state]() {
+        std::size_t count = 0;
+        for (const auto& span : state->ring.peek()) {
+            if (span.size > 0) {
+                state->subscriptions(span.messages, span.size);
+                count += span.size;
+            }
+        }
+
+        state->ring.release(count);
+        state->delivering = false;
+    });
+}
+
 void MavlinkPassthroughImpl::receive_mavlink_message(const mavlink_message_t& message)
 {
     _message_subscriptions[message.msgid].queue(
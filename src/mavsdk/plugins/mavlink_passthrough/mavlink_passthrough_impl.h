@@ -1,11 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 
 #include "mavlink_include.h"
 #include "plugins/mavlink_passthrough/mavlink_passthrough.h"
 #include "plugin_impl_base.h"
 #include "callback_list.h"
+#include "message_ring.h"
 
 namespace mavsdk {
 
@@ -22,6 +25,8 @@ public:
     void disable() override;
 
     MavlinkPassthrough::Result send_message(mavlink_message_t& message);
+    MavlinkPassthrough::Result
+    send_message_in_place(uint32_t message_id, const MessagePacker& pack);
     MavlinkPassthrough::Result send_command_long(const MavlinkPassthrough::CommandLong& command);
     MavlinkPassthrough::Result send_command_int(const MavlinkPassthrough::CommandInt& command);
     mavlink_message_t make_command_ack_message(
@@ -39,14 +44,32 @@ public:
 
     void unsubscribe_message(MavlinkPassthrough::MessageHandle handle);
 
+    void set_message_batch_options(const MavlinkPassthrough::MessageBatchOptions& options);
+    MavlinkPassthrough::MessageBatchHandle
+    subscribe_message_batch(const MavlinkPassthrough::MessageBatchCallback& callback);
+    void unsubscribe_message_batch(MavlinkPassthrough::MessageBatchHandle handle);
+    uint64_t message_batch_dropped() const;
+
     uint8_t get_our_sysid() const;
     uint8_t get_our_compid() const;
     uint8_t get_target_sysid() const;
     uint8_t get_target_compid() const;
 
 private:
+    // Shared with the callbacks in flight, so it outlives unsubscribing.
+    struct MessageBatchState {
+        MessageRing ring{MavlinkPassthrough::MESSAGE_BATCH_CAPACITY};
+        CallbackList<const mavlink_message_t*, std::size_t> subscriptions{};
+        std::atomic<bool> delivering{false};
+    };
+
     void receive_mavlink_message(const mavlink_message_t& message);
 
+    // Assumes to have the lock for _batch_mutex.
+    void register_message_batch_handlers();
+    void flush_message_batch();
+    void deliver_message_batch(const std::shared_ptr<MessageBatchState>& state);
+
     static MavlinkPassthrough::Result
     to_mavlink_passthrough_result_from_mavlink_commands_result(MavlinkCommandSender::Result result);
 
@@ -54,6 +77,12 @@ private:
     to_mavlink_passthrough_result_from_mavlink_params_result(MavlinkParameterClient::Result result);
 
     std::unordered_map<uint16_t, CallbackList<const mavlink_message_t&>> _message_subscriptions{};
+
+    mutable std::mutex _batch_mutex{};
+    MavlinkPassthrough::MessageBatchOptions _batch_options{};
+    // Only allocated once someone subscribes.
+    std::shared_ptr<MessageBatchState> _batch_state{};
+    void* _batch_call_every_cookie{nullptr};
 };
 
 } // namespace mavsdk
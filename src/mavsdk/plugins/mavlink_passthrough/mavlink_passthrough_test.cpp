@@ -0,0 +1,172 @@
+#include "plugins/mavlink_passthrough/mavlink_passthrough.h"
+#include "mavsdk_impl.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace mavsdk;
+
+namespace {
+
+constexpr std::size_t quarter_full = MavlinkPassthrough::MESSAGE_BATCH_CAPACITY / 4;
+
+mavlink_message_t make_attitude(uint8_t component_id = MAV_COMP_ID_AUTOPILOT1)
+{
+    mavlink_message_t message;
+    mavlink_msg_attitude_pack(1, component_id, &message, 0, 0, 0, 0, 0, 0, 0);
+    return message;
+}
+
+mavlink_message_t make_local_position_ned()
+{
+    mavlink_message_t message;
+    mavlink_msg_local_position_ned_pack(1, MAV_COMP_ID_AUTOPILOT1, &message, 0, 0, 0, 0, 0, 0, 0);
+    return message;
+}
+
+// Waits until the count reaches the expected one, or gives up after a second.
+bool wait_for(const std::atomic<std::size_t>& count, std::size_t expected)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (count < expected && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return count == expected;
+}
+
+class MavlinkPassthroughBatchTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        // The first message creates the system.
+        receive(make_attitude());
+        ASSERT_EQ(mavsdk_impl.systems().size(), 1u);
+        passthrough = std::make_unique<MavlinkPassthrough>(mavsdk_impl.systems()[0]);
+    }
+
+    void TearDown() override { passthrough.reset(); }
+
+    void receive(mavlink_message_t message) { mavsdk_impl.receive_message(message, nullptr); }
+
+    void subscribe_counting()
+    {
+        passthrough->subscribe_message_batch([this](const mavlink_message_t*, std::size_t count) {
+            received += count;
+        });
+    }
+
+    MavsdkImpl mavsdk_impl;
+    std::unique_ptr<MavlinkPassthrough> passthrough;
+    std::atomic<std::size_t> received{0};
+};
+
+} // namespace
+
+TEST_F(MavlinkPassthroughBatchTest, OnlyPassesOnFilteredMessages)
+{
+    MavlinkPassthrough::MessageBatchOptions options;
+    options.message_ids = {MAVLINK_MSG_ID_ATTITUDE};
+    options.component_id = MAV_COMP_ID_AUTOPILOT1;
+    passthrough->set_message_batch_options(options);
+
+    std::vector<uint32_t> message_ids;
+    std::vector<uint8_t> component_ids;
+    passthrough->subscribe_message_batch([&](const mavlink_message_t* messages, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            message_ids.push_back(messages[i].msgid);
+            component_ids.push_back(messages[i].compid);
+        }
+        received += count;
+    });
+
+    receive(make_attitude(MAV_COMP_ID_CAMERA));
+    receive(make_local_position_ned());
+    receive(make_attitude());
+
+    // Messages of other systems never reach the plugin of this one.
+    auto other_system = make_attitude();
+    other_system.sysid = 2;
+    receive(other_system);
+
+    ASSERT_TRUE(wait_for(received, 1));
+    // Give anything which should not be there a chance to show up.
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    EXPECT_EQ(received, 1u);
+    EXPECT_EQ(message_ids, (std::vector<uint32_t>{MAVLINK_MSG_ID_ATTITUDE}));
+    EXPECT_EQ(component_ids, (std::vector<uint8_t>{MAV_COMP_ID_AUTOPILOT1}));
+}
+
+TEST_F(MavlinkPassthroughBatchTest, PassesOnBatchOnceQuarterFull)
+{
+    // Long enough not to get in the way.
+    MavlinkPassthrough::MessageBatchOptions options;
+    options.max_latency_s = 10.0;
+    passthrough->set_message_batch_options(options);
+    subscribe_counting();
+
+    for (std::size_t i = 0; i < quarter_full - 1; ++i) {
+        receive(make_attitude());
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(received, 0u);
+
+    receive(make_attitude());
+    EXPECT_TRUE(wait_for(received, quarter_full));
+}
+
+TEST_F(MavlinkPassthroughBatchTest, PassesOnBatchAfterMaxLatency)
+{
+    MavlinkPassthrough::MessageBatchOptions options;
+    options.max_latency_s = 0.02;
+    passthrough->set_message_batch_options(options);
+    subscribe_counting();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < 3; ++i) {
+        receive(make_attitude());
+    }
+
+    EXPECT_TRUE(wait_for(received, 3));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+}
+
+TEST_F(MavlinkPassthroughBatchTest, CountsDroppedMessages)
+{
+    MavlinkPassthrough::MessageBatchOptions options;
+    options.max_latency_s = 10.0;
+    passthrough->set_message_batch_options(options);
+
+    // The first batch is held up until we let it go, so the ring fills up.
+    std::promise<void> entered;
+    std::promise<void> release;
+    auto release_future = release.get_future().share();
+    bool first = true;
+    passthrough->subscribe_message_batch([&](const mavlink_message_t*, std::size_t count) {
+        if (first) {
+            first = false;
+            entered.set_value();
+            release_future.wait();
+        }
+        received += count;
+    });
+
+    EXPECT_EQ(passthrough->message_batch_dropped(), 0u);
+
+    for (std::size_t i = 0; i < quarter_full; ++i) {
+        receive(make_attitude());
+    }
+    EXPECT_EQ(entered.get_future().wait_for(std::chrono::seconds(1)), std::future_status::ready);
+
+    // Only what is left of the ring fits in.
+    for (std::size_t i = 0; i < MavlinkPassthrough::MESSAGE_BATCH_CAPACITY; ++i) {
+        receive(make_attitude());
+    }
+    EXPECT_EQ(passthrough->message_batch_dropped(), quarter_full);
+
+    release.set_value();
+    EXPECT_TRUE(wait_for(received, quarter_full));
+}
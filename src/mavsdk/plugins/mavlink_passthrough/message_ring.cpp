@@ -0,0 +1,53 @@
+#include "message_ring.h"
+
+#include <algorithm>
+
+namespace mavsdk {
+
+MessageRing::MessageRing(std::size_t capacity) : _slots(std::max<std::size_t>(capacity, 1)) {}
+
+bool MessageRing::push(const mavlink_message_t& message)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_size == _slots.size()) {
+        ++_dropped;
+        return false;
+    }
+
+    _slots[(_first + _size) % _slots.size()] = message;
+    ++_size;
+    return true;
+}
+
+std::array<MessageRing::Span, 2> MessageRing::peek() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    const std::size_t until_end = std::min(_size, _slots.size() - _first);
+    return {
+        Span{_slots.data() + _first, until_end}, Span{_slots.data(), _size - until_end}};
+}
+
+void MessageRing::release(std::size_t count)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    count = std::min(count, _size);
+    _first = (_first + count) % _slots.size();
+    _size -= count;
+}
+
+std::size_t MessageRing::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _size;
+}
+
+uint64_t MessageRing::dropped() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _dropped;
+}
+
+} // namespace mavsdk
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "mavlink_include.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace mavsdk {
+
+// Fixed-size ring of received messages, to pass them on in batches.
+//
+// All slots are allocated upfront, so receiving a message only copies it
+// into the next free slot. The consumer reads the messages in place and
+// releases them once done, which frees the slots again. If the consumer
+// falls behind and the ring is full, new messages are dropped and counted.
+//
+// Pushing and releasing can happen on different threads.
+class MessageRing {
+public:
+    explicit MessageRing(std::size_t capacity);
+    ~MessageRing() = default;
+
+    // delete copy and move constructors and assign operators
+    MessageRing(MessageRing const&) = delete; // Copy construct
+    MessageRing(MessageRing&&) = delete; // Move construct
+    MessageRing& operator=(MessageRing const&) = delete; // Copy assign
+    MessageRing& operator=(MessageRing&&) = delete; // Move assign
+
+    struct Span {
+        const mavlink_message_t* messages{nullptr};
+        std::size_t size{0};
+    };
+
+    // Returns false if the ring is full.
+    bool push(const mavlink_message_t& message);
+
+    // What's queued, in order. The second span is only used if the messages
+    // wrap around the end of the ring. They stay valid until released.
+    [[nodiscard]] std::array<Span, 2> peek() const;
+
+    // Frees the first count messages.
+    void release(std::size_t count);
+
+    [[nodiscard]] std::size_t size() const;
+    [[nodiscard]] std::size_t capacity() const { return _slots.size(); }
+    [[nodiscard]] uint64_t dropped() const;
+
+private:
+    std::vector<mavlink_message_t> _slots;
+
+    mutable std::mutex _mutex{};
+    std::size_t _first{0};
+    std::size_t _size{0};
+    uint64_t _dropped{0};
+};
+
+} // namespace mavsdk
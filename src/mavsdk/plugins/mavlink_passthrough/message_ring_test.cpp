@@ -0,0 +1,67 @@
+#include "message_ring.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace mavsdk;
+
+namespace {
+mavlink_message_t make_message(uint32_t message_id)
+{
+    mavlink_message_t message{};
+    message.msgid = message_id;
+    return message;
+}
+
+std::vector<uint32_t> message_ids(const std::array<MessageRing::Span, 2>& spans)
+{
+    std::vector<uint32_t> result;
+    for (const auto& span : spans) {
+        for (std::size_t i = 0; i < span.size; ++i) {
+            result.push_back(span.messages[i].msgid);
+        }
+    }
+    return result;
+}
+} // namespace
+
+TEST(MessageRing, KeepsOrderAcrossEnd)
+{
+    MessageRing ring(4);
+
+    for (uint32_t i = 1; i <= 3; ++i) {
+        EXPECT_TRUE(ring.push(make_message(i)));
+    }
+    ring.release(2);
+
+    for (uint32_t i = 4; i <= 6; ++i) {
+        EXPECT_TRUE(ring.push(make_message(i)));
+    }
+
+    const auto spans = ring.peek();
+    EXPECT_EQ(spans[0].size, 2u);
+    EXPECT_EQ(spans[1].size, 2u);
+    EXPECT_EQ(message_ids(spans), (std::vector<uint32_t>{3, 4, 5, 6}));
+
+    ring.release(4);
+    EXPECT_EQ(ring.size(), 0u);
+    EXPECT_TRUE(message_ids(ring.peek()).empty());
+}
+
+TEST(MessageRing, DropsWhenFull)
+{
+    MessageRing ring(2);
+
+    EXPECT_TRUE(ring.push(make_message(1)));
+    EXPECT_TRUE(ring.push(make_message(2)));
+    EXPECT_FALSE(ring.push(make_message(3)));
+    EXPECT_EQ(ring.dropped(), 1u);
+
+    // Messages stay in place until released.
+    const auto spans = ring.peek();
+    EXPECT_FALSE(ring.push(make_message(4)));
+    EXPECT_EQ(message_ids(spans), (std::vector<uint32_t>{1, 2}));
+
+    ring.release(1);
+    EXPECT_TRUE(ring.push(make_message(5)));
+    EXPECT_EQ(message_ids(ring.peek()), (std::vector<uint32_t>{2, 5}));
+}
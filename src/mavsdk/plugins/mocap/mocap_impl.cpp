@@ -90,23 +90,26 @@ Mocap::Result MocapImpl::send_vision_position_estimate(
         return Mocap::Result::InvalidRequestData;
     }
 
-    mavlink_message_t message;
-    mavlink_msg_vision_position_estimate_pack(
-        _system_impl->get_own_system_id(),
-        _system_impl->get_own_component_id(),
-        &message,
-        autopilot_time_usec,
-        vision_position_estimate.position_body.x_m,
-        vision_position_estimate.position_body.y_m,
-        vision_position_estimate.position_body.z_m,
-        vision_position_estimate.angle_body.roll_rad,
-        vision_position_estimate.angle_body.pitch_rad,
-        vision_position_estimate.angle_body.yaw_rad,
-        covariance.data(),
-        0); // FIXME: reset_counter not set
-
-    return _system_impl->send_message(message) ? Mocap::Result::Success :
-                                                 Mocap::Result::ConnectionError;
+    const uint8_t own_system_id = _system_impl->get_own_system_id();
+    const uint8_t own_component_id = _system_impl->get_own_component_id();
+    const bool sent = _system_impl->send_message_in_place(
+        MAVLINK_MSG_ID_VISION_POSITION_ESTIMATE, [&](mavlink_message_t& message) {
+            mavlink_msg_vision_position_estimate_pack(
+                own_system_id,
+                own_component_id,
+                &message,
+                autopilot_time_usec,
+                vision_position_estimate.position_body.x_m,
+                vision_position_estimate.position_body.y_m,
+                vision_position_estimate.position_body.z_m,
+                vision_position_estimate.angle_body.roll_rad,
+                vision_position_estimate.angle_body.pitch_rad,
+                vision_position_estimate.angle_body.yaw_rad,
+                covariance.data(),
+                0); // FIXME: reset_counter not set
+        });
+
+    return sent ? Mocap::Result::Success : Mocap::Result::ConnectionError;
 }
 
 Mocap::Result
@@ -124,8 +127,6 @@ MocapImpl::send_attitude_position_mocap(const Mocap::AttitudePositionMocap& atti
                     .time_since_epoch())
                 .count();
 
-    mavlink_message_t message;
-
     std::array<float, 4> q{};
     q[0] = attitude_position_mocap.q.w;
     q[1] = attitude_position_mocap.q.x;
@@ -149,19 +150,23 @@ MocapImpl::send_attitude_position_mocap(const Mocap::AttitudePositionMocap& atti
         return Mocap::Result::InvalidRequestData;
     }
 
-    mavlink_msg_att_pos_mocap_pack(
-        _system_impl->get_own_system_id(),
-        _system_impl->get_own_component_id(),
-        &message,
-        autopilot_time_usec,
-        q.data(),
-        attitude_position_mocap.position_body.x_m,
-        attitude_position_mocap.position_body.y_m,
-        attitude_position_mocap.position_body.z_m,
-        covariance.data());
-
-    return _system_impl->send_message(message) ? Mocap::Result::Success :
-                                                 Mocap::Result::ConnectionError;
+    const uint8_t own_system_id = _system_impl->get_own_system_id();
+    const uint8_t own_component_id = _system_impl->get_own_component_id();
+    const bool sent = _system_impl->send_message_in_place(
+        MAVLINK_MSG_ID_ATT_POS_MOCAP, [&](mavlink_message_t& message) {
+            mavlink_msg_att_pos_mocap_pack(
+                own_system_id,
+                own_component_id,
+                &message,
+                autopilot_time_usec,
+                q.data(),
+                attitude_position_mocap.position_body.x_m,
+                attitude_position_mocap.position_body.y_m,
+                attitude_position_mocap.position_body.z_m,
+                covariance.data());
+        });
+
+    return sent ? Mocap::Result::Success : Mocap::Result::ConnectionError;
 }
 
 Mocap::Result MocapImpl::send_odometry(const Mocap::Odometry& odometry)
@@ -177,8 +182,6 @@ Mocap::Result MocapImpl::send_odometry(const Mocap::Odometry& odometry)
                     .time_since_epoch())
                 .count();
 
-    mavlink_message_t message;
-
     std::array<float, 4> q{};
     q[0] = odometry.q.w;
     q[1] = odometry.q.x;
@@ -216,31 +219,35 @@ Mocap::Result MocapImpl::send_odometry(const Mocap::Odometry& odometry)
         return Mocap::Result::InvalidRequestData;
     }
 
-    mavlink_msg_odometry_pack(
-        _system_impl->get_own_system_id(),
-        _system_impl->get_own_component_id(),
-        &message,
-        autopilot_time_usec,
-        static_cast<uint8_t>(odometry.frame_id),
-        static_cast<uint8_t>(MAV_FRAME_BODY_FRD),
-        odometry.position_body.x_m,
-        odometry.position_body.y_m,
-        odometry.position_body.z_m,
-        q.data(),
-        odometry.speed_body.x_m_s,
-        odometry.speed_body.y_m_s,
-        odometry.speed_body.z_m_s,
-        odometry.angular_velocity_body.roll_rad_s,
-        odometry.angular_velocity_body.pitch_rad_s,
-        odometry.angular_velocity_body.yaw_rad_s,
-        pose_covariance.data(),
-        velocity_covariance.data(),
-        0,
-        MAV_ESTIMATOR_TYPE_MOCAP,
-        0);
-
-    return _system_impl->send_message(message) ? Mocap::Result::Success :
-                                                 Mocap::Result::ConnectionError;
+    const uint8_t own_system_id = _system_impl->get_own_system_id();
+    const uint8_t own_component_id = _system_impl->get_own_component_id();
+    const bool sent = _system_impl->send_message_in_place(
+        MAVLINK_MSG_ID_ODOMETRY, [&](mavlink_message_t& message) {
+            mavlink_msg_odometry_pack(
+                own_system_id,
+                own_component_id,
+                &message,
+                autopilot_time_usec,
+                static_cast<uint8_t>(odometry.frame_id),
+                static_cast<uint8_t>(MAV_FRAME_BODY_FRD),
+                odometry.position_body.x_m,
+                odometry.position_body.y_m,
+                odometry.position_body.z_m,
+                q.data(),
+                odometry.speed_body.x_m_s,
+                odometry.speed_body.y_m_s,
+                odometry.speed_body.z_m_s,
+                odometry.angular_velocity_body.roll_rad_s,
+                odometry.angular_velocity_body.pitch_rad_s,
+                odometry.angular_velocity_body.yaw_rad_s,
+                pose_covariance.data(),
+                velocity_covariance.data(),
+                0,
+                MAV_ESTIMATOR_TYPE_MOCAP,
+                0);
+        });
+
+    return sent ? Mocap::Result::Success : Mocap::Result::ConnectionError;
 }
 
 } // namespace mavsdk
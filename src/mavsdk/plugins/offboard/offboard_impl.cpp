@@ -424,29 +424,31 @@ Offboard::Result OffboardImpl::send_position_ned()
         return _position_ned_yaw;
     }();
 
-    mavlink_message_t message;
-    mavlink_msg_set_position_target_local_ned_pack(
-        _system_impl->get_own_system_id(),
-        _system_impl->get_own_component_id(),
-        &message,
-        static_cast<uint32_t>(_system_impl->get_time().elapsed_ms()),
-        _system_impl->get_system_id(),
-        _system_impl->get_autopilot_id(),
-        MAV_FRAME_LOCAL_NED,
-        IGNORE_VX | IGNORE_VY | IGNORE_VZ | IGNORE_AX | IGNORE_AY | IGNORE_AZ | IGNORE_YAW_RATE,
-        position_ned_yaw.north_m,
-        position_ned_yaw.east_m,
-        position_ned_yaw.down_m,
-        0.0f, // vx
-        0.0f, // vy
-        0.0f, // vz
-        0.0f, // afx
-        0.0f, // afy
-        0.0f, // afz
-        to_rad_from_deg(position_ned_yaw.yaw_deg), // yaw
-        0.0f); // yaw_rate
-    return _system_impl->send_message(message) ? Offboard::Result::Success :
-                                                 Offboard::Result::ConnectionError;
+    const auto header = setpoint_header();
+    return send_in_place(
+        MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED, [&](mavlink_message_t& message) {
+            mavlink_msg_set_position_target_local_ned_pack(
+                header.own_system_id,
+                header.own_component_id,
+                &message,
+                header.time_boot_ms,
+                header.target_system_id,
+                header.target_component_id,
+                MAV_FRAME_LOCAL_NED,
+                IGNORE_VX | IGNORE_VY | IGNORE_VZ | IGNORE_AX | IGNORE_AY | IGNORE_AZ |
+                    IGNORE_YAW_RATE,
+                position_ned_yaw.north_m,
+                position_ned_yaw.east_m,
+                position_ned_yaw.down_m,
+                0.0f, // vx
+                0.0f, // vy
+                0.0f, // vz
+                0.0f, // afx
+                0.0f, // afy
+                0.0f, // afz
+                to_rad_from_deg(position_ned_yaw.yaw_deg), // yaw
+                0.0f); // yaw_rate
+        });
 }
 
 Offboard::Result OffboardImpl::send_position_global()
@@ -480,29 +482,31 @@ Offboard::Result OffboardImpl::send_position_global()
             break;
     }
 
-    mavlink_message_t message;
-    mavlink_msg_set_position_target_global_int_pack(
-        _system_impl->get_own_system_id(),
-        _system_impl->get_own_component_id(),
-        &message,
-        static_cast<uint32_t>(_system_impl->get_time().elapsed_ms()),
-        _system_impl->get_system_id(),
-        _system_impl->get_autopilot_id(),
-        frame,
-        IGNORE_VX | IGNORE_VY | IGNORE_VZ | IGNORE_AX | IGNORE_AY | IGNORE_AZ | IGNORE_YAW_RATE,
-        (int32_t)(position_global_yaw.lat_deg * 1.0e7),
-        (int32_t)(position_global_yaw.lon_deg * 1.0e7),
-        position_global_yaw.alt_m,
-        0.0f, // vx
-        0.0f, // vy
-        0.0f, // vz
-        0.0f, // afx
-        0.0f, // afy
-        0.0f, // afz
-        to_rad_from_deg(position_global_yaw.yaw_deg), // yaw
-        0.0f); // yaw_rate
-    return _system_impl->send_message(message) ? Offboard::Result::Success :
-                                                 Offboard::Result::ConnectionError;
+    const auto header = setpoint_header();
+    return send_in_place(
+        MAVLINK_MSG_ID_SET_POSITION_TARGET_GLOBAL_INT, [&](mavlink_message_t& message) {
+            mavlink_msg_set_position_target_global_int_pack(
+                header.own_system_id,
+                header.own_component_id,
+                &message,
+                header.time_boot_ms,
+                header.target_system_id,
+                header.target_component_id,
+                frame,
+                IGNORE_VX | IGNORE_VY | IGNORE_VZ | IGNORE_AX | IGNORE_AY | IGNORE_AZ |
+                    IGNORE_YAW_RATE,
+                (int32_t)(position_global_yaw.lat_deg * 1.0e7),
+                (int32_t)(position_global_yaw.lon_deg * 1.0e7),
+                position_global_yaw.alt_m,
+                0.0f, // vx
+                0.0f, // vy
+                0.0f, // vz
+                0.0f, // afx
+                0.0f, // afy
+                0.0f, // afz
+                to_rad_from_deg(position_global_yaw.yaw_deg), // yaw
+                0.0f); // yaw_rate
+        });
 }
 
 Offboard::Result OffboardImpl::send_velocity_ned()
@@ -520,29 +524,31 @@ Offboard::Result OffboardImpl::send_velocity_ned()
         return _velocity_ned_yaw;
     }();
 
-    mavlink_message_t message;
-    mavlink_msg_set_position_target_local_ned_pack(
-        _system_impl->get_own_system_id(),
-        _system_impl->get_own_component_id(),
-        &message,
-        static_cast<uint32_t>(_system_impl->get_time().elapsed_ms()),
-        _system_impl->get_system_id(),
-        _system_impl->get_autopilot_id(),
-        MAV_FRAME_LOCAL_NED,
-        IGNORE_X | IGNORE_Y | IGNORE_Z | IGNORE_AX | IGNORE_AY | IGNORE_AZ | IGNORE_YAW_RATE,
-        0.0f, // x,
-        0.0f, // y,
-        0.0f, // z,
-        velocity_ned_yaw.north_m_s,
-        velocity_ned_yaw.east_m_s,
-        velocity_ned_yaw.down_m_s,
-        0.0f, // afx
-        0.0f, // afy
-        0.0f, // afz
-        to_rad_from_deg(velocity_ned_yaw.yaw_deg), // yaw
-        0.0f); // yaw_rate
-    return _system_impl->send_message(message) ? Offboard::Result::Success :
-                                                 Offboard::Result::ConnectionError;
+    const auto header = setpoint_header();
+    return send_in_place(
+        MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED, [&](mavlink_message_t& message) {
+            mavlink_msg_set_position_target_local_ned_pack(
+                header.own_system_id,
+                header.own_component_id,
+                &message,
+                header.time_boot_ms,
+                header.target_system_id,
+                header.target_component_id,
+                MAV_FRAME_LOCAL_NED,
+                IGNORE_X | IGNORE_Y | IGNORE_Z | IGNORE_AX | IGNORE_AY | IGNORE_AZ |
+                    IGNORE_YAW_RATE,
+                0.0f, // x,
+                0.0f, // y,
+                0.0f, // z,
+                velocity_ned_yaw.north_m_s,
+                velocity_ned_yaw.east_m_s,
+                velocity_ned_yaw.down_m_s,
+                0.0f, // afx
+                0.0f, // afy
+                0.0f, // afz
+                to_rad_from_deg(velocity_ned_yaw.yaw_deg), // yaw
+                0.0f); // yaw_rate
+        });
 }
 
 Offboard::Result OffboardImpl::send_position_velocity_ned()
@@ -557,29 +563,30 @@ Offboard::Result OffboardImpl::send_position_velocity_ned()
         return std::make_pair<>(_position_ned_yaw, _velocity_ned_yaw);
     }();
 
-    mavlink_message_t message;
-    mavlink_msg_set_position_target_local_ned_pack(
-        _system_impl->get_own_system_id(),
-        _system_impl->get_own_component_id(),
-        &message,
-        static_cast<uint32_t>(_system_impl->get_time().elapsed_ms()),
-        _system_impl->get_system_id(),
-        _system_impl->get_autopilot_id(),
-        MAV_FRAME_LOCAL_NED,
-        IGNORE_AX | IGNORE_AY | IGNORE_AZ | IGNORE_YAW_RATE,
-        position_and_velocity.first.north_m,
-        position_and_velocity.first.east_m,
-        position_and_velocity.first.down_m,
-        position_and_velocity.second.north_m_s,
-        position_and_velocity.second.east_m_s,
-        position_and_velocity.second.down_m_s,
-        0.0f, // afx
-        0.0f, // afy
-        0.0f, // afz
-        to_rad_from_deg(position_and_velocity.first.yaw_deg), // yaw
-        0.0f); // yaw_rate
-    return _system_impl->send_message(message) ? Offboard::Result::Success :
-                                                 Offboard::Result::ConnectionError;
+    const auto header = setpoint_header();
+    return send_in_place(
+        MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED, [&](mavlink_message_t& message) {
+            mavlink_msg_set_position_target_local_ned_pack(
+                header.own_system_id,
+                header.own_component_id,
+                &message,
+                header.time_boot_ms,
+                header.target_system_id,
+                header.target_component_id,
+                MAV_FRAME_LOCAL_NED,
+                IGNORE_AX | IGNORE_AY | IGNORE_AZ | IGNORE_YAW_RATE,
+                position_and_velocity.first.north_m,
+                position_and_velocity.first.east_m,
+                position_and_velocity.first.down_m,
+                position_and_velocity.second.north_m_s,
+                position_and_velocity.second.east_m_s,
+                position_and_velocity.second.down_m_s,
+                0.0f, // afx
+                0.0f, // afy
+                0.0f, // afz
+                to_rad_from_deg(position_and_velocity.first.yaw_deg), // yaw
+                0.0f); // yaw_rate
+        });
 }
 
 Offboard::Result OffboardImpl::send_position_velocity_acceleration_ned()
@@ -588,29 +595,30 @@ Offboard::Result OffboardImpl::send_position_velocity_acceleration_ned()
 
     std::lock_guard<std::mutex> lock(_mutex);
 
-    mavlink_message_t message;
-    mavlink_msg_set_position_target_local_ned_pack(
-        _system_impl->get_own_system_id(),
-        _system_impl->get_own_component_id(),
-        &message,
-        static_cast<uint32_t>(_system_impl->get_time().elapsed_ms()),
-        _system_impl->get_system_id(),
-        _system_impl->get_autopilot_id(),
-        MAV_FRAME_LOCAL_NED,
-        IGNORE_YAW_RATE,
-        _position_ned_yaw.north_m,
-        _position_ned_yaw.east_m,
-        _position_ned_yaw.down_m,
-        _velocity_ned_yaw.north_m_s,
-        _velocity_ned_yaw.east_m_s,
-        _velocity_ned_yaw.down_m_s,
-        _acceleration_ned.north_m_s2,
-        _acceleration_ned.east_m_s2,
-        _acceleration_ned.down_m_s2,
-        to_rad_from_deg(_position_ned_yaw.yaw_deg), // yaw
-        0.0f); // yaw_rate
-    return _system_impl->send_message(message) ? Offboard::Result::Success :
-                                                 Offboard::Result::ConnectionError;
+    const auto header = setpoint_header();
+    return send_in_place(
+        MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED, [&](mavlink_message_t& message) {
+            mavlink_msg_set_position_target_local_ned_pack(
+                header.own_system_id,
+                header.own_component_id,
+                &message,
+                header.time_boot_ms,
+                header.target_system_id,
+                header.target_component_id,
+                MAV_FRAME_LOCAL_NED,
+                IGNORE_YAW_RATE,
+                _position_ned_yaw.north_m,
+                _position_ned_yaw.east_m,
+                _position_ned_yaw.down_m,
+                _velocity_ned_yaw.north_m_s,
+                _velocity_ned_yaw.east_m_s,
+                _velocity_ned_yaw.down_m_s,
+                _acceleration_ned.north_m_s2,
+                _acceleration_ned.east_m_s2,
+                _acceleration_ned.down_m_s2,
+                to_rad_from_deg(_position_ned_yaw.yaw_deg), // yaw
+                0.0f); // yaw_rate
+        });
 }
 
 Offboard::Result OffboardImpl::send_acceleration_ned()
@@ -629,30 +637,31 @@ Offboard::Result OffboardImpl::send_acceleration_ned()
         return _acceleration_ned;
     }();
 
-    mavlink_message_t message;
-    mavlink_msg_set_position_target_local_ned_pack(
-        _system_impl->get_own_system_id(),
-        _system_impl->get_own_component_id(),
-        &message,
-        static_cast<uint32_t>(_system_impl->get_time().elapsed_ms()),
-        _system_impl->get_system_id(),
-        _system_impl->get_autopilot_id(),
-        MAV_FRAME_LOCAL_NED,
-        IGNORE_X | IGNORE_Y | IGNORE_Z | IGNORE_VX | IGNORE_VY | IGNORE_VZ | IGNORE_YAW |
-            IGNORE_YAW_RATE,
-        0.0f, // x,
-        0.0f, // y,
-        0.0f, // z,
-        0.0f, // vfx
-        0.0f, // vfy
-        0.0f, // vfz
-        acceleration_ned.north_m_s2,
-        acceleration_ned.east_m_s2,
-        acceleration_ned.down_m_s2,
-        0.0f, // yaw
-        0.0f); // yaw_rate
-    return _system_impl->send_message(message) ? Offboard::Result::Success :
-                                                 Offboard::Result::ConnectionError;
+    const auto header = setpoint_header();
+    return send_in_place(
+        MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED, [&](mavlink_message_t& message) {
+            mavlink_msg_set_position_target_local_ned_pack(
+                header.own_system_id,
+                header.own_component_id,
+                &message,
+                header.time_boot_ms,
+                header.target_system_id,
+                header.target_component_id,
+                MAV_FRAME_LOCAL_NED,
+                IGNORE_X | IGNORE_Y | IGNORE_Z | IGNORE_VX | IGNORE_VY | IGNORE_VZ | IGNORE_YAW |
+                    IGNORE_YAW_RATE,
+                0.0f, // x,
+                0.0f, // y,
+                0.0f, // z,
+                0.0f, // vfx
+                0.0f, // vfy
+                0.0f, // vfz
+                acceleration_ned.north_m_s2,
+                acceleration_ned.east_m_s2,
+                acceleration_ned.down_m_s2,
+                0.0f, // yaw
+                0.0f); // yaw_rate
+        });
 }
 
 Offboard::Result OffboardImpl::send_velocity_body()
@@ -670,29 +679,30 @@ Offboard::Result OffboardImpl::send_velocity_body()
         return _velocity_body_yawspeed;
     }();
 
-    mavlink_message_t message;
-    mavlink_msg_set_position_target_local_ned_pack(
-        _system_impl->get_own_system_id(),
-        _system_impl->get_own_component_id(),
-        &message,
-        static_cast<uint32_t>(_system_impl->get_time().elapsed_ms()),
-        _system_impl->get_system_id(),
-        _system_impl->get_autopilot_id(),
-        MAV_FRAME_BODY_NED,
-        IGNORE_X | IGNORE_Y | IGNORE_Z | IGNORE_AX | IGNORE_AY | IGNORE_AZ | IGNORE_YAW,
-        0.0f, // x
-        0.0f, // y
-        0.0f, // z
-        velocity_body_yawspeed.forward_m_s,
-        velocity_body_yawspeed.right_m_s,
-        velocity_body_yawspeed.down_m_s,
-        0.0f, // afx
-        0.0f, // afy
-        0.0f, // afz
-        0.0f, // yaw
-        to_rad_from_deg(velocity_body_yawspeed.yawspeed_deg_s));
-    return _system_impl->send_message(message) ? Offboard::Result::Success :
-                                                 Offboard::Result::ConnectionError;
+    const auto header = setpoint_header();
+    return send_in_place(
+        MAVLINK_MSG_ID_SET_POSITION_TARGET_LOCAL_NED, [&](mavlink_message_t& message) {
+            mavlink_msg_set_position_target_local_ned_pack(
+                header.own_system_id,
+                header.own_component_id,
+                &message,
+                header.time_boot_ms,
+                header.target_system_id,
+                header.target_component_id,
+                MAV_FRAME_BODY_NED,
+                IGNORE_X | IGNORE_Y | IGNORE_Z | IGNORE_AX | IGNORE_AY | IGNORE_AZ | IGNORE_YAW,
+                0.0f, // x
+                0.0f, // y
+                0.0f, // z
+                velocity_body_yawspeed.forward_m_s,
+                velocity_body_yawspeed.right_m_s,
+                velocity_body_yawspeed.down_m_s,
+                0.0f, // afx
+                0.0f, // afy
+                0.0f, // afz
+                0.0f, // yaw
+                to_rad_from_deg(velocity_body_yawspeed.yawspeed_deg_s));
+        });
 }
 
 Offboard::Result OffboardImpl::send_attitude()
@@ -727,23 +737,24 @@ Offboard::Result OffboardImpl::send_attitude()
 
     const float thrust_body[3] = {0.0f, 0.0f, 0.0f};
 
-    mavlink_message_t message;
-    mavlink_msg_set_attitude_target_pack(
-        _system_impl->get_own_system_id(),
-        _system_impl->get_own_component_id(),
-        &message,
-        static_cast<uint32_t>(_system_impl->get_time().elapsed_ms()),
-        _system_impl->get_system_id(),
-        _system_impl->get_autopilot_id(),
-        IGNORE_BODY_ROLL_RATE | IGNORE_BODY_PITCH_RATE | IGNORE_BODY_YAW_RATE,
-        q,
-        0,
-        0,
-        0,
-        thrust,
-        thrust_body);
-    return _system_impl->send_message(message) ? Offboard::Result::Success :
-                                                 Offboard::Result::ConnectionError;
+    const auto header = setpoint_header();
+    return send_in_place(
+        MAVLINK_MSG_ID_SET_ATTITUDE_TARGET, [&](mavlink_message_t& message) {
+            mavlink_msg_set_attitude_target_pack(
+                header.own_system_id,
+                header.own_component_id,
+                &message,
+                header.time_boot_ms,
+                header.target_system_id,
+                header.target_component_id,
+                IGNORE_BODY_ROLL_RATE | IGNORE_BODY_PITCH_RATE | IGNORE_BODY_YAW_RATE,
+                q,
+                0,
+                0,
+                0,
+                thrust,
+                thrust_body);
+        });
 }
 
 Offboard::Result OffboardImpl::send_attitude_rate()
@@ -757,40 +768,42 @@ Offboard::Result OffboardImpl::send_attitude_rate()
 
     const float thrust_body[3] = {0.0f, 0.0f, 0.0f};
 
-    mavlink_message_t message;
-    mavlink_msg_set_attitude_target_pack(
-        _system_impl->get_own_system_id(),
-        _system_impl->get_own_component_id(),
-        &message,
-        static_cast<uint32_t>(_system_impl->get_time().elapsed_ms()),
-        _system_impl->get_system_id(),
-        _system_impl->get_autopilot_id(),
-        IGNORE_ATTITUDE,
-        0,
-        to_rad_from_deg(attitude_rate.roll_deg_s),
-        to_rad_from_deg(attitude_rate.pitch_deg_s),
-        to_rad_from_deg(attitude_rate.yaw_deg_s),
-        _attitude_rate.thrust_value,
-        thrust_body);
-    return _system_impl->send_message(message) ? Offboard::Result::Success :
-                                                 Offboard::Result::ConnectionError;
+    const auto header = setpoint_header();
+    return send_in_place(
+        MAVLINK_MSG_ID_SET_ATTITUDE_TARGET, [&](mavlink_message_t& message) {
+            mavlink_msg_set_attitude_target_pack(
+                header.own_system_id,
+                header.own_component_id,
+                &message,
+                header.time_boot_ms,
+                header.target_system_id,
+                header.target_component_id,
+                IGNORE_ATTITUDE,
+                0,
+                to_rad_from_deg(attitude_rate.roll_deg_s),
+                to_rad_from_deg(attitude_rate.pitch_deg_s),
+                to_rad_from_deg(attitude_rate.yaw_deg_s),
+                _attitude_rate.thrust_value,
+                thrust_body);
+        });
 }
 
 Offboard::Result
 OffboardImpl::send_actuator_control_message(const float* controls, uint8_t group_number)
 {
-    mavlink_message_t message;
-    mavlink_msg_set_actuator_control_target_pack(
-        _system_impl->get_own_system_id(),
-        _system_impl->get_own_component_id(),
-        &message,
-        static_cast<uint32_t>(_system_impl->get_time().elapsed_ms()),
-        group_number,
-        _system_impl->get_system_id(),
-        _system_impl->get_autopilot_id(),
-        controls);
-    return _system_impl->send_message(message) ? Offboard::Result::Success :
-                                                 Offboard::Result::ConnectionError;
+    const auto header = setpoint_header();
+    return send_in_place(
+        MAVLINK_MSG_ID_SET_ACTUATOR_CONTROL_TARGET, [&](mavlink_message_t& message) {
+            mavlink_msg_set_actuator_control_target_pack(
+                header.own_system_id,
+                header.own_component_id,
+                &message,
+                header.time_boot_ms,
+                group_number,
+                header.target_system_id,
+                header.target_component_id,
+                controls);
+        });
 }
 
 Offboard::Result OffboardImpl::send_actuator_control()
@@ -886,4 +899,21 @@ OffboardImpl::offboard_result_from_command_result(MavlinkCommandSender::Result r
     }
 }
 
+OffboardImpl::SetpointHeader OffboardImpl::setpoint_header() const
+{
+    return {
+        _system_impl->get_own_system_id(),
+        _system_impl->get_own_component_id(),
+        static_cast<uint32_t>(_system_impl->get_time().elapsed_ms()),
+        _system_impl->get_system_id(),
+        _system_impl->get_autopilot_id()};
+}
+
+Offboard::Result OffboardImpl::send_in_place(uint32_t message_id, const MessagePacker& pack)
+{
+    return _system_impl->send_message_in_place(message_id, pack) ?
+               Offboard::Result::Success :
+               Offboard::Result::ConnectionError;
+}
+
 } // namespace mavsdk
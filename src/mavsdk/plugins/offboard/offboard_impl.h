@@ -3,6 +3,7 @@
 #include <mutex>
 
 #include "mavlink_include.h"
+#include "message_packer.h"
 #include "plugins/offboard/offboard.h"
 #include "plugin_impl_base.h"
 #include "system.h"
@@ -60,6 +61,21 @@ private:
     Offboard::Result send_actuator_control();
     Offboard::Result send_actuator_control_message(const float* controls, uint8_t group_number = 0);
 
+    // What all setpoints start with, looked up before packing, which has to
+    // be quick.
+    struct SetpointHeader {
+        uint8_t own_system_id;
+        uint8_t own_component_id;
+        uint32_t time_boot_ms;
+        uint8_t target_system_id;
+        uint8_t target_component_id;
+    };
+    SetpointHeader setpoint_header() const;
+
+    // Setpoints are streamed at high rates, so they are packed straight into
+    // the send queue.
+    Offboard::Result send_in_place(uint32_t message_id, const MessagePacker& pack);
+
     void process_heartbeat(const mavlink_message_t& message);
     void receive_command_result(
         MavlinkCommandSender::Result result, const Offboard::ResultCallback& callback);
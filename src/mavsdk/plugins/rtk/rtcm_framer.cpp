@@ -0,0 +1,104 @@
+#include "rtcm_framer.h"
+
+#include <algorithm>
+#include <array>
+
+namespace mavsdk {
+
+namespace {
+constexpr std::array<uint32_t, 256> make_crc24q_table()
+{
+    constexpr uint32_t polynomial = 0x1864CFB;
+
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i << 16;
+        for (unsigned bit = 0; bit < 8; ++bit) {
+            crc <<= 1;
+            if (crc & 0x1000000) {
+                crc ^= polynomial;
+            }
+        }
+        table[i] = crc & 0xFFFFFF;
+    }
+    return table;
+}
+
+constexpr auto crc24q_table = make_crc24q_table();
+} // namespace
+
+uint32_t RtcmFramer::crc24q(const uint8_t* data, std::size_t length)
+{
+    uint32_t crc = 0;
+    for (std::size_t i = 0; i < length; ++i) {
+        crc = ((crc << 8) & 0xFFFFFF) ^ crc24q_table[((crc >> 16) ^ data[i]) & 0xFF];
+    }
+    return crc;
+}
+
+void RtcmFramer::push(const uint8_t* data, std::size_t length)
+{
+    // Move what's left to the front once it's worth it.
+    if (_start > 0 && _start >= _buffer.size() / 2) {
+        _buffer.erase(_buffer.begin(), _buffer.begin() + static_cast<std::ptrdiff_t>(_start));
+        _start = 0;
+    }
+
+    _buffer.insert(_buffer.end(), data, data + length);
+}
+
+bool RtcmFramer::next_frame(std::vector<uint8_t>& frame)
+{
+    while (true) {
+        const auto begin = _buffer.begin() + static_cast<std::ptrdiff_t>(_start);
+        const auto preamble = std::find(begin, _buffer.end(), PREAMBLE);
+        skip(static_cast<std::size_t>(preamble - begin));
+
+        const std::size_t available = _buffer.size() - _start;
+        if (available < HEADER_LEN) {
+            return false;
+        }
+
+        const uint8_t* header = &_buffer[_start];
+        if ((header[1] & 0xFC) != 0) {
+            // The reserved bits are always 0, so this is not a preamble.
+            skip(1);
+            continue;
+        }
+
+        const std::size_t payload_len =
+            (static_cast<std::size_t>(header[1] & 0x03) << 8) | header[2];
+        const std::size_t frame_len = HEADER_LEN + payload_len + CRC_LEN;
+        if (available < frame_len) {
+            return false;
+        }
+
+        const uint8_t* crc_bytes = header + HEADER_LEN + payload_len;
+        const uint32_t crc = (static_cast<uint32_t>(crc_bytes[0]) << 16) |
+                             (static_cast<uint32_t>(crc_bytes[1]) << 8) | crc_bytes[2];
+        if (crc24q(header, HEADER_LEN + payload_len) != crc) {
+            // Either corrupted or the 0xD3 was part of something else, so we
+            // look for the next one.
+            skip(1);
+            continue;
+        }
+
+        frame.assign(header, header + frame_len);
+        _start += frame_len;
+        return true;
+    }
+}
+
+void RtcmFramer::clear()
+{
+    _buffer.clear();
+    _start = 0;
+}
+
+void RtcmFramer::skip(std::size_t length)
+{
+    _start += length;
+    _bytes_skipped += length;
+}
+
+} // namespace mavsdk
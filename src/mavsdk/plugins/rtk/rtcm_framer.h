@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mavsdk {
+
+// Splits a continuous RTCM3 byte stream into messages.
+//
+// A message starts with the preamble 0xD3, followed by 6 reserved bits, a
+// 10 bit length, the payload and a CRC-24Q over all of it. Bytes which are
+// not part of a message with a valid CRC are skipped, so the stream can
+// start anywhere and recovers from corrupted bytes.
+//
+// This class is not thread-safe, the caller needs to lock around it.
+class RtcmFramer {
+public:
+    RtcmFramer() = default;
+    ~RtcmFramer() = default;
+
+    // delete copy and move constructors and assign operators
+    RtcmFramer(RtcmFramer const&) = delete; // Copy construct
+    RtcmFramer(RtcmFramer&&) = delete; // Move construct
+    RtcmFramer& operator=(RtcmFramer const&) = delete; // Copy assign
+    RtcmFramer& operator=(RtcmFramer&&) = delete; // Move assign
+
+    void push(const uint8_t* data, std::size_t length);
+
+    // Returns false if there is no complete message yet.
+    bool next_frame(std::vector<uint8_t>& frame);
+
+    void clear();
+
+    [[nodiscard]] uint64_t bytes_skipped() const { return _bytes_skipped; }
+
+    static uint32_t crc24q(const uint8_t* data, std::size_t length);
+
+    static constexpr uint8_t PREAMBLE = 0xD3;
+    static constexpr std::size_t HEADER_LEN = 3;
+    static constexpr std::size_t CRC_LEN = 3;
+    static constexpr std::size_t MAX_PAYLOAD_LEN = 1023;
+    static constexpr std::size_t MAX_FRAME_LEN = HEADER_LEN + MAX_PAYLOAD_LEN + CRC_LEN;
+
+private:
+    void skip(std::size_t length);
+
+    std::vector<uint8_t> _buffer{};
+    // Everything before is consumed already, so we don't have to move the
+    // rest to the front after every message.
+    std::size_t _start{0};
+    uint64_t _bytes_skipped{0};
+};
+
+} // namespace mavsdk
@@ -0,0 +1,77 @@
+#include "rtcm_framer.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+
+using namespace mavsdk;
+
+namespace {
+std::vector<uint8_t> make_frame(std::size_t payload_len, uint8_t fill)
+{
+    std::vector<uint8_t> frame{
+        RtcmFramer::PREAMBLE,
+        static_cast<uint8_t>(payload_len >> 8),
+        static_cast<uint8_t>(payload_len & 0xFF)};
+    frame.insert(frame.end(), payload_len, fill);
+
+    const uint32_t crc = RtcmFramer::crc24q(frame.data(), frame.size());
+    frame.push_back(static_cast<uint8_t>(crc >> 16));
+    frame.push_back(static_cast<uint8_t>(crc >> 8));
+    frame.push_back(static_cast<uint8_t>(crc));
+    return frame;
+}
+} // namespace
+
+TEST(RtcmFramer, Crc24q)
+{
+    const std::string check{"123456789"};
+    EXPECT_EQ(
+        RtcmFramer::crc24q(reinterpret_cast<const uint8_t*>(check.data()), check.size()),
+        0xCDE703u);
+}
+
+TEST(RtcmFramer, SplitsStreamCutAnywhere)
+{
+    const auto first = make_frame(19, 0x11);
+    const auto second = make_frame(1000, 0xD3);
+    const auto third = make_frame(0, 0x00);
+
+    // Some garbage in front, as if we started listening in the middle.
+    std::vector<uint8_t> stream{0x01, 0xD3, 0xFF, 0x02};
+    stream.insert(stream.end(), first.begin(), first.end());
+    stream.insert(stream.end(), second.begin(), second.end());
+    stream.insert(stream.end(), third.begin(), third.end());
+
+    RtcmFramer framer;
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<uint8_t> frame;
+    for (std::size_t i = 0; i < stream.size(); i += 7) {
+        framer.push(stream.data() + i, std::min<std::size_t>(7, stream.size() - i));
+        while (framer.next_frame(frame)) {
+            frames.push_back(frame);
+        }
+    }
+
+    ASSERT_EQ(frames.size(), 3u);
+    EXPECT_EQ(frames[0], first);
+    EXPECT_EQ(frames[1], second);
+    EXPECT_EQ(frames[2], third);
+    EXPECT_EQ(framer.bytes_skipped(), 4u);
+}
+
+TEST(RtcmFramer, SkipsCorruptedMessage)
+{
+    auto corrupted = make_frame(50, 0x22);
+    corrupted[10] ^= 0x40;
+    const auto valid = make_frame(30, 0x33);
+
+    RtcmFramer framer;
+    framer.push(corrupted.data(), corrupted.size());
+    framer.push(valid.data(), valid.size());
+
+    std::vector<uint8_t> frame;
+    ASSERT_TRUE(framer.next_frame(frame));
+    EXPECT_EQ(frame, valid);
+    EXPECT_FALSE(framer.next_frame(frame));
+    EXPECT_EQ(framer.bytes_skipped(), corrupted.size());
+}
@@ -0,0 +1,120 @@
+#include "rtcm_injector.h"
+
+#include <algorithm>
+
+namespace mavsdk {
+
+RtcmInjector::RtcmInjector(Time& time) : _time(time) {}
+
+void RtcmInjector::push(const uint8_t* data, std::size_t length)
+{
+    _framer.push(data, length);
+
+    const auto now = _time.steady_time();
+    Frame frame;
+    while (_framer.next_frame(frame.data)) {
+        frame.received = now;
+        _queued_bytes += frame.data.size();
+        _frames.push_back(std::move(frame));
+        frame = Frame{};
+    }
+
+    _stats.bytes_skipped = _framer.bytes_skipped();
+
+    drop_old_frames();
+}
+
+void RtcmInjector::run_once(const SendFragmentFunction& send)
+{
+    drop_old_frames();
+
+    const auto now = _time.steady_time();
+    if (_max_bytes_per_s > 0.0) {
+        const double elapsed_s = std::chrono::duration<double>(now - _last_run).count();
+        const double max_budget_bytes = std::max(
+            _max_bytes_per_s * MAX_BURST_S, static_cast<double>(RtcmFramer::MAX_FRAME_LEN));
+        _budget_bytes = std::min(_budget_bytes + elapsed_s * _max_bytes_per_s, max_budget_bytes);
+    }
+    _last_run = now;
+
+    while (!_frames.empty()) {
+        const auto& frame = _frames.front();
+        const auto frame_len = frame.data.size();
+
+        if (_max_bytes_per_s > 0.0) {
+            if (_budget_bytes < static_cast<double>(frame_len)) {
+                break;
+            }
+            _budget_bytes -= static_cast<double>(frame_len);
+        }
+
+        bool success = true;
+        for (std::size_t offset = 0; offset < frame_len; offset += MAX_SEQUENCE_LEN) {
+            const auto sequence_len = std::min(MAX_SEQUENCE_LEN, frame_len - offset);
+            if (!send_sequence(frame.data.data() + offset, sequence_len, send)) {
+                success = false;
+                break;
+            }
+        }
+
+        if (success) {
+            ++_stats.messages_sent;
+            _stats.bytes_sent += frame_len;
+        } else {
+            // Not retried, it would only delay what comes after.
+            ++_stats.send_failed;
+        }
+
+        _queued_bytes -= frame_len;
+        _frames.pop_front();
+    }
+}
+
+bool RtcmInjector::send_sequence(
+    const uint8_t* data, std::size_t length, const SendFragmentFunction& send)
+{
+    const std::size_t num_fragments = (length + FRAGMENT_LEN - 1) / FRAGMENT_LEN;
+
+    bool success = true;
+    for (std::size_t i = 0; i < num_fragments && success; ++i) {
+        const uint8_t flags = static_cast<uint8_t>(
+            (num_fragments > 1 ? 0x1 : 0x0) | ((i & 0x3) << 1) | ((_sequence & 0x1F) << 3));
+        const auto fragment_len = std::min(FRAGMENT_LEN, length - i * FRAGMENT_LEN);
+
+        success = send(flags, data + i * FRAGMENT_LEN, static_cast<uint8_t>(fragment_len));
+    }
+
+    ++_sequence;
+    return success;
+}
+
+void RtcmInjector::set_max_bytes_per_s(double max_bytes_per_s)
+{
+    _max_bytes_per_s = max_bytes_per_s;
+    _budget_bytes = 0.0;
+    _last_run = _time.steady_time();
+}
+
+void RtcmInjector::clear()
+{
+    _framer.clear();
+    _frames.clear();
+    _queued_bytes = 0;
+}
+
+RtcmInjector::Stats RtcmInjector::stats() const
+{
+    return _stats;
+}
+
+void RtcmInjector::drop_old_frames()
+{
+    while (!_frames.empty() && (_queued_bytes > MAX_QUEUED_BYTES ||
+                                _time.elapsed_since_s(_frames.front().received) > MAX_AGE_S)) {
+        _queued_bytes -= _frames.front().data.size();
+        _frames.pop_front();
+        ++_stats.messages_dropped;
+    }
+}
+
+} // namespace mavsdk
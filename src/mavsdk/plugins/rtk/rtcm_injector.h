@@ -0,0 +1,99 @@
+#pragma once
+
+#include "mavsdk_time.h"
+#include "rtcm_framer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace mavsdk {
+
+// Turns an RTCM3 byte stream into GPS_RTCM_DATA fragments.
+//
+// The stream is split into RTCM messages first, so a GPS_RTCM_DATA sequence
+// never mixes two of them. A message is sent in up to 4 fragments of 180
+// bytes, as that's all the fragment ID can count. Longer messages, such as
+// MSM7 of many satellites, are split into several sequences, which the
+// autopilot passes on to the GPS one after the other.
+//
+// Optionally, the output is limited to a number of bytes per second. The
+// messages which can't be sent right away are queued, and the ones which got
+// too old or don't fit the queue anymore are dropped, since outdated
+// corrections are of no use.
+//
+// This class is not thread-safe, the caller needs to lock around it.
+class RtcmInjector {
+public:
+    explicit RtcmInjector(Time& time);
+    ~RtcmInjector() = default;
+
+    // delete copy and move constructors and assign operators
+    RtcmInjector(RtcmInjector const&) = delete; // Copy construct
+    RtcmInjector(RtcmInjector&&) = delete; // Move construct
+    RtcmInjector& operator=(RtcmInjector const&) = delete; // Copy assign
+    RtcmInjector& operator=(RtcmInjector&&) = delete; // Move assign
+
+    // Sends one GPS_RTCM_DATA, returns false if that failed.
+    using SendFragmentFunction =
+        std::function<bool(uint8_t flags, const uint8_t* data, uint8_t length)>;
+
+    struct Stats {
+        uint64_t messages_sent{0};
+        uint64_t messages_dropped{0};
+        uint64_t bytes_sent{0};
+        uint64_t bytes_skipped{0};
+        uint64_t send_failed{0};
+    };
+
+    void push(const uint8_t* data, std::size_t length);
+
+    // Sends whatever the rate limit allows.
+    void run_once(const SendFragmentFunction& send);
+
+    // Sends one sequence of up to MAX_FRAGMENTS fragments.
+    bool send_sequence(const uint8_t* data, std::size_t length, const SendFragmentFunction& send);
+
+    // 0 means unlimited.
+    void set_max_bytes_per_s(double max_bytes_per_s);
+
+    void clear();
+
+    [[nodiscard]] Stats stats() const;
+
+    static constexpr std::size_t FRAGMENT_LEN = 180;
+    static constexpr std::size_t MAX_FRAGMENTS = 4;
+    static constexpr std::size_t MAX_SEQUENCE_LEN = FRAGMENT_LEN * MAX_FRAGMENTS;
+
+    static constexpr double MAX_AGE_S = 2.0;
+    static constexpr std::size_t MAX_QUEUED_BYTES = 16 * 1024;
+
+private:
+    struct Frame {
+        std::vector<uint8_t> data{};
+        SteadyTimePoint received{};
+    };
+
+    void drop_old_frames();
+
+    RtcmFramer _framer{};
+    std::deque<Frame> _frames{};
+    std::size_t _queued_bytes{0};
+    uint8_t _sequence{0};
+
+    double _max_bytes_per_s{0.0};
+    double _budget_bytes{0.0};
+    SteadyTimePoint _last_run{};
+
+    // How much unused budget can be saved up for a burst. It's never less
+    // than the longest RTCM message, so every message fits eventually.
+    static constexpr double MAX_BURST_S = 0.1;
+
+    Stats _stats{};
+
+    Time& _time;
+};
+
+} // namespace mavsdk
@@ -0,0 +1,150 @@
+#include "rtcm_injector.h"
+#include <gtest/gtest.h>
+
+#ifdef FAKE_TIME
+#define Time FakeTime
+#endif
+
+using namespace mavsdk;
+
+namespace {
+std::vector<uint8_t> make_frame(std::size_t payload_len)
+{
+    std::vector<uint8_t> frame{
+        RtcmFramer::PREAMBLE,
+        static_cast<uint8_t>(payload_len >> 8),
+        static_cast<uint8_t>(payload_len & 0xFF)};
+    for (std::size_t i = 0; i < payload_len; ++i) {
+        frame.push_back(static_cast<uint8_t>(i));
+    }
+
+    const uint32_t crc = RtcmFramer::crc24q(frame.data(), frame.size());
+    frame.push_back(static_cast<uint8_t>(crc >> 16));
+    frame.push_back(static_cast<uint8_t>(crc >> 8));
+    frame.push_back(static_cast<uint8_t>(crc));
+    return frame;
+}
+
+struct Fragment {
+    bool fragmented;
+    unsigned fragment_id;
+    unsigned sequence;
+    std::vector<uint8_t> data;
+};
+
+class Receiver {
+public:
+    RtcmInjector::SendFragmentFunction send_function()
+    {
+        return [this](uint8_t flags, const uint8_t* data, uint8_t length) {
+            fragments.push_back(Fragment{
+                (flags & 0x1) != 0,
+                static_cast<unsigned>((flags >> 1) & 0x3),
+                static_cast<unsigned>(flags >> 3),
+                std::vector<uint8_t>(data, data + length)});
+            return true;
+        };
+    }
+
+    std::vector<uint8_t> received() const
+    {
+        std::vector<uint8_t> result;
+        for (const auto& fragment : fragments) {
+            result.insert(result.end(), fragment.data.begin(), fragment.data.end());
+        }
+        return result;
+    }
+
+    std::vector<Fragment> fragments{};
+};
+} // namespace
+
+TEST(RtcmInjector, SendsShortMessageInOneFragment)
+{
+    Time time{};
+    RtcmInjector injector(time);
+    Receiver receiver;
+
+    const auto frame = make_frame(100);
+    injector.push(frame.data(), frame.size());
+    injector.run_once(receiver.send_function());
+
+    ASSERT_EQ(receiver.fragments.size(), 1u);
+    EXPECT_FALSE(receiver.fragments[0].fragmented);
+    EXPECT_EQ(receiver.fragments[0].data, frame);
+    EXPECT_EQ(injector.stats().messages_sent, 1u);
+}
+
+TEST(RtcmInjector, SplitsLongMessage)
+{
+    Time time{};
+    RtcmInjector injector(time);
+    Receiver receiver;
+
+    // 1006 bytes, more than the 720 bytes of one sequence.
+    const auto frame = make_frame(1000);
+    injector.push(frame.data(), frame.size());
+    injector.run_once(receiver.send_function());
+
+    ASSERT_EQ(receiver.fragments.size(), 6u);
+    for (unsigned i = 0; i < 6; ++i) {
+        const auto& fragment = receiver.fragments[i];
+        EXPECT_TRUE(fragment.fragmented);
+        EXPECT_EQ(fragment.fragment_id, i % 4);
+        EXPECT_EQ(fragment.sequence, i < 4 ? 0u : 1u);
+    }
+    EXPECT_EQ(receiver.fragments[5].data.size(), 1006u - 900u);
+    EXPECT_EQ(receiver.received(), frame);
+}
+
+TEST(RtcmInjector, LimitsRate)
+{
+    Time time{};
+    RtcmInjector injector(time);
+    Receiver receiver;
+
+    // 10 messages of 206 bytes.
+    injector.set_max_bytes_per_s(2060.0);
+    const auto frame = make_frame(200);
+    for (unsigned i = 0; i < 10; ++i) {
+        injector.push(frame.data(), frame.size());
+    }
+
+    for (unsigned i = 0; i < 50; ++i) {
+        time.sleep_for(std::chrono::milliseconds(10));
+        injector.run_once(receiver.send_function());
+    }
+
+    // Half a second plus the initial burst.
+    EXPECT_GE(injector.stats().messages_sent, 5u);
+    EXPECT_LE(injector.stats().messages_sent, 7u);
+
+    for (unsigned i = 0; i < 50; ++i) {
+        time.sleep_for(std::chrono::milliseconds(10));
+        injector.run_once(receiver.send_function());
+    }
+    EXPECT_EQ(injector.stats().messages_sent, 10u);
+    EXPECT_EQ(injector.stats().messages_dropped, 0u);
+}
+
+TEST(RtcmInjector, DropsOutdatedMessages)
+{
+    Time time{};
+    RtcmInjector injector(time);
+    Receiver receiver;
+
+    injector.set_max_bytes_per_s(100.0);
+    const auto frame = make_frame(500);
+    for (unsigned i = 0; i < 5; ++i) {
+        injector.push(frame.data(), frame.size());
+    }
+
+    for (unsigned i = 0; i < 300; ++i) {
+        time.sleep_for(std::chrono::milliseconds(10));
+        injector.run_once(receiver.send_function());
+    }
+
+    const auto stats = injector.stats();
+    EXPECT_EQ(stats.messages_sent + stats.messages_dropped, 5u);
+    EXPECT_GE(stats.messages_dropped, 3u);
+}
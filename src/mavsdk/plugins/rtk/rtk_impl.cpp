@@ -1,6 +1,9 @@
 #include "rtk_impl.h"
 #include "unused.h"
 
+#include <algorithm>
+#include <array>
+
 namespace mavsdk {
 
 RtkImpl::RtkImpl(System& system) : PluginImplBase(system)
@@ -18,9 +21,21 @@ RtkImpl::~RtkImpl()
     _system_impl->unregister_plugin(this);
 }
 
-void RtkImpl::init() {}
+void RtkImpl::init()
+{
+    _system_impl->add_call_every(
+        [this]() { run_injector(); },
+        static_cast<float>(INJECTOR_INTERVAL_S),
+        &_injector_call_every_cookie);
+}
+
+void RtkImpl::deinit()
+{
+    _system_impl->remove_call_every(_injector_call_every_cookie);
 
-void RtkImpl::deinit() {}
+    std::lock_guard<std::mutex> lock(_injector_mutex);
+    _injector.clear();
+}
 
 void RtkImpl::enable() {}
 
@@ -28,47 +43,67 @@ void RtkImpl::disable() {}
 
 Rtk::Result RtkImpl::send_rtcm_data(Rtk::RtcmData rtcm_data)
 {
-    constexpr size_t field_len = MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN;
-
-    const size_t num_packets_required =
-        rtcm_data.data.size() / field_len + (rtcm_data.data.size() % field_len == 0 ? 0 : 1);
-
     // The maximum is 4 times the 180 bytes because we only have two bits to
     // denote the fragment ID.
-    if (num_packets_required > 4) {
+    if (rtcm_data.data.size() > RtcmInjector::MAX_SEQUENCE_LEN) {
         return Rtk::Result::TooLong;
     }
 
-    // Copy length before we change it.
-    size_t bytes_to_send = rtcm_data.data.size();
+    std::lock_guard<std::mutex> lock(_injector_mutex);
+    const bool success = _injector.send_sequence(
+        reinterpret_cast<const uint8_t*>(rtcm_data.data.data()),
+        rtcm_data.data.size(),
+        [this](uint8_t flags, const uint8_t* data, uint8_t length) {
+            return send_fragment(flags, data, length);
+        });
+
+    return success ? Rtk::Result::Success : Rtk::Result::ConnectionError;
+}
 
-    // The mavlink helpers memcpy, so we need to make sure we're not
-    // copying from where we shouldn't.
-    rtcm_data.data.resize(num_packets_required * field_len);
+Rtk::Result RtkImpl::send_rtcm_stream(const std::vector<uint8_t>& data)
+{
+    std::lock_guard<std::mutex> lock(_injector_mutex);
+    _injector.push(data.data(), data.size());
 
-    for (size_t i = 0; i < num_packets_required; ++i) {
-        const uint8_t flags =
-            (num_packets_required > 1 ? 0x1 : 0x0) | ((i & 0x3) << 1) | ((_sequence & 0x1F) << 3);
+    // No need to wait for the next tick if the rate limit allows it.
+    _injector.run_once([this](uint8_t flags, const uint8_t* fragment, uint8_t length) {
+        return send_fragment(flags, fragment, length);
+    });
 
-        mavlink_message_t message;
-        mavlink_msg_gps_rtcm_data_pack(
-            _system_impl->get_own_system_id(),
-            _system_impl->get_own_component_id(),
-            &message,
-            flags,
-            static_cast<uint8_t>(std::min(field_len, bytes_to_send)),
-            reinterpret_cast<const uint8_t*>(rtcm_data.data.c_str() + (i * field_len)));
+    return Rtk::Result::Success;
+}
 
-        if (!_system_impl->send_message(message)) {
-            ++_sequence;
-            return Rtk::Result::ConnectionError;
-        }
+void RtkImpl::set_rtcm_stream_rate_limit(double max_bytes_per_s)
+{
+    std::lock_guard<std::mutex> lock(_injector_mutex);
+    _injector.set_max_bytes_per_s(max_bytes_per_s);
+}
 
-        bytes_to_send -= field_len;
-    }
+void RtkImpl::run_injector()
+{
+    std::lock_guard<std::mutex> lock(_injector_mutex);
+    _injector.run_once([this](uint8_t flags, const uint8_t* data, uint8_t length) {
+        return send_fragment(flags, data, length);
+    });
+}
 
-    ++_sequence;
-    return Rtk::Result::Success;
+bool RtkImpl::send_fragment(uint8_t flags, const uint8_t* data, uint8_t length)
+{
+    // The MAVLink helpers always copy the whole field, so the rest needs to
+    // be there.
+    std::array<uint8_t, MAVLINK_MSG_GPS_RTCM_DATA_FIELD_DATA_LEN> field{};
+    std::copy(data, data + length, field.begin());
+
+    mavlink_message_t message;
+    mavlink_msg_gps_rtcm_data_pack(
+        _system_impl->get_own_system_id(),
+        _system_impl->get_own_component_id(),
+        &message,
+        flags,
+        length,
+        field.data());
+
+    return _system_impl->send_message(message);
 }
 
 } // namespace mavsdk
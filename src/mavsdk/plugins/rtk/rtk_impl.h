@@ -2,6 +2,11 @@
 
 #include "plugins/rtk/rtk.h"
 #include "plugin_impl_base.h"
+#include "rtcm_injector.h"
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
 
 namespace mavsdk {
 
@@ -19,8 +24,19 @@ public:
 
     Rtk::Result send_rtcm_data(Rtk::RtcmData rtcm_data);
 
+    // Not part of the Rtk API until rtk.proto has the matching RPCs.
+    Rtk::Result send_rtcm_stream(const std::vector<uint8_t>& data);
+    void set_rtcm_stream_rate_limit(double max_bytes_per_s);
+
 private:
-    unsigned _sequence{0};
+    bool send_fragment(uint8_t flags, const uint8_t* data, uint8_t length);
+    void run_injector();
+
+    std::mutex _injector_mutex{};
+    RtcmInjector _injector{_system_impl->get_time()};
+    void* _injector_call_every_cookie{nullptr};
+
+    static constexpr double INJECTOR_INTERVAL_S = 0.02;
 };
 
 } // namespace mavsdk
@@ -0,0 +1,122 @@
+#include "stream_scheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mavsdk {
+
+namespace {
+std::chrono::steady_clock::duration to_duration(double seconds)
+{
+    // Time::shift_steady_time_by only has ms resolution, which would make
+    // e.g. 30 Hz streams drift.
+    return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(seconds));
+}
+} // namespace
+
+StreamScheduler::StreamScheduler(Time& time) : _time(time) {}
+
+void StreamScheduler::set_interval(uint32_t msg_id, double interval_s)
+{
+    const auto now = _time.steady_time();
+
+    auto it = find(msg_id);
+    if (it == _streams.end()) {
+        // Spread the phases of new streams using the golden ratio, so that
+        // they end up evenly distributed no matter how many there are.
+        static constexpr double golden_ratio_conjugate = 0.6180339887498949;
+        Stream stream;
+        stream.msg_id = msg_id;
+        stream.phase = std::fmod(double(_num_started++) * golden_ratio_conjugate, 1.0);
+        _streams.push_back(stream);
+        it = std::prev(_streams.end());
+    }
+
+    it->interval_s = interval_s;
+    it->deadline = now + to_duration(interval_s * it->phase);
+}
+
+void StreamScheduler::remove(uint32_t msg_id)
+{
+    auto it = find(msg_id);
+    if (it != _streams.end()) {
+        _streams.erase(it);
+    }
+}
+
+void StreamScheduler::clear()
+{
+    _streams.clear();
+}
+
+std::optional<double> StreamScheduler::interval_s(uint32_t msg_id) const
+{
+    auto it = find(msg_id);
+    if (it == _streams.end()) {
+        return {};
+    }
+    return it->interval_s;
+}
+
+void StreamScheduler::set_max_bytes_per_s(double max_bytes_per_s)
+{
+    _max_bytes_per_s = max_bytes_per_s;
+    _budget_bytes = 0.0;
+}
+
+void StreamScheduler::run_once(const SendCallback& send)
+{
+    const auto now = _time.steady_time();
+
+    if (_max_bytes_per_s > 0.0) {
+        const double elapsed_s = std::chrono::duration<double>(now - _last_run).count();
+        _budget_bytes = std::min(
+            _budget_bytes + _max_bytes_per_s * elapsed_s, _max_bytes_per_s * MAX_BURST_S);
+    }
+    _last_run = now;
+
+    _due.clear();
+    for (std::size_t i = 0; i < _streams.size(); ++i) {
+        if (_streams[i].deadline <= now) {
+            _due.push_back(i);
+        }
+    }
+
+    // The most overdue go first, in case we run out of budget.
+    std::sort(_due.begin(), _due.end(), [this](std::size_t lhs, std::size_t rhs) {
+        return _streams[lhs].deadline < _streams[rhs].deadline;
+    });
+
+    for (const auto index : _due) {
+        if (_max_bytes_per_s > 0.0 && _budget_bytes <= 0.0) {
+            // The rest stays due until there is budget again.
+            break;
+        }
+
+        auto& stream = _streams[index];
+        _budget_bytes -= send(stream.msg_id);
+
+        stream.deadline += to_duration(stream.interval_s);
+        if (stream.deadline <= now) {
+            // We fell behind, rather skip than send a burst to catch up.
+            stream.deadline = now + to_duration(stream.interval_s);
+        }
+    }
+}
+
+std::vector<StreamScheduler::Stream>::iterator StreamScheduler::find(uint32_t msg_id)
+{
+    return std::find_if(_streams.begin(), _streams.end(), [msg_id](const Stream& stream) {
+        return stream.msg_id == msg_id;
+    });
+}
+
+std::vector<StreamScheduler::Stream>::const_iterator StreamScheduler::find(uint32_t msg_id) const
+{
+    return std::find_if(_streams.begin(), _streams.end(), [msg_id](const Stream& stream) {
+        return stream.msg_id == msg_id;
+    });
+}
+
+} // namespace mavsdk
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "mavsdk_time.h"
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace mavsdk {
+
+// Schedules periodic message streams, as requested using
+// MAV_CMD_SET_MESSAGE_INTERVAL.
+//
+// Each stream has its own deadline. New streams are started with a phase
+// offset so that streams with the same interval don't all go out in the
+// same tick. Optionally, the total output can be limited to a byte rate,
+// in which case the streams which are most overdue are sent first.
+//
+// This class is not thread-safe, the caller needs to lock around it.
+class StreamScheduler {
+public:
+    explicit StreamScheduler(Time& time);
+    ~StreamScheduler() = default;
+
+    // delete copy and move constructors and assign operators
+    StreamScheduler(StreamScheduler const&) = delete; // Copy construct
+    StreamScheduler(StreamScheduler&&) = delete; // Move construct
+    StreamScheduler& operator=(StreamScheduler const&) = delete; // Copy assign
+    StreamScheduler& operator=(StreamScheduler&&) = delete; // Move assign
+
+    // Sends the latest message with this id and returns the number of bytes
+    // sent, 0 if there was nothing to send.
+    using SendCallback = std::function<unsigned(uint32_t msg_id)>;
+
+    void set_interval(uint32_t msg_id, double interval_s);
+    void remove(uint32_t msg_id);
+    void clear();
+    std::optional<double> interval_s(uint32_t msg_id) const;
+
+    // 0 means unlimited.
+    void set_max_bytes_per_s(double max_bytes_per_s);
+
+    void run_once(const SendCallback& send);
+
+private:
+    struct Stream {
+        uint32_t msg_id{0};
+        double interval_s{0.0};
+        // Offset of the deadline within the interval, in [0, 1).
+        double phase{0.0};
+        SteadyTimePoint deadline{};
+    };
+
+    std::vector<Stream>::iterator find(uint32_t msg_id);
+    std::vector<Stream>::const_iterator find(uint32_t msg_id) const;
+
+    std::vector<Stream> _streams{};
+    std::vector<std::size_t> _due{};
+    unsigned _num_started{0};
+
+    double _max_bytes_per_s{0.0};
+    double _budget_bytes{0.0};
+    SteadyTimePoint _last_run{};
+
+    // How much unused budget can be saved up for a burst.
+    static constexpr double MAX_BURST_S = 0.05;
+
+    Time& _time;
+};
+
+} // namespace mavsdk
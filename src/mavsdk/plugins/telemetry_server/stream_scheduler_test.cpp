@@ -0,0 +1,128 @@
+#include "stream_scheduler.h"
+#include <gtest/gtest.h>
+#include <map>
+
+#ifdef FAKE_TIME
+#define Time FakeTime
+#endif
+
+using namespace mavsdk;
+
+namespace {
+// Runs the scheduler at 100 Hz like the server component does.
+void run_for(
+    Time& time, StreamScheduler& scheduler, int ms, const StreamScheduler::SendCallback& send)
+{
+    for (int i = 0; i < ms / 10; ++i) {
+        time.sleep_for(std::chrono::milliseconds(10));
+        scheduler.run_once(send);
+    }
+}
+} // namespace
+
+TEST(StreamScheduler, Rates)
+{
+    Time time{};
+    StreamScheduler scheduler(time);
+
+    std::map<uint32_t, unsigned> num_sent;
+    const auto send = [&num_sent](uint32_t msg_id) {
+        ++num_sent[msg_id];
+        return 30u;
+    };
+
+    scheduler.set_interval(1, 1.0);
+    scheduler.set_interval(2, 0.1);
+    scheduler.set_interval(3, 0.05);
+
+    run_for(time, scheduler, 10000, send);
+
+    EXPECT_NEAR(num_sent[1], 10, 1);
+    EXPECT_NEAR(num_sent[2], 100, 1);
+    EXPECT_NEAR(num_sent[3], 200, 2);
+}
+
+TEST(StreamScheduler, ChangeAndRemove)
+{
+    Time time{};
+    StreamScheduler scheduler(time);
+
+    unsigned num_sent = 0;
+    const auto send = [&num_sent](uint32_t) {
+        ++num_sent;
+        return 30u;
+    };
+
+    scheduler.set_interval(42, 0.1);
+    ASSERT_TRUE(scheduler.interval_s(42));
+    EXPECT_DOUBLE_EQ(scheduler.interval_s(42).value(), 0.1);
+
+    run_for(time, scheduler, 1000, send);
+    EXPECT_NEAR(num_sent, 10, 1);
+
+    num_sent = 0;
+    scheduler.set_interval(42, 0.5);
+    run_for(time, scheduler, 2000, send);
+    EXPECT_NEAR(num_sent, 4, 1);
+
+    num_sent = 0;
+    scheduler.remove(42);
+    EXPECT_FALSE(scheduler.interval_s(42));
+    run_for(time, scheduler, 1000, send);
+    EXPECT_EQ(num_sent, 0);
+}
+
+TEST(StreamScheduler, PhasesSpread)
+{
+    Time time{};
+    StreamScheduler scheduler(time);
+
+    for (uint32_t msg_id = 0; msg_id < 5; ++msg_id) {
+        scheduler.set_interval(msg_id, 0.1);
+    }
+
+    unsigned max_per_tick = 0;
+    unsigned num_this_tick = 0;
+    const auto send = [&num_this_tick](uint32_t) {
+        ++num_this_tick;
+        return 30u;
+    };
+
+    for (int i = 0; i < 100; ++i) {
+        num_this_tick = 0;
+        run_for(time, scheduler, 10, send);
+        max_per_tick = std::max(max_per_tick, num_this_tick);
+    }
+
+    // 5 streams at the same rate should not all go out at once.
+    EXPECT_LE(max_per_tick, 2);
+}
+
+TEST(StreamScheduler, BandwidthLimit)
+{
+    Time time{};
+    StreamScheduler scheduler(time);
+
+    // Want 5 * 10 * 100 B/s = 5000 B/s but only allow 1000 B/s.
+    for (uint32_t msg_id = 0; msg_id < 5; ++msg_id) {
+        scheduler.set_interval(msg_id, 0.1);
+    }
+    scheduler.set_max_bytes_per_s(1000.0);
+
+    std::map<uint32_t, unsigned> num_sent;
+    unsigned bytes_sent = 0;
+    const auto send = [&num_sent, &bytes_sent](uint32_t msg_id) {
+        ++num_sent[msg_id];
+        bytes_sent += 100;
+        return 100u;
+    };
+
+    run_for(time, scheduler, 10000, send);
+
+    EXPECT_NEAR(bytes_sent, 10000, 500);
+
+    // All streams still get their share.
+    for (uint32_t msg_id = 0; msg_id < 5; ++msg_id) {
+        EXPECT_NEAR(num_sent[msg_id], 20, 3);
+    }
+}
@@ -1,6 +1,7 @@
 #include "telemetry_server_impl.h"
 #include "unused.h"
 #include <array>
+#include <cstdlib>
 
 namespace mavsdk {
 
@@ -14,56 +15,42 @@ TelemetryServerImpl::TelemetryServerImpl(std::shared_ptr<ServerComponent> server
 TelemetryServerImpl::~TelemetryServerImpl()
 {
     _server_component_impl->unregister_plugin(this);
-    std::unique_lock<std::mutex> lock(_interval_mutex);
-    for (const auto& request : _interval_requests) {
-        _server_component_impl->remove_call_every(request.cookie);
-    }
 }
 
 void TelemetryServerImpl::init()
 {
+    if (const char* env_p = std::getenv("MAVSDK_TELEMETRY_SERVER_MAX_BYTES_PER_S")) {
+        const double max_bytes_per_s = std::atof(env_p);
+        LogDebug() << "Limiting telemetry streams to " << max_bytes_per_s << " B/s";
+        std::lock_guard<std::mutex> lock(_interval_mutex);
+        _stream_scheduler.set_max_bytes_per_s(max_bytes_per_s);
+    }
+
+    // One timer for all streams, the scheduler takes care of the rest.
+    _server_component_impl->add_call_every(
+        [this]() { run_stream_scheduler(); },
+        STREAM_SCHEDULER_INTERVAL_S,
+        &_stream_scheduler_cookie);
+
     // Handle SET_MESSAGE_INTERVAL
     _server_component_impl->register_mavlink_command_handler(
         MAV_CMD_SET_MESSAGE_INTERVAL,
         [this](const MavlinkCommandReceiver::CommandLong& command) {
             std::lock_guard<std::mutex> lock(_interval_mutex);
             uint32_t msgid = static_cast<uint32_t>(command.params.param1);
-            // Set interval to 1hz if 0 (default rate)
-            uint32_t interval_ms =
-                command.params.param2 == 0 ?
-                    1000 :
-                    static_cast<uint32_t>(static_cast<double>(command.params.param2) * 1E-3);
-            LogDebug() << "Setting interval for msg id: " << std::to_string(msgid)
-                       << " interval_ms:" << std::to_string(interval_ms);
-            auto found = std::find_if(
-                _interval_requests.begin(),
-                _interval_requests.end(),
-                [msgid](const RequestMsgInterval& item) { return item.msg_id == msgid; });
-
-            if (found == _interval_requests.end() && command.params.param2 != -1) {
-                // If not found interval already, add a new one
-                _interval_requests.push_back({msgid, interval_ms, nullptr});
-                _server_component_impl->add_call_every(
-                    [this, msgid]() {
-                        std::lock_guard<std::mutex> lock_interval(_interval_mutex);
-                        if (_msg_cache.find(msgid) != _msg_cache.end()) {
-                            // Publish if callback exists :)
-                            _server_component_impl->send_message(_msg_cache.at(msgid));
-                        }
-                    },
-                    static_cast<double>(interval_ms) * 1E-3,
-                    &_interval_requests.back().cookie);
+
+            if (command.params.param2 == -1) {
+                // Deregister with -1 interval
+                LogDebug() << "Stopping stream for msg id: " << std::to_string(msgid);
+                _stream_scheduler.remove(msgid);
             } else {
-                if (command.params.param2 == -1) {
-                    // Deregister with -1 interval
-                    _server_component_impl->remove_call_every(found->cookie);
-                    _interval_requests.erase(found);
-                } else {
-                    // Update Interval
-                    found->interval = interval_ms;
-                    _server_component_impl->change_call_every(
-                        static_cast<double>(interval_ms) * 1E-3, found->cookie);
-                }
+                // Set interval to 1hz if 0 (default rate)
+                const double interval_s = command.params.param2 == 0 ?
+                                              1.0 :
+                                              static_cast<double>(command.params.param2) * 1E-6;
+                LogDebug() << "Setting interval for msg id: " << std::to_string(msgid)
+                           << " interval_s: " << interval_s;
+                _stream_scheduler.set_interval(msgid, interval_s);
             }
 
             return _server_component_impl->make_command_ack_message(
@@ -72,7 +59,14 @@ void TelemetryServerImpl::init()
         this);
 }
 
-void TelemetryServerImpl::deinit() {}
+void TelemetryServerImpl::deinit()
+{
+    _server_component_impl->unregister_mavlink_command_handler(MAV_CMD_SET_MESSAGE_INTERVAL, this);
+    _server_component_impl->remove_call_every(_stream_scheduler_cookie);
+
+    std::lock_guard<std::mutex> lock(_interval_mutex);
+    _stream_scheduler.clear();
+}
 
 TelemetryServer::Result TelemetryServerImpl::publish_position(
     TelemetryServer::Position position,
@@ -94,10 +88,7 @@ TelemetryServer::Result TelemetryServerImpl::publish_position(
         static_cast<int16_t>(static_cast<double>(velocity_ned.down_m_s) * 1E2),
         static_cast<uint16_t>(static_cast<double>(heading.heading_deg) * 1E2));
 
-    add_msg_cache(MAVLINK_MSG_ID_GLOBAL_POSITION_INT, msg);
-
-    return _server_component_impl->send_message(msg) ? TelemetryServer::Result::Success :
-                                                       TelemetryServer::Result::Unsupported;
+    return send_or_cache(MAVLINK_MSG_ID_GLOBAL_POSITION_INT, msg);
 }
 
 TelemetryServer::Result TelemetryServerImpl::publish_home(TelemetryServer::Position home)
@@ -121,10 +112,7 @@ TelemetryServer::Result TelemetryServerImpl::publish_home(TelemetryServer::Posit
         get_boot_time_ms() // TO-DO: System boot
     );
 
-    add_msg_cache(MAVLINK_MSG_ID_HOME_POSITION, msg);
-
-    return _server_component_impl->send_message(msg) ? TelemetryServer::Result::Success :
-                                                       TelemetryServer::Result::Unsupported;
+    return send_or_cache(MAVLINK_MSG_ID_HOME_POSITION, msg);
 }
 
 TelemetryServer::Result TelemetryServerImpl::publish_raw_gps(
@@ -152,10 +140,7 @@ TelemetryServer::Result TelemetryServerImpl::publish_raw_gps(
         static_cast<uint32_t>(static_cast<double>(raw_gps.heading_uncertainty_deg) * 1E5),
         static_cast<uint16_t>(static_cast<double>(raw_gps.yaw_deg) * 1E2));
 
-    add_msg_cache(MAVLINK_MSG_ID_GPS_RAW_INT, msg);
-
-    return _server_component_impl->send_message(msg) ? TelemetryServer::Result::Success :
-                                                       TelemetryServer::Result::Unsupported;
+    return send_or_cache(MAVLINK_MSG_ID_GPS_RAW_INT, msg);
 }
 
 TelemetryServer::Result TelemetryServerImpl::publish_battery(TelemetryServer::Battery battery)
@@ -185,10 +170,7 @@ TelemetryServer::Result TelemetryServerImpl::publish_battery(TelemetryServer::Ba
         MAV_BATTERY_MODE_UNKNOWN,
         0);
 
-    add_msg_cache(MAVLINK_MSG_ID_BATTERY_STATUS, msg);
-
-    return _server_component_impl->send_message(msg) ? TelemetryServer::Result::Success :
-                                                       TelemetryServer::Result::Unsupported;
+    return send_or_cache(MAVLINK_MSG_ID_BATTERY_STATUS, msg);
 }
 
 TelemetryServer::Result
@@ -215,10 +197,7 @@ TelemetryServerImpl::publish_distance_sensor(TelemetryServer::DistanceSensor dis
         q.data(),
         0);
 
-    add_msg_cache(MAVLINK_MSG_ID_DISTANCE_SENSOR, msg);
-
-    return _server_component_impl->send_message(msg) ? TelemetryServer::Result::Success :
-                                                       TelemetryServer::Result::Unsupported;
+    return send_or_cache(MAVLINK_MSG_ID_DISTANCE_SENSOR, msg);
 }
 
 TelemetryServer::Result
@@ -298,10 +277,7 @@ TelemetryServer::Result TelemetryServerImpl::publish_position_velocity_ned(
         position_velocity_ned.velocity.east_m_s,
         position_velocity_ned.velocity.down_m_s);
 
-    add_msg_cache(MAVLINK_MSG_ID_LOCAL_POSITION_NED, msg);
-
-    return _server_component_impl->send_message(msg) ? TelemetryServer::Result::Success :
-                                                       TelemetryServer::Result::Unsupported;
+    return send_or_cache(MAVLINK_MSG_ID_LOCAL_POSITION_NED, msg);
 }
 
 TelemetryServer::Result
@@ -392,10 +368,7 @@ TelemetryServer::Result TelemetryServerImpl::publish_sys_status(
         0,
         0);
 
-    add_msg_cache(MAVLINK_MSG_ID_SYS_STATUS, msg);
-
-    return _server_component_impl->send_message(msg) ? TelemetryServer::Result::Success :
-                                                       TelemetryServer::Result::Unsupported;
+    return send_or_cache(MAVLINK_MSG_ID_SYS_STATUS, msg);
 }
 
 uint8_t to_mav_vtol_state(TelemetryServer::VtolState vtol_state)
@@ -443,16 +416,39 @@ TelemetryServer::Result TelemetryServerImpl::publish_extended_sys_state(
         to_mav_vtol_state(vtol_state),
         to_mav_landed_state(landed_state));
 
-    add_msg_cache(MAVLINK_MSG_ID_EXTENDED_SYS_STATE, msg);
+    return send_or_cache(MAVLINK_MSG_ID_EXTENDED_SYS_STATE, msg);
+}
+
+TelemetryServer::Result
+TelemetryServerImpl::send_or_cache(uint64_t id, const mavlink_message_t& msg)
+{
+    {
+        std::lock_guard<std::mutex> lock(_interval_mutex);
+        _msg_cache.insert_or_assign(id, msg);
+
+        if (_stream_scheduler.interval_s(static_cast<uint32_t>(id))) {
+            // The scheduler will send it at the requested rate.
+            return TelemetryServer::Result::Success;
+        }
+    }
 
     return _server_component_impl->send_message(msg) ? TelemetryServer::Result::Success :
                                                        TelemetryServer::Result::Unsupported;
 }
 
-void TelemetryServerImpl::add_msg_cache(uint64_t id, mavlink_message_t& msg)
+void TelemetryServerImpl::run_stream_scheduler()
 {
-    std::unique_lock<std::mutex> lock(_interval_mutex);
-    _msg_cache.insert_or_assign(id, msg);
+    std::lock_guard<std::mutex> lock(_interval_mutex);
+    _stream_scheduler.run_once([this](uint32_t msg_id) -> unsigned {
+        auto it = _msg_cache.find(msg_id);
+        if (it == _msg_cache.end()) {
+            return 0;
+        }
+        if (!_server_component_impl->send_message(it->second)) {
+            return 0;
+        }
+        return MAVLINK_NUM_NON_PAYLOAD_BYTES + it->second.len;
+    });
 }
 
 } // namespace mavsdk
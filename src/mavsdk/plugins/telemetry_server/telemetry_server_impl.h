@@ -2,6 +2,7 @@
 
 #include "plugins/telemetry_server/telemetry_server.h"
 #include "server_plugin_impl_base.h"
+#include "stream_scheduler.h"
 
 #include <unordered_map>
 #include <chrono>
@@ -10,12 +11,6 @@ namespace mavsdk {
 
 class TelemetryServerImpl : public ServerPluginImplBase {
 public:
-    struct RequestMsgInterval {
-        uint32_t msg_id{0};
-        uint32_t interval{0};
-        void* cookie{nullptr};
-    };
-
     explicit TelemetryServerImpl(std::shared_ptr<ServerComponent> server_component);
     ~TelemetryServerImpl() override;
 
@@ -78,11 +73,18 @@ public:
 private:
     std::chrono::time_point<std::chrono::steady_clock> _start_time;
 
-    std::vector<RequestMsgInterval> _interval_requests;
+    // Messages requested using SET_MESSAGE_INTERVAL are only sent by the
+    // scheduler. Publishing them just replaces what is in the cache.
+    Time _time{};
     std::mutex _interval_mutex;
+    StreamScheduler _stream_scheduler{_time};
     std::unordered_map<uint64_t, mavlink_message_t> _msg_cache;
+    void* _stream_scheduler_cookie{nullptr};
+
+    static constexpr float STREAM_SCHEDULER_INTERVAL_S = 0.01f;
 
-    void add_msg_cache(uint64_t id, mavlink_message_t& msg);
+    TelemetryServer::Result send_or_cache(uint64_t id, const mavlink_message_t& msg);
+    void run_stream_scheduler();
 
     uint64_t get_boot_time_ms()
     {
@@ -0,0 +1,270 @@
+#include "traffic_table.h"
+#include "geometry.h"
+#include "mavsdk_math.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mavsdk {
+
+namespace {
+constexpr int NUM_LAT_CELLS = 180 * TrafficTable::CELLS_PER_DEG;
+constexpr int NUM_LON_CELLS = 360 * TrafficTable::CELLS_PER_DEG;
+
+// Same radius as used for the coordinate transformation.
+constexpr double METERS_PER_DEG = 6371000.0 * PI / 180.0;
+
+// Wraps around at the antimeridian.
+int wrap_lon_index(int index)
+{
+    return ((index % NUM_LON_CELLS) + NUM_LON_CELLS) % NUM_LON_CELLS;
+}
+
+int unwrapped_lon_index(double longitude_deg)
+{
+    return static_cast<int>(std::floor((longitude_deg + 180.0) * TrafficTable::CELLS_PER_DEG));
+}
+} // namespace
+
+TrafficTable::TrafficTable(Time& time) : _time(time) {}
+
+void TrafficTable::update(const Transponder::AdsbVehicle& vehicle)
+{
+    auto& entry = _entries[vehicle.icao_address];
+    entry.vehicle = vehicle;
+    entry.last_update = _time.steady_time();
+
+    if (has_position(vehicle)) {
+        const auto cell =
+            cell_key(lat_index(vehicle.latitude_deg), lon_index(vehicle.longitude_deg));
+        if (!entry.indexed || entry.cell != cell) {
+            if (entry.indexed) {
+                remove_from_cell(vehicle.icao_address, entry.cell);
+            }
+            add_to_cell(vehicle.icao_address, cell);
+            entry.indexed = true;
+            entry.cell = cell;
+        }
+    } else if (entry.indexed) {
+        remove_from_cell(vehicle.icao_address, entry.cell);
+        entry.indexed = false;
+    }
+
+    if (!entry.changed) {
+        entry.changed = true;
+        _changed.push_back(vehicle.icao_address);
+    }
+
+    // It's back before anyone was told that it's gone.
+    _expired.erase(
+        std::remove(_expired.begin(), _expired.end(), vehicle.icao_address), _expired.end());
+}
+
+void TrafficTable::remove_expired(double timeout_s)
+{
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        if (_time.elapsed_since_s(it->second.last_update) > timeout_s) {
+            if (it->second.indexed) {
+                remove_from_cell(it->first, it->second.cell);
+            }
+            _expired.push_back(it->first);
+            it = _entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void TrafficTable::clear()
+{
+    _entries.clear();
+    _cells.clear();
+    _changed.clear();
+    _expired.clear();
+}
+
+std::vector<Transponder::AdsbVehicle> TrafficTable::all() const
+{
+    std::vector<Transponder::AdsbVehicle> vehicles;
+    vehicles.reserve(_entries.size());
+    for (const auto& entry : _entries) {
+        vehicles.push_back(entry.second.vehicle);
+    }
+    return vehicles;
+}
+
+std::vector<Transponder::AdsbVehicle> TrafficTable::within(
+    double latitude_deg,
+    double longitude_deg,
+    float absolute_altitude_m,
+    double radius_m,
+    float altitude_band_m) const
+{
+    std::vector<uint32_t> candidates;
+    find_candidates(latitude_deg, longitude_deg, radius_m, candidates);
+
+    std::vector<double> latitudes_deg;
+    std::vector<double> longitudes_deg;
+    latitudes_deg.reserve(candidates.size());
+    longitudes_deg.reserve(candidates.size());
+
+    // Sort out the altitude first, it's cheaper.
+    auto remaining = candidates.begin();
+    for (const auto icao_address : candidates) {
+        const auto& vehicle = _entries.at(icao_address).vehicle;
+        if (std::abs(vehicle.absolute_altitude_m - absolute_altitude_m) <= altitude_band_m) {
+            *remaining++ = icao_address;
+            latitudes_deg.push_back(vehicle.latitude_deg);
+            longitudes_deg.push_back(vehicle.longitude_deg);
+        }
+    }
+    candidates.erase(remaining, candidates.end());
+
+    std::vector<double> north_m(candidates.size());
+    std::vector<double> east_m(candidates.size());
+    geometry::CoordinateTransformation({latitude_deg, longitude_deg})
+        .local_from_global(
+            latitudes_deg.data(),
+            longitudes_deg.data(),
+            candidates.size(),
+            north_m.data(),
+            east_m.data());
+
+    std::vector<std::pair<double, uint32_t>> found;
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+        const double distance_m = std::hypot(north_m[i], east_m[i]);
+        if (distance_m <= radius_m) {
+            found.emplace_back(distance_m, candidates[i]);
+        }
+    }
+    std::sort(found.begin(), found.end());
+
+    std::vector<Transponder::AdsbVehicle> vehicles;
+    vehicles.reserve(found.size());
+    for (const auto& distance_and_icao_address : found) {
+        vehicles.push_back(_entries.at(distance_and_icao_address.second).vehicle);
+    }
+    return vehicles;
+}
+
+TrafficUpdate TrafficTable::take_changes()
+{
+    TrafficUpdate update;
+    update.updated_vehicles.reserve(_changed.size());
+    for (const auto icao_address : _changed) {
+        auto it = _entries.find(icao_address);
+        if (it != _entries.end() && it->second.changed) {
+            it->second.changed = false;
+            update.updated_vehicles.push_back(it->second.vehicle);
+        }
+    }
+    _changed.clear();
+
+    update.expired_icao_addresses = std::move(_expired);
+    _expired.clear();
+    return update;
+}
+
+bool TrafficTable::has_position(const Transponder::AdsbVehicle& vehicle)
+{
+    return std::isfinite(vehicle.latitude_deg) && std::isfinite(vehicle.longitude_deg) &&
+           std::abs(vehicle.latitude_deg) <= 90.0 && std::abs(vehicle.longitude_deg) <= 180.0;
+}
+
+int TrafficTable::lat_index(double latitude_deg)
+{
+    const int index = static_cast<int>(std::floor((latitude_deg + 90.0) * CELLS_PER_DEG));
+    return constrain(index, 0, NUM_LAT_CELLS - 1);
+}
+
+int TrafficTable::lon_index(double longitude_deg)
+{
+    return wrap_lon_index(unwrapped_lon_index(longitude_deg));
+}
+
+TrafficTable::CellKey TrafficTable::cell_key(int lat, int lon)
+{
+    return static_cast<CellKey>(lat) * NUM_LON_CELLS + static_cast<CellKey>(lon);
+}
+
+void TrafficTable::add_to_cell(uint32_t icao_address, CellKey cell)
+{
+    _cells[cell].push_back(icao_address);
+}
+
+void TrafficTable::remove_from_cell(uint32_t icao_address, CellKey cell)
+{
+    auto it = _cells.find(cell);
+    if (it == _cells.end()) {
+        return;
+    }
+
+    auto& icao_addresses = it->second;
+    auto found = std::find(icao_addresses.begin(), icao_addresses.end(), icao_address);
+    if (found != icao_addresses.end()) {
+        // The order within a cell doesn't matter.
+        *found = icao_addresses.back();
+        icao_addresses.pop_back();
+    }
+
+    if (icao_addresses.empty()) {
+        _cells.erase(it);
+    }
+}
+
+void TrafficTable::find_candidates(
+    double latitude_deg,
+    double longitude_deg,
+    double radius_m,
+    std::vector<uint32_t>& candidates) const
+{
+    const auto add_all = [&]() {
+        for (const auto& entry : _entries) {
+            if (entry.second.indexed) {
+                candidates.push_back(entry.first);
+            }
+        }
+    };
+
+    const double delta_lat_deg = radius_m / METERS_PER_DEG;
+    const double min_lat_deg = latitude_deg - delta_lat_deg;
+    const double max_lat_deg = latitude_deg + delta_lat_deg;
+
+    if (min_lat_deg <= -90.0 || max_lat_deg >= 90.0) {
+        // Around a pole all longitudes are close.
+        add_all();
+        return;
+    }
+
+    // Longitudes get closer towards the poles, so the widest span is needed
+    // on the side closer to the pole.
+    const double max_abs_lat_rad =
+        to_rad_from_deg(std::max(std::abs(min_lat_deg), std::abs(max_lat_deg)));
+    const double delta_lon_deg = delta_lat_deg / std::cos(max_abs_lat_rad);
+
+    const int min_lat = lat_index(min_lat_deg);
+    const int max_lat = lat_index(max_lat_deg);
+    const int min_lon = unwrapped_lon_index(longitude_deg - delta_lon_deg);
+    const int max_lon = unwrapped_lon_index(longitude_deg + delta_lon_deg);
+
+    const auto num_cells = static_cast<std::size_t>(max_lat - min_lat + 1) *
+                           static_cast<std::size_t>(max_lon - min_lon + 1);
+
+    // For a large radius or a small table, looking at each cell is slower
+    // than just checking every target.
+    if (max_lon - min_lon + 1 >= NUM_LON_CELLS || num_cells > _entries.size()) {
+        add_all();
+        return;
+    }
+
+    for (int lat = min_lat; lat <= max_lat; ++lat) {
+        for (int lon = min_lon; lon <= max_lon; ++lon) {
+            const auto it = _cells.find(cell_key(lat, wrap_lon_index(lon)));
+            if (it != _cells.end()) {
+                candidates.insert(candidates.end(), it->second.begin(), it->second.end());
+            }
+        }
+    }
+}
+
+} // namespace mavsdk
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "mavsdk_time.h"
+#include "plugins/transponder/transponder.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace mavsdk {
+
+// Changes of the traffic table since they were last taken.
+struct TrafficUpdate {
+    // Targets added or updated, at their latest state.
+    std::vector<Transponder::AdsbVehicle> updated_vehicles{};
+    // ICAO addresses of the targets which expired.
+    std::vector<uint32_t> expired_icao_addresses{};
+};
+
+// Keeps the latest state of every ADS-B target, keyed by ICAO address.
+//
+// Targets which are not heard from for a while are expired. To find the
+// targets near a position without going through all of them, the positions
+// are indexed in a grid of latitude/longitude cells. A query only looks at
+// the cells overlapping the search radius and then checks the distance of
+// the targets in there.
+//
+// Changes are collected until taken, so they can be passed on in batches
+// instead of one by one.
+//
+// This class is not thread-safe, the caller needs to lock around it.
+class TrafficTable {
+public:
+    explicit TrafficTable(Time& time);
+    ~TrafficTable() = default;
+
+    // delete copy and move constructors and assign operators
+    TrafficTable(TrafficTable const&) = delete; // Copy construct
+    TrafficTable(TrafficTable&&) = delete; // Move construct
+    TrafficTable& operator=(TrafficTable const&) = delete; // Copy assign
+    TrafficTable& operator=(TrafficTable&&) = delete; // Move assign
+
+    void update(const Transponder::AdsbVehicle& vehicle);
+
+    // Removes the targets not updated within timeout_s.
+    void remove_expired(double timeout_s);
+
+    void clear();
+
+    [[nodiscard]] std::size_t size() const { return _entries.size(); }
+
+    [[nodiscard]] std::vector<Transponder::AdsbVehicle> all() const;
+
+    // Targets within radius_m horizontally and altitude_band_m vertically,
+    // sorted by horizontal distance. Altitudes are compared as they are,
+    // regardless of the altitude type.
+    [[nodiscard]] std::vector<Transponder::AdsbVehicle> within(
+        double latitude_deg,
+        double longitude_deg,
+        float absolute_altitude_m,
+        double radius_m,
+        float altitude_band_m) const;
+
+    // Returns what changed since the last call.
+    TrafficUpdate take_changes();
+
+    // Cells of 0.05 degrees, which is about 5.5 km north to south.
+    static constexpr int CELLS_PER_DEG = 20;
+
+private:
+    using CellKey = uint64_t;
+
+    struct Entry {
+        Transponder::AdsbVehicle vehicle{};
+        SteadyTimePoint last_update{};
+        bool indexed{false};
+        CellKey cell{0};
+        bool changed{false};
+    };
+
+    static bool has_position(const Transponder::AdsbVehicle& vehicle);
+    static int lat_index(double latitude_deg);
+    static int lon_index(double longitude_deg);
+    static CellKey cell_key(int lat, int lon);
+
+    void add_to_cell(uint32_t icao_address, CellKey cell);
+    void remove_from_cell(uint32_t icao_address, CellKey cell);
+
+    // Appends the ICAO addresses of the targets which might be within the radius.
+    void find_candidates(
+        double latitude_deg,
+        double longitude_deg,
+        double radius_m,
+        std::vector<uint32_t>& candidates) const;
+
+    std::unordered_map<uint32_t, Entry> _entries{};
+    std::unordered_map<CellKey, std::vector<uint32_t>> _cells{};
+    std::vector<uint32_t> _changed{};
+    std::vector<uint32_t> _expired{};
+
+    Time& _time;
+};
+
+} // namespace mavsdk
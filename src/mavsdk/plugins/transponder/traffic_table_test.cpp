@@ -0,0 +1,176 @@
+#include "traffic_table.h"
+#include "geometry.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#ifdef FAKE_TIME
+#define Time FakeTime
+#endif
+
+using namespace mavsdk;
+
+namespace {
+Transponder::AdsbVehicle
+make_vehicle(uint32_t icao_address, double north_m, double east_m, float altitude_m)
+{
+    // Relative to somewhere close to Zurich airport.
+    const geometry::CoordinateTransformation ct({47.45, 8.56});
+    const auto global = ct.global_from_local({north_m, east_m});
+
+    Transponder::AdsbVehicle vehicle;
+    vehicle.icao_address = icao_address;
+    vehicle.latitude_deg = global.latitude_deg;
+    vehicle.longitude_deg = global.longitude_deg;
+    vehicle.absolute_altitude_m = altitude_m;
+    return vehicle;
+}
+
+std::vector<uint32_t> icao_addresses(const std::vector<Transponder::AdsbVehicle>& vehicles)
+{
+    std::vector<uint32_t> result;
+    for (const auto& vehicle : vehicles) {
+        result.push_back(vehicle.icao_address);
+    }
+    return result;
+}
+} // namespace
+
+TEST(TrafficTable, KeepsLatestStatePerVehicle)
+{
+    Time time{};
+    TrafficTable table(time);
+
+    table.update(make_vehicle(1, 0.0, 0.0, 500.0f));
+    table.update(make_vehicle(2, 0.0, 0.0, 500.0f));
+    table.update(make_vehicle(1, 100.0, 0.0, 600.0f));
+
+    EXPECT_EQ(table.size(), 2u);
+
+    const auto changes = table.take_changes();
+    ASSERT_EQ(changes.updated_vehicles.size(), 2u);
+    EXPECT_EQ(changes.updated_vehicles[0], make_vehicle(1, 100.0, 0.0, 600.0f));
+    EXPECT_EQ(changes.updated_vehicles[1].icao_address, 2u);
+    EXPECT_TRUE(changes.expired_icao_addresses.empty());
+
+    // Taken already.
+    EXPECT_TRUE(table.take_changes().updated_vehicles.empty());
+}
+
+TEST(TrafficTable, Expires)
+{
+    Time time{};
+    TrafficTable table(time);
+
+    table.update(make_vehicle(1, 0.0, 0.0, 500.0f));
+    table.update(make_vehicle(2, 1000.0, 0.0, 500.0f));
+    table.take_changes();
+
+    time.sleep_for(std::chrono::seconds(5));
+    table.update(make_vehicle(2, 1000.0, 0.0, 500.0f));
+    time.sleep_for(std::chrono::seconds(6));
+    table.remove_expired(10.0);
+
+    EXPECT_EQ(table.size(), 1u);
+    EXPECT_EQ(table.within(47.45, 8.56, 500.0f, 10000.0, 100.0f).size(), 1u);
+
+    const auto changes = table.take_changes();
+    EXPECT_EQ(icao_addresses(changes.updated_vehicles), std::vector<uint32_t>{2});
+    EXPECT_EQ(changes.expired_icao_addresses, std::vector<uint32_t>{1});
+
+    // Back before it was reported as gone.
+    time.sleep_for(std::chrono::seconds(6));
+    table.remove_expired(10.0);
+    table.update(make_vehicle(2, 1000.0, 0.0, 500.0f));
+    EXPECT_TRUE(table.take_changes().expired_icao_addresses.empty());
+}
+
+TEST(TrafficTable, FindsWithinRadiusAndAltitudeBand)
+{
+    Time time{};
+    TrafficTable table(time);
+
+    table.update(make_vehicle(1, 3000.0, 0.0, 500.0f));
+    table.update(make_vehicle(2, 0.0, -1000.0, 550.0f));
+    table.update(make_vehicle(3, 0.0, 5500.0, 500.0f));
+    table.update(make_vehicle(4, 2000.0, 2000.0, 1500.0f));
+    table.update(make_vehicle(5, -20000.0, 0.0, 500.0f));
+
+    // Without a position it can't be found.
+    auto no_position = make_vehicle(6, 0.0, 0.0, 500.0f);
+    no_position.latitude_deg = std::numeric_limits<double>::quiet_NaN();
+    table.update(no_position);
+
+    EXPECT_EQ(
+        icao_addresses(table.within(47.45, 8.56, 500.0f, 5000.0, 300.0f)),
+        (std::vector<uint32_t>{2, 1}));
+    EXPECT_EQ(
+        icao_addresses(table.within(47.45, 8.56, 500.0f, 6000.0, 1000.0f)),
+        (std::vector<uint32_t>{2, 4, 1, 3}));
+    EXPECT_EQ(
+        icao_addresses(table.within(47.45, 8.56, 500.0f, 100000.0, 300.0f)),
+        (std::vector<uint32_t>{2, 1, 3, 5}));
+}
+
+TEST(TrafficTable, FindsAcrossAntimeridian)
+{
+    Time time{};
+    TrafficTable table(time);
+
+    Transponder::AdsbVehicle west;
+    west.icao_address = 1;
+    west.latitude_deg = -17.0;
+    west.longitude_deg = 179.99;
+    table.update(west);
+
+    Transponder::AdsbVehicle east = west;
+    east.icao_address = 2;
+    east.longitude_deg = -179.99;
+    table.update(east);
+
+    // Enough others so the grid is used.
+    for (uint32_t i = 0; i < 1000; ++i) {
+        Transponder::AdsbVehicle other = west;
+        other.icao_address = 100 + i;
+        other.longitude_deg = 170.0;
+        table.update(other);
+    }
+
+    EXPECT_EQ(icao_addresses(table.within(-17.0, 179.995, 0.0f, 5000.0, 100.0f)).size(), 2u);
+}
+
+TEST(TrafficTable, FindsSameAsLinearSearch)
+{
+    Time time{};
+    TrafficTable table(time);
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> position_m(-50000.0, 50000.0);
+    std::uniform_real_distribution<float> altitude_m(0.0f, 3000.0f);
+
+    std::vector<Transponder::AdsbVehicle> vehicles;
+    for (uint32_t i = 0; i < 500; ++i) {
+        const double north_m = position_m(generator);
+        const double east_m = position_m(generator);
+        vehicles.push_back(make_vehicle(i, north_m, east_m, altitude_m(generator)));
+        table.update(vehicles.back());
+    }
+
+    const geometry::CoordinateTransformation ct({47.45, 8.56});
+    for (const double radius_m : {1000.0, 8000.0, 30000.0}) {
+        std::vector<uint32_t> expected;
+        for (const auto& vehicle : vehicles) {
+            const auto local = ct.local_from_global({vehicle.latitude_deg, vehicle.longitude_deg});
+            if (std::hypot(local.north_m, local.east_m) <= radius_m &&
+                std::abs(vehicle.absolute_altitude_m - 1000.0f) <= 500.0f) {
+                expected.push_back(vehicle.icao_address);
+            }
+        }
+
+        auto found = icao_addresses(table.within(47.45, 8.56, 1000.0f, radius_m, 500.0f));
+        std::sort(found.begin(), found.end());
+        EXPECT_EQ(found, expected);
+    }
+}
@@ -4,6 +4,7 @@
 namespace mavsdk {
 
 template class CallbackList<Transponder::AdsbVehicle>;
+template class CallbackList<TrafficUpdate>;
 
 TransponderImpl::TransponderImpl(System& system) : PluginImplBase(system)
 {
@@ -26,11 +27,26 @@ void TransponderImpl::init()
         MAVLINK_MSG_ID_ADSB_VEHICLE,
         [this](const mavlink_message_t& message) { process_transponder(message); },
         this);
+
+    _system_impl->register_mavlink_message_handler(
+        MAVLINK_MSG_ID_GLOBAL_POSITION_INT,
+        [this](const mavlink_message_t& message) { process_global_position_int(message); },
+        this);
+
+    _system_impl->add_call_every(
+        [this]() { publish_traffic(); },
+        static_cast<float>(1.0 / DEFAULT_TRAFFIC_UPDATE_RATE_HZ),
+        &_traffic_call_every_cookie);
 }
 
 void TransponderImpl::deinit()
 {
+    _system_impl->remove_call_every(_traffic_call_every_cookie);
     _system_impl->unregister_all_mavlink_message_handlers(this);
+
+    std::lock_guard<std::mutex> lock(_traffic_mutex);
+    _traffic_table.clear();
+    _ownship.reset();
 }
 
 void TransponderImpl::enable() {}
@@ -73,6 +89,56 @@ void TransponderImpl::unsubscribe_transponder(Transponder::TransponderHandle han
     _transponder_subscriptions.unsubscribe(handle);
 }
 
+TransponderImpl::TrafficHandle TransponderImpl::subscribe_traffic(const TrafficCallback& callback)
+{
+    std::lock_guard<std::mutex> lock(_subscription_mutex);
+    return _traffic_subscriptions.subscribe(callback);
+}
+
+void TransponderImpl::unsubscribe_traffic(TrafficHandle handle)
+{
+    std::lock_guard<std::mutex> lock(_subscription_mutex);
+    _traffic_subscriptions.unsubscribe(handle);
+}
+
+void TransponderImpl::set_traffic_update_rate(double rate_hz)
+{
+    if (!(rate_hz > 0.0)) {
+        LogErr() << "Invalid traffic update rate: " << rate_hz;
+        return;
+    }
+
+    _system_impl->change_call_every(static_cast<float>(1.0 / rate_hz), _traffic_call_every_cookie);
+}
+
+void TransponderImpl::set_traffic_timeout(double timeout_s)
+{
+    std::lock_guard<std::mutex> lock(_traffic_mutex);
+    _traffic_timeout_s = timeout_s;
+}
+
+std::vector<Transponder::AdsbVehicle> TransponderImpl::traffic() const
+{
+    std::lock_guard<std::mutex> lock(_traffic_mutex);
+    return _traffic_table.all();
+}
+
+std::vector<Transponder::AdsbVehicle>
+TransponderImpl::traffic_within(double radius_m, float altitude_band_m) const
+{
+    std::lock_guard<std::mutex> lock(_traffic_mutex);
+    if (!_ownship) {
+        return {};
+    }
+
+    return _traffic_table.within(
+        _ownship->latitude_deg,
+        _ownship->longitude_deg,
+        _ownship->absolute_altitude_m,
+        radius_m,
+        altitude_band_m);
+}
+
 void TransponderImpl::set_transponder(Transponder::AdsbVehicle transponder)
 {
     std::lock_guard<std::mutex> lock(_transponder_mutex);
@@ -103,10 +169,47 @@ void TransponderImpl::process_transponder(const mavlink_message_t& message)
 
     set_transponder(adsbVehicle);
 
+    {
+        std::lock_guard<std::mutex> lock(_traffic_mutex);
+        _traffic_table.update(adsbVehicle);
+    }
+
     _transponder_subscriptions.queue(
         transponder(), [this](const auto& func) { _system_impl->call_user_callback(func); });
 }
 
+void TransponderImpl::process_global_position_int(const mavlink_message_t& message)
+{
+    mavlink_global_position_int_t global_position_int;
+    mavlink_msg_global_position_int_decode(&message, &global_position_int);
+
+    Ownship ownship;
+    ownship.latitude_deg = global_position_int.lat * 1e-7;
+    ownship.longitude_deg = global_position_int.lon * 1e-7;
+    ownship.absolute_altitude_m = global_position_int.alt * 1e-3f;
+
+    std::lock_guard<std::mutex> lock(_traffic_mutex);
+    _ownship = ownship;
+}
+
+void TransponderImpl::publish_traffic()
+{
+    TrafficUpdate update;
+    {
+        std::lock_guard<std::mutex> lock(_traffic_mutex);
+        _traffic_table.remove_expired(_traffic_timeout_s);
+        // Taken even without subscribers, so the changes don't pile up.
+        update = _traffic_table.take_changes();
+    }
+
+    if (update.updated_vehicles.empty() && update.expired_icao_addresses.empty()) {
+        return;
+    }
+
+    _traffic_subscriptions.queue(
+        update, [this](const auto& func) { _system_impl->call_user_callback(func); });
+}
+
 Transponder::Result
 TransponderImpl::transponder_result_from_command_result(MavlinkCommandSender::Result command_result)
 {
@@ -3,6 +3,9 @@
 #include "plugins/transponder/transponder.h"
 #include "plugin_impl_base.h"
 #include "callback_list.h"
+#include "traffic_table.h"
+
+#include <optional>
 
 namespace mavsdk {
 
@@ -12,6 +15,10 @@ public:
     explicit TransponderImpl(std::shared_ptr<System> system);
     ~TransponderImpl() override;
 
+    // Not part of the Transponder API until transponder.proto has the matching RPCs.
+    using TrafficCallback = std::function<void(TrafficUpdate)>;
+    using TrafficHandle = Handle<TrafficUpdate>;
+
     void init() override;
     void deinit() override;
 
@@ -28,10 +35,22 @@ public:
     subscribe_transponder(const Transponder::TransponderCallback& callback);
     void unsubscribe_transponder(Transponder::TransponderHandle handle);
 
+    TrafficHandle subscribe_traffic(const TrafficCallback& callback);
+    void unsubscribe_traffic(TrafficHandle handle);
+
+    void set_traffic_update_rate(double rate_hz);
+    void set_traffic_timeout(double timeout_s);
+
+    std::vector<Transponder::AdsbVehicle> traffic() const;
+    std::vector<Transponder::AdsbVehicle>
+    traffic_within(double radius_m, float altitude_band_m) const;
+
 private:
     void set_transponder(Transponder::AdsbVehicle transponder);
 
     void process_transponder(const mavlink_message_t& message);
+    void process_global_position_int(const mavlink_message_t& message);
+    void publish_traffic();
 
     static Transponder::Result
     transponder_result_from_command_result(MavlinkCommandSender::Result command_result);
@@ -44,6 +63,22 @@ private:
 
     std::mutex _subscription_mutex{};
     CallbackList<Transponder::AdsbVehicle> _transponder_subscriptions{};
+    CallbackList<TrafficUpdate> _traffic_subscriptions{};
+
+    struct Ownship {
+        double latitude_deg{0.0};
+        double longitude_deg{0.0};
+        float absolute_altitude_m{0.0f};
+    };
+
+    mutable std::mutex _traffic_mutex{};
+    TrafficTable _traffic_table{_system_impl->get_time()};
+    std::optional<Ownship> _ownship{};
+    double _traffic_timeout_s{DEFAULT_TRAFFIC_TIMEOUT_S};
+    void* _traffic_call_every_cookie{nullptr};
+
+    static constexpr double DEFAULT_TRAFFIC_UPDATE_RATE_HZ = 1.0;
+    static constexpr double DEFAULT_TRAFFIC_TIMEOUT_S = 20.0;
 };
 
 } // namespace mavsdk
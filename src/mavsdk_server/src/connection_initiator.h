@@ -57,13 +57,20 @@ private:
 
         mavsdk.subscribe_on_new_system([this, &mavsdk]() {
             std::lock_guard<std::mutex> guard(_mutex);
-            const auto system = mavsdk.systems().at(0);
+            if (_is_discovery_finished) {
+                return;
+            }
 
-            if (!_is_discovery_finished && system->is_connected()) {
-                LogInfo() << "System discovered";
+            // Any system will do, with several vehicles on the same link they
+            // are all served and calls are routed by system id.
+            for (const auto& system : mavsdk.systems()) {
+                if (system->is_connected()) {
+                    LogInfo() << "System discovered";
 
-                _is_discovery_finished = true;
-                _discovery_promise->set_value(true);
+                    _is_discovery_finished = true;
+                    _discovery_promise->set_value(true);
+                    break;
+                }
             }
         });
 
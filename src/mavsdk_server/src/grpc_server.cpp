@@ -6,6 +6,7 @@
 #include <grpc++/security/server_credentials.h>
 
 #include "log.h"
+#include "system_selection_interceptor.h"
 
 namespace mavsdk {
 namespace mavsdk_server {
@@ -15,6 +16,11 @@ void GrpcServer::set_port(const int port)
     _port = port;
 }
 
+void GrpcServer::set_unix_socket_path(const std::string& path)
+{
+    _unix_socket_path = path;
+}
+
 int GrpcServer::run()
 {
     grpc::ServerBuilder builder;
@@ -22,6 +28,12 @@ int GrpcServer::run()
 
     builder.RegisterService(&_core);
 
+    // Route each call to the system given in its metadata.
+    std::vector<std::unique_ptr<grpc::experimental::ServerInterceptorFactoryInterface>>
+        interceptor_creators;
+    interceptor_creators.push_back(std::make_unique<SystemSelectionInterceptorFactory>());
+    builder.experimental().SetInterceptorCreators(std::move(interceptor_creators));
+
 #ifdef ACTION_ENABLED
     builder.RegisterService(&_action_service);
 #endif
@@ -159,9 +171,15 @@ int GrpcServer::run()
 
     if (_bound_port != 0) {
         LogInfo() << "Server started";
-        LogInfo() << "Server set to listen on 0.0.0.0:" << _bound_port;
-    } else {
+        if (_unix_socket_path.empty()) {
+            LogInfo() << "Server set to listen on 0.0.0.0:" << _bound_port;
+        } else {
+            LogInfo() << "Server set to listen on unix:" << _unix_socket_path;
+        }
+    } else if (_unix_socket_path.empty()) {
         LogErr() << "Failed to bind server to port " << _port;
+    } else {
+        LogErr() << "Failed to bind server to unix:" << _unix_socket_path;
     }
 
     return _bound_port;
@@ -317,6 +335,14 @@ void GrpcServer::stop()
 
 void GrpcServer::setup_port(grpc::ServerBuilder& builder)
 {
+    if (!_unix_socket_path.empty()) {
+        // For clients on the same host, this avoids going through the TCP stack.
+        // There is no port for a unix socket but gRPC sets it to 1 when bound.
+        builder.AddListeningPort(
+            "unix:" + _unix_socket_path, grpc::InsecureServerCredentials(), &_bound_port);
+        return;
+    }
+
     const std::string server_address("0.0.0.0:" + std::to_string(_port));
     builder.AddListeningPort(server_address, grpc::InsecureServerCredentials(), &_bound_port);
 }
@@ -10,6 +10,7 @@
 #endif
 
 #include <memory>
+#include <string>
 
 #include "mavsdk.h"
 #include "core/core_service_impl.h"
@@ -348,6 +349,7 @@ public:
     void wait();
     void stop();
     void set_port(int port);
+    void set_unix_socket_path(const std::string& path);
 
 private:
     void setup_port(grpc::ServerBuilder& builder);
@@ -582,6 +584,7 @@ private:
 
     int _port{0};
     int _bound_port{0};
+    std::string _unix_socket_path{};
 };
 
 } // namespace mavsdk_server
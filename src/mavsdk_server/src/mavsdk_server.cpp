@@ -5,6 +5,9 @@
 #include "connection_initiator.h"
 #include "mavsdk.h"
 #include "grpc_server.h"
+#include "log.h"
+#include "plugins/telemetry/telemetry.h"
+#include "telemetry/telemetry_shm_ring.h"
 
 using namespace mavsdk::mavsdk_server;
 
@@ -16,13 +19,24 @@ public:
     bool connect(const std::string& connection_url)
     {
         _connection_initiator.start(_mavsdk, connection_url);
-        return _connection_initiator.wait();
+        if (!_connection_initiator.wait()) {
+            return false;
+        }
+
+        if (!_telemetry_shm_name.empty()) {
+            startTelemetryShmRing();
+        }
+
+        return true;
     }
 
     int startGrpcServer(const int port)
     {
         _server = std::make_unique<GrpcServer>(_mavsdk);
         _server->set_port(port);
+        if (!_unix_socket_path.empty()) {
+            _server->set_unix_socket_path(_unix_socket_path);
+        }
         _grpc_port = _server->run();
         return _grpc_port;
     }
@@ -40,16 +54,43 @@ public:
 
     int getPort() { return _grpc_port; }
 
+    void setUnixSocketPath(const std::string& path) { _unix_socket_path = path; }
+
+    void setTelemetryShmName(const std::string& name) { _telemetry_shm_name = name; }
+
     void setMavlinkIds(uint8_t system_id, uint8_t component_id)
     {
         _mavsdk.set_configuration(mavsdk::Mavsdk::Configuration{system_id, component_id, false});
     }
 
 private:
+    void startTelemetryShmRing()
+    {
+#if defined(WINDOWS)
+        LogErr() << "Shared memory telemetry is not supported on Windows";
+#else
+        for (const auto& system : _mavsdk.systems()) {
+            if (system->is_connected()) {
+                _telemetry = std::make_unique<mavsdk::Telemetry>(system);
+                _telemetry_shm_ring =
+                    std::make_unique<TelemetryShmRing<>>(*_telemetry, _telemetry_shm_name);
+                break;
+            }
+        }
+#endif
+    }
+
     mavsdk::Mavsdk _mavsdk;
     ConnectionInitiator<mavsdk::Mavsdk> _connection_initiator;
     std::unique_ptr<GrpcServer> _server;
     int _grpc_port;
+    std::string _unix_socket_path{};
+
+    std::string _telemetry_shm_name{};
+    std::unique_ptr<mavsdk::Telemetry> _telemetry{};
+#if !defined(WINDOWS)
+    std::unique_ptr<TelemetryShmRing<>> _telemetry_shm_ring{};
+#endif
 };
 
 MavsdkServer::MavsdkServer() : _impl(std::make_unique<Impl>()) {}
@@ -60,6 +101,16 @@ int MavsdkServer::startGrpcServer(const int port)
     return _impl->startGrpcServer(port);
 }
 
+void MavsdkServer::setUnixSocketPath(const std::string& path)
+{
+    _impl->setUnixSocketPath(path);
+}
+
+void MavsdkServer::setTelemetryShmName(const std::string& name)
+{
+    _impl->setTelemetryShmName(name);
+}
+
 bool MavsdkServer::connect(const std::string& connection_url)
 {
     return _impl->connect(connection_url);
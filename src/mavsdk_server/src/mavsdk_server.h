@@ -12,6 +12,8 @@ public:
     MavsdkServer& operator=(MavsdkServer&&) = delete;
 
     int startGrpcServer(int port);
+    void setUnixSocketPath(const std::string& path);
+    void setTelemetryShmName(const std::string& name);
     bool connect(const std::string& connection_url = "udp://:14540");
     void wait();
     void stop();
@@ -35,6 +35,16 @@ int mavsdk_server_run_with_mavlink_ids(
     return mavsdk_server_run(mavsdk_server, system_address, mavsdk_server_port);
 }
 
+void mavsdk_server_set_unix_socket_path(MavsdkServer* mavsdk_server, const char* path)
+{
+    mavsdk_server->setUnixSocketPath(std::string(path));
+}
+
+void mavsdk_server_set_telemetry_shm_name(MavsdkServer* mavsdk_server, const char* name)
+{
+    mavsdk_server->setTelemetryShmName(std::string(name));
+}
+
 int mavsdk_server_get_port(MavsdkServer* mavsdk_server)
 {
     return mavsdk_server->getPort();
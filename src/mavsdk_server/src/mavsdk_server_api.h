@@ -30,6 +30,18 @@ DLLExport int mavsdk_server_run_with_mavlink_ids(
     const uint8_t system_id,
     const uint8_t component_id);
 
+// Listen on a unix domain socket at the given path instead of a TCP port.
+// Needs to be called before mavsdk_server_run.
+DLLExport void
+mavsdk_server_set_unix_socket_path(struct MavsdkServer* mavsdk_server, const char* path);
+
+// Also publish position, attitude and velocity of the vehicle into a POSIX
+// shared memory ring of the given name, e.g. "/mavsdk_telemetry", for clients
+// on the same host. The layout is described in telemetry_shm_ring.h.
+// Needs to be called before mavsdk_server_run.
+DLLExport void
+mavsdk_server_set_telemetry_shm_name(struct MavsdkServer* mavsdk_server, const char* name);
+
 DLLExport int mavsdk_server_get_port(struct MavsdkServer* mavsdk_server);
 
 DLLExport void mavsdk_server_attach(struct MavsdkServer* mavsdk_server);
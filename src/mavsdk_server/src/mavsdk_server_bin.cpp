@@ -19,6 +19,8 @@ int main(int argc, char** argv)
     int mavsdk_server_port = default_mavsdk_server_port;
     int mavsdk_sysid = default_sysid;
     int mavsdk_compid = default_compid;
+    std::string unix_socket_path;
+    std::string telemetry_shm_name;
 
     for (int i = 1; i < argc; i++) {
         const std::string current_arg = argv[i];
@@ -81,6 +83,22 @@ int main(int argc, char** argv)
                 usage(argv[0]);
                 return 1;
             }
+        } else if (current_arg == "--unix") {
+            if (argc <= i + 1) {
+                usage(argv[0]);
+                return 1;
+            }
+
+            unix_socket_path = argv[i + 1];
+            i++;
+        } else if (current_arg == "--shm-telemetry") {
+            if (argc <= i + 1) {
+                usage(argv[0]);
+                return 1;
+            }
+
+            telemetry_shm_name = argv[i + 1];
+            i++;
         } else {
             connection_url = current_arg;
         }
@@ -88,6 +106,12 @@ int main(int argc, char** argv)
 
     MavsdkServer* mavsdk_server;
     mavsdk_server_init(&mavsdk_server);
+    if (!unix_socket_path.empty()) {
+        mavsdk_server_set_unix_socket_path(mavsdk_server, unix_socket_path.c_str());
+    }
+    if (!telemetry_shm_name.empty()) {
+        mavsdk_server_set_telemetry_shm_name(mavsdk_server, telemetry_shm_name.c_str());
+    }
     const auto is_started = mavsdk_server_run_with_mavlink_ids(
         mavsdk_server,
         connection_url.c_str(),
@@ -123,6 +147,11 @@ void usage(const char* bin_name)
               << "  -p          : set the port on which to run the gRPC server,\n"
               << "                set to 0 to choose a free port automatically\n"
               << "                (default is " << default_mavsdk_server_port << ")\n"
+              << "  --unix      : listen on a unix domain socket at the given path\n"
+              << "                instead of the gRPC port, for clients on the same host\n"
+              << "  --shm-telemetry : also publish position, attitude and velocity into\n"
+              << "                a shared memory ring of the given name, e.g. /mavsdk_telemetry,\n"
+              << "                for clients on the same host\n"
               << "  --sysid     : set the MAVLink system ID of the MAVSDK server itself,\n"
               << "                (default is " << default_sysid << ", range 1..255)\n"
               << "  --compid    : set the MAVLink component ID of the MAVSDK server itself,\n"
@@ -256,7 +256,8 @@ public:
         const mavsdk::rpc::action_server::SubscribeArmDisarmRequest* /* request */,
         grpc::ServerWriter<rpc::action_server::ArmDisarmResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             rpc::action_server::ArmDisarmResponse rpc_response;
 
             // For server plugins, this should never happen, they should always be constructible.
@@ -274,32 +275,31 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::ActionServer::ArmDisarmHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_arm_disarm(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    mavsdk::ActionServer::Result result,
-                    const mavsdk::ActionServer::ArmDisarm arm_disarm) {
-                    rpc::action_server::ArmDisarmResponse rpc_response;
+        const mavsdk::ActionServer::ArmDisarmHandle handle = plugin->subscribe_arm_disarm(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                mavsdk::ActionServer::Result result,
+                const mavsdk::ActionServer::ArmDisarm arm_disarm) {
+                rpc::action_server::ArmDisarmResponse rpc_response;
 
-                    rpc_response.set_allocated_arm(translateToRpcArmDisarm(arm_disarm).release());
+                rpc_response.set_allocated_arm(translateToRpcArmDisarm(arm_disarm).release());
 
-                    auto rpc_result = translateToRpcResult(result);
-                    auto* rpc_action_server_result = new rpc::action_server::ActionServerResult();
-                    rpc_action_server_result->set_result(rpc_result);
-                    std::stringstream ss;
-                    ss << result;
-                    rpc_action_server_result->set_result_str(ss.str());
-                    rpc_response.set_allocated_action_server_result(rpc_action_server_result);
+                auto rpc_result = translateToRpcResult(result);
+                auto* rpc_action_server_result = new rpc::action_server::ActionServerResult();
+                rpc_action_server_result->set_result(rpc_result);
+                std::stringstream ss;
+                ss << result;
+                rpc_action_server_result->set_result_str(ss.str());
+                rpc_response.set_allocated_action_server_result(rpc_action_server_result);
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_arm_disarm(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_arm_disarm(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -313,7 +313,8 @@ public:
         const mavsdk::rpc::action_server::SubscribeFlightModeChangeRequest* /* request */,
         grpc::ServerWriter<rpc::action_server::FlightModeChangeResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             rpc::action_server::FlightModeChangeResponse rpc_response;
 
             // For server plugins, this should never happen, they should always be constructible.
@@ -332,8 +333,14 @@ public:
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
         const mavsdk::ActionServer::FlightModeChangeHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_flight_mode_change(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+            plugin->subscribe_flight_mode_change(
+                [this,
+                 plugin,
+                 &writer,
+                 &stream_closed_promise,
+                 is_finished,
+                 subscribe_mutex,
+                 &handle](
                     mavsdk::ActionServer::Result result,
                     const mavsdk::ActionServer::FlightMode flight_mode_change) {
                     rpc::action_server::FlightModeChangeResponse rpc_response;
@@ -350,7 +357,7 @@ public:
 
                     std::unique_lock<std::mutex> lock(*subscribe_mutex);
                     if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_flight_mode_change(handle);
+                        plugin->unsubscribe_flight_mode_change(handle);
 
                         *is_finished = true;
                         unregister_stream_stop_promise(stream_closed_promise);
@@ -370,7 +377,8 @@ public:
         const mavsdk::rpc::action_server::SubscribeTakeoffRequest* /* request */,
         grpc::ServerWriter<rpc::action_server::TakeoffResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             rpc::action_server::TakeoffResponse rpc_response;
 
             // For server plugins, this should never happen, they should always be constructible.
@@ -388,31 +396,30 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::ActionServer::TakeoffHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_takeoff(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    mavsdk::ActionServer::Result result, const bool takeoff) {
-                    rpc::action_server::TakeoffResponse rpc_response;
+        const mavsdk::ActionServer::TakeoffHandle handle = plugin->subscribe_takeoff(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                mavsdk::ActionServer::Result result, const bool takeoff) {
+                rpc::action_server::TakeoffResponse rpc_response;
 
-                    rpc_response.set_takeoff(takeoff);
+                rpc_response.set_takeoff(takeoff);
 
-                    auto rpc_result = translateToRpcResult(result);
-                    auto* rpc_action_server_result = new rpc::action_server::ActionServerResult();
-                    rpc_action_server_result->set_result(rpc_result);
-                    std::stringstream ss;
-                    ss << result;
-                    rpc_action_server_result->set_result_str(ss.str());
-                    rpc_response.set_allocated_action_server_result(rpc_action_server_result);
+                auto rpc_result = translateToRpcResult(result);
+                auto* rpc_action_server_result = new rpc::action_server::ActionServerResult();
+                rpc_action_server_result->set_result(rpc_result);
+                std::stringstream ss;
+                ss << result;
+                rpc_action_server_result->set_result_str(ss.str());
+                rpc_response.set_allocated_action_server_result(rpc_action_server_result);
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_takeoff(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_takeoff(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -426,7 +433,8 @@ public:
         const mavsdk::rpc::action_server::SubscribeLandRequest* /* request */,
         grpc::ServerWriter<rpc::action_server::LandResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             rpc::action_server::LandResponse rpc_response;
 
             // For server plugins, this should never happen, they should always be constructible.
@@ -444,8 +452,8 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::ActionServer::LandHandle handle = _lazy_plugin.maybe_plugin()->subscribe_land(
-            [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+        const mavsdk::ActionServer::LandHandle handle = plugin->subscribe_land(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
                 mavsdk::ActionServer::Result result, const bool land) {
                 rpc::action_server::LandResponse rpc_response;
 
@@ -461,7 +469,7 @@ public:
 
                 std::unique_lock<std::mutex> lock(*subscribe_mutex);
                 if (!*is_finished && !writer->Write(rpc_response)) {
-                    _lazy_plugin.maybe_plugin()->unsubscribe_land(handle);
+                    plugin->unsubscribe_land(handle);
 
                     *is_finished = true;
                     unregister_stream_stop_promise(stream_closed_promise);
@@ -481,7 +489,8 @@ public:
         const mavsdk::rpc::action_server::SubscribeRebootRequest* /* request */,
         grpc::ServerWriter<rpc::action_server::RebootResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             rpc::action_server::RebootResponse rpc_response;
 
             // For server plugins, this should never happen, they should always be constructible.
@@ -499,31 +508,30 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::ActionServer::RebootHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_reboot(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    mavsdk::ActionServer::Result result, const bool reboot) {
-                    rpc::action_server::RebootResponse rpc_response;
+        const mavsdk::ActionServer::RebootHandle handle = plugin->subscribe_reboot(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                mavsdk::ActionServer::Result result, const bool reboot) {
+                rpc::action_server::RebootResponse rpc_response;
 
-                    rpc_response.set_reboot(reboot);
+                rpc_response.set_reboot(reboot);
 
-                    auto rpc_result = translateToRpcResult(result);
-                    auto* rpc_action_server_result = new rpc::action_server::ActionServerResult();
-                    rpc_action_server_result->set_result(rpc_result);
-                    std::stringstream ss;
-                    ss << result;
-                    rpc_action_server_result->set_result_str(ss.str());
-                    rpc_response.set_allocated_action_server_result(rpc_action_server_result);
+                auto rpc_result = translateToRpcResult(result);
+                auto* rpc_action_server_result = new rpc::action_server::ActionServerResult();
+                rpc_action_server_result->set_result(rpc_result);
+                std::stringstream ss;
+                ss << result;
+                rpc_action_server_result->set_result_str(ss.str());
+                rpc_response.set_allocated_action_server_result(rpc_action_server_result);
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_reboot(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_reboot(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -537,7 +545,8 @@ public:
         const mavsdk::rpc::action_server::SubscribeShutdownRequest* /* request */,
         grpc::ServerWriter<rpc::action_server::ShutdownResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             rpc::action_server::ShutdownResponse rpc_response;
 
             // For server plugins, this should never happen, they should always be constructible.
@@ -555,31 +564,30 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::ActionServer::ShutdownHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_shutdown(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    mavsdk::ActionServer::Result result, const bool shutdown) {
-                    rpc::action_server::ShutdownResponse rpc_response;
+        const mavsdk::ActionServer::ShutdownHandle handle = plugin->subscribe_shutdown(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                mavsdk::ActionServer::Result result, const bool shutdown) {
+                rpc::action_server::ShutdownResponse rpc_response;
 
-                    rpc_response.set_shutdown(shutdown);
+                rpc_response.set_shutdown(shutdown);
 
-                    auto rpc_result = translateToRpcResult(result);
-                    auto* rpc_action_server_result = new rpc::action_server::ActionServerResult();
-                    rpc_action_server_result->set_result(rpc_result);
-                    std::stringstream ss;
-                    ss << result;
-                    rpc_action_server_result->set_result_str(ss.str());
-                    rpc_response.set_allocated_action_server_result(rpc_action_server_result);
+                auto rpc_result = translateToRpcResult(result);
+                auto* rpc_action_server_result = new rpc::action_server::ActionServerResult();
+                rpc_action_server_result->set_result(rpc_result);
+                std::stringstream ss;
+                ss << result;
+                rpc_action_server_result->set_result_str(ss.str());
+                rpc_response.set_allocated_action_server_result(rpc_action_server_result);
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_shutdown(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_shutdown(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -593,7 +601,8 @@ public:
         const mavsdk::rpc::action_server::SubscribeTerminateRequest* /* request */,
         grpc::ServerWriter<rpc::action_server::TerminateResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             rpc::action_server::TerminateResponse rpc_response;
 
             // For server plugins, this should never happen, they should always be constructible.
@@ -611,31 +620,30 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::ActionServer::TerminateHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_terminate(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    mavsdk::ActionServer::Result result, const bool terminate) {
-                    rpc::action_server::TerminateResponse rpc_response;
+        const mavsdk::ActionServer::TerminateHandle handle = plugin->subscribe_terminate(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                mavsdk::ActionServer::Result result, const bool terminate) {
+                rpc::action_server::TerminateResponse rpc_response;
 
-                    rpc_response.set_terminate(terminate);
+                rpc_response.set_terminate(terminate);
 
-                    auto rpc_result = translateToRpcResult(result);
-                    auto* rpc_action_server_result = new rpc::action_server::ActionServerResult();
-                    rpc_action_server_result->set_result(rpc_result);
-                    std::stringstream ss;
-                    ss << result;
-                    rpc_action_server_result->set_result_str(ss.str());
-                    rpc_response.set_allocated_action_server_result(rpc_action_server_result);
+                auto rpc_result = translateToRpcResult(result);
+                auto* rpc_action_server_result = new rpc::action_server::ActionServerResult();
+                rpc_action_server_result->set_result(rpc_result);
+                std::stringstream ss;
+                ss << result;
+                rpc_action_server_result->set_result_str(ss.str());
+                rpc_response.set_allocated_action_server_result(rpc_action_server_result);
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_terminate(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_terminate(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
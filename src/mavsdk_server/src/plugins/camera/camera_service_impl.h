@@ -968,7 +968,8 @@ public:
         const mavsdk::rpc::camera::SubscribeModeRequest* /* request */,
         grpc::ServerWriter<rpc::camera::ModeResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -979,8 +980,8 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Camera::ModeHandle handle = _lazy_plugin.maybe_plugin()->subscribe_mode(
-            [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+        const mavsdk::Camera::ModeHandle handle = plugin->subscribe_mode(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
                 const mavsdk::Camera::Mode mode) {
                 rpc::camera::ModeResponse rpc_response;
 
@@ -988,7 +989,7 @@ public:
 
                 std::unique_lock<std::mutex> lock(*subscribe_mutex);
                 if (!*is_finished && !writer->Write(rpc_response)) {
-                    _lazy_plugin.maybe_plugin()->unsubscribe_mode(handle);
+                    plugin->unsubscribe_mode(handle);
 
                     *is_finished = true;
                     unregister_stream_stop_promise(stream_closed_promise);
@@ -1008,7 +1009,8 @@ public:
         const mavsdk::rpc::camera::SubscribeInformationRequest* /* request */,
         grpc::ServerWriter<rpc::camera::InformationResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1019,24 +1021,23 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Camera::InformationHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_information(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Camera::Information information) {
-                    rpc::camera::InformationResponse rpc_response;
+        const mavsdk::Camera::InformationHandle handle = plugin->subscribe_information(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Camera::Information information) {
+                rpc::camera::InformationResponse rpc_response;
 
-                    rpc_response.set_allocated_information(
-                        translateToRpcInformation(information).release());
+                rpc_response.set_allocated_information(
+                    translateToRpcInformation(information).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_information(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_information(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -1050,7 +1051,8 @@ public:
         const mavsdk::rpc::camera::SubscribeVideoStreamInfoRequest* /* request */,
         grpc::ServerWriter<rpc::camera::VideoStreamInfoResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1061,24 +1063,23 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Camera::VideoStreamInfoHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_video_stream_info(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Camera::VideoStreamInfo video_stream_info) {
-                    rpc::camera::VideoStreamInfoResponse rpc_response;
+        const mavsdk::Camera::VideoStreamInfoHandle handle = plugin->subscribe_video_stream_info(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Camera::VideoStreamInfo video_stream_info) {
+                rpc::camera::VideoStreamInfoResponse rpc_response;
 
-                    rpc_response.set_allocated_video_stream_info(
-                        translateToRpcVideoStreamInfo(video_stream_info).release());
+                rpc_response.set_allocated_video_stream_info(
+                    translateToRpcVideoStreamInfo(video_stream_info).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_video_stream_info(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_video_stream_info(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -1092,7 +1093,8 @@ public:
         const mavsdk::rpc::camera::SubscribeCaptureInfoRequest* /* request */,
         grpc::ServerWriter<rpc::camera::CaptureInfoResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1103,24 +1105,23 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Camera::CaptureInfoHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_capture_info(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Camera::CaptureInfo capture_info) {
-                    rpc::camera::CaptureInfoResponse rpc_response;
+        const mavsdk::Camera::CaptureInfoHandle handle = plugin->subscribe_capture_info(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Camera::CaptureInfo capture_info) {
+                rpc::camera::CaptureInfoResponse rpc_response;
 
-                    rpc_response.set_allocated_capture_info(
-                        translateToRpcCaptureInfo(capture_info).release());
+                rpc_response.set_allocated_capture_info(
+                    translateToRpcCaptureInfo(capture_info).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_capture_info(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_capture_info(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -1134,7 +1135,8 @@ public:
         const mavsdk::rpc::camera::SubscribeStatusRequest* /* request */,
         grpc::ServerWriter<rpc::camera::StatusResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1145,8 +1147,8 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Camera::StatusHandle handle = _lazy_plugin.maybe_plugin()->subscribe_status(
-            [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+        const mavsdk::Camera::StatusHandle handle = plugin->subscribe_status(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
                 const mavsdk::Camera::Status status) {
                 rpc::camera::StatusResponse rpc_response;
 
@@ -1154,7 +1156,7 @@ public:
 
                 std::unique_lock<std::mutex> lock(*subscribe_mutex);
                 if (!*is_finished && !writer->Write(rpc_response)) {
-                    _lazy_plugin.maybe_plugin()->unsubscribe_status(handle);
+                    plugin->unsubscribe_status(handle);
 
                     *is_finished = true;
                     unregister_stream_stop_promise(stream_closed_promise);
@@ -1174,7 +1176,8 @@ public:
         const mavsdk::rpc::camera::SubscribeCurrentSettingsRequest* /* request */,
         grpc::ServerWriter<rpc::camera::CurrentSettingsResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1185,26 +1188,25 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Camera::CurrentSettingsHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_current_settings(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const std::vector<mavsdk::Camera::Setting> current_settings) {
-                    rpc::camera::CurrentSettingsResponse rpc_response;
+        const mavsdk::Camera::CurrentSettingsHandle handle = plugin->subscribe_current_settings(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const std::vector<mavsdk::Camera::Setting> current_settings) {
+                rpc::camera::CurrentSettingsResponse rpc_response;
 
-                    for (const auto& elem : current_settings) {
-                        auto* ptr = rpc_response.add_current_settings();
-                        ptr->CopyFrom(*translateToRpcSetting(elem).release());
-                    }
+                for (const auto& elem : current_settings) {
+                    auto* ptr = rpc_response.add_current_settings();
+                    ptr->CopyFrom(*translateToRpcSetting(elem).release());
+                }
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_current_settings(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_current_settings(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -1218,7 +1220,8 @@ public:
         const mavsdk::rpc::camera::SubscribePossibleSettingOptionsRequest* /* request */,
         grpc::ServerWriter<rpc::camera::PossibleSettingOptionsResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1230,8 +1233,14 @@ public:
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
         const mavsdk::Camera::PossibleSettingOptionsHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_possible_setting_options(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+            plugin->subscribe_possible_setting_options(
+                [this,
+                 plugin,
+                 &writer,
+                 &stream_closed_promise,
+                 is_finished,
+                 subscribe_mutex,
+                 &handle](
                     const std::vector<mavsdk::Camera::SettingOptions> possible_setting_options) {
                     rpc::camera::PossibleSettingOptionsResponse rpc_response;
 
@@ -1242,7 +1251,7 @@ public:
 
                     std::unique_lock<std::mutex> lock(*subscribe_mutex);
                     if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_possible_setting_options(handle);
+                        plugin->unsubscribe_possible_setting_options(handle);
 
                         *is_finished = true;
                         unregister_stream_stop_promise(stream_closed_promise);
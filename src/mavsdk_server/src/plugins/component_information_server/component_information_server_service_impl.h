@@ -224,7 +224,8 @@ public:
         const mavsdk::rpc::component_information_server::SubscribeFloatParamRequest* /* request */,
         grpc::ServerWriter<rpc::component_information_server::FloatParamResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -236,8 +237,14 @@ public:
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
         const mavsdk::ComponentInformationServer::FloatParamHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_float_param(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+            plugin->subscribe_float_param(
+                [this,
+                 plugin,
+                 &writer,
+                 &stream_closed_promise,
+                 is_finished,
+                 subscribe_mutex,
+                 &handle](
                     const mavsdk::ComponentInformationServer::FloatParamUpdate float_param) {
                     rpc::component_information_server::FloatParamResponse rpc_response;
 
@@ -246,7 +253,7 @@ public:
 
                     std::unique_lock<std::mutex> lock(*subscribe_mutex);
                     if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_float_param(handle);
+                        plugin->unsubscribe_float_param(handle);
 
                         *is_finished = true;
                         unregister_stream_stop_promise(stream_closed_promise);
@@ -729,7 +729,8 @@ public:
         const mavsdk::rpc::mission::SubscribeMissionProgressRequest* /* request */,
         grpc::ServerWriter<rpc::mission::MissionProgressResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -740,24 +741,23 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Mission::MissionProgressHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_mission_progress(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Mission::MissionProgress mission_progress) {
-                    rpc::mission::MissionProgressResponse rpc_response;
+        const mavsdk::Mission::MissionProgressHandle handle = plugin->subscribe_mission_progress(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Mission::MissionProgress mission_progress) {
+                rpc::mission::MissionProgressResponse rpc_response;
 
-                    rpc_response.set_allocated_mission_progress(
-                        translateToRpcMissionProgress(mission_progress).release());
+                rpc_response.set_allocated_mission_progress(
+                    translateToRpcMissionProgress(mission_progress).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_mission_progress(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_mission_progress(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
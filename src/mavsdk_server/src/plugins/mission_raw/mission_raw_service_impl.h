@@ -550,7 +550,8 @@ public:
         const mavsdk::rpc::mission_raw::SubscribeMissionProgressRequest* /* request */,
         grpc::ServerWriter<rpc::mission_raw::MissionProgressResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -561,24 +562,23 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::MissionRaw::MissionProgressHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_mission_progress(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::MissionRaw::MissionProgress mission_progress) {
-                    rpc::mission_raw::MissionProgressResponse rpc_response;
+        const mavsdk::MissionRaw::MissionProgressHandle handle = plugin->subscribe_mission_progress(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::MissionRaw::MissionProgress mission_progress) {
+                rpc::mission_raw::MissionProgressResponse rpc_response;
 
-                    rpc_response.set_allocated_mission_progress(
-                        translateToRpcMissionProgress(mission_progress).release());
+                rpc_response.set_allocated_mission_progress(
+                    translateToRpcMissionProgress(mission_progress).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_mission_progress(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_mission_progress(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -592,7 +592,8 @@ public:
         const mavsdk::rpc::mission_raw::SubscribeMissionChangedRequest* /* request */,
         grpc::ServerWriter<rpc::mission_raw::MissionChangedResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -603,23 +604,22 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::MissionRaw::MissionChangedHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_mission_changed(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const bool mission_changed) {
-                    rpc::mission_raw::MissionChangedResponse rpc_response;
+        const mavsdk::MissionRaw::MissionChangedHandle handle = plugin->subscribe_mission_changed(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const bool mission_changed) {
+                rpc::mission_raw::MissionChangedResponse rpc_response;
 
-                    rpc_response.set_mission_changed(mission_changed);
+                rpc_response.set_mission_changed(mission_changed);
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_mission_changed(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_mission_changed(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -248,7 +248,8 @@ public:
         const mavsdk::rpc::mission_raw_server::SubscribeIncomingMissionRequest* /* request */,
         grpc::ServerWriter<rpc::mission_raw_server::IncomingMissionResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             rpc::mission_raw_server::IncomingMissionResponse rpc_response;
 
             // For server plugins, this should never happen, they should always be constructible.
@@ -267,8 +268,14 @@ public:
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
         const mavsdk::MissionRawServer::IncomingMissionHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_incoming_mission(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+            plugin->subscribe_incoming_mission(
+                [this,
+                 plugin,
+                 &writer,
+                 &stream_closed_promise,
+                 is_finished,
+                 subscribe_mutex,
+                 &handle](
                     mavsdk::MissionRawServer::Result result,
                     const mavsdk::MissionRawServer::MissionPlan incoming_mission) {
                     rpc::mission_raw_server::IncomingMissionResponse rpc_response;
@@ -288,7 +295,7 @@ public:
 
                     std::unique_lock<std::mutex> lock(*subscribe_mutex);
                     if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_incoming_mission(handle);
+                        plugin->unsubscribe_incoming_mission(handle);
 
                         *is_finished = true;
                         unregister_stream_stop_promise(stream_closed_promise);
@@ -308,7 +315,8 @@ public:
         const mavsdk::rpc::mission_raw_server::SubscribeCurrentItemChangedRequest* /* request */,
         grpc::ServerWriter<rpc::mission_raw_server::CurrentItemChangedResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -320,8 +328,14 @@ public:
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
         const mavsdk::MissionRawServer::CurrentItemChangedHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_current_item_changed(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+            plugin->subscribe_current_item_changed(
+                [this,
+                 plugin,
+                 &writer,
+                 &stream_closed_promise,
+                 is_finished,
+                 subscribe_mutex,
+                 &handle](
                     const mavsdk::MissionRawServer::MissionItem current_item_changed) {
                     rpc::mission_raw_server::CurrentItemChangedResponse rpc_response;
 
@@ -330,7 +344,7 @@ public:
 
                     std::unique_lock<std::mutex> lock(*subscribe_mutex);
                     if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_current_item_changed(handle);
+                        plugin->unsubscribe_current_item_changed(handle);
 
                         *is_finished = true;
                         unregister_stream_stop_promise(stream_closed_promise);
@@ -364,7 +378,8 @@ public:
         const mavsdk::rpc::mission_raw_server::SubscribeClearAllRequest* /* request */,
         grpc::ServerWriter<rpc::mission_raw_server::ClearAllResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -375,23 +390,22 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::MissionRawServer::ClearAllHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_clear_all(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const uint32_t clear_all) {
-                    rpc::mission_raw_server::ClearAllResponse rpc_response;
+        const mavsdk::MissionRawServer::ClearAllHandle handle = plugin->subscribe_clear_all(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const uint32_t clear_all) {
+                rpc::mission_raw_server::ClearAllResponse rpc_response;
 
-                    rpc_response.set_clear_type(clear_all);
+                rpc_response.set_clear_type(clear_all);
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_clear_all(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_clear_all(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
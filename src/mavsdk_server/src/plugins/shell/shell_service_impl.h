@@ -117,7 +117,8 @@ public:
         const mavsdk::rpc::shell::SubscribeReceiveRequest* /* request */,
         grpc::ServerWriter<rpc::shell::ReceiveResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -128,8 +129,8 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Shell::ReceiveHandle handle = _lazy_plugin.maybe_plugin()->subscribe_receive(
-            [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+        const mavsdk::Shell::ReceiveHandle handle = plugin->subscribe_receive(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
                 const std::string receive) {
                 rpc::shell::ReceiveResponse rpc_response;
 
@@ -137,7 +138,7 @@ public:
 
                 std::unique_lock<std::mutex> lock(*subscribe_mutex);
                 if (!*is_finished && !writer->Write(rpc_response)) {
-                    _lazy_plugin.maybe_plugin()->unsubscribe_receive(handle);
+                    plugin->unsubscribe_receive(handle);
 
                     *is_finished = true;
                     unregister_stream_stop_promise(stream_closed_promise);
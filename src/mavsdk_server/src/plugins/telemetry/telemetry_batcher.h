@@ -0,0 +1,193 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "plugins/telemetry/telemetry.h"
+
+namespace mavsdk {
+namespace mavsdk_server {
+
+// Collects the latest samples of several telemetry topics and hands them out
+// in batches, so that one stream can carry all of them.
+//
+// Instead of one gRPC stream per topic, each with its own handler thread and
+// a write per sample, a batched stream handler waits for the next batch and
+// writes it in one go. A sample overwritten before the flush is dropped, only
+// the latest one of each topic is sent. Periods without updates produce no
+// batch at all.
+template<typename Telemetry = Telemetry> class TelemetryBatcher {
+public:
+    enum class Topic {
+        Position,
+        AttitudeQuaternion,
+        VelocityNed,
+        Battery,
+        GpsInfo,
+    };
+
+    struct Batch {
+        std::optional<mavsdk::Telemetry::Position> position{};
+        std::optional<mavsdk::Telemetry::Quaternion> attitude_quaternion{};
+        std::optional<mavsdk::Telemetry::VelocityNed> velocity_ned{};
+        std::optional<mavsdk::Telemetry::Battery> battery{};
+        std::optional<mavsdk::Telemetry::GpsInfo> gps_info{};
+
+        bool empty() const
+        {
+            return !position && !attitude_quaternion && !velocity_ned && !battery && !gps_info;
+        }
+    };
+
+    TelemetryBatcher(
+        Telemetry& telemetry,
+        const std::vector<Topic>& topics,
+        std::chrono::milliseconds flush_period) :
+        _telemetry(telemetry),
+        _flush_period(flush_period),
+        _next_flush(std::chrono::steady_clock::now() + flush_period)
+    {
+        for (const auto topic : topics) {
+            subscribe(topic);
+        }
+    }
+
+    ~TelemetryBatcher()
+    {
+        if (_position_handle) {
+            _telemetry.unsubscribe_position(_position_handle.value());
+        }
+        if (_attitude_quaternion_handle) {
+            _telemetry.unsubscribe_attitude_quaternion(_attitude_quaternion_handle.value());
+        }
+        if (_velocity_ned_handle) {
+            _telemetry.unsubscribe_velocity_ned(_velocity_ned_handle.value());
+        }
+        if (_battery_handle) {
+            _telemetry.unsubscribe_battery(_battery_handle.value());
+        }
+        if (_gps_info_handle) {
+            _telemetry.unsubscribe_gps_info(_gps_info_handle.value());
+        }
+    }
+
+    // Blocks until the next flush with something to send, and returns what
+    // was updated since the previous batch. Returns false once stopped.
+    bool wait_for_batch(Batch& batch)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        while (!_stopped) {
+            _cv.wait_until(lock, _next_flush, [this]() { return _stopped; });
+            if (_stopped) {
+                break;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            if (now < _next_flush) {
+                // Spurious wakeup.
+                continue;
+            }
+
+            // If we fell behind we skip ahead rather than flushing in a burst.
+            _next_flush += _flush_period;
+            if (_next_flush < now) {
+                _next_flush = now + _flush_period;
+            }
+
+            if (!_pending.empty()) {
+                batch = _pending;
+                _pending = Batch{};
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopped = true;
+        }
+        _cv.notify_all();
+    }
+
+    // Non-copyable
+    TelemetryBatcher(const TelemetryBatcher&) = delete;
+    const TelemetryBatcher& operator=(const TelemetryBatcher&) = delete;
+
+private:
+    void subscribe(Topic topic)
+    {
+        switch (topic) {
+            case Topic::Position:
+                if (!_position_handle) {
+                    _position_handle = _telemetry.subscribe_position(
+                        [this](const mavsdk::Telemetry::Position position) {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            _pending.position = position;
+                        });
+                }
+                break;
+            case Topic::AttitudeQuaternion:
+                if (!_attitude_quaternion_handle) {
+                    _attitude_quaternion_handle = _telemetry.subscribe_attitude_quaternion(
+                        [this](const mavsdk::Telemetry::Quaternion attitude_quaternion) {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            _pending.attitude_quaternion = attitude_quaternion;
+                        });
+                }
+                break;
+            case Topic::VelocityNed:
+                if (!_velocity_ned_handle) {
+                    _velocity_ned_handle = _telemetry.subscribe_velocity_ned(
+                        [this](const mavsdk::Telemetry::VelocityNed velocity_ned) {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            _pending.velocity_ned = velocity_ned;
+                        });
+                }
+                break;
+            case Topic::Battery:
+                if (!_battery_handle) {
+                    _battery_handle = _telemetry.subscribe_battery(
+                        [this](const mavsdk::Telemetry::Battery battery) {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            _pending.battery = battery;
+                        });
+                }
+                break;
+            case Topic::GpsInfo:
+                if (!_gps_info_handle) {
+                    _gps_info_handle = _telemetry.subscribe_gps_info(
+                        [this](const mavsdk::Telemetry::GpsInfo gps_info) {
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            _pending.gps_info = gps_info;
+                        });
+                }
+                break;
+        }
+    }
+
+    Telemetry& _telemetry;
+    const std::chrono::milliseconds _flush_period;
+
+    std::mutex _mutex{};
+    std::condition_variable _cv{};
+    std::chrono::steady_clock::time_point _next_flush;
+    Batch _pending{};
+    bool _stopped{false};
+
+    std::optional<mavsdk::Telemetry::PositionHandle> _position_handle{};
+    std::optional<mavsdk::Telemetry::AttitudeQuaternionHandle> _attitude_quaternion_handle{};
+    std::optional<mavsdk::Telemetry::VelocityNedHandle> _velocity_ned_handle{};
+    std::optional<mavsdk::Telemetry::BatteryHandle> _battery_handle{};
+    std::optional<mavsdk::Telemetry::GpsInfoHandle> _gps_info_handle{};
+};
+
+} // namespace mavsdk_server
+} // namespace mavsdk
@@ -1361,7 +1361,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribePositionRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::PositionResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1372,23 +1373,22 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::PositionHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_position(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::Position position) {
-                    rpc::telemetry::PositionResponse rpc_response;
+        const mavsdk::Telemetry::PositionHandle handle = plugin->subscribe_position(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::Position position) {
+                rpc::telemetry::PositionResponse rpc_response;
 
-                    rpc_response.set_allocated_position(translateToRpcPosition(position).release());
+                rpc_response.set_allocated_position(translateToRpcPosition(position).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_position(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_position(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -1402,7 +1402,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeHomeRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::HomeResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1413,8 +1414,8 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::HomeHandle handle = _lazy_plugin.maybe_plugin()->subscribe_home(
-            [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+        const mavsdk::Telemetry::HomeHandle handle = plugin->subscribe_home(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
                 const mavsdk::Telemetry::Position home) {
                 rpc::telemetry::HomeResponse rpc_response;
 
@@ -1422,7 +1423,7 @@ public:
 
                 std::unique_lock<std::mutex> lock(*subscribe_mutex);
                 if (!*is_finished && !writer->Write(rpc_response)) {
-                    _lazy_plugin.maybe_plugin()->unsubscribe_home(handle);
+                    plugin->unsubscribe_home(handle);
 
                     *is_finished = true;
                     unregister_stream_stop_promise(stream_closed_promise);
@@ -1442,7 +1443,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeInAirRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::InAirResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1453,8 +1455,8 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::InAirHandle handle = _lazy_plugin.maybe_plugin()->subscribe_in_air(
-            [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+        const mavsdk::Telemetry::InAirHandle handle = plugin->subscribe_in_air(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
                 const bool in_air) {
                 rpc::telemetry::InAirResponse rpc_response;
 
@@ -1462,7 +1464,7 @@ public:
 
                 std::unique_lock<std::mutex> lock(*subscribe_mutex);
                 if (!*is_finished && !writer->Write(rpc_response)) {
-                    _lazy_plugin.maybe_plugin()->unsubscribe_in_air(handle);
+                    plugin->unsubscribe_in_air(handle);
 
                     *is_finished = true;
                     unregister_stream_stop_promise(stream_closed_promise);
@@ -1482,7 +1484,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeLandedStateRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::LandedStateResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1493,23 +1496,22 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::LandedStateHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_landed_state(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::LandedState landed_state) {
-                    rpc::telemetry::LandedStateResponse rpc_response;
+        const mavsdk::Telemetry::LandedStateHandle handle = plugin->subscribe_landed_state(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::LandedState landed_state) {
+                rpc::telemetry::LandedStateResponse rpc_response;
 
-                    rpc_response.set_landed_state(translateToRpcLandedState(landed_state));
+                rpc_response.set_landed_state(translateToRpcLandedState(landed_state));
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_landed_state(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_landed_state(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -1523,7 +1525,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeArmedRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::ArmedResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1534,8 +1537,8 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::ArmedHandle handle = _lazy_plugin.maybe_plugin()->subscribe_armed(
-            [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+        const mavsdk::Telemetry::ArmedHandle handle = plugin->subscribe_armed(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
                 const bool armed) {
                 rpc::telemetry::ArmedResponse rpc_response;
 
@@ -1543,7 +1546,7 @@ public:
 
                 std::unique_lock<std::mutex> lock(*subscribe_mutex);
                 if (!*is_finished && !writer->Write(rpc_response)) {
-                    _lazy_plugin.maybe_plugin()->unsubscribe_armed(handle);
+                    plugin->unsubscribe_armed(handle);
 
                     *is_finished = true;
                     unregister_stream_stop_promise(stream_closed_promise);
@@ -1563,7 +1566,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeVtolStateRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::VtolStateResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1574,23 +1578,22 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::VtolStateHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_vtol_state(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::VtolState vtol_state) {
-                    rpc::telemetry::VtolStateResponse rpc_response;
+        const mavsdk::Telemetry::VtolStateHandle handle = plugin->subscribe_vtol_state(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::VtolState vtol_state) {
+                rpc::telemetry::VtolStateResponse rpc_response;
 
-                    rpc_response.set_vtol_state(translateToRpcVtolState(vtol_state));
+                rpc_response.set_vtol_state(translateToRpcVtolState(vtol_state));
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_vtol_state(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_vtol_state(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -1604,7 +1607,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeAttitudeQuaternionRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::AttitudeQuaternionResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1616,8 +1620,14 @@ public:
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
         const mavsdk::Telemetry::AttitudeQuaternionHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_attitude_quaternion(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+            plugin->subscribe_attitude_quaternion(
+                [this,
+                 plugin,
+                 &writer,
+                 &stream_closed_promise,
+                 is_finished,
+                 subscribe_mutex,
+                 &handle](
                     const mavsdk::Telemetry::Quaternion attitude_quaternion) {
                     rpc::telemetry::AttitudeQuaternionResponse rpc_response;
 
@@ -1626,7 +1636,7 @@ public:
 
                     std::unique_lock<std::mutex> lock(*subscribe_mutex);
                     if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_attitude_quaternion(handle);
+                        plugin->unsubscribe_attitude_quaternion(handle);
 
                         *is_finished = true;
                         unregister_stream_stop_promise(stream_closed_promise);
@@ -1646,7 +1656,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeAttitudeEulerRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::AttitudeEulerResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1657,24 +1668,23 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::AttitudeEulerHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_attitude_euler(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::EulerAngle attitude_euler) {
-                    rpc::telemetry::AttitudeEulerResponse rpc_response;
+        const mavsdk::Telemetry::AttitudeEulerHandle handle = plugin->subscribe_attitude_euler(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::EulerAngle attitude_euler) {
+                rpc::telemetry::AttitudeEulerResponse rpc_response;
 
-                    rpc_response.set_allocated_attitude_euler(
-                        translateToRpcEulerAngle(attitude_euler).release());
+                rpc_response.set_allocated_attitude_euler(
+                    translateToRpcEulerAngle(attitude_euler).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_attitude_euler(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_attitude_euler(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -1688,7 +1698,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeAttitudeAngularVelocityBodyRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::AttitudeAngularVelocityBodyResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1700,8 +1711,14 @@ public:
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
         const mavsdk::Telemetry::AttitudeAngularVelocityBodyHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_attitude_angular_velocity_body(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+            plugin->subscribe_attitude_angular_velocity_body(
+                [this,
+                 plugin,
+                 &writer,
+                 &stream_closed_promise,
+                 is_finished,
+                 subscribe_mutex,
+                 &handle](
                     const mavsdk::Telemetry::AngularVelocityBody attitude_angular_velocity_body) {
                     rpc::telemetry::AttitudeAngularVelocityBodyResponse rpc_response;
 
@@ -1711,7 +1728,7 @@ public:
 
                     std::unique_lock<std::mutex> lock(*subscribe_mutex);
                     if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_attitude_angular_velocity_body(
+                        plugin->unsubscribe_attitude_angular_velocity_body(
                             handle);
 
                         *is_finished = true;
@@ -1732,7 +1749,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeCameraAttitudeQuaternionRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::CameraAttitudeQuaternionResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1744,8 +1762,14 @@ public:
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
         const mavsdk::Telemetry::CameraAttitudeQuaternionHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_camera_attitude_quaternion(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+            plugin->subscribe_camera_attitude_quaternion(
+                [this,
+                 plugin,
+                 &writer,
+                 &stream_closed_promise,
+                 is_finished,
+                 subscribe_mutex,
+                 &handle](
                     const mavsdk::Telemetry::Quaternion camera_attitude_quaternion) {
                     rpc::telemetry::CameraAttitudeQuaternionResponse rpc_response;
 
@@ -1754,7 +1778,7 @@ public:
 
                     std::unique_lock<std::mutex> lock(*subscribe_mutex);
                     if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_camera_attitude_quaternion(handle);
+                        plugin->unsubscribe_camera_attitude_quaternion(handle);
 
                         *is_finished = true;
                         unregister_stream_stop_promise(stream_closed_promise);
@@ -1774,7 +1798,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeCameraAttitudeEulerRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::CameraAttitudeEulerResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1786,8 +1811,14 @@ public:
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
         const mavsdk::Telemetry::CameraAttitudeEulerHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_camera_attitude_euler(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+            plugin->subscribe_camera_attitude_euler(
+                [this,
+                 plugin,
+                 &writer,
+                 &stream_closed_promise,
+                 is_finished,
+                 subscribe_mutex,
+                 &handle](
                     const mavsdk::Telemetry::EulerAngle camera_attitude_euler) {
                     rpc::telemetry::CameraAttitudeEulerResponse rpc_response;
 
@@ -1796,7 +1827,7 @@ public:
 
                     std::unique_lock<std::mutex> lock(*subscribe_mutex);
                     if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_camera_attitude_euler(handle);
+                        plugin->unsubscribe_camera_attitude_euler(handle);
 
                         *is_finished = true;
                         unregister_stream_stop_promise(stream_closed_promise);
@@ -1816,7 +1847,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeVelocityNedRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::VelocityNedResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1827,24 +1859,23 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::VelocityNedHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_velocity_ned(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::VelocityNed velocity_ned) {
-                    rpc::telemetry::VelocityNedResponse rpc_response;
+        const mavsdk::Telemetry::VelocityNedHandle handle = plugin->subscribe_velocity_ned(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::VelocityNed velocity_ned) {
+                rpc::telemetry::VelocityNedResponse rpc_response;
 
-                    rpc_response.set_allocated_velocity_ned(
-                        translateToRpcVelocityNed(velocity_ned).release());
+                rpc_response.set_allocated_velocity_ned(
+                    translateToRpcVelocityNed(velocity_ned).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_velocity_ned(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_velocity_ned(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -1858,7 +1889,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeGpsInfoRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::GpsInfoResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1869,23 +1901,22 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::GpsInfoHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_gps_info(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::GpsInfo gps_info) {
-                    rpc::telemetry::GpsInfoResponse rpc_response;
+        const mavsdk::Telemetry::GpsInfoHandle handle = plugin->subscribe_gps_info(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::GpsInfo gps_info) {
+                rpc::telemetry::GpsInfoResponse rpc_response;
 
-                    rpc_response.set_allocated_gps_info(translateToRpcGpsInfo(gps_info).release());
+                rpc_response.set_allocated_gps_info(translateToRpcGpsInfo(gps_info).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_gps_info(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_gps_info(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -1899,7 +1930,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeRawGpsRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::RawGpsResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1910,23 +1942,22 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::RawGpsHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_raw_gps(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::RawGps raw_gps) {
-                    rpc::telemetry::RawGpsResponse rpc_response;
+        const mavsdk::Telemetry::RawGpsHandle handle = plugin->subscribe_raw_gps(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::RawGps raw_gps) {
+                rpc::telemetry::RawGpsResponse rpc_response;
 
-                    rpc_response.set_allocated_raw_gps(translateToRpcRawGps(raw_gps).release());
+                rpc_response.set_allocated_raw_gps(translateToRpcRawGps(raw_gps).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_raw_gps(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_raw_gps(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -1940,7 +1971,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeBatteryRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::BatteryResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1951,23 +1983,22 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::BatteryHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_battery(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::Battery battery) {
-                    rpc::telemetry::BatteryResponse rpc_response;
+        const mavsdk::Telemetry::BatteryHandle handle = plugin->subscribe_battery(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::Battery battery) {
+                rpc::telemetry::BatteryResponse rpc_response;
 
-                    rpc_response.set_allocated_battery(translateToRpcBattery(battery).release());
+                rpc_response.set_allocated_battery(translateToRpcBattery(battery).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_battery(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_battery(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -1981,7 +2012,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeFlightModeRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::FlightModeResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -1992,23 +2024,22 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::FlightModeHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_flight_mode(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::FlightMode flight_mode) {
-                    rpc::telemetry::FlightModeResponse rpc_response;
+        const mavsdk::Telemetry::FlightModeHandle handle = plugin->subscribe_flight_mode(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::FlightMode flight_mode) {
+                rpc::telemetry::FlightModeResponse rpc_response;
 
-                    rpc_response.set_flight_mode(translateToRpcFlightMode(flight_mode));
+                rpc_response.set_flight_mode(translateToRpcFlightMode(flight_mode));
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_flight_mode(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_flight_mode(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -2022,7 +2053,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeHealthRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::HealthResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -2033,23 +2065,22 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::HealthHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_health(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::Health health) {
-                    rpc::telemetry::HealthResponse rpc_response;
+        const mavsdk::Telemetry::HealthHandle handle = plugin->subscribe_health(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::Health health) {
+                rpc::telemetry::HealthResponse rpc_response;
 
-                    rpc_response.set_allocated_health(translateToRpcHealth(health).release());
+                rpc_response.set_allocated_health(translateToRpcHealth(health).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_health(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_health(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -2063,7 +2094,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeRcStatusRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::RcStatusResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -2074,24 +2106,23 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::RcStatusHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_rc_status(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::RcStatus rc_status) {
-                    rpc::telemetry::RcStatusResponse rpc_response;
+        const mavsdk::Telemetry::RcStatusHandle handle = plugin->subscribe_rc_status(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::RcStatus rc_status) {
+                rpc::telemetry::RcStatusResponse rpc_response;
 
-                    rpc_response.set_allocated_rc_status(
-                        translateToRpcRcStatus(rc_status).release());
+                rpc_response.set_allocated_rc_status(
+                    translateToRpcRcStatus(rc_status).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_rc_status(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_rc_status(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -2105,7 +2136,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeStatusTextRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::StatusTextResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -2116,24 +2148,23 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::StatusTextHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_status_text(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::StatusText status_text) {
-                    rpc::telemetry::StatusTextResponse rpc_response;
+        const mavsdk::Telemetry::StatusTextHandle handle = plugin->subscribe_status_text(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::StatusText status_text) {
+                rpc::telemetry::StatusTextResponse rpc_response;
 
-                    rpc_response.set_allocated_status_text(
-                        translateToRpcStatusText(status_text).release());
+                rpc_response.set_allocated_status_text(
+                    translateToRpcStatusText(status_text).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_status_text(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_status_text(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -2147,7 +2178,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeActuatorControlTargetRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::ActuatorControlTargetResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -2159,8 +2191,14 @@ public:
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
         const mavsdk::Telemetry::ActuatorControlTargetHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_actuator_control_target(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+            plugin->subscribe_actuator_control_target(
+                [this,
+                 plugin,
+                 &writer,
+                 &stream_closed_promise,
+                 is_finished,
+                 subscribe_mutex,
+                 &handle](
                     const mavsdk::Telemetry::ActuatorControlTarget actuator_control_target) {
                     rpc::telemetry::ActuatorControlTargetResponse rpc_response;
 
@@ -2169,7 +2207,7 @@ public:
 
                     std::unique_lock<std::mutex> lock(*subscribe_mutex);
                     if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_actuator_control_target(handle);
+                        plugin->unsubscribe_actuator_control_target(handle);
 
                         *is_finished = true;
                         unregister_stream_stop_promise(stream_closed_promise);
@@ -2189,7 +2227,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeActuatorOutputStatusRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::ActuatorOutputStatusResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -2201,8 +2240,14 @@ public:
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
         const mavsdk::Telemetry::ActuatorOutputStatusHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_actuator_output_status(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+            plugin->subscribe_actuator_output_status(
+                [this,
+                 plugin,
+                 &writer,
+                 &stream_closed_promise,
+                 is_finished,
+                 subscribe_mutex,
+                 &handle](
                     const mavsdk::Telemetry::ActuatorOutputStatus actuator_output_status) {
                     rpc::telemetry::ActuatorOutputStatusResponse rpc_response;
 
@@ -2211,7 +2256,7 @@ public:
 
                     std::unique_lock<std::mutex> lock(*subscribe_mutex);
                     if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_actuator_output_status(handle);
+                        plugin->unsubscribe_actuator_output_status(handle);
 
                         *is_finished = true;
                         unregister_stream_stop_promise(stream_closed_promise);
@@ -2231,7 +2276,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeOdometryRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::OdometryResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -2242,23 +2288,22 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::OdometryHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_odometry(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::Odometry odometry) {
-                    rpc::telemetry::OdometryResponse rpc_response;
+        const mavsdk::Telemetry::OdometryHandle handle = plugin->subscribe_odometry(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::Odometry odometry) {
+                rpc::telemetry::OdometryResponse rpc_response;
 
-                    rpc_response.set_allocated_odometry(translateToRpcOdometry(odometry).release());
+                rpc_response.set_allocated_odometry(translateToRpcOdometry(odometry).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_odometry(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_odometry(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -2272,7 +2317,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribePositionVelocityNedRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::PositionVelocityNedResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -2284,8 +2330,14 @@ public:
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
         const mavsdk::Telemetry::PositionVelocityNedHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_position_velocity_ned(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+            plugin->subscribe_position_velocity_ned(
+                [this,
+                 plugin,
+                 &writer,
+                 &stream_closed_promise,
+                 is_finished,
+                 subscribe_mutex,
+                 &handle](
                     const mavsdk::Telemetry::PositionVelocityNed position_velocity_ned) {
                     rpc::telemetry::PositionVelocityNedResponse rpc_response;
 
@@ -2294,7 +2346,7 @@ public:
 
                     std::unique_lock<std::mutex> lock(*subscribe_mutex);
                     if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_position_velocity_ned(handle);
+                        plugin->unsubscribe_position_velocity_ned(handle);
 
                         *is_finished = true;
                         unregister_stream_stop_promise(stream_closed_promise);
@@ -2314,7 +2366,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeGroundTruthRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::GroundTruthResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -2325,24 +2378,23 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::GroundTruthHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_ground_truth(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::GroundTruth ground_truth) {
-                    rpc::telemetry::GroundTruthResponse rpc_response;
+        const mavsdk::Telemetry::GroundTruthHandle handle = plugin->subscribe_ground_truth(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::GroundTruth ground_truth) {
+                rpc::telemetry::GroundTruthResponse rpc_response;
 
-                    rpc_response.set_allocated_ground_truth(
-                        translateToRpcGroundTruth(ground_truth).release());
+                rpc_response.set_allocated_ground_truth(
+                    translateToRpcGroundTruth(ground_truth).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_ground_truth(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_ground_truth(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -2356,7 +2408,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeFixedwingMetricsRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::FixedwingMetricsResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -2368,8 +2421,14 @@ public:
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
         const mavsdk::Telemetry::FixedwingMetricsHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_fixedwing_metrics(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+            plugin->subscribe_fixedwing_metrics(
+                [this,
+                 plugin,
+                 &writer,
+                 &stream_closed_promise,
+                 is_finished,
+                 subscribe_mutex,
+                 &handle](
                     const mavsdk::Telemetry::FixedwingMetrics fixedwing_metrics) {
                     rpc::telemetry::FixedwingMetricsResponse rpc_response;
 
@@ -2378,7 +2437,7 @@ public:
 
                     std::unique_lock<std::mutex> lock(*subscribe_mutex);
                     if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_fixedwing_metrics(handle);
+                        plugin->unsubscribe_fixedwing_metrics(handle);
 
                         *is_finished = true;
                         unregister_stream_stop_promise(stream_closed_promise);
@@ -2398,7 +2457,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeImuRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::ImuResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -2409,8 +2469,8 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::ImuHandle handle = _lazy_plugin.maybe_plugin()->subscribe_imu(
-            [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+        const mavsdk::Telemetry::ImuHandle handle = plugin->subscribe_imu(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
                 const mavsdk::Telemetry::Imu imu) {
                 rpc::telemetry::ImuResponse rpc_response;
 
@@ -2418,7 +2478,7 @@ public:
 
                 std::unique_lock<std::mutex> lock(*subscribe_mutex);
                 if (!*is_finished && !writer->Write(rpc_response)) {
-                    _lazy_plugin.maybe_plugin()->unsubscribe_imu(handle);
+                    plugin->unsubscribe_imu(handle);
 
                     *is_finished = true;
                     unregister_stream_stop_promise(stream_closed_promise);
@@ -2438,7 +2498,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeScaledImuRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::ScaledImuResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -2449,23 +2510,22 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::ScaledImuHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_scaled_imu(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::Imu scaled_imu) {
-                    rpc::telemetry::ScaledImuResponse rpc_response;
+        const mavsdk::Telemetry::ScaledImuHandle handle = plugin->subscribe_scaled_imu(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::Imu scaled_imu) {
+                rpc::telemetry::ScaledImuResponse rpc_response;
 
-                    rpc_response.set_allocated_imu(translateToRpcImu(scaled_imu).release());
+                rpc_response.set_allocated_imu(translateToRpcImu(scaled_imu).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_scaled_imu(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_scaled_imu(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -2479,7 +2539,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeRawImuRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::RawImuResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -2490,23 +2551,22 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::RawImuHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_raw_imu(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::Imu raw_imu) {
-                    rpc::telemetry::RawImuResponse rpc_response;
+        const mavsdk::Telemetry::RawImuHandle handle = plugin->subscribe_raw_imu(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::Imu raw_imu) {
+                rpc::telemetry::RawImuResponse rpc_response;
 
-                    rpc_response.set_allocated_imu(translateToRpcImu(raw_imu).release());
+                rpc_response.set_allocated_imu(translateToRpcImu(raw_imu).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_raw_imu(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_raw_imu(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -2520,7 +2580,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeHealthAllOkRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::HealthAllOkResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -2531,23 +2592,22 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::HealthAllOkHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_health_all_ok(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const bool health_all_ok) {
-                    rpc::telemetry::HealthAllOkResponse rpc_response;
+        const mavsdk::Telemetry::HealthAllOkHandle handle = plugin->subscribe_health_all_ok(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const bool health_all_ok) {
+                rpc::telemetry::HealthAllOkResponse rpc_response;
 
-                    rpc_response.set_is_health_all_ok(health_all_ok);
+                rpc_response.set_is_health_all_ok(health_all_ok);
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_health_all_ok(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_health_all_ok(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -2561,7 +2621,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeUnixEpochTimeRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::UnixEpochTimeResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -2572,23 +2633,22 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::UnixEpochTimeHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_unix_epoch_time(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const uint64_t unix_epoch_time) {
-                    rpc::telemetry::UnixEpochTimeResponse rpc_response;
+        const mavsdk::Telemetry::UnixEpochTimeHandle handle = plugin->subscribe_unix_epoch_time(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const uint64_t unix_epoch_time) {
+                rpc::telemetry::UnixEpochTimeResponse rpc_response;
 
-                    rpc_response.set_time_us(unix_epoch_time);
+                rpc_response.set_time_us(unix_epoch_time);
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_unix_epoch_time(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_unix_epoch_time(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -2602,7 +2662,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeDistanceSensorRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::DistanceSensorResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -2613,24 +2674,23 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::DistanceSensorHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_distance_sensor(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::DistanceSensor distance_sensor) {
-                    rpc::telemetry::DistanceSensorResponse rpc_response;
+        const mavsdk::Telemetry::DistanceSensorHandle handle = plugin->subscribe_distance_sensor(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::DistanceSensor distance_sensor) {
+                rpc::telemetry::DistanceSensorResponse rpc_response;
 
-                    rpc_response.set_allocated_distance_sensor(
-                        translateToRpcDistanceSensor(distance_sensor).release());
+                rpc_response.set_allocated_distance_sensor(
+                    translateToRpcDistanceSensor(distance_sensor).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_distance_sensor(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_distance_sensor(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -2644,7 +2704,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeScaledPressureRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::ScaledPressureResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -2655,24 +2716,23 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::ScaledPressureHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_scaled_pressure(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::ScaledPressure scaled_pressure) {
-                    rpc::telemetry::ScaledPressureResponse rpc_response;
+        const mavsdk::Telemetry::ScaledPressureHandle handle = plugin->subscribe_scaled_pressure(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::ScaledPressure scaled_pressure) {
+                rpc::telemetry::ScaledPressureResponse rpc_response;
 
-                    rpc_response.set_allocated_scaled_pressure(
-                        translateToRpcScaledPressure(scaled_pressure).release());
+                rpc_response.set_allocated_scaled_pressure(
+                    translateToRpcScaledPressure(scaled_pressure).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_scaled_pressure(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_scaled_pressure(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -2686,7 +2746,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeHeadingRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::HeadingResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -2697,24 +2758,23 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::HeadingHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_heading(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::Heading heading) {
-                    rpc::telemetry::HeadingResponse rpc_response;
+        const mavsdk::Telemetry::HeadingHandle handle = plugin->subscribe_heading(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::Heading heading) {
+                rpc::telemetry::HeadingResponse rpc_response;
 
-                    rpc_response.set_allocated_heading_deg(
-                        translateToRpcHeading(heading).release());
+                rpc_response.set_allocated_heading_deg(
+                    translateToRpcHeading(heading).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_heading(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_heading(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -2728,7 +2788,8 @@ public:
         const mavsdk::rpc::telemetry::SubscribeAltitudeRequest* /* request */,
         grpc::ServerWriter<rpc::telemetry::AltitudeResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -2739,23 +2800,22 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Telemetry::AltitudeHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_altitude(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
-                    const mavsdk::Telemetry::Altitude altitude) {
-                    rpc::telemetry::AltitudeResponse rpc_response;
+        const mavsdk::Telemetry::AltitudeHandle handle = plugin->subscribe_altitude(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+                const mavsdk::Telemetry::Altitude altitude) {
+                rpc::telemetry::AltitudeResponse rpc_response;
 
-                    rpc_response.set_allocated_altitude(translateToRpcAltitude(altitude).release());
+                rpc_response.set_allocated_altitude(translateToRpcAltitude(altitude).release());
 
-                    std::unique_lock<std::mutex> lock(*subscribe_mutex);
-                    if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_altitude(handle);
+                std::unique_lock<std::mutex> lock(*subscribe_mutex);
+                if (!*is_finished && !writer->Write(rpc_response)) {
+                    plugin->unsubscribe_altitude(handle);
 
-                        *is_finished = true;
-                        unregister_stream_stop_promise(stream_closed_promise);
-                        stream_closed_promise->set_value();
-                    }
-                });
+                    *is_finished = true;
+                    unregister_stream_stop_promise(stream_closed_promise);
+                    stream_closed_promise->set_value();
+                }
+            });
 
         stream_closed_future.wait();
         std::unique_lock<std::mutex> lock(*subscribe_mutex);
@@ -0,0 +1,420 @@
+#pragma once
+
+#if !defined(WINDOWS)
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "log.h"
+#include "plugins/telemetry/telemetry.h"
+
+namespace mavsdk {
+namespace mavsdk_server {
+
+// Layout of the shared memory object, for clients on the same host which map
+// it instead of streaming the same topics over gRPC. All fields are in host
+// byte order.
+//
+// Header, 64 bytes:
+//   offset  0: uint32_t magic, TELEMETRY_SHM_MAGIC
+//   offset  4: uint32_t version, TELEMETRY_SHM_VERSION
+//   offset  8: uint32_t slot_count
+//   offset 12: uint32_t slot_size
+//   offset 16: uint64_t write_index, the number of records written so far
+//
+// Followed by slot_count slots of slot_size bytes. Record n goes into slot
+// n % slot_count:
+//   offset  0: uint64_t sequence, odd while the slot is being written
+//   offset  8: uint32_t topic, see TelemetryShmTopic
+//   offset 12: uint32_t payload size in bytes
+//   offset 16: uint64_t time of writing in microseconds, steady clock
+//   offset 24: payload, one of the TelemetryShm* structs below
+//
+// A reader keeps its own read index. Once record n is complete its slot has
+// sequence 2 * (n / slot_count + 1). A different value read before and after
+// copying the slot means the writer lapped the reader and the record is lost.
+constexpr uint32_t TELEMETRY_SHM_MAGIC = 0x52545653; // "SVTR"
+constexpr uint32_t TELEMETRY_SHM_VERSION = 1;
+
+enum class TelemetryShmTopic : uint32_t {
+    Position = 1,
+    AttitudeQuaternion = 2,
+    VelocityNed = 3,
+};
+
+struct TelemetryShmPosition {
+    double latitude_deg;
+    double longitude_deg;
+    float absolute_altitude_m;
+    float relative_altitude_m;
+};
+
+struct TelemetryShmQuaternion {
+    float w;
+    float x;
+    float y;
+    float z;
+    uint64_t timestamp_us;
+};
+
+struct TelemetryShmVelocityNed {
+    float north_m_s;
+    float east_m_s;
+    float down_m_s;
+};
+
+struct TelemetryShmHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t slot_size;
+    std::atomic<uint64_t> write_index;
+    uint8_t reserved[40];
+};
+
+struct TelemetryShmSlot {
+    static constexpr std::size_t PAYLOAD_SIZE = 40;
+
+    std::atomic<uint64_t> sequence;
+    uint32_t topic;
+    uint32_t size;
+    uint64_t time_us;
+    uint8_t payload[PAYLOAD_SIZE];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Needs lock-free 64 bit atomics");
+static_assert(sizeof(TelemetryShmHeader) == 64, "Header layout changed");
+static_assert(sizeof(TelemetryShmSlot) == 64, "Slot layout changed");
+static_assert(sizeof(TelemetryShmPosition) <= TelemetryShmSlot::PAYLOAD_SIZE, "Too big");
+static_assert(sizeof(TelemetryShmQuaternion) <= TelemetryShmSlot::PAYLOAD_SIZE, "Too big");
+static_assert(sizeof(TelemetryShmVelocityNed) <= TelemetryShmSlot::PAYLOAD_SIZE, "Too big");
+
+// A POSIX shared memory object mapped into this process. The creating side
+// also removes the name again once done.
+class TelemetryShmMapping {
+public:
+    static std::optional<TelemetryShmMapping> create(const std::string& name, std::size_t size)
+    {
+        const int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+        if (fd < 0) {
+            LogErr() << "Could not create shared memory " << name << ": " << strerror(errno);
+            return std::nullopt;
+        }
+
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            LogErr() << "Could not size shared memory " << name << ": " << strerror(errno);
+            close(fd);
+            shm_unlink(name.c_str());
+            return std::nullopt;
+        }
+
+        void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            LogErr() << "Could not map shared memory " << name << ": " << strerror(errno);
+            shm_unlink(name.c_str());
+            return std::nullopt;
+        }
+
+        return TelemetryShmMapping(name, data, size, true);
+    }
+
+    static std::optional<TelemetryShmMapping> open(const std::string& name)
+    {
+        const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            return std::nullopt;
+        }
+
+        struct stat st {};
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            return std::nullopt;
+        }
+
+        const auto size = static_cast<std::size_t>(st.st_size);
+        if (size < sizeof(TelemetryShmHeader)) {
+            close(fd);
+            return std::nullopt;
+        }
+
+        void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) {
+            return std::nullopt;
+        }
+
+        return TelemetryShmMapping(name, data, size, false);
+    }
+
+    ~TelemetryShmMapping()
+    {
+        if (_data == nullptr) {
+            return;
+        }
+        munmap(_data, _size);
+        if (_owner) {
+            shm_unlink(_name.c_str());
+        }
+    }
+
+    TelemetryShmMapping(TelemetryShmMapping&& other) noexcept :
+        _name(std::move(other._name)),
+        _data(other._data),
+        _size(other._size),
+        _owner(other._owner)
+    {
+        other._data = nullptr;
+    }
+
+    // Non-copyable
+    TelemetryShmMapping(const TelemetryShmMapping&) = delete;
+    const TelemetryShmMapping& operator=(const TelemetryShmMapping&) = delete;
+    TelemetryShmMapping& operator=(TelemetryShmMapping&&) = delete;
+
+    void* data() const { return _data; }
+    std::size_t size() const { return _size; }
+
+private:
+    TelemetryShmMapping(std::string name, void* data, std::size_t size, bool owner) :
+        _name(std::move(name)),
+        _data(data),
+        _size(size),
+        _owner(owner)
+    {}
+
+    std::string _name;
+    void* _data;
+    std::size_t _size;
+    bool _owner;
+};
+
+// Publishes the hot telemetry topics into a shared memory ring, so that
+// clients on the same host can read them without a gRPC stream, protobuf
+// encoding or a socket write per sample. There is a single writer and any
+// number of readers, readers which fall behind lose the oldest records.
+//
+// The ring is in addition to gRPC, all other calls still go through the
+// server as before.
+template<typename Telemetry = Telemetry> class TelemetryShmRing {
+public:
+    static constexpr uint32_t DEFAULT_SLOT_COUNT = 1024;
+
+    TelemetryShmRing(
+        Telemetry& telemetry, const std::string& name, uint32_t slot_count = DEFAULT_SLOT_COUNT) :
+        _telemetry(telemetry),
+        _mapping(TelemetryShmMapping::create(
+            name, sizeof(TelemetryShmHeader) + std::size_t(slot_count) * sizeof(TelemetryShmSlot)))
+    {
+        if (!_mapping) {
+            return;
+        }
+
+        _header = new (_mapping->data()) TelemetryShmHeader{};
+        _slots = reinterpret_cast<TelemetryShmSlot*>(_header + 1);
+        for (uint32_t i = 0; i < slot_count; ++i) {
+            new (&_slots[i]) TelemetryShmSlot{};
+        }
+        _header->slot_count = slot_count;
+        _header->slot_size = sizeof(TelemetryShmSlot);
+        _header->version = TELEMETRY_SHM_VERSION;
+        // The magic goes last so a reader never sees a half initialized header.
+        std::atomic_thread_fence(std::memory_order_release);
+        _header->magic = TELEMETRY_SHM_MAGIC;
+
+        LogInfo() << "Publishing telemetry to shared memory " << name;
+
+        _position_handle =
+            _telemetry.subscribe_position([this](const mavsdk::Telemetry::Position position) {
+                write(
+                    TelemetryShmTopic::Position,
+                    TelemetryShmPosition{
+                        position.latitude_deg,
+                        position.longitude_deg,
+                        position.absolute_altitude_m,
+                        position.relative_altitude_m});
+            });
+        _attitude_quaternion_handle = _telemetry.subscribe_attitude_quaternion(
+            [this](const mavsdk::Telemetry::Quaternion quaternion) {
+                write(
+                    TelemetryShmTopic::AttitudeQuaternion,
+                    TelemetryShmQuaternion{
+                        quaternion.w,
+                        quaternion.x,
+                        quaternion.y,
+                        quaternion.z,
+                        quaternion.timestamp_us});
+            });
+        _velocity_ned_handle = _telemetry.subscribe_velocity_ned(
+            [this](const mavsdk::Telemetry::VelocityNed velocity_ned) {
+                write(
+                    TelemetryShmTopic::VelocityNed,
+                    TelemetryShmVelocityNed{
+                        velocity_ned.north_m_s, velocity_ned.east_m_s, velocity_ned.down_m_s});
+            });
+    }
+
+    ~TelemetryShmRing()
+    {
+        if (_position_handle) {
+            _telemetry.unsubscribe_position(_position_handle.value());
+        }
+        if (_attitude_quaternion_handle) {
+            _telemetry.unsubscribe_attitude_quaternion(_attitude_quaternion_handle.value());
+        }
+        if (_velocity_ned_handle) {
+            _telemetry.unsubscribe_velocity_ned(_velocity_ned_handle.value());
+        }
+    }
+
+    bool is_open() const { return _mapping.has_value(); }
+
+    // Non-copyable
+    TelemetryShmRing(const TelemetryShmRing&) = delete;
+    const TelemetryShmRing& operator=(const TelemetryShmRing&) = delete;
+
+private:
+    template<typename Payload> void write(TelemetryShmTopic topic, const Payload& payload)
+    {
+        // Callbacks of different topics are not guaranteed to come from the
+        // same thread, the lock keeps it a single writer.
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        const uint64_t index = _header->write_index.load(std::memory_order_relaxed);
+        TelemetryShmSlot& slot = _slots[index % _header->slot_count];
+
+        const uint64_t sequence = slot.sequence.load(std::memory_order_relaxed);
+        slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        slot.topic = static_cast<uint32_t>(topic);
+        slot.size = sizeof(Payload);
+        slot.time_us = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+        std::memcpy(slot.payload, &payload, sizeof(Payload));
+
+        slot.sequence.store(sequence + 2, std::memory_order_release);
+        _header->write_index.store(index + 1, std::memory_order_release);
+    }
+
+    Telemetry& _telemetry;
+
+    std::optional<TelemetryShmMapping> _mapping;
+    TelemetryShmHeader* _header{nullptr};
+    TelemetryShmSlot* _slots{nullptr};
+    std::mutex _mutex{};
+
+    std::optional<mavsdk::Telemetry::PositionHandle> _position_handle{};
+    std::optional<mavsdk::Telemetry::AttitudeQuaternionHandle> _attitude_quaternion_handle{};
+    std::optional<mavsdk::Telemetry::VelocityNedHandle> _velocity_ned_handle{};
+};
+
+// Reads records back in order, as a client of the ring would.
+class TelemetryShmReader {
+public:
+    struct Record {
+        TelemetryShmTopic topic{};
+        uint64_t time_us{};
+        std::vector<uint8_t> payload{};
+    };
+
+    explicit TelemetryShmReader(const std::string& name) :
+        _mapping(TelemetryShmMapping::open(name))
+    {
+        if (!_mapping) {
+            return;
+        }
+
+        _header = static_cast<const TelemetryShmHeader*>(_mapping->data());
+        const auto magic = _header->magic;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (magic != TELEMETRY_SHM_MAGIC || _header->version != TELEMETRY_SHM_VERSION ||
+            _header->slot_size != sizeof(TelemetryShmSlot) ||
+            _mapping->size() < sizeof(TelemetryShmHeader) +
+                                   std::size_t(_header->slot_count) * sizeof(TelemetryShmSlot)) {
+            _header = nullptr;
+            return;
+        }
+
+        _slots = reinterpret_cast<const TelemetryShmSlot*>(_header + 1);
+        // Only what is written from now on.
+        _read_index = _header->write_index.load(std::memory_order_acquire);
+    }
+
+    bool is_open() const { return _header != nullptr; }
+
+    // Returns the next record, or nothing if the reader has caught up.
+    std::optional<Record> read_next()
+    {
+        if (_header == nullptr) {
+            return std::nullopt;
+        }
+
+        const uint64_t slot_count = _header->slot_count;
+
+        while (true) {
+            const uint64_t write_index = _header->write_index.load(std::memory_order_acquire);
+            if (_read_index == write_index) {
+                return std::nullopt;
+            }
+
+            if (write_index - _read_index > slot_count) {
+                _dropped += write_index - slot_count - _read_index;
+                _read_index = write_index - slot_count;
+            }
+
+            const TelemetryShmSlot& slot = _slots[_read_index % slot_count];
+            const uint64_t expected = 2 * (_read_index / slot_count + 1);
+
+            const uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            Record record;
+            record.topic = static_cast<TelemetryShmTopic>(slot.topic);
+            record.time_us = slot.time_us;
+            const auto size = std::min<std::size_t>(slot.size, TelemetryShmSlot::PAYLOAD_SIZE);
+            record.payload.assign(slot.payload, slot.payload + size);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint64_t after = slot.sequence.load(std::memory_order_relaxed);
+
+            ++_read_index;
+            if (before == expected && after == expected) {
+                return record;
+            }
+            ++_dropped;
+        }
+    }
+
+    // Records overwritten before they could be read.
+    uint64_t dropped() const { return _dropped; }
+
+    // Non-copyable
+    TelemetryShmReader(const TelemetryShmReader&) = delete;
+    const TelemetryShmReader& operator=(const TelemetryShmReader&) = delete;
+
+private:
+    std::optional<TelemetryShmMapping> _mapping;
+    const TelemetryShmHeader* _header{nullptr};
+    const TelemetryShmSlot* _slots{nullptr};
+    uint64_t _read_index{0};
+    uint64_t _dropped{0};
+};
+
+} // namespace mavsdk_server
+} // namespace mavsdk
+
+#endif
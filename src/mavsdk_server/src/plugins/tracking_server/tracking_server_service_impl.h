@@ -243,7 +243,8 @@ public:
         const mavsdk::rpc::tracking_server::SubscribeTrackingPointCommandRequest* /* request */,
         grpc::ServerWriter<rpc::tracking_server::TrackingPointCommandResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -255,8 +256,14 @@ public:
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
         const mavsdk::TrackingServer::TrackingPointCommandHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_tracking_point_command(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+            plugin->subscribe_tracking_point_command(
+                [this,
+                 plugin,
+                 &writer,
+                 &stream_closed_promise,
+                 is_finished,
+                 subscribe_mutex,
+                 &handle](
                     const mavsdk::TrackingServer::TrackPoint tracking_point_command) {
                     rpc::tracking_server::TrackingPointCommandResponse rpc_response;
 
@@ -265,7 +272,7 @@ public:
 
                     std::unique_lock<std::mutex> lock(*subscribe_mutex);
                     if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_tracking_point_command(handle);
+                        plugin->unsubscribe_tracking_point_command(handle);
 
                         *is_finished = true;
                         unregister_stream_stop_promise(stream_closed_promise);
@@ -285,7 +292,8 @@ public:
         const mavsdk::rpc::tracking_server::SubscribeTrackingRectangleCommandRequest* /* request */,
         grpc::ServerWriter<rpc::tracking_server::TrackingRectangleCommandResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -297,8 +305,14 @@ public:
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
         const mavsdk::TrackingServer::TrackingRectangleCommandHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_tracking_rectangle_command(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+            plugin->subscribe_tracking_rectangle_command(
+                [this,
+                 plugin,
+                 &writer,
+                 &stream_closed_promise,
+                 is_finished,
+                 subscribe_mutex,
+                 &handle](
                     const mavsdk::TrackingServer::TrackRectangle tracking_rectangle_command) {
                     rpc::tracking_server::TrackingRectangleCommandResponse rpc_response;
 
@@ -307,7 +321,7 @@ public:
 
                     std::unique_lock<std::mutex> lock(*subscribe_mutex);
                     if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_tracking_rectangle_command(handle);
+                        plugin->unsubscribe_tracking_rectangle_command(handle);
 
                         *is_finished = true;
                         unregister_stream_stop_promise(stream_closed_promise);
@@ -327,7 +341,8 @@ public:
         const mavsdk::rpc::tracking_server::SubscribeTrackingOffCommandRequest* /* request */,
         grpc::ServerWriter<rpc::tracking_server::TrackingOffCommandResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -339,8 +354,14 @@ public:
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
         const mavsdk::TrackingServer::TrackingOffCommandHandle handle =
-            _lazy_plugin.maybe_plugin()->subscribe_tracking_off_command(
-                [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+            plugin->subscribe_tracking_off_command(
+                [this,
+                 plugin,
+                 &writer,
+                 &stream_closed_promise,
+                 is_finished,
+                 subscribe_mutex,
+                 &handle](
                     const int32_t tracking_off_command) {
                     rpc::tracking_server::TrackingOffCommandResponse rpc_response;
 
@@ -348,7 +369,7 @@ public:
 
                     std::unique_lock<std::mutex> lock(*subscribe_mutex);
                     if (!*is_finished && !writer->Write(rpc_response)) {
-                        _lazy_plugin.maybe_plugin()->unsubscribe_tracking_off_command(handle);
+                        plugin->unsubscribe_tracking_off_command(handle);
 
                         *is_finished = true;
                         unregister_stream_stop_promise(stream_closed_promise);
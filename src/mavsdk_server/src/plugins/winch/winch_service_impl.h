@@ -273,7 +273,8 @@ public:
         const mavsdk::rpc::winch::SubscribeStatusRequest* /* request */,
         grpc::ServerWriter<rpc::winch::StatusResponse>* writer) override
     {
-        if (_lazy_plugin.maybe_plugin() == nullptr) {
+        auto* plugin = _lazy_plugin.maybe_plugin();
+        if (plugin == nullptr) {
             return grpc::Status::OK;
         }
 
@@ -284,8 +285,8 @@ public:
         auto is_finished = std::make_shared<bool>(false);
         auto subscribe_mutex = std::make_shared<std::mutex>();
 
-        const mavsdk::Winch::StatusHandle handle = _lazy_plugin.maybe_plugin()->subscribe_status(
-            [this, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
+        const mavsdk::Winch::StatusHandle handle = plugin->subscribe_status(
+            [this, plugin, &writer, &stream_closed_promise, is_finished, subscribe_mutex, &handle](
                 const mavsdk::Winch::Status status) {
                 rpc::winch::StatusResponse rpc_response;
 
@@ -293,7 +294,7 @@ public:
 
                 std::unique_lock<std::mutex> lock(*subscribe_mutex);
                 if (!*is_finished && !writer->Write(rpc_response)) {
-                    _lazy_plugin.maybe_plugin()->unsubscribe_status(handle);
+                    plugin->unsubscribe_status(handle);
 
                     *is_finished = true;
                     unregister_stream_stop_promise(stream_closed_promise);
@@ -0,0 +1,47 @@
+#include "system_selection_interceptor.h"
+#include "system_selection.h"
+#include "log.h"
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace mavsdk::mavsdk_server {
+
+void SystemSelectionInterceptor::Intercept(grpc::experimental::InterceptorBatchMethods* methods)
+{
+    if (methods->QueryInterceptionHookPoint(
+            grpc::experimental::InterceptionHookPoints::POST_RECV_INITIAL_METADATA)) {
+        // Always set it, so a previous call on this thread doesn't leak into this one.
+        SystemSelection::set(system_id_from(*methods->GetRecvInitialMetadata()));
+    }
+
+    methods->Proceed();
+}
+
+std::optional<uint8_t> SystemSelectionInterceptor::system_id_from(
+    const std::multimap<grpc::string_ref, grpc::string_ref>& metadata)
+{
+    const auto it = metadata.find(SystemSelection::metadata_key);
+    if (it == metadata.end()) {
+        return std::nullopt;
+    }
+
+    const std::string_view value{it->second.data(), it->second.size()};
+    const auto system_id = SystemSelection::parse(value);
+    if (!system_id) {
+        // Never fall back to the first system here, a command meant for
+        // another vehicle must not end up there.
+        LogWarn() << "Invalid " << SystemSelection::metadata_key << ": " << std::string(value);
+        return SystemSelection::invalid_system_id;
+    }
+    return system_id;
+}
+
+grpc::experimental::Interceptor* SystemSelectionInterceptorFactory::CreateServerInterceptor(
+    grpc::experimental::ServerRpcInfo* /* info */)
+{
+    return new SystemSelectionInterceptor();
+}
+
+} // namespace mavsdk::mavsdk_server
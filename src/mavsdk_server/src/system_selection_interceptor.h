@@ -0,0 +1,34 @@
+#pragma once
+
+#include <grpcpp/support/server_interceptor.h>
+#include <grpcpp/support/string_ref.h>
+
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace mavsdk::mavsdk_server {
+
+// Selects the system for each incoming call from its "mavsdk-system-id"
+// metadata, so that the plugins of that system are used to handle it.
+//
+// For the synchronous server, the metadata hook runs on the same thread as
+// the handler afterwards, which is what makes the thread-local selection work.
+class SystemSelectionInterceptor : public grpc::experimental::Interceptor {
+public:
+    void Intercept(grpc::experimental::InterceptorBatchMethods* methods) override;
+
+    // Returns the system selected by the metadata of a call, nothing if it
+    // doesn't select one, and the invalid system ID if it can't be parsed.
+    static std::optional<uint8_t>
+    system_id_from(const std::multimap<grpc::string_ref, grpc::string_ref>& metadata);
+};
+
+class SystemSelectionInterceptorFactory
+    : public grpc::experimental::ServerInterceptorFactoryInterface {
+public:
+    grpc::experimental::Interceptor*
+    CreateServerInterceptor(grpc::experimental::ServerRpcInfo* info) override;
+};
+
+} // namespace mavsdk::mavsdk_server
@@ -105,4 +105,27 @@ TEST(ConnectionInitiator, doesNotCrashIfDiscoverCallbackCalledMoreThanOnce)
     change_callback();
 }
 
+TEST(ConnectionInitiator, connectionDetectedIfAnySystemIsConnected)
+{
+    ConnectionInitiator initiator;
+    MockMavsdk mavsdk;
+    NewSystemCallback change_callback;
+
+    EXPECT_CALL(mavsdk, subscribe_on_new_system(_)).WillOnce(SaveCallback(&change_callback));
+
+    std::vector<std::shared_ptr<MockSystem>> systems;
+    auto first_system = std::make_shared<MockSystem>();
+    auto second_system = std::make_shared<MockSystem>();
+    systems.push_back(first_system);
+    systems.push_back(second_system);
+    EXPECT_CALL(mavsdk, systems()).WillOnce(testing::Return(systems));
+
+    EXPECT_CALL(*first_system, is_connected()).WillOnce(testing::Return(false));
+    EXPECT_CALL(*second_system, is_connected()).WillOnce(testing::Return(true));
+
+    initiator.start(mavsdk, ARBITRARY_CONNECTION_URL);
+    change_callback();
+    EXPECT_TRUE(initiator.wait());
+}
+
 } // namespace
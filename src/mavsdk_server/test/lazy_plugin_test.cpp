@@ -0,0 +1,120 @@
+#include <gmock/gmock.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "lazy_plugin.h"
+#include "system_selection.h"
+#include "mocks/mavsdk_mock.h"
+#include "mocks/system_mock.h"
+
+namespace {
+
+using testing::NiceMock;
+using testing::Return;
+
+using MockMavsdk = NiceMock<mavsdk::testing::MockMavsdk>;
+using MockSystem = mavsdk::testing::MockSystem;
+using SystemSelection = mavsdk::mavsdk_server::SystemSelection;
+
+// Only remembers which system it was created for.
+struct FakePlugin {
+    explicit FakePlugin(std::shared_ptr<MockSystem> plugin_system) :
+        system(std::move(plugin_system))
+    {}
+
+    std::shared_ptr<MockSystem> system;
+};
+
+using LazyPlugin = mavsdk::mavsdk_server::LazyPlugin<FakePlugin, MockMavsdk>;
+
+std::shared_ptr<MockSystem> make_system(uint8_t system_id)
+{
+    auto system = std::make_shared<NiceMock<MockSystem>>();
+    ON_CALL(*system, get_system_id()).WillByDefault(Return(system_id));
+    return system;
+}
+
+class LazyPluginTest : public testing::Test {
+protected:
+    LazyPluginTest() : _first(make_system(3)), _second(make_system(7))
+    {
+        ON_CALL(_mavsdk, systems())
+            .WillByDefault(Return(std::vector<std::shared_ptr<MockSystem>>{_first, _second}));
+    }
+
+    // The selection is per thread, so it must not leak into other tests.
+    void TearDown() override { SystemSelection::set(std::nullopt); }
+
+    MockMavsdk _mavsdk;
+    std::shared_ptr<MockSystem> _first;
+    std::shared_ptr<MockSystem> _second;
+};
+
+TEST_F(LazyPluginTest, returnsNullWithoutSystems)
+{
+    MockMavsdk mavsdk;
+    LazyPlugin lazy_plugin(mavsdk);
+
+    EXPECT_EQ(nullptr, lazy_plugin.maybe_plugin());
+}
+
+TEST_F(LazyPluginTest, usesFirstSystemWithoutSelection)
+{
+    LazyPlugin lazy_plugin(_mavsdk);
+
+    auto* plugin = lazy_plugin.maybe_plugin();
+    ASSERT_NE(nullptr, plugin);
+    EXPECT_EQ(_first, plugin->system);
+    EXPECT_EQ(plugin, lazy_plugin.maybe_plugin());
+}
+
+TEST_F(LazyPluginTest, usesSelectedSystem)
+{
+    LazyPlugin lazy_plugin(_mavsdk);
+
+    SystemSelection::set(7);
+    auto* second_plugin = lazy_plugin.maybe_plugin();
+    ASSERT_NE(nullptr, second_plugin);
+    EXPECT_EQ(_second, second_plugin->system);
+
+    SystemSelection::set(3);
+    auto* first_plugin = lazy_plugin.maybe_plugin();
+    ASSERT_NE(nullptr, first_plugin);
+    EXPECT_EQ(_first, first_plugin->system);
+
+    // Each system keeps its plugin.
+    SystemSelection::set(7);
+    EXPECT_EQ(second_plugin, lazy_plugin.maybe_plugin());
+
+    // Without selection it's the same plugin as when selecting the first one.
+    SystemSelection::set(std::nullopt);
+    EXPECT_EQ(first_plugin, lazy_plugin.maybe_plugin());
+}
+
+TEST_F(LazyPluginTest, returnsNullForUnknownOrInvalidSystem)
+{
+    LazyPlugin lazy_plugin(_mavsdk);
+
+    SystemSelection::set(9);
+    EXPECT_EQ(nullptr, lazy_plugin.maybe_plugin());
+
+    SystemSelection::set(SystemSelection::invalid_system_id);
+    EXPECT_EQ(nullptr, lazy_plugin.maybe_plugin());
+}
+
+TEST_F(LazyPluginTest, selectionOnlyAppliesToItsThread)
+{
+    LazyPlugin lazy_plugin(_mavsdk);
+
+    SystemSelection::set(7);
+
+    FakePlugin* other_thread_plugin = nullptr;
+    std::thread([&]() { other_thread_plugin = lazy_plugin.maybe_plugin(); }).join();
+
+    ASSERT_NE(nullptr, other_thread_plugin);
+    EXPECT_EQ(_first, other_thread_plugin->system);
+    EXPECT_EQ(_second, lazy_plugin.maybe_plugin()->system);
+}
+
+} // namespace
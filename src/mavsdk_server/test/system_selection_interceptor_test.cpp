@@ -0,0 +1,50 @@
+#include <gmock/gmock.h>
+#include <map>
+
+#include "system_selection.h"
+#include "system_selection_interceptor.h"
+
+namespace {
+
+using Metadata = std::multimap<grpc::string_ref, grpc::string_ref>;
+using SystemSelection = mavsdk::mavsdk_server::SystemSelection;
+using SystemSelectionInterceptor = mavsdk::mavsdk_server::SystemSelectionInterceptor;
+
+std::optional<uint8_t> system_id_from(const char* value)
+{
+    Metadata metadata;
+    metadata.emplace(SystemSelection::metadata_key, value);
+    return SystemSelectionInterceptor::system_id_from(metadata);
+}
+
+TEST(SystemSelectionInterceptor, selectsNothingWithoutMetadata)
+{
+    EXPECT_EQ(std::nullopt, SystemSelectionInterceptor::system_id_from(Metadata{}));
+
+    Metadata metadata;
+    metadata.emplace("user-agent", "grpc-python/1.46.0");
+    EXPECT_EQ(std::nullopt, SystemSelectionInterceptor::system_id_from(metadata));
+}
+
+TEST(SystemSelectionInterceptor, selectsSystemFromMetadata)
+{
+    EXPECT_EQ(std::optional<uint8_t>{1}, system_id_from("1"));
+    EXPECT_EQ(std::optional<uint8_t>{42}, system_id_from("42"));
+    EXPECT_EQ(std::optional<uint8_t>{255}, system_id_from("255"));
+    EXPECT_EQ(std::optional<uint8_t>{7}, system_id_from("007"));
+}
+
+TEST(SystemSelectionInterceptor, selectsInvalidSystemForBadMetadata)
+{
+    const std::optional<uint8_t> invalid{SystemSelection::invalid_system_id};
+
+    EXPECT_EQ(invalid, system_id_from(""));
+    EXPECT_EQ(invalid, system_id_from("0"));
+    EXPECT_EQ(invalid, system_id_from("256"));
+    EXPECT_EQ(invalid, system_id_from("1000"));
+    EXPECT_EQ(invalid, system_id_from("-1"));
+    EXPECT_EQ(invalid, system_id_from(" 1"));
+    EXPECT_EQ(invalid, system_id_from("0x1"));
+}
+
+} // namespace
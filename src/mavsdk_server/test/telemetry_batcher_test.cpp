@@ -0,0 +1,120 @@
+#include <chrono>
+#include <future>
+#include <gmock/gmock.h>
+#include <thread>
+
+#include "telemetry/mocks/telemetry_mock.h"
+#include "telemetry/telemetry_batcher.h"
+
+namespace {
+
+using testing::_;
+using testing::DoAll;
+using testing::NiceMock;
+using testing::Return;
+using testing::SaveArg;
+
+using MockTelemetry = NiceMock<mavsdk::testing::MockTelemetry>;
+using TelemetryBatcher = mavsdk::mavsdk_server::TelemetryBatcher<MockTelemetry>;
+using Topic = TelemetryBatcher::Topic;
+
+static constexpr auto FLUSH_PERIOD = std::chrono::milliseconds(20);
+
+TEST(TelemetryBatcher, subscribesOnlySelectedTopics)
+{
+    MockTelemetry telemetry;
+
+    EXPECT_CALL(telemetry, subscribe_position(_)).Times(1);
+    EXPECT_CALL(telemetry, subscribe_battery(_)).Times(1);
+    EXPECT_CALL(telemetry, subscribe_attitude_quaternion(_)).Times(0);
+    EXPECT_CALL(telemetry, subscribe_velocity_ned(_)).Times(0);
+    EXPECT_CALL(telemetry, subscribe_gps_info(_)).Times(0);
+
+    EXPECT_CALL(telemetry, unsubscribe_position(_)).Times(1);
+    EXPECT_CALL(telemetry, unsubscribe_battery(_)).Times(1);
+
+    TelemetryBatcher batcher(
+        telemetry, {Topic::Position, Topic::Battery, Topic::Position}, FLUSH_PERIOD);
+}
+
+TEST(TelemetryBatcher, batchContainsLatestSampleOfEachTopic)
+{
+    MockTelemetry telemetry;
+    mavsdk::Telemetry::PositionCallback position_callback;
+    mavsdk::Telemetry::BatteryCallback battery_callback;
+
+    EXPECT_CALL(telemetry, subscribe_position(_))
+        .WillOnce(DoAll(
+            SaveArg<0>(&position_callback), Return(mavsdk::Telemetry::PositionHandle{})));
+    EXPECT_CALL(telemetry, subscribe_battery(_))
+        .WillOnce(
+            DoAll(SaveArg<0>(&battery_callback), Return(mavsdk::Telemetry::BatteryHandle{})));
+
+    TelemetryBatcher batcher(telemetry, {Topic::Position, Topic::Battery}, FLUSH_PERIOD);
+
+    mavsdk::Telemetry::Position position{};
+    position.latitude_deg = 1.0;
+    position_callback(position);
+    position.latitude_deg = 2.0;
+    position_callback(position);
+
+    mavsdk::Telemetry::Battery battery{};
+    battery.remaining_percent = 42.0f;
+    battery_callback(battery);
+
+    TelemetryBatcher::Batch batch;
+    ASSERT_TRUE(batcher.wait_for_batch(batch));
+
+    ASSERT_TRUE(batch.position);
+    EXPECT_DOUBLE_EQ(batch.position->latitude_deg, 2.0);
+    ASSERT_TRUE(batch.battery);
+    EXPECT_FLOAT_EQ(batch.battery->remaining_percent, 42.0f);
+    EXPECT_FALSE(batch.attitude_quaternion);
+
+    // Only what was updated since goes into the next batch.
+    battery_callback(battery);
+    ASSERT_TRUE(batcher.wait_for_batch(batch));
+    EXPECT_FALSE(batch.position);
+    EXPECT_TRUE(batch.battery);
+}
+
+TEST(TelemetryBatcher, periodsWithoutUpdatesAreSkipped)
+{
+    MockTelemetry telemetry;
+    mavsdk::Telemetry::PositionCallback position_callback;
+
+    EXPECT_CALL(telemetry, subscribe_position(_))
+        .WillOnce(DoAll(
+            SaveArg<0>(&position_callback), Return(mavsdk::Telemetry::PositionHandle{})));
+
+    TelemetryBatcher batcher(telemetry, {Topic::Position}, FLUSH_PERIOD);
+
+    auto batch_future = std::async(std::launch::async, [&batcher]() {
+        TelemetryBatcher::Batch batch;
+        return batcher.wait_for_batch(batch);
+    });
+
+    EXPECT_EQ(batch_future.wait_for(FLUSH_PERIOD * 3), std::future_status::timeout);
+
+    position_callback(mavsdk::Telemetry::Position{});
+    EXPECT_TRUE(batch_future.get());
+}
+
+TEST(TelemetryBatcher, stopUnblocksWait)
+{
+    MockTelemetry telemetry;
+    TelemetryBatcher batcher(telemetry, {Topic::GpsInfo}, std::chrono::milliseconds(10000));
+
+    auto batch_future = std::async(std::launch::async, [&batcher]() {
+        TelemetryBatcher::Batch batch;
+        return batcher.wait_for_batch(batch);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    batcher.stop();
+
+    ASSERT_EQ(batch_future.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_FALSE(batch_future.get());
+}
+
+} // namespace
@@ -0,0 +1,135 @@
+#include <cstring>
+#include <gmock/gmock.h>
+#include <string>
+#include <unistd.h>
+
+#include "telemetry/mocks/telemetry_mock.h"
+#include "telemetry/telemetry_shm_ring.h"
+
+namespace {
+
+using testing::_;
+using testing::DoAll;
+using testing::NiceMock;
+using testing::Return;
+using testing::SaveArg;
+
+using MockTelemetry = NiceMock<mavsdk::testing::MockTelemetry>;
+using TelemetryShmRing = mavsdk::mavsdk_server::TelemetryShmRing<MockTelemetry>;
+using TelemetryShmReader = mavsdk::mavsdk_server::TelemetryShmReader;
+using TelemetryShmTopic = mavsdk::mavsdk_server::TelemetryShmTopic;
+
+static constexpr uint32_t SLOT_COUNT = 8;
+
+std::string unique_name()
+{
+    return "/mavsdk_server_test_" + std::to_string(getpid());
+}
+
+TEST(TelemetryShmRing, subscribesAndUnsubscribesHotTopics)
+{
+    MockTelemetry telemetry;
+
+    EXPECT_CALL(telemetry, subscribe_position(_)).Times(1);
+    EXPECT_CALL(telemetry, subscribe_attitude_quaternion(_)).Times(1);
+    EXPECT_CALL(telemetry, subscribe_velocity_ned(_)).Times(1);
+
+    EXPECT_CALL(telemetry, unsubscribe_position(_)).Times(1);
+    EXPECT_CALL(telemetry, unsubscribe_attitude_quaternion(_)).Times(1);
+    EXPECT_CALL(telemetry, unsubscribe_velocity_ned(_)).Times(1);
+
+    TelemetryShmRing ring(telemetry, unique_name(), SLOT_COUNT);
+    EXPECT_TRUE(ring.is_open());
+}
+
+TEST(TelemetryShmRing, readerGetsRecordsInOrder)
+{
+    MockTelemetry telemetry;
+    mavsdk::Telemetry::PositionCallback position_callback;
+    mavsdk::Telemetry::VelocityNedCallback velocity_ned_callback;
+
+    EXPECT_CALL(telemetry, subscribe_position(_))
+        .WillOnce(DoAll(
+            SaveArg<0>(&position_callback), Return(mavsdk::Telemetry::PositionHandle{})));
+    EXPECT_CALL(telemetry, subscribe_velocity_ned(_))
+        .WillOnce(DoAll(
+            SaveArg<0>(&velocity_ned_callback), Return(mavsdk::Telemetry::VelocityNedHandle{})));
+
+    TelemetryShmRing ring(telemetry, unique_name(), SLOT_COUNT);
+    TelemetryShmReader reader(unique_name());
+    ASSERT_TRUE(reader.is_open());
+    EXPECT_FALSE(reader.read_next());
+
+    mavsdk::Telemetry::Position position{};
+    position.latitude_deg = 47.0;
+    position.relative_altitude_m = 10.0f;
+    position_callback(position);
+
+    mavsdk::Telemetry::VelocityNed velocity_ned{};
+    velocity_ned.down_m_s = -1.5f;
+    velocity_ned_callback(velocity_ned);
+
+    auto record = reader.read_next();
+    ASSERT_TRUE(record);
+    ASSERT_EQ(record->topic, TelemetryShmTopic::Position);
+    ASSERT_EQ(record->payload.size(), sizeof(mavsdk::mavsdk_server::TelemetryShmPosition));
+    mavsdk::mavsdk_server::TelemetryShmPosition shm_position;
+    std::memcpy(&shm_position, record->payload.data(), sizeof(shm_position));
+    EXPECT_DOUBLE_EQ(shm_position.latitude_deg, 47.0);
+    EXPECT_FLOAT_EQ(shm_position.relative_altitude_m, 10.0f);
+
+    record = reader.read_next();
+    ASSERT_TRUE(record);
+    ASSERT_EQ(record->topic, TelemetryShmTopic::VelocityNed);
+    mavsdk::mavsdk_server::TelemetryShmVelocityNed shm_velocity_ned;
+    std::memcpy(&shm_velocity_ned, record->payload.data(), sizeof(shm_velocity_ned));
+    EXPECT_FLOAT_EQ(shm_velocity_ned.down_m_s, -1.5f);
+
+    EXPECT_FALSE(reader.read_next());
+    EXPECT_EQ(reader.dropped(), 0u);
+}
+
+TEST(TelemetryShmRing, slowReaderLosesOldestRecords)
+{
+    MockTelemetry telemetry;
+    mavsdk::Telemetry::PositionCallback position_callback;
+
+    EXPECT_CALL(telemetry, subscribe_position(_))
+        .WillOnce(DoAll(
+            SaveArg<0>(&position_callback), Return(mavsdk::Telemetry::PositionHandle{})));
+
+    TelemetryShmRing ring(telemetry, unique_name(), SLOT_COUNT);
+    TelemetryShmReader reader(unique_name());
+    ASSERT_TRUE(reader.is_open());
+
+    mavsdk::Telemetry::Position position{};
+    for (uint32_t i = 0; i < SLOT_COUNT + 3; ++i) {
+        position.latitude_deg = i;
+        position_callback(position);
+    }
+
+    auto record = reader.read_next();
+    ASSERT_TRUE(record);
+    mavsdk::mavsdk_server::TelemetryShmPosition shm_position;
+    std::memcpy(&shm_position, record->payload.data(), sizeof(shm_position));
+    EXPECT_DOUBLE_EQ(shm_position.latitude_deg, 3.0);
+    EXPECT_EQ(reader.dropped(), 3u);
+
+    unsigned count = 1;
+    while (reader.read_next()) {
+        ++count;
+    }
+    EXPECT_EQ(count, SLOT_COUNT);
+}
+
+TEST(TelemetryShmRing, nameIsRemovedWithRing)
+{
+    MockTelemetry telemetry;
+    {
+        TelemetryShmRing ring(telemetry, unique_name(), SLOT_COUNT);
+        EXPECT_TRUE(TelemetryShmReader(unique_name()).is_open());
+    }
+    EXPECT_FALSE(TelemetryShmReader(unique_name()).is_open());
+}
+
+} // namespace
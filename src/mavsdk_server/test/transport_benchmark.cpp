@@ -0,0 +1,179 @@
+// Compares streaming telemetry over TCP loopback and over a unix domain socket.
+//
+// A position stream is subscribed to through the real telemetry service impl
+// and positions are pushed one by one, each waiting for the client to receive
+// it. The send time travels in the message, so we get the one-way latency,
+// and the CPU time of the whole process per message.
+//
+// Usage: transport_benchmark_mavsdk_server [num_messages]
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <grpc++/grpc++.h>
+#include <grpc++/server.h>
+#include <grpc++/server_builder.h>
+#include <unistd.h>
+
+#include "telemetry/mocks/telemetry_mock.h"
+#include "telemetry/telemetry_service_impl.h"
+#include "mocks/lazy_plugin_mock.h"
+
+namespace {
+
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+
+using MockTelemetry = NiceMock<mavsdk::testing::MockTelemetry>;
+using MockLazyPlugin =
+    testing::NiceMock<mavsdk::mavsdk_server::testing::MockLazyPlugin<MockTelemetry>>;
+using TelemetryServiceImpl =
+    mavsdk::mavsdk_server::TelemetryServiceImpl<MockTelemetry, MockLazyPlugin>;
+using TelemetryService = mavsdk::rpc::telemetry::TelemetryService;
+using Position = mavsdk::Telemetry::Position;
+
+struct Result {
+    std::vector<double> latencies_us;
+    double cpu_us_per_message{0.0};
+};
+
+double now_us()
+{
+    return std::chrono::duration<double, std::micro>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+double cpu_time_us()
+{
+    return static_cast<double>(std::clock()) * 1e6 / CLOCKS_PER_SEC;
+}
+
+Result run(const std::string& address, unsigned count)
+{
+    MockLazyPlugin lazy_plugin;
+    MockTelemetry telemetry;
+    TelemetryServiceImpl service(lazy_plugin);
+
+    ON_CALL(lazy_plugin, maybe_plugin()).WillByDefault(Return(&telemetry));
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    mavsdk::Telemetry::PositionCallback position_callback;
+    unsigned received = 0;
+    Result result;
+    result.latencies_us.reserve(count);
+
+    ON_CALL(telemetry, subscribe_position(_))
+        .WillByDefault([&](const mavsdk::Telemetry::PositionCallback& callback) {
+            std::lock_guard<std::mutex> lock(mutex);
+            position_callback = callback;
+            cv.notify_all();
+            return mavsdk::Telemetry::PositionHandle{};
+        });
+
+    grpc::ServerBuilder builder;
+    int bound_port = 0;
+    builder.AddListeningPort(address, grpc::InsecureServerCredentials(), &bound_port);
+    builder.RegisterService(&service);
+    auto server = builder.BuildAndStart();
+
+    // A TCP address is given with port 0 to get a free one.
+    const std::string client_address = address.rfind("unix:", 0) == 0 ?
+                                           address :
+                                           "127.0.0.1:" + std::to_string(bound_port);
+    auto channel = grpc::CreateChannel(client_address, grpc::InsecureChannelCredentials());
+    auto stub = TelemetryService::NewStub(channel);
+
+    grpc::ClientContext context;
+    mavsdk::rpc::telemetry::SubscribePositionRequest request;
+    auto reader = stub->SubscribePosition(&context, request);
+
+    std::thread reader_thread([&]() {
+        mavsdk::rpc::telemetry::PositionResponse response;
+        while (reader->Read(&response)) {
+            const double latency_us = now_us() - response.position().latitude_deg();
+            std::lock_guard<std::mutex> lock(mutex);
+            result.latencies_us.push_back(latency_us);
+            ++received;
+            cv.notify_all();
+        }
+    });
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&]() { return position_callback != nullptr; });
+    }
+
+    const double cpu_start_us = cpu_time_us();
+    for (unsigned i = 0; i < count; ++i) {
+        Position position{};
+        // The timestamp fits into a double without loss.
+        position.latitude_deg = now_us();
+        position_callback(position);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&]() { return received > i; });
+    }
+    result.cpu_us_per_message = (cpu_time_us() - cpu_start_us) / count;
+
+    context.TryCancel();
+    service.stop();
+    server->Shutdown();
+    reader_thread.join();
+
+    return result;
+}
+
+void print(const std::string& name, Result& result)
+{
+    auto& latencies = result.latencies_us;
+    std::sort(latencies.begin(), latencies.end());
+
+    const auto percentile = [&](double p) {
+        return latencies[static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1))];
+    };
+
+    std::cout << std::fixed << std::setprecision(1) << std::setw(6) << name
+              << ": median " << percentile(0.5) << " us, p99 " << percentile(0.99)
+              << " us, max " << latencies.back() << " us, cpu " << result.cpu_us_per_message
+              << " us/msg\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const unsigned count = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 10000;
+    if (count == 0) {
+        std::cerr << "Usage: " << argv[0] << " [num_messages]\n";
+        return 1;
+    }
+
+    const std::string socket_path =
+        "/tmp/mavsdk_transport_benchmark_" + std::to_string(getpid()) + ".sock";
+
+    std::cout << "Streaming " << count << " positions\n";
+
+    auto tcp = run("127.0.0.1:0", count);
+    print("tcp", tcp);
+
+    auto unix_socket = run("unix:" + socket_path, count);
+    print("unix", unix_socket);
+
+    unlink(socket_path.c_str());
+    return 0;
+}
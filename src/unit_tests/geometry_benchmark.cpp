@@ -0,0 +1,94 @@
+// Compares transforming points one by one with the batch versions of
+// CoordinateTransformation.
+//
+// Usage: geometry_benchmark [num_points]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "geometry.h"
+
+using namespace mavsdk::geometry;
+
+namespace {
+
+template<typename F> double points_per_s(std::size_t num_points, F&& transform)
+{
+    // Once to warm up, then the best of a few runs.
+    transform();
+    double best_s = 1e9;
+    for (unsigned i = 0; i < 5; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        transform();
+        const double elapsed_s =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best_s = std::min(best_s, elapsed_s);
+    }
+    return static_cast<double>(num_points) / best_s;
+}
+
+void print(const std::string& name, double single, double batch)
+{
+    std::cout << std::setw(18) << name << ": " << std::fixed << std::setprecision(1)
+              << single / 1e6 << " M points/s single, " << batch / 1e6
+              << " M points/s batch (x" << std::setprecision(2) << batch / single << ")\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t num_points = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    if (num_points == 0) {
+        std::cerr << "Usage: " << argv[0] << " [num_points]\n";
+        return 1;
+    }
+
+    CoordinateTransformation ct({47.397742, 8.545594});
+
+    // Points within 10 km around the reference, like a mission or a fleet.
+    std::vector<double> north(num_points);
+    std::vector<double> east(num_points);
+    for (std::size_t i = 0; i < num_points; ++i) {
+        north[i] = static_cast<double>(i % 2000) * 10.0 - 10000.0;
+        east[i] = static_cast<double>(i / 2000 % 2000) * 10.0 - 10000.0;
+    }
+
+    std::vector<double> latitudes(num_points);
+    std::vector<double> longitudes(num_points);
+    std::vector<double> north_again(num_points);
+    std::vector<double> east_again(num_points);
+
+    const double global_single = points_per_s(num_points, [&]() {
+        for (std::size_t i = 0; i < num_points; ++i) {
+            const auto global = ct.global_from_local({north[i], east[i]});
+            latitudes[i] = global.latitude_deg;
+            longitudes[i] = global.longitude_deg;
+        }
+    });
+    const double global_batch = points_per_s(num_points, [&]() {
+        ct.global_from_local(
+            north.data(), east.data(), num_points, latitudes.data(), longitudes.data());
+    });
+    print("global_from_local", global_single, global_batch);
+
+    const double local_single = points_per_s(num_points, [&]() {
+        for (std::size_t i = 0; i < num_points; ++i) {
+            const auto local = ct.local_from_global({latitudes[i], longitudes[i]});
+            north_again[i] = local.north_m;
+            east_again[i] = local.east_m;
+        }
+    });
+    const double local_batch = points_per_s(num_points, [&]() {
+        ct.local_from_global(
+            latitudes.data(), longitudes.data(), num_points, north_again.data(), east_again.data());
+    });
+    print("local_from_global", local_single, local_batch);
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+// Measures the cost of routing incoming messages to the handlers of their
+// system for fleets of different sizes.
+//
+// Each system gets a set of handlers like the ones a few plugins would
+// register. The messages are then received round-robin from all systems
+// without any connection involved, so only the routing and dispatching
+// is measured.
+//
+// Usage: message_routing_benchmark [num_messages]
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "mavsdk_impl.h"
+#include "plugin_impl_base.h"
+
+using namespace mavsdk;
+
+namespace {
+
+// Roughly what telemetry, mission and param plugins register.
+constexpr uint16_t subscribed_message_ids[] = {
+    MAVLINK_MSG_ID_ATTITUDE,
+    MAVLINK_MSG_ID_ATTITUDE_QUATERNION,
+    MAVLINK_MSG_ID_GLOBAL_POSITION_INT,
+    MAVLINK_MSG_ID_LOCAL_POSITION_NED,
+    MAVLINK_MSG_ID_GPS_RAW_INT,
+    MAVLINK_MSG_ID_SYS_STATUS,
+    MAVLINK_MSG_ID_BATTERY_STATUS,
+    MAVLINK_MSG_ID_EXTENDED_SYS_STATE,
+    MAVLINK_MSG_ID_VFR_HUD,
+    MAVLINK_MSG_ID_HOME_POSITION,
+    MAVLINK_MSG_ID_RC_CHANNELS,
+    MAVLINK_MSG_ID_ODOMETRY,
+    MAVLINK_MSG_ID_HIGHRES_IMU,
+    MAVLINK_MSG_ID_SCALED_IMU,
+    MAVLINK_MSG_ID_ALTITUDE,
+    MAVLINK_MSG_ID_WIND_COV,
+    MAVLINK_MSG_ID_MISSION_CURRENT,
+    MAVLINK_MSG_ID_MISSION_ITEM_REACHED,
+    MAVLINK_MSG_ID_PARAM_VALUE,
+    MAVLINK_MSG_ID_PARAM_EXT_VALUE,
+};
+
+class SubscriberImpl : public PluginImplBase {
+public:
+    explicit SubscriberImpl(std::shared_ptr<System> system) : PluginImplBase(std::move(system)) {}
+
+    void init() override
+    {
+        for (const auto message_id : subscribed_message_ids) {
+            _system_impl->register_mavlink_message_handler(
+                message_id, [this](const mavlink_message_t&) { ++count; }, this);
+        }
+    }
+
+    void deinit() override { _system_impl->unregister_all_mavlink_message_handlers(this); }
+    void enable() override {}
+    void disable() override {}
+
+    unsigned count{0};
+};
+
+mavlink_message_t make_attitude(uint8_t system_id)
+{
+    mavlink_message_t message;
+    mavlink_msg_attitude_pack(system_id, MAV_COMP_ID_AUTOPILOT1, &message, 0, 0, 0, 0, 0, 0, 0);
+    return message;
+}
+
+// Returns false if a message did not arrive exactly at its system.
+bool run(unsigned num_systems, unsigned num_messages)
+{
+    MavsdkImpl mavsdk_impl;
+
+    std::vector<mavlink_message_t> messages;
+    for (unsigned i = 1; i <= num_systems; ++i) {
+        messages.push_back(make_attitude(static_cast<uint8_t>(i)));
+        mavsdk_impl.receive_message(messages.back(), nullptr);
+    }
+
+    std::vector<std::unique_ptr<SubscriberImpl>> subscribers;
+    for (auto& system : mavsdk_impl.systems()) {
+        subscribers.push_back(std::make_unique<SubscriberImpl>(system));
+        subscribers.back()->init();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < num_messages; ++i) {
+        mavsdk_impl.receive_message(messages[i % num_systems], nullptr);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    bool ok = true;
+    for (unsigned i = 0; i < num_systems; ++i) {
+        const unsigned expected = num_messages / num_systems + (i < num_messages % num_systems);
+        ok = ok && subscribers[i]->count == expected;
+        subscribers[i]->deinit();
+    }
+
+    std::cout << std::setw(4) << num_systems << " systems: " << std::fixed << std::setprecision(1)
+              << std::chrono::duration<double, std::nano>(elapsed).count() / num_messages
+              << " ns/msg" << (ok ? "" : " (messages misrouted)") << '\n';
+
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const unsigned num_messages =
+        argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 1000000;
+    if (num_messages == 0) {
+        std::cerr << "Usage: " << argv[0] << " [num_messages]\n";
+        return 1;
+    }
+
+    std::cout << "Routing " << num_messages << " messages to "
+              << sizeof(subscribed_message_ids) / sizeof(subscribed_message_ids[0])
+              << " handlers per system\n";
+
+    bool ok = true;
+    for (const unsigned num_systems : {1u, 10u, 100u}) {
+        ok = run(num_systems, num_messages) && ok;
+    }
+
+    return ok ? 0 : 1;
+}
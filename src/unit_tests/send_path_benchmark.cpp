@@ -0,0 +1,108 @@
+// Measures how many messages per second a connection's SendQueue can take
+// from one sending thread and write out, with each message either packed on
+// the stack and pushed, or packed straight into the queue with emplace().
+//
+// The writes do nothing but serialize the message, or pass on the packed
+// bytes when coalescing, so only the cost of queueing and serializing is
+// measured, not that of a socket or serial port.
+//
+// Usage: send_path_benchmark [num_messages]
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "send_queue.h"
+
+using namespace mavsdk;
+
+namespace {
+
+void pack_attitude(mavlink_message_t& message, std::size_t i)
+{
+    mavlink_msg_attitude_pack(
+        1, MAV_COMP_ID_AUTOPILOT1, &message, static_cast<uint32_t>(i), 0, 0, 0, 0, 0, 0);
+}
+
+double messages_per_s(
+    SendQueue& queue, std::size_t num_messages, bool in_place, uint64_t& dropped)
+{
+    queue.start();
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < num_messages; ++i) {
+        // Like a plugin streaming as fast as it can, without dropping.
+        while (!queue.has_room(SendQueue::Priority::Normal)) {
+            std::this_thread::yield();
+        }
+        if (in_place) {
+            queue.emplace(MAVLINK_MSG_ID_ATTITUDE, [i](mavlink_message_t& message) {
+                pack_attitude(message, i);
+                return true;
+            });
+        } else {
+            mavlink_message_t message;
+            pack_attitude(message, i);
+            queue.push(message);
+        }
+    }
+    // Only returns once everything is written.
+    queue.stop();
+    const double elapsed_s =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const auto stats = queue.stats();
+    dropped = stats.dropped[static_cast<unsigned>(SendQueue::Priority::Normal)];
+    return static_cast<double>(stats.written) / elapsed_s;
+}
+
+void print(const std::string& name, double per_s, uint64_t write_calls, uint64_t dropped)
+{
+    std::cout << std::setw(20) << name << ": " << std::fixed << std::setprecision(2)
+              << per_s / 1e6 << " M messages/s, " << write_calls << " writes, " << dropped
+              << " dropped\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t num_messages = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    if (num_messages == 0) {
+        std::cerr << "Usage: " << argv[0] << " [num_messages]\n";
+        return 1;
+    }
+
+    for (const bool in_place : {false, true}) {
+        SendQueue queue([](const mavlink_message_t& message) {
+            uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+            return mavlink_msg_to_send_buffer(buffer, &message) > 0;
+        });
+        uint64_t dropped = 0;
+        const double per_s = messages_per_s(queue, num_messages, in_place, dropped);
+        print(in_place ? "single, in place" : "single", per_s, queue.stats().write_calls, dropped);
+    }
+
+    for (const bool in_place : {false, true}) {
+        SendQueue queue([](const mavlink_message_t&) { return true; });
+        std::atomic<uint64_t> bytes{0};
+        queue.set_coalescing(
+            std::chrono::microseconds(1000), [&](const uint8_t*, std::size_t length) {
+                bytes += length;
+                return true;
+            });
+        uint64_t dropped = 0;
+        const double per_s = messages_per_s(queue, num_messages, in_place, dropped);
+        print(
+            in_place ? "coalescing, in place" : "coalescing",
+            per_s,
+            queue.stats().write_calls,
+            dropped);
+    }
+
+    return 0;
+}
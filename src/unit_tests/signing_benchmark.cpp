@@ -0,0 +1,139 @@
+// Measures the time MAVLink 2 message signing adds per message, for short
+// and long messages.
+//
+// Compares signing and verifying with MavlinkSigning to only serializing the
+// message, as every connection does anyway, and to signing with the MAVLink
+// library.
+//
+// Usage: signing_benchmark [num_messages]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "mavlink_signing.h"
+
+using namespace mavsdk;
+
+namespace {
+
+template<typename F> double ns_per_message(std::size_t num_messages, F&& run)
+{
+    // Once to warm up, then the best of a few runs.
+    run();
+    double best_s = 1e9;
+    for (unsigned i = 0; i < 5; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        run();
+        const double elapsed_s =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best_s = std::min(best_s, elapsed_s);
+    }
+    return best_s * 1e9 / static_cast<double>(num_messages);
+}
+
+void print(const std::string& name, double ns)
+{
+    std::cout << std::setw(28) << name << ": " << std::fixed << std::setprecision(0) << ns
+              << " ns/message, max " << std::setprecision(1) << 1e3 / ns << " M messages/s\n";
+}
+
+void run_for(const std::string& name, const mavlink_message_t& message, std::size_t num_messages)
+{
+    std::array<uint8_t, MavlinkSigning::KEY_LEN> key{};
+    for (std::size_t i = 0; i < key.size(); ++i) {
+        key[i] = static_cast<uint8_t>(i * 11);
+    }
+
+    std::cout << name << " (" << static_cast<unsigned>(message.len) << " bytes payload)\n";
+
+    std::vector<uint8_t> buffer(MAVLINK_MAX_PACKET_LEN);
+    print("serialize only", ns_per_message(num_messages, [&]() {
+              for (std::size_t i = 0; i < num_messages; ++i) {
+                  mavlink_msg_to_send_buffer(buffer.data(), &message);
+              }
+          }));
+
+    MavlinkSigning signing;
+    signing.enable(key, 1, false);
+    std::vector<mavlink_message_t> signed_messages(num_messages, message);
+    print("sign and serialize", ns_per_message(num_messages, [&]() {
+              for (auto& signed_message : signed_messages) {
+                  signed_message = message;
+                  signing.sign(signed_message);
+                  mavlink_msg_to_send_buffer(buffer.data(), &signed_message);
+              }
+          }));
+
+    // Each verifier only accepts a message once, so every run needs its own.
+    print("verify", ns_per_message(num_messages, [&]() {
+              MavlinkSigning verifying;
+              verifying.enable(key, 0, false);
+              for (const auto& signed_message : signed_messages) {
+                  verifying.verify(signed_message);
+              }
+          }));
+
+    mavlink_signing_t library_signing{};
+    std::memcpy(library_signing.secret_key, key.data(), key.size());
+    library_signing.flags = MAVLINK_SIGNING_FLAG_SIGN_OUTGOING;
+    uint8_t header[MAVLINK_CORE_HEADER_LEN + 1]{};
+    uint8_t crc[2]{};
+    uint8_t signature[MAVLINK_SIGNATURE_BLOCK_LEN];
+    print("sign with MAVLink library", ns_per_message(num_messages, [&]() {
+              for (std::size_t i = 0; i < num_messages; ++i) {
+                  mavlink_sign_packet(
+                      &library_signing,
+                      signature,
+                      header,
+                      sizeof(header),
+                      reinterpret_cast<const uint8_t*>(message.payload64),
+                      message.len,
+                      crc);
+              }
+          }));
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::size_t num_messages = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    if (num_messages == 0) {
+        std::cerr << "Usage: " << argv[0] << " [num_messages]\n";
+        return 1;
+    }
+
+    mavlink_message_t heartbeat;
+    mavlink_msg_heartbeat_pack(
+        1,
+        MAV_COMP_ID_AUTOPILOT1,
+        &heartbeat,
+        MAV_TYPE_QUADROTOR,
+        MAV_AUTOPILOT_PX4,
+        MAV_MODE_FLAG_CUSTOM_MODE_ENABLED,
+        0,
+        MAV_STATE_ACTIVE);
+    run_for("HEARTBEAT", heartbeat, num_messages);
+
+    mavlink_message_t attitude;
+    mavlink_msg_attitude_pack(
+        1, MAV_COMP_ID_AUTOPILOT1, &attitude, 123456, 0.1f, -0.2f, 1.5f, 0.01f, 0.02f, 0.03f);
+    run_for("ATTITUDE", attitude, num_messages);
+
+    // The longest payload there is, like during FTP transfers.
+    mavlink_message_t ftp;
+    uint8_t ftp_payload[251];
+    for (std::size_t i = 0; i < sizeof(ftp_payload); ++i) {
+        ftp_payload[i] = static_cast<uint8_t>(i + 1);
+    }
+    mavlink_msg_file_transfer_protocol_pack(1, MAV_COMP_ID_AUTOPILOT1, &ftp, 0, 1, 1, ftp_payload);
+    run_for("FILE_TRANSFER_PROTOCOL", ftp, num_messages);
+
+    return 0;
+}
@@ -1,5 +1,10 @@
 #!/bin/bash
 
+# Note: a single mavsdk_server can serve all vehicles on one link, e.g. `mavsdk_server udp://:14540`
+# with each vehicle using its own MAV_SYS_ID. Clients then select the vehicle per call by sending
+# its system id as "mavsdk-system-id" gRPC metadata. This script is only needed if separate ports
+# or processes per vehicle are required.
+#
 # Run multiple MAVSDK-Server instances, up to a maximum of 9. Read (http://docs.px4.io/main/en/simulation/multi_vehicle_simulation_gazebo.html) notes.
 # For more than 9 vehicles reuse the 14549 UDP vehicle port and use the MAV_SYS_ID to select each vehicle.
 #